@@ -103,6 +103,8 @@ struct _GstAppSinkPrivate
   gboolean started;
   gboolean is_eos;
   gboolean buffer_lists_supported;
+  /* new_samples was called and the queue was not drained since */
+  gboolean samples_notified;
 
   GstAppSinkCallbacks callbacks;
   gpointer user_data;
@@ -637,6 +639,7 @@ gst_app_sink_flush_unlocked (GstAppSink * appsink)
   while ((obj = gst_queue_array_pop_head (priv->queue)))
     gst_mini_object_unref (obj);
   priv->num_buffers = 0;
+  priv->samples_notified = FALSE;
   g_cond_signal (&priv->cond);
 }
 
@@ -865,6 +868,34 @@ dequeue_buffer (GstAppSink * appsink)
   return obj;
 }
 
+/* call with the mutex held and at least one buffer/list in the queue */
+static GstSample *
+dequeue_sample (GstAppSink * appsink)
+{
+  GstAppSinkPrivate *priv = appsink->priv;
+  GstMiniObject *obj;
+  GstSample *sample;
+
+  obj = dequeue_buffer (appsink);
+  priv->sample = gst_sample_make_writable (priv->sample);
+  if (GST_IS_BUFFER (obj)) {
+    GST_DEBUG_OBJECT (appsink, "we have a buffer %p", obj);
+    gst_sample_set_buffer_list (priv->sample, NULL);
+    gst_sample_set_buffer (priv->sample, GST_BUFFER_CAST (obj));
+  } else {
+    GST_DEBUG_OBJECT (appsink, "we have a list %p", obj);
+    gst_sample_set_buffer (priv->sample, NULL);
+    gst_sample_set_buffer_list (priv->sample, GST_BUFFER_LIST_CAST (obj));
+  }
+  sample = gst_sample_ref (priv->sample);
+  gst_mini_object_unref (obj);
+
+  if (priv->num_buffers == 0)
+    priv->samples_notified = FALSE;
+
+  return sample;
+}
+
 static GstFlowReturn
 gst_app_sink_render_common (GstBaseSink * psink, GstMiniObject * data,
     gboolean is_list)
@@ -872,7 +903,8 @@ gst_app_sink_render_common (GstBaseSink * psink, GstMiniObject * data,
   GstFlowReturn ret;
   GstAppSink *appsink = GST_APP_SINK_CAST (psink);
   GstAppSinkPrivate *priv = appsink->priv;
-  gboolean emit;
+  gboolean emit, notify_samples = FALSE;
+  guint n_samples = 0;
 
 restart:
   g_mutex_lock (&priv->mutex);
@@ -931,10 +963,22 @@ restart:
   if ((priv->wait_status & APP_WAITING))
     g_cond_signal (&priv->cond);
 
+  /* only notify the batched callback again once the application drained
+   * the samples we told it about */
+  if (priv->callbacks.new_samples && !priv->samples_notified) {
+    priv->samples_notified = TRUE;
+    notify_samples = TRUE;
+    n_samples = priv->num_buffers;
+  }
+
   emit = priv->emit_signals;
   g_mutex_unlock (&priv->mutex);
 
-  if (priv->callbacks.new_sample) {
+  if (priv->callbacks.new_samples) {
+    ret = GST_FLOW_OK;
+    if (notify_samples)
+      ret = priv->callbacks.new_samples (appsink, n_samples, priv->user_data);
+  } else if (priv->callbacks.new_sample) {
     ret = priv->callbacks.new_sample (appsink, priv->user_data);
   } else {
     ret = GST_FLOW_OK;
@@ -1626,7 +1670,6 @@ gst_app_sink_try_pull_sample (GstAppSink * appsink, GstClockTime timeout)
 {
   GstAppSinkPrivate *priv;
   GstSample *sample = NULL;
-  GstMiniObject *obj;
   gboolean timeout_valid;
   gint64 end_time;
 
@@ -1666,21 +1709,7 @@ gst_app_sink_try_pull_sample (GstAppSink * appsink, GstClockTime timeout)
     priv->wait_status &= ~APP_WAITING;
   }
 
-  obj = dequeue_buffer (appsink);
-  if (GST_IS_BUFFER (obj)) {
-    GST_DEBUG_OBJECT (appsink, "we have a buffer %p", obj);
-    priv->sample = gst_sample_make_writable (priv->sample);
-    gst_sample_set_buffer_list (priv->sample, NULL);
-    gst_sample_set_buffer (priv->sample, GST_BUFFER_CAST (obj));
-    sample = gst_sample_ref (priv->sample);
-  } else {
-    GST_DEBUG_OBJECT (appsink, "we have a list %p", obj);
-    priv->sample = gst_sample_make_writable (priv->sample);
-    gst_sample_set_buffer (priv->sample, NULL);
-    gst_sample_set_buffer_list (priv->sample, GST_BUFFER_LIST_CAST (obj));
-    sample = gst_sample_ref (priv->sample);
-  }
-  gst_mini_object_unref (obj);
+  sample = dequeue_sample (appsink);
 
   if ((priv->wait_status & STREAM_WAITING))
     g_cond_signal (&priv->cond);
@@ -1711,6 +1740,117 @@ not_started:
   }
 }
 
+/**
+ * gst_app_sink_try_pull_samples:
+ * @appsink: a #GstAppSink
+ * @max_samples: the maximum number of samples to return, 0 for all queued
+ *     samples
+ * @timeout: the maximum amount of time to wait for the first sample
+ *
+ * This function blocks until at least one sample or EOS becomes available
+ * or the appsink element is set to the READY/NULL state or the timeout
+ * expires. It then dequeues up to @max_samples samples at once.
+ *
+ * This behaves like calling gst_app_sink_try_pull_sample() repeatedly but
+ * only takes the internal lock once, which is considerably cheaper when
+ * the application consumes many small buffers.
+ *
+ * If an EOS event was received before any buffers or the timeout expires,
+ * this function returns %NULL. Use gst_app_sink_is_eos () to check for the EOS
+ * condition.
+ *
+ * Returns: (transfer full) (element-type GstSample) (nullable): an array of
+ *     #GstSample in stream order or %NULL when the appsink is stopped or EOS
+ *     or the timeout expires. Call g_ptr_array_unref() after usage.
+ *
+ * Since: 1.16
+ */
+GPtrArray *
+gst_app_sink_try_pull_samples (GstAppSink * appsink, guint max_samples,
+    GstClockTime timeout)
+{
+  GstAppSinkPrivate *priv;
+  GPtrArray *samples;
+  gboolean timeout_valid;
+  gint64 end_time;
+  guint i, n;
+
+  g_return_val_if_fail (GST_IS_APP_SINK (appsink), NULL);
+
+  timeout_valid = GST_CLOCK_TIME_IS_VALID (timeout);
+
+  if (timeout_valid)
+    end_time =
+        g_get_monotonic_time () + timeout / (GST_SECOND / G_TIME_SPAN_SECOND);
+
+  priv = appsink->priv;
+
+  g_mutex_lock (&priv->mutex);
+  gst_buffer_replace (&priv->preroll_buffer, NULL);
+
+  while (TRUE) {
+    GST_DEBUG_OBJECT (appsink, "trying to grab buffers");
+    if (!priv->started)
+      goto not_started;
+
+    if (priv->num_buffers > 0)
+      break;
+
+    if (priv->is_eos)
+      goto eos;
+
+    /* nothing to return, wait */
+    GST_DEBUG_OBJECT (appsink, "waiting for a buffer");
+    priv->wait_status |= APP_WAITING;
+    if (timeout_valid) {
+      if (!g_cond_wait_until (&priv->cond, &priv->mutex, end_time))
+        goto expired;
+    } else {
+      g_cond_wait (&priv->cond, &priv->mutex);
+    }
+    priv->wait_status &= ~APP_WAITING;
+  }
+
+  n = priv->num_buffers;
+  if (max_samples > 0 && max_samples < n)
+    n = max_samples;
+
+  samples = g_ptr_array_new_full (n, (GDestroyNotify) gst_sample_unref);
+  for (i = 0; i < n; i++)
+    g_ptr_array_add (samples, dequeue_sample (appsink));
+
+  GST_DEBUG_OBJECT (appsink, "dequeued %u samples, %u left", n,
+      priv->num_buffers);
+
+  if ((priv->wait_status & STREAM_WAITING))
+    g_cond_signal (&priv->cond);
+
+  g_mutex_unlock (&priv->mutex);
+
+  return samples;
+
+  /* special conditions */
+expired:
+  {
+    GST_DEBUG_OBJECT (appsink, "timeout expired, return NULL");
+    priv->wait_status &= ~APP_WAITING;
+    g_mutex_unlock (&priv->mutex);
+    return NULL;
+  }
+eos:
+  {
+    GST_DEBUG_OBJECT (appsink, "we are EOS, return NULL");
+    g_mutex_unlock (&priv->mutex);
+    return NULL;
+  }
+not_started:
+  {
+    GST_DEBUG_OBJECT (appsink, "we are stopped, return NULL");
+    g_mutex_unlock (&priv->mutex);
+    return NULL;
+  }
+}
+
 /**
  * gst_app_sink_set_callbacks: (skip)
  * @appsink: a #GstAppSink
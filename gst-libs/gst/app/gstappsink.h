@@ -59,6 +59,13 @@ typedef struct _GstAppSinkPrivate GstAppSinkPrivate;
  *       The new sample can be retrieved with
  *       gst_app_sink_pull_sample() either from this callback
  *       or from any other thread.
+ * @new_samples: Called with the number of queued samples when new samples
+ *       are available. It is called only once until all queued samples
+ *       were pulled, so it fires once per wakeup of the application rather
+ *       than for every buffer. When set, @new_sample is not called.
+ *       This callback is called from the streaming thread.
+ *       The samples can be retrieved with gst_app_sink_try_pull_samples()
+ *       either from this callback or from any other thread. Since: 1.16
  *
  * A set of callbacks that can be installed on the appsink with
  * gst_app_sink_set_callbacks().
@@ -67,9 +74,10 @@ typedef struct {
   void          (*eos)              (GstAppSink *appsink, gpointer user_data);
   GstFlowReturn (*new_preroll)      (GstAppSink *appsink, gpointer user_data);
   GstFlowReturn (*new_sample)       (GstAppSink *appsink, gpointer user_data);
+  GstFlowReturn (*new_samples)      (GstAppSink *appsink, guint n_samples, gpointer user_data);
 
   /*< private >*/
-  gpointer     _gst_reserved[GST_PADDING];
+  gpointer     _gst_reserved[GST_PADDING - 1];
 } GstAppSinkCallbacks;
 
 struct _GstAppSink
@@ -156,6 +164,10 @@ GstSample *     gst_app_sink_try_pull_preroll (GstAppSink *appsink, GstClockTime
 GST_APP_API
 GstSample *     gst_app_sink_try_pull_sample  (GstAppSink *appsink, GstClockTime timeout);
 
+GST_APP_API
+GPtrArray *     gst_app_sink_try_pull_samples (GstAppSink *appsink, guint max_samples,
+                                               GstClockTime timeout);
+
 GST_APP_API
 void            gst_app_sink_set_callbacks    (GstAppSink * appsink,
                                                GstAppSinkCallbacks *callbacks,
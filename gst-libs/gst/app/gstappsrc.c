@@ -51,6 +51,10 @@
  * signal the "enough-data" signal, which signals the application that it should
  * stop pushing data into appsrc. The "block" property will cause appsrc to
  * block the push-buffer method until free data becomes available again.
+ * The "max-buffers" and "max-time" properties limit the queue by the number
+ * of buffers and the amount of time it holds instead. With the "leaky-type"
+ * property appsrc drops either the new or the oldest buffers when the queue
+ * is full, which keeps the latency bounded for live sources.
  *
  * When the internal queue is running out of data, the "need-data" signal is
  * emitted, which signals the application that it should start pushing more data
@@ -122,6 +126,9 @@ struct _GstAppSrcPrivate
   GstClockTime duration;
   GstAppStreamType stream_type;
   guint64 max_bytes;
+  guint64 max_buffers;
+  GstClockTime max_time;
+  GstAppLeakyType leaky_type;
   GstFormat format;
   gboolean block;
   gchar *uri;
@@ -130,6 +137,11 @@ struct _GstAppSrcPrivate
   gboolean started;
   gboolean is_eos;
   guint64 queued_bytes;
+  guint64 queued_buffers;
+  /* timestamps of the last queued and the last dequeued buffer, their
+   * difference is the amount of queued time */
+  GstClockTime last_in_ts;
+  GstClockTime last_out_ts;
   guint64 offset;
   GstAppStreamType current_type;
 
@@ -138,6 +150,11 @@ struct _GstAppSrcPrivate
   gboolean emit_signals;
   guint min_percent;
 
+  /* stats */
+  guint64 n_in;
+  guint64 n_out;
+  guint64 n_dropped;
+
   GstAppSrcCallbacks callbacks;
   gpointer user_data;
   GDestroyNotify notify;
@@ -165,6 +182,9 @@ enum
 #define DEFAULT_PROP_SIZE          -1
 #define DEFAULT_PROP_STREAM_TYPE   GST_APP_STREAM_TYPE_STREAM
 #define DEFAULT_PROP_MAX_BYTES     200000
+#define DEFAULT_PROP_MAX_BUFFERS   0
+#define DEFAULT_PROP_MAX_TIME      0
+#define DEFAULT_PROP_LEAKY_TYPE    GST_APP_LEAKY_TYPE_NONE
 #define DEFAULT_PROP_FORMAT        GST_FORMAT_BYTES
 #define DEFAULT_PROP_BLOCK         FALSE
 #define DEFAULT_PROP_IS_LIVE       FALSE
@@ -173,6 +193,8 @@ enum
 #define DEFAULT_PROP_EMIT_SIGNALS  TRUE
 #define DEFAULT_PROP_MIN_PERCENT   0
 #define DEFAULT_PROP_CURRENT_LEVEL_BYTES   0
+#define DEFAULT_PROP_CURRENT_LEVEL_BUFFERS 0
+#define DEFAULT_PROP_CURRENT_LEVEL_TIME    0
 #define DEFAULT_PROP_DURATION      GST_CLOCK_TIME_NONE
 
 enum
@@ -191,6 +213,12 @@ enum
   PROP_MIN_PERCENT,
   PROP_CURRENT_LEVEL_BYTES,
   PROP_DURATION,
+  PROP_MAX_BUFFERS,
+  PROP_MAX_TIME,
+  PROP_LEAKY_TYPE,
+  PROP_CURRENT_LEVEL_BUFFERS,
+  PROP_CURRENT_LEVEL_TIME,
+  PROP_STATS,
   PROP_LAST
 };
 
@@ -410,6 +438,97 @@ gst_app_src_class_init (GstAppSrcClass * klass)
           0, G_MAXUINT64, DEFAULT_PROP_DURATION,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstAppSrc::max-buffers:
+   *
+   * The maximum amount of buffers that can be queued internally.
+   * After the maximum amount of buffers are queued, appsrc will emit the
+   * "enough-data" signal.
+   *
+   * Since: 1.16
+   */
+  g_object_class_install_property (gobject_class, PROP_MAX_BUFFERS,
+      g_param_spec_uint64 ("max-buffers", "Max buffers",
+          "The maximum number of buffers to queue internally (0 = disabled)",
+          0, G_MAXUINT64, DEFAULT_PROP_MAX_BUFFERS,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstAppSrc::max-time:
+   *
+   * The maximum amount of time that can be queued internally.
+   * After the maximum amount of time are queued, appsrc will emit the
+   * "enough-data" signal.
+   *
+   * Since: 1.16
+   */
+  g_object_class_install_property (gobject_class, PROP_MAX_TIME,
+      g_param_spec_uint64 ("max-time", "Max time",
+          "The maximum amount of time to queue internally (0 = disabled)",
+          0, G_MAXUINT64, DEFAULT_PROP_MAX_TIME,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstAppSrc::leaky-type:
+   *
+   * When set to any other value than GST_APP_LEAKY_TYPE_NONE then the appsrc
+   * will drop any buffers that are pushed into it once its internal queue is
+   * full. The selected type defines whether to drop the oldest or new
+   * buffers.
+   *
+   * Since: 1.16
+   */
+  g_object_class_install_property (gobject_class, PROP_LEAKY_TYPE,
+      g_param_spec_enum ("leaky-type", "Leaky Type",
+          "Whether to drop buffers once the internal queue is full",
+          GST_TYPE_APP_LEAKY_TYPE, DEFAULT_PROP_LEAKY_TYPE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstAppSrc::current-level-buffers:
+   *
+   * The number of currently queued buffers inside appsrc.
+   *
+   * Since: 1.16
+   */
+  g_object_class_install_property (gobject_class, PROP_CURRENT_LEVEL_BUFFERS,
+      g_param_spec_uint64 ("current-level-buffers", "Current Level Buffers",
+          "The number of currently queued buffers",
+          0, G_MAXUINT64, DEFAULT_PROP_CURRENT_LEVEL_BUFFERS,
+          G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstAppSrc::current-level-time:
+   *
+   * The amount of currently queued time inside appsrc, measured between
+   * the timestamps of the last queued and the last dequeued buffer.
+   *
+   * Since: 1.16
+   */
+  g_object_class_install_property (gobject_class, PROP_CURRENT_LEVEL_TIME,
+      g_param_spec_uint64 ("current-level-time", "Current Level Time",
+          "The amount of currently queued time",
+          0, G_MAXUINT64, DEFAULT_PROP_CURRENT_LEVEL_TIME,
+          G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstAppSrc::stats:
+   *
+   * Various #GstAppSrc statistics. This property returns a #GstStructure
+   * with name application/x-app-src-stats with the following fields:
+   *
+   * - "in"  G_TYPE_UINT64 number of buffers that were queued
+   * - "out" G_TYPE_UINT64 number of buffers that were pushed downstream
+   * - "dropped" G_TYPE_UINT64 number of buffers dropped because the queue
+   *   was full and a leaky-type was configured
+   *
+   * Since: 1.16
+   */
+  g_object_class_install_property (gobject_class, PROP_STATS,
+      g_param_spec_boxed ("stats", "Statistics",
+          "Various statistics", GST_TYPE_STRUCTURE,
+          G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
   /**
    * GstAppSrc::need-data:
    * @appsrc: the appsrc element that emitted the signal
@@ -583,6 +702,11 @@ gst_app_src_init (GstAppSrc * appsrc)
   priv->duration = DEFAULT_PROP_DURATION;
   priv->stream_type = DEFAULT_PROP_STREAM_TYPE;
   priv->max_bytes = DEFAULT_PROP_MAX_BYTES;
+  priv->max_buffers = DEFAULT_PROP_MAX_BUFFERS;
+  priv->max_time = DEFAULT_PROP_MAX_TIME;
+  priv->leaky_type = DEFAULT_PROP_LEAKY_TYPE;
+  priv->last_in_ts = GST_CLOCK_TIME_NONE;
+  priv->last_out_ts = GST_CLOCK_TIME_NONE;
   priv->format = DEFAULT_PROP_FORMAT;
   priv->block = DEFAULT_PROP_BLOCK;
   priv->min_latency = DEFAULT_PROP_MIN_LATENCY;
@@ -616,6 +740,144 @@ gst_app_src_flush_queued (GstAppSrc * src, gboolean retain_last_caps)
   }
 
   priv->queued_bytes = 0;
+  priv->queued_buffers = 0;
+  priv->last_in_ts = GST_CLOCK_TIME_NONE;
+  priv->last_out_ts = GST_CLOCK_TIME_NONE;
+}
+
+static GstClockTime
+buffer_get_ts (GstBuffer * buffer)
+{
+  GstClockTime ts = GST_BUFFER_DTS (buffer);
+
+  if (!GST_CLOCK_TIME_IS_VALID (ts))
+    ts = GST_BUFFER_PTS (buffer);
+
+  return ts;
+}
+
+/* size, number of buffers and timestamp of the last buffer of a queued
+ * buffer or buffer list */
+static void
+queue_item_get_info (GstMiniObject * obj, guint64 * size, guint * n_buffers,
+    GstClockTime * ts)
+{
+  if (GST_IS_BUFFER (obj)) {
+    *size = gst_buffer_get_size (GST_BUFFER_CAST (obj));
+    *n_buffers = 1;
+    *ts = buffer_get_ts (GST_BUFFER_CAST (obj));
+  } else {
+    GstBufferList *list = GST_BUFFER_LIST_CAST (obj);
+
+    *size = gst_buffer_list_calculate_size (list);
+    *n_buffers = gst_buffer_list_length (list);
+    *ts = *n_buffers ? buffer_get_ts (gst_buffer_list_get (list,
+            *n_buffers - 1)) : GST_CLOCK_TIME_NONE;
+  }
+}
+
+/* with priv->mutex */
+static void
+gst_app_src_item_queued (GstAppSrc * appsrc, GstMiniObject * obj)
+{
+  GstAppSrcPrivate *priv = appsrc->priv;
+  GstClockTime ts;
+  guint64 size;
+  guint n_buffers;
+
+  queue_item_get_info (obj, &size, &n_buffers, &ts);
+
+  priv->queued_bytes += size;
+  priv->queued_buffers += n_buffers;
+  priv->n_in += n_buffers;
+
+  if (GST_CLOCK_TIME_IS_VALID (ts)) {
+    priv->last_in_ts = ts;
+    if (!GST_CLOCK_TIME_IS_VALID (priv->last_out_ts))
+      priv->last_out_ts = ts;
+  }
+}
+
+/* with priv->mutex */
+static void
+gst_app_src_item_dequeued (GstAppSrc * appsrc, GstMiniObject * obj)
+{
+  GstAppSrcPrivate *priv = appsrc->priv;
+  GstClockTime ts;
+  guint64 size;
+  guint n_buffers;
+
+  queue_item_get_info (obj, &size, &n_buffers, &ts);
+
+  priv->queued_bytes -= size;
+  priv->queued_buffers -= n_buffers;
+
+  if (GST_CLOCK_TIME_IS_VALID (ts))
+    priv->last_out_ts = ts;
+}
+
+/* with priv->mutex */
+static GstClockTime
+gst_app_src_get_queued_time_unlocked (GstAppSrc * appsrc)
+{
+  GstAppSrcPrivate *priv = appsrc->priv;
+
+  if (priv->queued_buffers == 0 ||
+      !GST_CLOCK_TIME_IS_VALID (priv->last_in_ts) ||
+      !GST_CLOCK_TIME_IS_VALID (priv->last_out_ts) ||
+      priv->last_in_ts < priv->last_out_ts)
+    return 0;
+
+  return priv->last_in_ts - priv->last_out_ts;
+}
+
+/* with priv->mutex */
+static gboolean
+gst_app_src_is_full_unlocked (GstAppSrc * appsrc)
+{
+  GstAppSrcPrivate *priv = appsrc->priv;
+
+  if (priv->max_bytes && priv->queued_bytes >= priv->max_bytes)
+    return TRUE;
+  if (priv->max_buffers && priv->queued_buffers >= priv->max_buffers)
+    return TRUE;
+  if (priv->max_time &&
+      gst_app_src_get_queued_time_unlocked (appsrc) >= priv->max_time)
+    return TRUE;
+
+  return FALSE;
+}
+
+static gint
+find_buffer_or_list (gconstpointer a, gconstpointer b)
+{
+  return (GST_IS_BUFFER (a) || GST_IS_BUFFER_LIST (a)) ? 0 : 1;
+}
+
+/* drop the oldest queued buffer or buffer list, leaving caps in place.
+ * with priv->mutex */
+static gboolean
+gst_app_src_drop_oldest_unlocked (GstAppSrc * appsrc)
+{
+  GstAppSrcPrivate *priv = appsrc->priv;
+  GstMiniObject *obj;
+  guint idx, n_buffers;
+
+  idx = gst_queue_array_find (priv->queue, find_buffer_or_list, NULL);
+  if (idx == G_MAXUINT)
+    return FALSE;
+
+  obj = gst_queue_array_drop_element (priv->queue, idx);
+  gst_app_src_item_dequeued (appsrc, obj);
+
+  n_buffers = GST_IS_BUFFER (obj) ? 1 :
+      gst_buffer_list_length (GST_BUFFER_LIST_CAST (obj));
+  priv->n_dropped += n_buffers;
+
+  GST_DEBUG_OBJECT (appsrc, "dropped oldest buffer/list %p", obj);
+  gst_mini_object_unref (obj);
+
+  return TRUE;
 }
 
 static void
@@ -736,6 +998,15 @@ gst_app_src_set_property (GObject * object, guint prop_id,
     case PROP_DURATION:
       gst_app_src_set_duration (appsrc, g_value_get_uint64 (value));
       break;
+    case PROP_MAX_BUFFERS:
+      gst_app_src_set_max_buffers (appsrc, g_value_get_uint64 (value));
+      break;
+    case PROP_MAX_TIME:
+      gst_app_src_set_max_time (appsrc, g_value_get_uint64 (value));
+      break;
+    case PROP_LEAKY_TYPE:
+      gst_app_src_set_leaky_type (appsrc, g_value_get_enum (value));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -799,6 +1070,35 @@ gst_app_src_get_property (GObject * object, guint prop_id, GValue * value,
     case PROP_DURATION:
       g_value_set_uint64 (value, gst_app_src_get_duration (appsrc));
       break;
+    case PROP_MAX_BUFFERS:
+      g_value_set_uint64 (value, gst_app_src_get_max_buffers (appsrc));
+      break;
+    case PROP_MAX_TIME:
+      g_value_set_uint64 (value, gst_app_src_get_max_time (appsrc));
+      break;
+    case PROP_LEAKY_TYPE:
+      g_value_set_enum (value, gst_app_src_get_leaky_type (appsrc));
+      break;
+    case PROP_CURRENT_LEVEL_BUFFERS:
+      g_value_set_uint64 (value,
+          gst_app_src_get_current_level_buffers (appsrc));
+      break;
+    case PROP_CURRENT_LEVEL_TIME:
+      g_value_set_uint64 (value, gst_app_src_get_current_level_time (appsrc));
+      break;
+    case PROP_STATS:
+    {
+      GstStructure *stats;
+
+      g_mutex_lock (&priv->mutex);
+      stats = gst_structure_new ("application/x-app-src-stats",
+          "in", G_TYPE_UINT64, priv->n_in,
+          "out", G_TYPE_UINT64, priv->n_out,
+          "dropped", G_TYPE_UINT64, priv->n_dropped, NULL);
+      g_mutex_unlock (&priv->mutex);
+      g_value_take_boxed (value, stats);
+      break;
+    }
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -1201,8 +1501,13 @@ gst_app_src_create (GstBaseSrc * bsrc, guint64 offset, guint size,
           gst_caps_unref (next_caps);
         }
 
-        if (caps_changed)
+        if (caps_changed) {
           gst_app_src_do_negotiate (bsrc);
+          /* make the base class run the allocation query for the new caps
+           * before the next buffer so that gst_app_src_acquire_buffer() can
+           * hand out memory from the new downstream pool */
+          gst_pad_mark_reconfigure (GST_BASE_SRC_PAD (bsrc));
+        }
 
         /* Lock has released so now may need
          *- flushing
@@ -1215,9 +1520,12 @@ gst_app_src_create (GstBaseSrc * bsrc, guint64 offset, guint size,
         continue;
       }
 
+      gst_app_src_item_dequeued (appsrc, obj);
+
       if (GST_IS_BUFFER (obj)) {
         *buf = GST_BUFFER (obj);
         buf_size = gst_buffer_get_size (*buf);
+        priv->n_out++;
         GST_LOG_OBJECT (appsrc, "have buffer %p of size %u", *buf, buf_size);
       } else {
         GstBufferList *buffer_list;
@@ -1230,13 +1538,12 @@ gst_app_src_create (GstBaseSrc * bsrc, guint64 offset, guint size,
 
         GST_LOG_OBJECT (appsrc, "have buffer list %p of size %u, %u buffers",
             buffer_list, buf_size, gst_buffer_list_length (buffer_list));
+        priv->n_out += gst_buffer_list_length (buffer_list);
 
         gst_base_src_submit_buffer_list (bsrc, buffer_list);
         *buf = NULL;
       }
 
-      priv->queued_bytes -= buf_size;
-
       /* only update the offset when in random_access mode */
       if (priv->stream_type == GST_APP_STREAM_TYPE_RANDOM_ACCESS)
         priv->offset += buf_size;
@@ -1621,6 +1928,242 @@ gst_app_src_get_current_level_bytes (GstAppSrc * appsrc)
   return queued;
 }
 
+/**
+ * gst_app_src_set_max_buffers:
+ * @appsrc: a #GstAppSrc
+ * @max: the maximum number of buffers to queue
+ *
+ * Set the maximum amount of buffers that can be queued in @appsrc.
+ * After the maximum amount of buffers are queued, @appsrc will emit the
+ * "enough-data" signal.
+ *
+ * Since: 1.16
+ */
+void
+gst_app_src_set_max_buffers (GstAppSrc * appsrc, guint64 max)
+{
+  GstAppSrcPrivate *priv;
+
+  g_return_if_fail (GST_IS_APP_SRC (appsrc));
+
+  priv = appsrc->priv;
+
+  g_mutex_lock (&priv->mutex);
+  if (max != priv->max_buffers) {
+    GST_DEBUG_OBJECT (appsrc, "setting max-buffers to %" G_GUINT64_FORMAT,
+        max);
+    priv->max_buffers = max;
+    /* signal the change */
+    g_cond_broadcast (&priv->cond);
+  }
+  g_mutex_unlock (&priv->mutex);
+}
+
+/**
+ * gst_app_src_get_max_buffers:
+ * @appsrc: a #GstAppSrc
+ *
+ * Get the maximum amount of buffers that can be queued in @appsrc.
+ *
+ * Returns: The maximum amount of buffers that can be queued.
+ *
+ * Since: 1.16
+ */
+guint64
+gst_app_src_get_max_buffers (GstAppSrc * appsrc)
+{
+  guint64 result;
+  GstAppSrcPrivate *priv;
+
+  g_return_val_if_fail (GST_IS_APP_SRC (appsrc), 0);
+
+  priv = appsrc->priv;
+
+  g_mutex_lock (&priv->mutex);
+  result = priv->max_buffers;
+  GST_DEBUG_OBJECT (appsrc, "getting max-buffers of %" G_GUINT64_FORMAT,
+      result);
+  g_mutex_unlock (&priv->mutex);
+
+  return result;
+}
+
+/**
+ * gst_app_src_set_max_time:
+ * @appsrc: a #GstAppSrc
+ * @max: the maximum amount of time to queue
+ *
+ * Set the maximum amount of time that can be queued in @appsrc.
+ * After the maximum amount of time are queued, @appsrc will emit the
+ * "enough-data" signal.
+ *
+ * Since: 1.16
+ */
+void
+gst_app_src_set_max_time (GstAppSrc * appsrc, GstClockTime max)
+{
+  GstAppSrcPrivate *priv;
+
+  g_return_if_fail (GST_IS_APP_SRC (appsrc));
+
+  priv = appsrc->priv;
+
+  g_mutex_lock (&priv->mutex);
+  if (max != priv->max_time) {
+    GST_DEBUG_OBJECT (appsrc, "setting max-time to %" GST_TIME_FORMAT,
+        GST_TIME_ARGS (max));
+    priv->max_time = max;
+    /* signal the change */
+    g_cond_broadcast (&priv->cond);
+  }
+  g_mutex_unlock (&priv->mutex);
+}
+
+/**
+ * gst_app_src_get_max_time:
+ * @appsrc: a #GstAppSrc
+ *
+ * Get the maximum amount of time that can be queued in @appsrc.
+ *
+ * Returns: The maximum amount of time that can be queued.
+ *
+ * Since: 1.16
+ */
+GstClockTime
+gst_app_src_get_max_time (GstAppSrc * appsrc)
+{
+  GstClockTime result;
+  GstAppSrcPrivate *priv;
+
+  g_return_val_if_fail (GST_IS_APP_SRC (appsrc), 0);
+
+  priv = appsrc->priv;
+
+  g_mutex_lock (&priv->mutex);
+  result = priv->max_time;
+  GST_DEBUG_OBJECT (appsrc, "getting max-time of %" GST_TIME_FORMAT,
+      GST_TIME_ARGS (result));
+  g_mutex_unlock (&priv->mutex);
+
+  return result;
+}
+
+/**
+ * gst_app_src_set_leaky_type:
+ * @appsrc: a #GstAppSrc
+ * @leaky: the #GstAppLeakyType
+ *
+ * When set to any other value than GST_APP_LEAKY_TYPE_NONE then the appsrc
+ * will drop any buffers that are pushed into it once its internal queue is
+ * full. The selected type defines whether to drop the oldest or new
+ * buffers.
+ *
+ * Since: 1.16
+ */
+void
+gst_app_src_set_leaky_type (GstAppSrc * appsrc, GstAppLeakyType leaky)
+{
+  GstAppSrcPrivate *priv;
+
+  g_return_if_fail (GST_IS_APP_SRC (appsrc));
+
+  priv = appsrc->priv;
+
+  g_mutex_lock (&priv->mutex);
+  priv->leaky_type = leaky;
+  /* blocked pushers need to drop now */
+  g_cond_broadcast (&priv->cond);
+  g_mutex_unlock (&priv->mutex);
+}
+
+/**
+ * gst_app_src_get_leaky_type:
+ * @appsrc: a #GstAppSrc
+ *
+ * Returns the currently set #GstAppLeakyType. See gst_app_src_set_leaky_type()
+ * for more details.
+ *
+ * Returns: The currently set #GstAppLeakyType.
+ *
+ * Since: 1.16
+ */
+GstAppLeakyType
+gst_app_src_get_leaky_type (GstAppSrc * appsrc)
+{
+  GstAppLeakyType result;
+  GstAppSrcPrivate *priv;
+
+  g_return_val_if_fail (GST_IS_APP_SRC (appsrc), GST_APP_LEAKY_TYPE_NONE);
+
+  priv = appsrc->priv;
+
+  g_mutex_lock (&priv->mutex);
+  result = priv->leaky_type;
+  g_mutex_unlock (&priv->mutex);
+
+  return result;
+}
+
+/**
+ * gst_app_src_get_current_level_buffers:
+ * @appsrc: a #GstAppSrc
+ *
+ * Get the number of currently queued buffers inside @appsrc.
+ *
+ * Returns: The number of currently queued buffers.
+ *
+ * Since: 1.16
+ */
+guint64
+gst_app_src_get_current_level_buffers (GstAppSrc * appsrc)
+{
+  guint64 queued;
+  GstAppSrcPrivate *priv;
+
+  g_return_val_if_fail (GST_IS_APP_SRC (appsrc), 0);
+
+  priv = appsrc->priv;
+
+  g_mutex_lock (&priv->mutex);
+  queued = priv->queued_buffers;
+  GST_DEBUG_OBJECT (appsrc, "current level buffers is %" G_GUINT64_FORMAT,
+      queued);
+  g_mutex_unlock (&priv->mutex);
+
+  return queued;
+}
+
+/**
+ * gst_app_src_get_current_level_time:
+ * @appsrc: a #GstAppSrc
+ *
+ * Get the amount of currently queued time inside @appsrc. This is the
+ * difference between the timestamps of the last queued buffer and of the
+ * last buffer that left the queue.
+ *
+ * Returns: The amount of currently queued time.
+ *
+ * Since: 1.16
+ */
+GstClockTime
+gst_app_src_get_current_level_time (GstAppSrc * appsrc)
+{
+  GstClockTime queued;
+  GstAppSrcPrivate *priv;
+
+  g_return_val_if_fail (GST_IS_APP_SRC (appsrc), 0);
+
+  priv = appsrc->priv;
+
+  g_mutex_lock (&priv->mutex);
+  queued = gst_app_src_get_queued_time_unlocked (appsrc);
+  GST_DEBUG_OBJECT (appsrc, "current level time is %" GST_TIME_FORMAT,
+      GST_TIME_ARGS (queued));
+  g_mutex_unlock (&priv->mutex);
+
+  return queued;
+}
+
 static void
 gst_app_src_set_latencies (GstAppSrc * appsrc, gboolean do_min, guint64 min,
     gboolean do_max, guint64 max)
@@ -1813,10 +2356,12 @@ gst_app_src_push_internal (GstAppSrc * appsrc, GstBuffer * buffer,
     if (priv->is_eos)
       goto eos;
 
-    if (priv->max_bytes && priv->queued_bytes >= priv->max_bytes) {
+    if (gst_app_src_is_full_unlocked (appsrc)) {
       GST_DEBUG_OBJECT (appsrc,
-          "queue filled (%" G_GUINT64_FORMAT " >= %" G_GUINT64_FORMAT ")",
-          priv->queued_bytes, priv->max_bytes);
+          "queue filled (%" G_GUINT64_FORMAT " bytes, %" G_GUINT64_FORMAT
+          " buffers, %" GST_TIME_FORMAT ")", priv->queued_bytes,
+          priv->queued_buffers,
+          GST_TIME_ARGS (gst_app_src_get_queued_time_unlocked (appsrc)));
 
       if (first) {
         gboolean emit;
@@ -1836,7 +2381,14 @@ gst_app_src_push_internal (GstAppSrc * appsrc, GstBuffer * buffer,
         first = FALSE;
         continue;
       }
-      if (priv->block) {
+      if (priv->leaky_type == GST_APP_LEAKY_TYPE_UPSTREAM) {
+        goto dropped;
+      } else if (priv->leaky_type == GST_APP_LEAKY_TYPE_DOWNSTREAM) {
+        /* make room by dropping the oldest data and check again */
+        if (gst_app_src_drop_oldest_unlocked (appsrc))
+          continue;
+        break;
+      } else if (priv->block) {
         GST_DEBUG_OBJECT (appsrc, "waiting for free space");
         /* we are filled, wait until a buffer gets popped or when we
          * flush. */
@@ -1858,13 +2410,13 @@ gst_app_src_push_internal (GstAppSrc * appsrc, GstBuffer * buffer,
     if (!steal_ref)
       gst_buffer_list_ref (buflist);
     gst_queue_array_push_tail (priv->queue, buflist);
-    priv->queued_bytes += gst_buffer_list_calculate_size (buflist);
+    gst_app_src_item_queued (appsrc, GST_MINI_OBJECT_CAST (buflist));
   } else {
     GST_DEBUG_OBJECT (appsrc, "queueing buffer %p", buffer);
     if (!steal_ref)
       gst_buffer_ref (buffer);
     gst_queue_array_push_tail (priv->queue, buffer);
-    priv->queued_bytes += gst_buffer_get_size (buffer);
+    gst_app_src_item_queued (appsrc, GST_MINI_OBJECT_CAST (buffer));
   }
 
   if ((priv->wait_status & STREAM_WAITING))
@@ -1891,6 +2443,24 @@ eos:
     g_mutex_unlock (&priv->mutex);
     return GST_FLOW_EOS;
   }
+dropped:
+  {
+    if (buflist != NULL) {
+      GST_DEBUG_OBJECT (appsrc, "dropping new buffer list %p, queue is full",
+          buflist);
+      priv->n_dropped += gst_buffer_list_length (buflist);
+      if (steal_ref)
+        gst_buffer_list_unref (buflist);
+    } else {
+      GST_DEBUG_OBJECT (appsrc, "dropping new buffer %p, queue is full",
+          buffer);
+      priv->n_dropped++;
+      if (steal_ref)
+        gst_buffer_unref (buffer);
+    }
+    g_mutex_unlock (&priv->mutex);
+    return GST_FLOW_OK;
+  }
 }
 
 static GstFlowReturn
@@ -1928,6 +2498,92 @@ gst_app_src_push_sample_internal (GstAppSrc * appsrc, GstSample * sample)
   return GST_FLOW_OK;
 }
 
+/**
+ * gst_app_src_acquire_buffer:
+ * @appsrc: a #GstAppSrc
+ * @size: the size of the buffer
+ * @buffer: (out) (transfer full): a location for the new #GstBuffer
+ *
+ * Allocate a buffer of @size bytes that the application can fill and then
+ * push with gst_app_src_push_buffer().
+ *
+ * Once the caps of @appsrc are negotiated, the buffer comes from the
+ * #GstBufferPool or #GstAllocator that was agreed on with downstream in the
+ * ALLOCATION query. Filling such a buffer directly avoids copying the data
+ * again downstream, for example into shared memory or GL mapped buffers.
+ * Buffers from a video pool can carry a #GstVideoMeta with the strides the
+ * application has to respect. Acquiring a buffer from a pool can block until
+ * downstream releases one of its buffers.
+ *
+ * Before negotiation, or when the negotiated pool is too small for @size, a
+ * buffer is allocated with the negotiated allocator or with the default
+ * allocator.
+ *
+ * Returns: #GST_FLOW_OK when a buffer was allocated.
+ * #GST_FLOW_FLUSHING when the pool is being deactivated.
+ * #GST_FLOW_ERROR when the allocation failed.
+ *
+ * Since: 1.16
+ */
+GstFlowReturn
+gst_app_src_acquire_buffer (GstAppSrc * appsrc, gsize size,
+    GstBuffer ** buffer)
+{
+  GstBaseSrc *basesrc;
+  GstBufferPool *pool;
+  GstAllocator *allocator = NULL;
+  GstAllocationParams params;
+
+  g_return_val_if_fail (GST_IS_APP_SRC (appsrc), GST_FLOW_ERROR);
+  g_return_val_if_fail (buffer != NULL, GST_FLOW_ERROR);
+
+  basesrc = GST_BASE_SRC_CAST (appsrc);
+
+  if ((pool = gst_base_src_get_buffer_pool (basesrc))) {
+    GstStructure *config;
+    guint pool_size = 0;
+
+    config = gst_buffer_pool_get_config (pool);
+    gst_buffer_pool_config_get_params (config, NULL, &pool_size, NULL, NULL);
+    gst_structure_free (config);
+
+    if (size <= pool_size) {
+      GstFlowReturn ret;
+
+      ret = gst_buffer_pool_acquire_buffer (pool, buffer, NULL);
+      gst_object_unref (pool);
+
+      if (ret != GST_FLOW_OK) {
+        GST_DEBUG_OBJECT (appsrc, "failed to acquire buffer from pool: %s",
+            gst_flow_get_name (ret));
+        return ret;
+      }
+      if (size < pool_size)
+        gst_buffer_set_size (*buffer, size);
+
+      GST_LOG_OBJECT (appsrc, "acquired buffer %p of size %" G_GSIZE_FORMAT
+          " from pool", *buffer, size);
+      return GST_FLOW_OK;
+    }
+    GST_DEBUG_OBJECT (appsrc, "pool buffers of size %u are too small for %"
+        G_GSIZE_FORMAT, pool_size, size);
+    gst_object_unref (pool);
+  }
+
+  gst_base_src_get_allocator (basesrc, &allocator, &params);
+  *buffer = gst_buffer_new_allocate (allocator, size, &params);
+  if (allocator)
+    gst_object_unref (allocator);
+
+  if (*buffer == NULL) {
+    GST_WARNING_OBJECT (appsrc, "failed to allocate buffer of size %"
+        G_GSIZE_FORMAT, size);
+    return GST_FLOW_ERROR;
+  }
+
+  return GST_FLOW_OK;
+}
+
 /**
  * gst_app_src_push_buffer:
  * @appsrc: a #GstAppSrc
@@ -68,7 +68,12 @@ ensure_debug_category (void)
 #define ensure_debug_category() /* NOOP */
 #endif /* GST_DISABLE_GST_DEBUG */
 
+#define GST_PARALLELIZED_TASK_THREAD_NAME "audioconvert"
+#include "gst/parallelized-task-runner-private.h"
+
 typedef struct _AudioChain AudioChain;
+typedef struct _AudioChainSlice AudioChainSlice;
+typedef struct _AudioResampleGroup AudioResampleGroup;
 
 typedef void (*AudioConvertFunc) (gpointer dst, const gpointer src, gint count);
 typedef gboolean (*AudioConvertSamplesFunc) (GstAudioConverter * convert,
@@ -124,12 +129,18 @@ struct _GstAudioConverter
 
   /* resample */
   GstAudioResampler *resampler;
+  AudioResampleGroup *groups;   /* one per thread when resampling by channel groups, else NULL */
+  gpointer *group_data;
+  gpointer *resample_in;
+  gpointer *resample_out;
+  gint resample_bps;
 
   /* convert out */
   AudioConvertFunc convert_out;
 
   /* quant */
   GstAudioQuantize *quant;
+  gboolean quant_sliced;        /* no dither or noise shaping state, can be split in frames */
 
   /* pack */
   gboolean out_default;
@@ -139,6 +150,22 @@ struct _GstAudioConverter
   AudioConvertEndianFunc swap_endian;
 
   AudioConvertSamplesFunc convert;
+
+  /* scratch memory of all the chain steps. Steps writing to temp samples
+   * alternate between two slots so that a step never writes to the samples
+   * it reads. The deinterleaved planes of the resample groups follow the
+   * slots. Only grows, in powers of two */
+  gpointer arena;
+  gsize arena_frames;           /* frames that fit in one block */
+  gsize arena_block_stride;     /* bytes between blocks */
+  gint arena_stride;            /* largest stride of the steps using the arena */
+  gint arena_blocks;            /* largest number of blocks of those steps */
+  gint arena_slots;
+
+  /* threading, NULL when running on the calling thread only */
+  GstParallelizedTaskRunner *runner;
+  AudioChainSlice *slices;
+  gpointer *slice_data;
 };
 
 static GstAudioConverter *
@@ -178,13 +205,41 @@ struct _AudioChain
   AudioChainAllocFunc alloc_func;
   gpointer alloc_data;
 
-  gpointer *tmp;
-  gsize allocated_samples;
+  gpointer *tmp;                /* block pointers into the arena */
+  gint slot;                    /* arena slot when allocating temp samples */
 
   gpointer *samples;
   gsize num_samples;
 };
 
+/* a range of frames of one step, handled by one thread */
+struct _AudioChainSlice
+{
+  GstAudioConverter *convert;
+  AudioChain *chain;
+  gpointer *in;
+  gpointer *out;
+  gsize start;
+  gsize n_frames;
+};
+
+/* a range of channels resampled by one thread. The channels are
+ * deinterleaved into planes so that each group has its own resampler
+ * and history */
+struct _AudioResampleGroup
+{
+  GstAudioConverter *convert;
+  GstAudioResampler *resampler; /* NULL when the group has no channels */
+  gint first;
+  gint n_channels;
+
+  gsize in_frames;
+  gsize out_frames;
+
+  gpointer *in;                 /* planes in the arena */
+  gpointer *out;
+};
+
 static AudioChain *
 audio_chain_new (AudioChain * prev, GstAudioConverter * convert)
 {
@@ -256,7 +311,6 @@ audio_chain_get_samples (AudioChain * chain, gsize * avail)
   return res;
 }
 
-/*
 static guint
 get_opt_uint (GstAudioConverter * convert, const gchar * opt, guint def)
 {
@@ -265,7 +319,6 @@ get_opt_uint (GstAudioConverter * convert, const gchar * opt, guint def)
     res = def;
   return res;
 }
-*/
 
 static gint
 get_opt_enum (GstAudioConverter * convert, const gchar * opt, GType type,
@@ -287,6 +340,7 @@ get_opt_value (GstAudioConverter * convert, const gchar * opt)
 #define DEFAULT_OPT_DITHER_METHOD GST_AUDIO_DITHER_NONE
 #define DEFAULT_OPT_NOISE_SHAPING_METHOD GST_AUDIO_NOISE_SHAPING_NONE
 #define DEFAULT_OPT_QUANTIZATION 1
+#define DEFAULT_OPT_THREADS 1
 
 #define GET_OPT_RESAMPLER_METHOD(c) get_opt_enum(c, \
     GST_AUDIO_CONVERTER_OPT_RESAMPLER_METHOD, GST_TYPE_AUDIO_RESAMPLER_METHOD, \
@@ -301,6 +355,8 @@ get_opt_value (GstAudioConverter * convert, const gchar * opt)
     GST_AUDIO_CONVERTER_OPT_QUANTIZATION, DEFAULT_OPT_QUANTIZATION)
 #define GET_OPT_MIX_MATRIX(c) get_opt_value(c, \
     GST_AUDIO_CONVERTER_OPT_MIX_MATRIX)
+#define GET_OPT_THREADS(c) get_opt_uint(c, \
+    GST_AUDIO_CONVERTER_OPT_THREADS, DEFAULT_OPT_THREADS)
 
 static gboolean
 copy_config (GQuark field_id, const GValue * value, gpointer user_data)
@@ -354,8 +410,17 @@ gst_audio_converter_update_config (GstAudioConverter * convert,
   convert->in.rate = in_rate;
   convert->out.rate = out_rate;
 
-  if (convert->resampler)
+  if (convert->groups) {
+    guint i;
+
+    for (i = 0; i < convert->runner->n_threads; i++) {
+      if (convert->groups[i].resampler)
+        gst_audio_resampler_update (convert->groups[i].resampler, in_rate,
+            out_rate, config);
+    }
+  } else if (convert->resampler) {
     gst_audio_resampler_update (convert->resampler, in_rate, out_rate, config);
+  }
 
   if (config) {
     gst_structure_foreach (config, copy_config, convert);
@@ -403,36 +468,279 @@ get_output_samples (AudioChain * chain, gsize num_samples, gpointer user_data)
 }
 
 #define MEM_ALIGN(m,a) ((gint8 *)((guintptr)((gint8 *)(m) + ((a)-1)) & ~((a)-1)))
-#define ALIGN 16
+/* cache line */
+#define ALIGN 64
+#define MIN_ARENA_FRAMES 256
+
+/* make sure each step can get @num_samples of temp samples without
+ * reallocating in the middle of the chain */
+static void
+audio_converter_ensure_arena (GstAudioConverter * convert, gsize num_samples)
+{
+  gsize frames, stride, slots_size, plane_stride = 0;
+  gint n_planes = 0;
+  gint8 *planes;
+  guint i;
+
+  if ((convert->arena_slots == 0 && convert->groups == NULL)
+      || num_samples <= convert->arena_frames)
+    return;
+
+  frames = MAX (convert->arena_frames, MIN_ARENA_FRAMES);
+  while (frames < num_samples)
+    frames <<= 1;
+
+  stride = GST_ROUND_UP_N (frames * convert->arena_stride, ALIGN);
+  slots_size = stride * convert->arena_blocks * convert->arena_slots;
+
+  /* an input and an output plane for each channel */
+  if (convert->groups) {
+    plane_stride = GST_ROUND_UP_N (frames * convert->resample_bps, ALIGN);
+    n_planes = 2 * convert->current_channels;
+  }
+
+  GST_DEBUG ("arena for %" G_GSIZE_FORMAT " frames, %d slots of %d blocks of %"
+      G_GSIZE_FORMAT " bytes, %d planes of %" G_GSIZE_FORMAT " bytes", frames,
+      convert->arena_slots, convert->arena_blocks, stride, n_planes,
+      plane_stride);
+
+  g_free (convert->arena);
+  convert->arena =
+      g_malloc (slots_size + plane_stride * n_planes + ALIGN - 1);
+  convert->arena_frames = frames;
+  convert->arena_block_stride = stride;
+
+  if (convert->groups == NULL)
+    return;
+
+  planes = MEM_ALIGN (convert->arena, ALIGN) + slots_size;
+  for (i = 0; i < convert->runner->n_threads; i++) {
+    AudioResampleGroup *group = &convert->groups[i];
+    gint c;
+
+    for (c = 0; c < group->n_channels; c++) {
+      group->in[c] = planes + (group->first + c) * plane_stride;
+      group->out[c] = planes +
+          (convert->current_channels + group->first + c) * plane_stride;
+    }
+  }
+}
 
 static gpointer *
 get_temp_samples (AudioChain * chain, gsize num_samples, gpointer user_data)
 {
-  if (num_samples > chain->allocated_samples) {
-    gint i;
-    gint8 *s;
-    gsize stride = GST_ROUND_UP_N (num_samples * chain->stride, ALIGN);
-    /* first part contains the pointers, second part the data, add some extra bytes
-     * for alignement */
-    gsize needed = (stride + sizeof (gpointer)) * chain->blocks + ALIGN - 1;
-
-    GST_DEBUG ("alloc samples %d %" G_GSIZE_FORMAT " %" G_GSIZE_FORMAT,
-        chain->stride, num_samples, needed);
-    chain->tmp = g_realloc (chain->tmp, needed);
-    chain->allocated_samples = num_samples;
-
-    /* pointer to the data, make sure it's 16 bytes aligned */
-    s = MEM_ALIGN (&chain->tmp[chain->blocks], ALIGN);
-
-    /* set up the pointers */
-    for (i = 0; i < chain->blocks; i++)
-      chain->tmp[i] = s + i * stride;
-  }
-  GST_LOG ("temp samples %p %" G_GSIZE_FORMAT, chain->tmp, num_samples);
+  GstAudioConverter *convert = user_data;
+  gsize stride = convert->arena_block_stride;
+  gint8 *s;
+  gint i;
+
+  g_assert (num_samples <= convert->arena_frames);
+
+  s = MEM_ALIGN (convert->arena, ALIGN) +
+      chain->slot * convert->arena_blocks * stride;
+  for (i = 0; i < chain->blocks; i++)
+    chain->tmp[i] = s + i * stride;
+
+  GST_LOG ("temp samples %p slot %d %" G_GSIZE_FORMAT, chain->tmp,
+      chain->slot, num_samples);
 
   return chain->tmp;
 }
 
+/* don't bother waking up the other threads for less than this */
+#define MIN_FRAMES_PER_THREAD 256
+
+/* Run @func on @n_frames of @in and @out. When there is a task runner and
+ * enough frames, the frames are split in ranges over all threads. */
+static void
+audio_chain_run_sliced (AudioChain * chain, GstAudioConverter * convert,
+    GstParallelizedTaskFunc func, gpointer * in, gpointer * out, gsize n_frames)
+{
+  guint i, n_threads;
+
+  if (convert->runner == NULL
+      || n_frames < convert->runner->n_threads * MIN_FRAMES_PER_THREAD) {
+    AudioChainSlice slice = { convert, chain, in, out, 0, n_frames };
+
+    func (&slice);
+    return;
+  }
+
+  n_threads = convert->runner->n_threads;
+  for (i = 0; i < n_threads; i++) {
+    AudioChainSlice *slice = &convert->slices[i];
+
+    slice->convert = convert;
+    slice->chain = chain;
+    slice->in = in;
+    slice->out = out;
+    slice->start = (n_frames * i) / n_threads;
+    slice->n_frames = (n_frames * (i + 1)) / n_threads - slice->start;
+  }
+  gst_parallelized_task_runner_run (convert->runner, func,
+      convert->slice_data);
+}
+
+static void
+do_unpack_slice (AudioChainSlice * slice)
+{
+  GstAudioConverter *convert = slice->convert;
+  AudioChain *chain = slice->chain;
+  gsize in_stride = (convert->in.finfo->width * chain->inc) / 8;
+  gint i;
+
+  for (i = 0; i < chain->blocks; i++) {
+    guint8 *out = (guint8 *) slice->out[i] + slice->start * chain->stride;
+
+    if (slice->in) {
+      guint8 *in = (guint8 *) slice->in[i] + slice->start * in_stride;
+
+      if (convert->in_default) {
+        memcpy (out, in, slice->n_frames * chain->stride);
+      } else {
+        convert->in.finfo->unpack_func (convert->in.finfo,
+            GST_AUDIO_PACK_FLAG_TRUNCATE_RANGE, out, in,
+            slice->n_frames * chain->inc);
+      }
+    } else {
+      gst_audio_format_fill_silence (chain->finfo, out,
+          slice->n_frames * chain->inc);
+    }
+  }
+}
+
+static void
+do_quantize_slice (AudioChainSlice * slice)
+{
+  AudioChain *chain = slice->chain;
+  gpointer *in, *out;
+  gint i;
+
+  in = g_newa (gpointer, chain->blocks);
+  out = g_newa (gpointer, chain->blocks);
+  for (i = 0; i < chain->blocks; i++) {
+    in[i] = (guint8 *) slice->in[i] + slice->start * chain->stride;
+    out[i] = (guint8 *) slice->out[i] + slice->start * chain->stride;
+  }
+  gst_audio_quantize_samples (slice->convert->quant, in, out,
+      slice->n_frames);
+}
+
+#define DEINTERLEAVE(type) G_STMT_START {                       \
+  const type *s = (const type *) src + first;                   \
+  for (c = 0; c < n_channels; c++) {                            \
+    type *d = dst[c];                                           \
+    for (i = 0; i < n_frames; i++)                              \
+      d[i] = s[i * channels + c];                               \
+  }                                                             \
+} G_STMT_END
+
+#define INTERLEAVE(type) G_STMT_START {                         \
+  type *d = (type *) dst + first;                               \
+  for (c = 0; c < n_channels; c++) {                            \
+    const type *s = src[c];                                     \
+    for (i = 0; i < n_frames; i++)                              \
+      d[i * channels + c] = s[i];                               \
+  }                                                             \
+} G_STMT_END
+
+static void
+deinterleave_channels (gpointer * dst, gconstpointer src, gint bps,
+    gint channels, gint first, gint n_channels, gsize n_frames)
+{
+  gsize i;
+  gint c;
+
+  switch (bps) {
+    case 2:
+      DEINTERLEAVE (guint16);
+      break;
+    case 4:
+      DEINTERLEAVE (guint32);
+      break;
+    case 8:
+      DEINTERLEAVE (guint64);
+      break;
+    default:
+      g_assert_not_reached ();
+  }
+}
+
+static void
+interleave_channels (gpointer dst, gpointer * src, gint bps,
+    gint channels, gint first, gint n_channels, gsize n_frames)
+{
+  gsize i;
+  gint c;
+
+  switch (bps) {
+    case 2:
+      INTERLEAVE (guint16);
+      break;
+    case 4:
+      INTERLEAVE (guint32);
+      break;
+    case 8:
+      INTERLEAVE (guint64);
+      break;
+    default:
+      g_assert_not_reached ();
+  }
+}
+
+#undef DEINTERLEAVE
+#undef INTERLEAVE
+
+static void
+do_resample_group (AudioResampleGroup * group)
+{
+  GstAudioConverter *convert = group->convert;
+  gint bps = convert->resample_bps;
+  gint channels = convert->current_channels;
+  gpointer *in = NULL;
+
+  if (group->resampler == NULL)
+    return;
+
+  g_assert (MAX (group->in_frames, group->out_frames) <= convert->arena_frames);
+
+  if (convert->resample_in) {
+    deinterleave_channels (group->in, convert->resample_in[0], bps, channels,
+        group->first, group->n_channels, group->in_frames);
+    in = group->in;
+  }
+
+  gst_audio_resampler_resample (group->resampler, in, group->in_frames,
+      group->out, group->out_frames);
+
+  interleave_channels (convert->resample_out[0], group->out, bps, channels,
+      group->first, group->n_channels, group->out_frames);
+}
+
+static void
+audio_converter_resample (GstAudioConverter * convert, gpointer in[],
+    gsize in_frames, gpointer out[], gsize out_frames)
+{
+  guint i;
+
+  if (convert->groups == NULL) {
+    gst_audio_resampler_resample (convert->resampler, in, in_frames, out,
+        out_frames);
+    return;
+  }
+
+  convert->resample_in = in;
+  convert->resample_out = out;
+  for (i = 0; i < convert->runner->n_threads; i++) {
+    convert->groups[i].in_frames = in_frames;
+    convert->groups[i].out_frames = out_frames;
+  }
+  gst_parallelized_task_runner_run (convert->runner,
+      (GstParallelizedTaskFunc) do_resample_group, convert->group_data);
+  convert->resample_in = NULL;
+  convert->resample_out = NULL;
+}
+
 static gboolean
 do_unpack (AudioChain * chain, gpointer user_data)
 {
@@ -445,8 +753,6 @@ do_unpack (AudioChain * chain, gpointer user_data)
   num_samples = convert->in_frames;
 
   if (!chain->allow_ip || !in_writable || !convert->in_default) {
-    gint i;
-
     if (in_writable && chain->allow_ip) {
       tmp = convert->in_data;
       GST_LOG ("unpack in-place %p, %" G_GSIZE_FORMAT, tmp, num_samples);
@@ -455,25 +761,19 @@ do_unpack (AudioChain * chain, gpointer user_data)
       GST_LOG ("unpack to tmp %p, %" G_GSIZE_FORMAT, tmp, num_samples);
     }
 
-    if (convert->in_data) {
-      for (i = 0; i < chain->blocks; i++) {
-        if (convert->in_default) {
-          GST_LOG ("copy %p, %p, %" G_GSIZE_FORMAT, tmp[i], convert->in_data[i],
-              num_samples);
-          memcpy (tmp[i], convert->in_data[i], num_samples * chain->stride);
-        } else {
-          GST_LOG ("unpack %p, %p, %" G_GSIZE_FORMAT, tmp[i],
-              convert->in_data[i], num_samples);
-          convert->in.finfo->unpack_func (convert->in.finfo,
-              GST_AUDIO_PACK_FLAG_TRUNCATE_RANGE, tmp[i], convert->in_data[i],
-              num_samples * chain->inc);
-        }
-      }
+    GST_LOG ("%s %p, %p, %" G_GSIZE_FORMAT, convert->in_data ?
+        (convert->in_default ? "copy" : "unpack") : "silence", tmp,
+        convert->in_data, num_samples);
+    if (tmp == convert->in_data) {
+      /* unpacking in place writes behind where the next range reads, keep it
+       * on one thread */
+      AudioChainSlice slice = { convert, chain, tmp, tmp, 0, num_samples };
+
+      do_unpack_slice (&slice);
     } else {
-      for (i = 0; i < chain->blocks; i++) {
-        gst_audio_format_fill_silence (chain->finfo, tmp[i],
-            num_samples * chain->inc);
-      }
+      audio_chain_run_sliced (chain, convert,
+          (GstParallelizedTaskFunc) do_unpack_slice, convert->in_data, tmp,
+          num_samples);
     }
   } else {
     tmp = convert->in_data;
@@ -536,8 +836,7 @@ do_resample (AudioChain * chain, gpointer user_data)
   GST_LOG ("resample %p %p,%" G_GSIZE_FORMAT " %" G_GSIZE_FORMAT, in,
       out, in_frames, out_frames);
 
-  gst_audio_resampler_resample (convert->resampler, in, in_frames, out,
-      out_frames);
+  audio_converter_resample (convert, in, in_frames, out, out_frames);
 
   audio_chain_set_samples (chain, out, out_frames);
 
@@ -575,7 +874,11 @@ do_quantize (AudioChain * chain, gpointer user_data)
   out = (chain->allow_ip ? in : audio_chain_alloc_samples (chain, num_samples));
   GST_LOG ("quantize %p, %p %" G_GSIZE_FORMAT, in, out, num_samples);
 
-  gst_audio_quantize_samples (convert->quant, in, out, num_samples);
+  if (convert->quant_sliced)
+    audio_chain_run_sliced (chain, convert,
+        (GstParallelizedTaskFunc) do_quantize_slice, in, out, num_samples);
+  else
+    gst_audio_quantize_samples (convert->quant, in, out, num_samples);
 
   audio_chain_set_samples (chain, out, num_samples);
 
@@ -786,9 +1089,45 @@ chain_resample (GstAudioConverter * convert, AudioChain * prev)
     if (variable_rate)
       flags |= GST_AUDIO_RESAMPLER_FLAG_VARIABLE_RATE;
 
-    convert->resampler =
-        gst_audio_resampler_new (method, flags, format, channels, in->rate,
-        out->rate, convert->config);
+    if (convert->runner && channels > 1
+        && convert->current_layout == GST_AUDIO_LAYOUT_INTERLEAVED) {
+      guint i, n_threads = convert->runner->n_threads;
+
+      GST_INFO ("resample %d channels in %u groups", channels, n_threads);
+
+      flags |= GST_AUDIO_RESAMPLER_FLAG_NON_INTERLEAVED_IN;
+      flags |= GST_AUDIO_RESAMPLER_FLAG_NON_INTERLEAVED_OUT;
+
+      convert->resample_bps = gst_audio_format_get_info (format)->width / 8;
+      convert->groups = g_new0 (AudioResampleGroup, n_threads);
+      convert->group_data = g_new (gpointer, n_threads);
+
+      for (i = 0; i < n_threads; i++) {
+        AudioResampleGroup *group = &convert->groups[i];
+
+        group->convert = convert;
+        group->first = (channels * i) / n_threads;
+        group->n_channels = (channels * (i + 1)) / n_threads - group->first;
+        convert->group_data[i] = group;
+
+        if (group->n_channels == 0)
+          continue;
+
+        group->in = g_new0 (gpointer, group->n_channels);
+        group->out = g_new0 (gpointer, group->n_channels);
+        group->resampler =
+            gst_audio_resampler_new (method, flags, format, group->n_channels,
+            in->rate, out->rate, convert->config);
+
+        /* the first resampler answers the frame and latency queries */
+        if (convert->resampler == NULL)
+          convert->resampler = group->resampler;
+      }
+    } else {
+      convert->resampler =
+          gst_audio_resampler_new (method, flags, format, channels, in->rate,
+          out->rate, convert->config);
+    }
 
     prev = audio_chain_new (prev, convert);
     prev->allow_ip = FALSE;
@@ -866,6 +1205,8 @@ chain_quantize (GstAudioConverter * convert, AudioChain * prev)
     convert->quant =
         gst_audio_quantize_new (dither, ns, 0, convert->current_format,
         out->channels, 1U << (32 - out_depth));
+    convert->quant_sliced = dither == GST_AUDIO_DITHER_NONE
+        && ns == GST_AUDIO_NOISE_SHAPING_NONE;
 
     prev = audio_chain_new (prev, convert);
     prev->allow_ip = TRUE;
@@ -896,6 +1237,7 @@ setup_allocators (GstAudioConverter * convert)
   AudioChain *chain;
   AudioChainAllocFunc alloc_func;
   gboolean allow_ip;
+  gint n_temp;
 
   /* start with using dest if we can directly write into it */
   if (convert->out_default) {
@@ -919,6 +1261,20 @@ setup_allocators (GstAudioConverter * convert)
       allow_ip = TRUE;
     }
   }
+
+  /* assign the arena slots, a step reads the samples of the previous step
+   * that wrote to the arena so they need to use a different slot */
+  n_temp = 0;
+  for (chain = convert->chain_end; chain; chain = chain->prev) {
+    if (chain->alloc_func != get_temp_samples)
+      continue;
+
+    chain->slot = n_temp++ % 2;
+    chain->tmp = g_new0 (gpointer, chain->blocks);
+    convert->arena_stride = MAX (convert->arena_stride, chain->stride);
+    convert->arena_blocks = MAX (convert->arena_blocks, chain->blocks);
+  }
+  convert->arena_slots = MIN (n_temp, 2);
 }
 
 static gboolean
@@ -1127,6 +1483,8 @@ converter_generic (GstAudioConverter * convert,
   convert->out_data = out;
   convert->out_frames = out_frames;
 
+  audio_converter_ensure_arena (convert, MAX (in_frames, out_frames));
+
   /* get frames to pack */
   tmp = audio_chain_get_samples (chain, &produced);
 
@@ -1145,8 +1503,8 @@ converter_resample (GstAudioConverter * convert,
     GstAudioConverterFlags flags, gpointer in[], gsize in_frames,
     gpointer out[], gsize out_frames)
 {
-  gst_audio_resampler_resample (convert->resampler, in, in_frames, out,
-      out_frames);
+  audio_converter_ensure_arena (convert, MAX (in_frames, out_frames));
+  audio_converter_resample (convert, in, in_frames, out, out_frames);
 
   return TRUE;
 }
@@ -1181,6 +1539,7 @@ gst_audio_converter_new (GstAudioConverterFlags flags, GstAudioInfo * in_info,
   GstAudioConverter *convert;
   AudioChain *prev;
   const GValue *opt_matrix = NULL;
+  guint n_threads;
 
   g_return_val_if_fail (in_info != NULL, FALSE);
   g_return_val_if_fail (out_info != NULL, FALSE);
@@ -1214,6 +1573,27 @@ gst_audio_converter_new (GstAudioConverterFlags flags, GstAudioInfo * in_info,
 
   GST_INFO ("unitsizes: %d -> %d", in_info->bpf, out_info->bpf);
 
+  n_threads = GET_OPT_THREADS (convert);
+  if (n_threads == 0 || n_threads > g_get_num_processors ())
+    n_threads = g_get_num_processors ();
+  if (n_threads > 1) {
+    convert->runner = gst_parallelized_task_runner_new (n_threads);
+    /* without a shared pool everything runs on the calling thread */
+    if (convert->runner->n_threads == 1) {
+      gst_parallelized_task_runner_free (convert->runner);
+      convert->runner = NULL;
+    } else {
+      guint i;
+
+      n_threads = convert->runner->n_threads;
+      GST_INFO ("using %u threads", n_threads);
+      convert->slices = g_new0 (AudioChainSlice, n_threads);
+      convert->slice_data = g_new (gpointer, n_threads);
+      for (i = 0; i < n_threads; i++)
+        convert->slice_data[i] = &convert->slices[i];
+    }
+  }
+
   /* step 1, unpack */
   prev = chain_unpack (convert);
   /* step 2, optional convert from S32 to F64 for channel mix */
@@ -1320,8 +1700,27 @@ gst_audio_converter_free (GstAudioConverter * convert)
     gst_audio_quantize_free (convert->quant);
   if (convert->mix)
     gst_audio_channel_mixer_free (convert->mix);
-  if (convert->resampler)
+  if (convert->groups) {
+    guint i;
+
+    for (i = 0; i < convert->runner->n_threads; i++) {
+      AudioResampleGroup *group = &convert->groups[i];
+
+      if (group->resampler)
+        gst_audio_resampler_free (group->resampler);
+      g_free (group->in);
+      g_free (group->out);
+    }
+    g_free (convert->groups);
+    g_free (convert->group_data);
+  } else if (convert->resampler) {
     gst_audio_resampler_free (convert->resampler);
+  }
+  if (convert->runner)
+    gst_parallelized_task_runner_free (convert->runner);
+  g_free (convert->slices);
+  g_free (convert->slice_data);
+  g_free (convert->arena);
   gst_audio_info_init (&convert->in);
   gst_audio_info_init (&convert->out);
 
@@ -1399,8 +1798,16 @@ gst_audio_converter_get_max_latency (GstAudioConverter * convert)
 void
 gst_audio_converter_reset (GstAudioConverter * convert)
 {
-  if (convert->resampler)
+  if (convert->groups) {
+    guint i;
+
+    for (i = 0; i < convert->runner->n_threads; i++) {
+      if (convert->groups[i].resampler)
+        gst_audio_resampler_reset (convert->groups[i].resampler);
+    }
+  } else if (convert->resampler) {
     gst_audio_resampler_reset (convert->resampler);
+  }
   if (convert->quant)
     gst_audio_quantize_reset (convert->quant);
 }
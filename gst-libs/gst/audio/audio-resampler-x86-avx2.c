@@ -0,0 +1,676 @@
+/* GStreamer
+ * Copyright (C) <2016> Wim Taymans <wim.taymans@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "audio-resampler-x86-avx2.h"
+
+#if defined (HAVE_IMMINTRIN_H) && defined(__AVX2__)
+#include <immintrin.h>
+
+/* The taps are only guaranteed to be 16 byte aligned so all loads are
+ * unaligned. The loops never read further past @len than the SSE versions
+ * do, the taps are padded with zeroes for that.
+ *
+ * The integer versions first fold the two 128 bit halves of their
+ * accumulators together, this makes every lane hold exactly the same sum as
+ * the corresponding lane in the SSE2/SSE4.1 versions so that rounding is
+ * identical. */
+
+static inline __m128
+hadd_ps_avx2 (__m256 sum)
+{
+  __m128 s;
+
+  s = _mm_add_ps (_mm256_castps256_ps128 (sum), _mm256_extractf128_ps (sum, 1));
+  s = _mm_add_ps (s, _mm_movehl_ps (s, s));
+  s = _mm_add_ss (s, _mm_shuffle_ps (s, s, 0x55));
+
+  return s;
+}
+
+static inline __m128d
+hadd_pd_avx2 (__m256d sum)
+{
+  __m128d s;
+
+  s = _mm_add_pd (_mm256_castpd256_pd128 (sum), _mm256_extractf128_pd (sum,
+          1));
+  s = _mm_add_sd (s, _mm_unpackhi_pd (s, s));
+
+  return s;
+}
+
+static inline __m128i
+fold_si256_avx2 (__m256i sum)
+{
+  return _mm_add_epi32 (_mm256_castsi256_si128 (sum),
+      _mm256_extracti128_si256 (sum, 1));
+}
+
+static inline __m128i
+fold_epi64_avx2 (__m256i sum)
+{
+  return _mm_add_epi64 (_mm256_castsi256_si128 (sum),
+      _mm256_extracti128_si256 (sum, 1));
+}
+
+static inline void
+inner_product_gint16_full_1_avx2 (gint16 * o, const gint16 * a,
+    const gint16 * b, gint len, const gint16 * icoeff, gint bstride)
+{
+  gint i;
+  __m256i sum;
+  __m128i s;
+
+  sum = _mm256_setzero_si256 ();
+
+  for (i = 0; i < len; i += 16) {
+    sum =
+        _mm256_add_epi32 (sum,
+        _mm256_madd_epi16 (_mm256_loadu_si256 ((__m256i *) (a + i)),
+            _mm256_loadu_si256 ((__m256i *) (b + i))));
+  }
+  s = fold_si256_avx2 (sum);
+  s = _mm_add_epi32 (s, _mm_shuffle_epi32 (s, _MM_SHUFFLE (2, 3, 2, 3)));
+  s = _mm_add_epi32 (s, _mm_shuffle_epi32 (s, _MM_SHUFFLE (1, 1, 1, 1)));
+
+  s = _mm_add_epi32 (s, _mm_set1_epi32 (1 << (PRECISION_S16 - 1)));
+  s = _mm_srai_epi32 (s, PRECISION_S16);
+  s = _mm_packs_epi32 (s, s);
+  *o = _mm_extract_epi16 (s, 0);
+}
+
+static inline void
+inner_product_gint16_linear_1_avx2 (gint16 * o, const gint16 * a,
+    const gint16 * b, gint len, const gint16 * icoeff, gint bstride)
+{
+  gint i;
+  __m256i sum[2], t;
+  __m128i s[2];
+  __m128i f = _mm_set_epi64x (0, *((gint64 *) icoeff));
+  const gint16 *c[2] = { (gint16 *) ((gint8 *) b + 0 * bstride),
+    (gint16 *) ((gint8 *) b + 1 * bstride)
+  };
+
+  sum[0] = sum[1] = _mm256_setzero_si256 ();
+  f = _mm_unpacklo_epi16 (f, _mm_setzero_si128 ());
+
+  for (i = 0; i < len; i += 16) {
+    t = _mm256_loadu_si256 ((__m256i *) (a + i));
+    sum[0] =
+        _mm256_add_epi32 (sum[0], _mm256_madd_epi16 (t,
+            _mm256_loadu_si256 ((__m256i *) (c[0] + i))));
+    sum[1] =
+        _mm256_add_epi32 (sum[1], _mm256_madd_epi16 (t,
+            _mm256_loadu_si256 ((__m256i *) (c[1] + i))));
+  }
+  s[0] = _mm_srai_epi32 (fold_si256_avx2 (sum[0]), PRECISION_S16);
+  s[1] = _mm_srai_epi32 (fold_si256_avx2 (sum[1]), PRECISION_S16);
+
+  s[0] = _mm_madd_epi16 (s[0], _mm_shuffle_epi32 (f, _MM_SHUFFLE (0, 0, 0, 0)));
+  s[1] = _mm_madd_epi16 (s[1], _mm_shuffle_epi32 (f, _MM_SHUFFLE (1, 1, 1, 1)));
+  s[0] = _mm_add_epi32 (s[0], s[1]);
+
+  s[0] = _mm_add_epi32 (s[0], _mm_shuffle_epi32 (s[0], _MM_SHUFFLE (2, 3, 2,
+              3)));
+  s[0] = _mm_add_epi32 (s[0], _mm_shuffle_epi32 (s[0], _MM_SHUFFLE (1, 1, 1,
+              1)));
+
+  s[0] = _mm_add_epi32 (s[0], _mm_set1_epi32 (1 << (PRECISION_S16 - 1)));
+  s[0] = _mm_srai_epi32 (s[0], PRECISION_S16);
+  s[0] = _mm_packs_epi32 (s[0], s[0]);
+  *o = _mm_extract_epi16 (s[0], 0);
+}
+
+static inline void
+inner_product_gint16_cubic_1_avx2 (gint16 * o, const gint16 * a,
+    const gint16 * b, gint len, const gint16 * icoeff, gint bstride)
+{
+  gint i;
+  __m256i sum[4], t;
+  __m128i s[4], u[4];
+  __m128i f = _mm_set_epi64x (0, *((gint64 *) icoeff));
+  const gint16 *c[4] = { (gint16 *) ((gint8 *) b + 0 * bstride),
+    (gint16 *) ((gint8 *) b + 1 * bstride),
+    (gint16 *) ((gint8 *) b + 2 * bstride),
+    (gint16 *) ((gint8 *) b + 3 * bstride)
+  };
+
+  sum[0] = sum[1] = sum[2] = sum[3] = _mm256_setzero_si256 ();
+  f = _mm_unpacklo_epi16 (f, _mm_setzero_si128 ());
+
+  for (i = 0; i < len; i += 16) {
+    t = _mm256_loadu_si256 ((__m256i *) (a + i));
+    sum[0] =
+        _mm256_add_epi32 (sum[0], _mm256_madd_epi16 (t,
+            _mm256_loadu_si256 ((__m256i *) (c[0] + i))));
+    sum[1] =
+        _mm256_add_epi32 (sum[1], _mm256_madd_epi16 (t,
+            _mm256_loadu_si256 ((__m256i *) (c[1] + i))));
+    sum[2] =
+        _mm256_add_epi32 (sum[2], _mm256_madd_epi16 (t,
+            _mm256_loadu_si256 ((__m256i *) (c[2] + i))));
+    sum[3] =
+        _mm256_add_epi32 (sum[3], _mm256_madd_epi16 (t,
+            _mm256_loadu_si256 ((__m256i *) (c[3] + i))));
+  }
+  s[0] = fold_si256_avx2 (sum[0]);
+  s[1] = fold_si256_avx2 (sum[1]);
+  s[2] = fold_si256_avx2 (sum[2]);
+  s[3] = fold_si256_avx2 (sum[3]);
+
+  u[0] = _mm_unpacklo_epi32 (s[0], s[1]);
+  u[1] = _mm_unpacklo_epi32 (s[2], s[3]);
+  u[2] = _mm_unpackhi_epi32 (s[0], s[1]);
+  u[3] = _mm_unpackhi_epi32 (s[2], s[3]);
+
+  s[0] =
+      _mm_add_epi32 (_mm_unpacklo_epi64 (u[0], u[1]), _mm_unpackhi_epi64 (u[0],
+          u[1]));
+  s[2] =
+      _mm_add_epi32 (_mm_unpacklo_epi64 (u[2], u[3]), _mm_unpackhi_epi64 (u[2],
+          u[3]));
+  s[0] = _mm_add_epi32 (s[0], s[2]);
+
+  s[0] = _mm_srai_epi32 (s[0], PRECISION_S16);
+  s[0] = _mm_madd_epi16 (s[0], f);
+
+  s[0] = _mm_add_epi32 (s[0], _mm_shuffle_epi32 (s[0], _MM_SHUFFLE (2, 3, 2,
+              3)));
+  s[0] = _mm_add_epi32 (s[0], _mm_shuffle_epi32 (s[0], _MM_SHUFFLE (1, 1, 1,
+              1)));
+
+  s[0] = _mm_add_epi32 (s[0], _mm_set1_epi32 (1 << (PRECISION_S16 - 1)));
+  s[0] = _mm_srai_epi32 (s[0], PRECISION_S16);
+  s[0] = _mm_packs_epi32 (s[0], s[0]);
+  *o = _mm_extract_epi16 (s[0], 0);
+}
+
+#if defined (__x86_64__)
+static inline __m256i
+mul_add_epi32_avx2 (__m256i sum, __m256i ta, __m256i tb)
+{
+  sum = _mm256_add_epi64 (sum,
+      _mm256_mul_epi32 (_mm256_unpacklo_epi32 (ta, ta),
+          _mm256_unpacklo_epi32 (tb, tb)));
+  sum = _mm256_add_epi64 (sum,
+      _mm256_mul_epi32 (_mm256_unpackhi_epi32 (ta, ta),
+          _mm256_unpackhi_epi32 (tb, tb)));
+  return sum;
+}
+
+static inline void
+inner_product_gint32_full_1_avx2 (gint32 * o, const gint32 * a,
+    const gint32 * b, gint len, const gint32 * icoeff, gint bstride)
+{
+  gint i;
+  __m256i sum;
+  __m128i s;
+  gint64 res;
+
+  sum = _mm256_setzero_si256 ();
+
+  for (i = 0; i < len; i += 8) {
+    sum = mul_add_epi32_avx2 (sum, _mm256_loadu_si256 ((__m256i *) (a + i)),
+        _mm256_loadu_si256 ((__m256i *) (b + i)));
+  }
+  s = fold_epi64_avx2 (sum);
+  s = _mm_add_epi64 (s, _mm_unpackhi_epi64 (s, s));
+  res = _mm_cvtsi128_si64 (s);
+
+  res = (res + (1 << (PRECISION_S32 - 1))) >> PRECISION_S32;
+  *o = CLAMP (res, G_MININT32, G_MAXINT32);
+}
+
+static inline void
+inner_product_gint32_linear_1_avx2 (gint32 * o, const gint32 * a,
+    const gint32 * b, gint len, const gint32 * icoeff, gint bstride)
+{
+  gint i;
+  gint64 res;
+  __m256i sum[2], ta;
+  __m128i s[2];
+  __m128i f = _mm_loadu_si128 ((__m128i *) icoeff);
+  const gint32 *c[2] = { (gint32 *) ((gint8 *) b + 0 * bstride),
+    (gint32 *) ((gint8 *) b + 1 * bstride)
+  };
+
+  sum[0] = sum[1] = _mm256_setzero_si256 ();
+
+  for (i = 0; i < len; i += 8) {
+    ta = _mm256_loadu_si256 ((__m256i *) (a + i));
+    sum[0] = mul_add_epi32_avx2 (sum[0], ta,
+        _mm256_loadu_si256 ((__m256i *) (c[0] + i)));
+    sum[1] = mul_add_epi32_avx2 (sum[1], ta,
+        _mm256_loadu_si256 ((__m256i *) (c[1] + i)));
+  }
+  s[0] = _mm_srli_epi64 (fold_epi64_avx2 (sum[0]), PRECISION_S32);
+  s[1] = _mm_srli_epi64 (fold_epi64_avx2 (sum[1]), PRECISION_S32);
+  s[0] = _mm_mul_epi32 (s[0], _mm_shuffle_epi32 (f, _MM_SHUFFLE (0, 0, 0, 0)));
+  s[1] = _mm_mul_epi32 (s[1], _mm_shuffle_epi32 (f, _MM_SHUFFLE (1, 1, 1, 1)));
+  s[0] = _mm_add_epi64 (s[0], s[1]);
+  s[0] = _mm_add_epi64 (s[0], _mm_unpackhi_epi64 (s[0], s[0]));
+  res = _mm_cvtsi128_si64 (s[0]);
+
+  res = (res + (1 << (PRECISION_S32 - 1))) >> PRECISION_S32;
+  *o = CLAMP (res, G_MININT32, G_MAXINT32);
+}
+
+static inline void
+inner_product_gint32_cubic_1_avx2 (gint32 * o, const gint32 * a,
+    const gint32 * b, gint len, const gint32 * icoeff, gint bstride)
+{
+  gint i;
+  gint64 res;
+  __m256i sum[4], ta;
+  __m128i s[4];
+  __m128i f = _mm_loadu_si128 ((__m128i *) icoeff);
+  const gint32 *c[4] = { (gint32 *) ((gint8 *) b + 0 * bstride),
+    (gint32 *) ((gint8 *) b + 1 * bstride),
+    (gint32 *) ((gint8 *) b + 2 * bstride),
+    (gint32 *) ((gint8 *) b + 3 * bstride)
+  };
+
+  sum[0] = sum[1] = sum[2] = sum[3] = _mm256_setzero_si256 ();
+
+  for (i = 0; i < len; i += 8) {
+    ta = _mm256_loadu_si256 ((__m256i *) (a + i));
+    sum[0] = mul_add_epi32_avx2 (sum[0], ta,
+        _mm256_loadu_si256 ((__m256i *) (c[0] + i)));
+    sum[1] = mul_add_epi32_avx2 (sum[1], ta,
+        _mm256_loadu_si256 ((__m256i *) (c[1] + i)));
+    sum[2] = mul_add_epi32_avx2 (sum[2], ta,
+        _mm256_loadu_si256 ((__m256i *) (c[2] + i)));
+    sum[3] = mul_add_epi32_avx2 (sum[3], ta,
+        _mm256_loadu_si256 ((__m256i *) (c[3] + i)));
+  }
+  s[0] = _mm_srli_epi64 (fold_epi64_avx2 (sum[0]), PRECISION_S32);
+  s[1] = _mm_srli_epi64 (fold_epi64_avx2 (sum[1]), PRECISION_S32);
+  s[2] = _mm_srli_epi64 (fold_epi64_avx2 (sum[2]), PRECISION_S32);
+  s[3] = _mm_srli_epi64 (fold_epi64_avx2 (sum[3]), PRECISION_S32);
+  s[0] = _mm_mul_epi32 (s[0], _mm_shuffle_epi32 (f, _MM_SHUFFLE (0, 0, 0, 0)));
+  s[1] = _mm_mul_epi32 (s[1], _mm_shuffle_epi32 (f, _MM_SHUFFLE (1, 1, 1, 1)));
+  s[2] = _mm_mul_epi32 (s[2], _mm_shuffle_epi32 (f, _MM_SHUFFLE (2, 2, 2, 2)));
+  s[3] = _mm_mul_epi32 (s[3], _mm_shuffle_epi32 (f, _MM_SHUFFLE (3, 3, 3, 3)));
+  s[0] = _mm_add_epi64 (s[0], s[1]);
+  s[2] = _mm_add_epi64 (s[2], s[3]);
+  s[0] = _mm_add_epi64 (s[0], s[2]);
+  s[0] = _mm_add_epi64 (s[0], _mm_unpackhi_epi64 (s[0], s[0]));
+  res = _mm_cvtsi128_si64 (s[0]);
+
+  res = (res + (1 << (PRECISION_S32 - 1))) >> PRECISION_S32;
+  *o = CLAMP (res, G_MININT32, G_MAXINT32);
+}
+#endif
+
+static inline void
+inner_product_gfloat_full_1_avx2 (gfloat * o, const gfloat * a,
+    const gfloat * b, gint len, const gfloat * icoeff, gint bstride)
+{
+  gint i;
+  __m256 sum = _mm256_setzero_ps ();
+
+  for (i = 0; i < len; i += 8) {
+    sum =
+        _mm256_add_ps (sum, _mm256_mul_ps (_mm256_loadu_ps (a + i),
+            _mm256_loadu_ps (b + i)));
+  }
+  _mm_store_ss (o, hadd_ps_avx2 (sum));
+}
+
+static inline void
+inner_product_gfloat_linear_1_avx2 (gfloat * o, const gfloat * a,
+    const gfloat * b, gint len, const gfloat * icoeff, gint bstride)
+{
+  gint i;
+  __m256 sum[2], t;
+  const gfloat *c[2] = { (gfloat *) ((gint8 *) b + 0 * bstride),
+    (gfloat *) ((gint8 *) b + 1 * bstride)
+  };
+
+  sum[0] = sum[1] = _mm256_setzero_ps ();
+
+  for (i = 0; i < len; i += 8) {
+    t = _mm256_loadu_ps (a + i);
+    sum[0] = _mm256_add_ps (sum[0], _mm256_mul_ps (t, _mm256_loadu_ps (c[0] +
+                i)));
+    sum[1] = _mm256_add_ps (sum[1], _mm256_mul_ps (t, _mm256_loadu_ps (c[1] +
+                i)));
+  }
+  sum[0] =
+      _mm256_mul_ps (_mm256_sub_ps (sum[0], sum[1]),
+      _mm256_broadcast_ss (icoeff));
+  sum[0] = _mm256_add_ps (sum[0], sum[1]);
+  _mm_store_ss (o, hadd_ps_avx2 (sum[0]));
+}
+
+static inline void
+inner_product_gfloat_cubic_1_avx2 (gfloat * o, const gfloat * a,
+    const gfloat * b, gint len, const gfloat * icoeff, gint bstride)
+{
+  gint i;
+  __m256 sum[4], t;
+  const gfloat *c[4] = { (gfloat *) ((gint8 *) b + 0 * bstride),
+    (gfloat *) ((gint8 *) b + 1 * bstride),
+    (gfloat *) ((gint8 *) b + 2 * bstride),
+    (gfloat *) ((gint8 *) b + 3 * bstride)
+  };
+
+  sum[0] = sum[1] = sum[2] = sum[3] = _mm256_setzero_ps ();
+
+  for (i = 0; i < len; i += 8) {
+    t = _mm256_loadu_ps (a + i);
+    sum[0] = _mm256_add_ps (sum[0], _mm256_mul_ps (t, _mm256_loadu_ps (c[0] +
+                i)));
+    sum[1] = _mm256_add_ps (sum[1], _mm256_mul_ps (t, _mm256_loadu_ps (c[1] +
+                i)));
+    sum[2] = _mm256_add_ps (sum[2], _mm256_mul_ps (t, _mm256_loadu_ps (c[2] +
+                i)));
+    sum[3] = _mm256_add_ps (sum[3], _mm256_mul_ps (t, _mm256_loadu_ps (c[3] +
+                i)));
+  }
+  sum[0] = _mm256_mul_ps (sum[0], _mm256_broadcast_ss (icoeff + 0));
+  sum[1] = _mm256_mul_ps (sum[1], _mm256_broadcast_ss (icoeff + 1));
+  sum[2] = _mm256_mul_ps (sum[2], _mm256_broadcast_ss (icoeff + 2));
+  sum[3] = _mm256_mul_ps (sum[3], _mm256_broadcast_ss (icoeff + 3));
+  sum[0] = _mm256_add_ps (sum[0], sum[1]);
+  sum[2] = _mm256_add_ps (sum[2], sum[3]);
+  sum[0] = _mm256_add_ps (sum[0], sum[2]);
+  _mm_store_ss (o, hadd_ps_avx2 (sum[0]));
+}
+
+static inline void
+inner_product_gdouble_full_1_avx2 (gdouble * o, const gdouble * a,
+    const gdouble * b, gint len, const gdouble * icoeff, gint bstride)
+{
+  gint i;
+  __m256d sum[2];
+
+  sum[0] = sum[1] = _mm256_setzero_pd ();
+
+  for (i = 0; i < len; i += 8) {
+    sum[0] =
+        _mm256_add_pd (sum[0], _mm256_mul_pd (_mm256_loadu_pd (a + i + 0),
+            _mm256_loadu_pd (b + i + 0)));
+    sum[1] =
+        _mm256_add_pd (sum[1], _mm256_mul_pd (_mm256_loadu_pd (a + i + 4),
+            _mm256_loadu_pd (b + i + 4)));
+  }
+  _mm_store_sd (o, hadd_pd_avx2 (_mm256_add_pd (sum[0], sum[1])));
+}
+
+static inline void
+inner_product_gdouble_linear_1_avx2 (gdouble * o, const gdouble * a,
+    const gdouble * b, gint len, const gdouble * icoeff, gint bstride)
+{
+  gint i;
+  __m256d sum[2], t;
+  const gdouble *c[2] = { (gdouble *) ((gint8 *) b + 0 * bstride),
+    (gdouble *) ((gint8 *) b + 1 * bstride)
+  };
+
+  sum[0] = sum[1] = _mm256_setzero_pd ();
+
+  for (i = 0; i < len; i += 4) {
+    t = _mm256_loadu_pd (a + i);
+    sum[0] = _mm256_add_pd (sum[0], _mm256_mul_pd (t, _mm256_loadu_pd (c[0] +
+                i)));
+    sum[1] = _mm256_add_pd (sum[1], _mm256_mul_pd (t, _mm256_loadu_pd (c[1] +
+                i)));
+  }
+  sum[0] =
+      _mm256_mul_pd (_mm256_sub_pd (sum[0], sum[1]),
+      _mm256_broadcast_sd (icoeff));
+  sum[0] = _mm256_add_pd (sum[0], sum[1]);
+  _mm_store_sd (o, hadd_pd_avx2 (sum[0]));
+}
+
+static inline void
+inner_product_gdouble_cubic_1_avx2 (gdouble * o, const gdouble * a,
+    const gdouble * b, gint len, const gdouble * icoeff, gint bstride)
+{
+  gint i;
+  __m256d sum[4], t;
+  const gdouble *c[4] = { (gdouble *) ((gint8 *) b + 0 * bstride),
+    (gdouble *) ((gint8 *) b + 1 * bstride),
+    (gdouble *) ((gint8 *) b + 2 * bstride),
+    (gdouble *) ((gint8 *) b + 3 * bstride)
+  };
+
+  sum[0] = sum[1] = sum[2] = sum[3] = _mm256_setzero_pd ();
+
+  for (i = 0; i < len; i += 4) {
+    t = _mm256_loadu_pd (a + i);
+    sum[0] = _mm256_add_pd (sum[0], _mm256_mul_pd (t, _mm256_loadu_pd (c[0] +
+                i)));
+    sum[1] = _mm256_add_pd (sum[1], _mm256_mul_pd (t, _mm256_loadu_pd (c[1] +
+                i)));
+    sum[2] = _mm256_add_pd (sum[2], _mm256_mul_pd (t, _mm256_loadu_pd (c[2] +
+                i)));
+    sum[3] = _mm256_add_pd (sum[3], _mm256_mul_pd (t, _mm256_loadu_pd (c[3] +
+                i)));
+  }
+  sum[0] = _mm256_mul_pd (sum[0], _mm256_broadcast_sd (icoeff + 0));
+  sum[1] = _mm256_mul_pd (sum[1], _mm256_broadcast_sd (icoeff + 1));
+  sum[2] = _mm256_mul_pd (sum[2], _mm256_broadcast_sd (icoeff + 2));
+  sum[3] = _mm256_mul_pd (sum[3], _mm256_broadcast_sd (icoeff + 3));
+  sum[0] = _mm256_add_pd (sum[0], sum[1]);
+  sum[2] = _mm256_add_pd (sum[2], sum[3]);
+  sum[0] = _mm256_add_pd (sum[0], sum[2]);
+  _mm_store_sd (o, hadd_pd_avx2 (sum[0]));
+}
+
+MAKE_RESAMPLE_FUNC (gint16, full, 1, avx2);
+MAKE_RESAMPLE_FUNC (gint16, linear, 1, avx2);
+MAKE_RESAMPLE_FUNC (gint16, cubic, 1, avx2);
+
+#if defined (__x86_64__)
+MAKE_RESAMPLE_FUNC (gint32, full, 1, avx2);
+MAKE_RESAMPLE_FUNC (gint32, linear, 1, avx2);
+MAKE_RESAMPLE_FUNC (gint32, cubic, 1, avx2);
+#endif
+
+MAKE_RESAMPLE_FUNC (gfloat, full, 1, avx2);
+MAKE_RESAMPLE_FUNC (gfloat, linear, 1, avx2);
+MAKE_RESAMPLE_FUNC (gfloat, cubic, 1, avx2);
+
+MAKE_RESAMPLE_FUNC (gdouble, full, 1, avx2);
+MAKE_RESAMPLE_FUNC (gdouble, linear, 1, avx2);
+MAKE_RESAMPLE_FUNC (gdouble, cubic, 1, avx2);
+
+void
+interpolate_gint16_linear_avx2 (gpointer op, const gpointer ap,
+    gint len, const gpointer icp, gint astride)
+{
+  gint i;
+  gint16 *o = op, *a = ap, *ic = icp;
+  __m256i ta, tb, t1, t2;
+  __m256i f = _mm256_set1_epi32 (*((gint32 *) ic));
+  const gint16 *c[2] = { (gint16 *) ((gint8 *) a + 0 * astride),
+    (gint16 *) ((gint8 *) a + 1 * astride)
+  };
+
+  /* unpack and pack both work per 128 bit lane so the samples end up in
+   * the right order again */
+  for (i = 0; i < len; i += 16) {
+    ta = _mm256_loadu_si256 ((__m256i *) (c[0] + i));
+    tb = _mm256_loadu_si256 ((__m256i *) (c[1] + i));
+
+    t1 = _mm256_madd_epi16 (_mm256_unpacklo_epi16 (ta, tb), f);
+    t2 = _mm256_madd_epi16 (_mm256_unpackhi_epi16 (ta, tb), f);
+
+    t1 = _mm256_add_epi32 (t1, _mm256_set1_epi32 (1 << (PRECISION_S16 - 1)));
+    t2 = _mm256_add_epi32 (t2, _mm256_set1_epi32 (1 << (PRECISION_S16 - 1)));
+
+    t1 = _mm256_srai_epi32 (t1, PRECISION_S16);
+    t2 = _mm256_srai_epi32 (t2, PRECISION_S16);
+
+    t1 = _mm256_packs_epi32 (t1, t2);
+    _mm256_storeu_si256 ((__m256i *) (o + i), t1);
+  }
+}
+
+void
+interpolate_gint16_cubic_avx2 (gpointer op, const gpointer ap,
+    gint len, const gpointer icp, gint astride)
+{
+  gint i;
+  gint16 *o = op, *a = ap, *ic = icp;
+  __m256i ta, tb, tl1, tl2, th1, th2;
+  __m256i f[2];
+  const gint16 *c[4] = { (gint16 *) ((gint8 *) a + 0 * astride),
+    (gint16 *) ((gint8 *) a + 1 * astride),
+    (gint16 *) ((gint8 *) a + 2 * astride),
+    (gint16 *) ((gint8 *) a + 3 * astride)
+  };
+
+  f[0] = _mm256_set1_epi32 (*((gint32 *) (ic + 0)));
+  f[1] = _mm256_set1_epi32 (*((gint32 *) (ic + 2)));
+
+  for (i = 0; i < len; i += 16) {
+    ta = _mm256_loadu_si256 ((__m256i *) (c[0] + i));
+    tb = _mm256_loadu_si256 ((__m256i *) (c[1] + i));
+
+    tl1 = _mm256_madd_epi16 (_mm256_unpacklo_epi16 (ta, tb), f[0]);
+    th1 = _mm256_madd_epi16 (_mm256_unpackhi_epi16 (ta, tb), f[0]);
+
+    ta = _mm256_loadu_si256 ((__m256i *) (c[2] + i));
+    tb = _mm256_loadu_si256 ((__m256i *) (c[3] + i));
+
+    tl2 = _mm256_madd_epi16 (_mm256_unpacklo_epi16 (ta, tb), f[1]);
+    th2 = _mm256_madd_epi16 (_mm256_unpackhi_epi16 (ta, tb), f[1]);
+
+    tl1 = _mm256_add_epi32 (tl1, tl2);
+    th1 = _mm256_add_epi32 (th1, th2);
+
+    tl1 = _mm256_add_epi32 (tl1, _mm256_set1_epi32 (1 << (PRECISION_S16 - 1)));
+    th1 = _mm256_add_epi32 (th1, _mm256_set1_epi32 (1 << (PRECISION_S16 - 1)));
+
+    tl1 = _mm256_srai_epi32 (tl1, PRECISION_S16);
+    th1 = _mm256_srai_epi32 (th1, PRECISION_S16);
+
+    tl1 = _mm256_packs_epi32 (tl1, th1);
+    _mm256_storeu_si256 ((__m256i *) (o + i), tl1);
+  }
+}
+
+void
+interpolate_gfloat_linear_avx2 (gpointer op, const gpointer ap,
+    gint len, const gpointer icp, gint astride)
+{
+  gint i;
+  gfloat *o = op, *a = ap, *ic = icp;
+  __m256 f[2], t1, t2;
+  const gfloat *c[2] = { (gfloat *) ((gint8 *) a + 0 * astride),
+    (gfloat *) ((gint8 *) a + 1 * astride)
+  };
+
+  f[0] = _mm256_broadcast_ss (ic + 0);
+  f[1] = _mm256_broadcast_ss (ic + 1);
+
+  for (i = 0; i < len; i += 8) {
+    t1 = _mm256_mul_ps (_mm256_loadu_ps (c[0] + i), f[0]);
+    t2 = _mm256_mul_ps (_mm256_loadu_ps (c[1] + i), f[1]);
+    _mm256_storeu_ps (o + i, _mm256_add_ps (t1, t2));
+  }
+}
+
+void
+interpolate_gfloat_cubic_avx2 (gpointer op, const gpointer ap,
+    gint len, const gpointer icp, gint astride)
+{
+  gint i;
+  gfloat *o = op, *a = ap, *ic = icp;
+  __m256 f[4], t[4];
+  const gfloat *c[4] = { (gfloat *) ((gint8 *) a + 0 * astride),
+    (gfloat *) ((gint8 *) a + 1 * astride),
+    (gfloat *) ((gint8 *) a + 2 * astride),
+    (gfloat *) ((gint8 *) a + 3 * astride)
+  };
+
+  f[0] = _mm256_broadcast_ss (ic + 0);
+  f[1] = _mm256_broadcast_ss (ic + 1);
+  f[2] = _mm256_broadcast_ss (ic + 2);
+  f[3] = _mm256_broadcast_ss (ic + 3);
+
+  for (i = 0; i < len; i += 8) {
+    t[0] = _mm256_mul_ps (_mm256_loadu_ps (c[0] + i), f[0]);
+    t[1] = _mm256_mul_ps (_mm256_loadu_ps (c[1] + i), f[1]);
+    t[2] = _mm256_mul_ps (_mm256_loadu_ps (c[2] + i), f[2]);
+    t[3] = _mm256_mul_ps (_mm256_loadu_ps (c[3] + i), f[3]);
+    t[0] = _mm256_add_ps (t[0], t[1]);
+    t[2] = _mm256_add_ps (t[2], t[3]);
+    _mm256_storeu_ps (o + i, _mm256_add_ps (t[0], t[2]));
+  }
+}
+
+void
+interpolate_gdouble_linear_avx2 (gpointer op, const gpointer ap,
+    gint len, const gpointer icp, gint astride)
+{
+  gint i;
+  gdouble *o = op, *a = ap, *ic = icp;
+  __m256d f[2], t1, t2;
+  const gdouble *c[2] = { (gdouble *) ((gint8 *) a + 0 * astride),
+    (gdouble *) ((gint8 *) a + 1 * astride)
+  };
+
+  f[0] = _mm256_broadcast_sd (ic + 0);
+  f[1] = _mm256_broadcast_sd (ic + 1);
+
+  for (i = 0; i < len; i += 4) {
+    t1 = _mm256_mul_pd (_mm256_loadu_pd (c[0] + i), f[0]);
+    t2 = _mm256_mul_pd (_mm256_loadu_pd (c[1] + i), f[1]);
+    _mm256_storeu_pd (o + i, _mm256_add_pd (t1, t2));
+  }
+}
+
+void
+interpolate_gdouble_cubic_avx2 (gpointer op, const gpointer ap,
+    gint len, const gpointer icp, gint astride)
+{
+  gint i;
+  gdouble *o = op, *a = ap, *ic = icp;
+  __m256d f[4], t[4];
+  const gdouble *c[4] = { (gdouble *) ((gint8 *) a + 0 * astride),
+    (gdouble *) ((gint8 *) a + 1 * astride),
+    (gdouble *) ((gint8 *) a + 2 * astride),
+    (gdouble *) ((gint8 *) a + 3 * astride)
+  };
+
+  f[0] = _mm256_broadcast_sd (ic + 0);
+  f[1] = _mm256_broadcast_sd (ic + 1);
+  f[2] = _mm256_broadcast_sd (ic + 2);
+  f[3] = _mm256_broadcast_sd (ic + 3);
+
+  for (i = 0; i < len; i += 4) {
+    t[0] = _mm256_mul_pd (_mm256_loadu_pd (c[0] + i), f[0]);
+    t[1] = _mm256_mul_pd (_mm256_loadu_pd (c[1] + i), f[1]);
+    t[2] = _mm256_mul_pd (_mm256_loadu_pd (c[2] + i), f[2]);
+    t[3] = _mm256_mul_pd (_mm256_loadu_pd (c[3] + i), f[3]);
+    t[0] = _mm256_add_pd (t[0], t[1]);
+    t[2] = _mm256_add_pd (t[2], t[3]);
+    _mm256_storeu_pd (o + i, _mm256_add_pd (t[0], t[2]));
+  }
+}
+
+#endif
@@ -0,0 +1,736 @@
+/* GStreamer
+ * Copyright (C) <2016> Wim Taymans <wim.taymans@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "audio-resampler-x86-avx512.h"
+
+#if defined (HAVE_IMMINTRIN_H) && defined(__AVX512F__) && defined(__AVX512BW__)
+#include <immintrin.h>
+
+/* The main loops handle 512 bits at a time as long as there is that much
+ * left and finish with 256 bit steps so that we never read or write
+ * further past @len than the SSE and AVX2 versions do. The integer
+ * accumulators are folded down to 128 bits before the final reduction,
+ * which gives results identical to the SSE2/SSE4.1 versions. */
+
+static inline __m256i
+fold_si512_avx512 (__m512i sum)
+{
+  return _mm256_add_epi32 (_mm512_castsi512_si256 (sum),
+      _mm512_extracti64x4_epi64 (sum, 1));
+}
+
+static inline __m256i
+fold_epi64_avx512 (__m512i sum)
+{
+  return _mm256_add_epi64 (_mm512_castsi512_si256 (sum),
+      _mm512_extracti64x4_epi64 (sum, 1));
+}
+
+static inline __m256
+fold_ps_avx512 (__m512 sum)
+{
+  return _mm256_add_ps (_mm512_castps512_ps256 (sum),
+      _mm256_castpd_ps (_mm512_extractf64x4_pd (_mm512_castps_pd (sum), 1)));
+}
+
+static inline __m256d
+fold_pd_avx512 (__m512d sum)
+{
+  return _mm256_add_pd (_mm512_castpd512_pd256 (sum),
+      _mm512_extractf64x4_pd (sum, 1));
+}
+
+static inline __m128
+hadd_ps_avx512 (__m256 sum)
+{
+  __m128 s;
+
+  s = _mm_add_ps (_mm256_castps256_ps128 (sum), _mm256_extractf128_ps (sum, 1));
+  s = _mm_add_ps (s, _mm_movehl_ps (s, s));
+  s = _mm_add_ss (s, _mm_shuffle_ps (s, s, 0x55));
+
+  return s;
+}
+
+static inline __m128d
+hadd_pd_avx512 (__m256d sum)
+{
+  __m128d s;
+
+  s = _mm_add_pd (_mm256_castpd256_pd128 (sum), _mm256_extractf128_pd (sum,
+          1));
+  s = _mm_add_sd (s, _mm_unpackhi_pd (s, s));
+
+  return s;
+}
+
+static inline __m128i
+fold_si256_avx512 (__m256i sum)
+{
+  return _mm_add_epi32 (_mm256_castsi256_si128 (sum),
+      _mm256_extracti128_si256 (sum, 1));
+}
+
+static inline __m128i
+fold_epi64x4_avx512 (__m256i sum)
+{
+  return _mm_add_epi64 (_mm256_castsi256_si128 (sum),
+      _mm256_extracti128_si256 (sum, 1));
+}
+
+static inline __m128i
+sum_gint16_avx512 (const gint16 * a, const gint16 * b, gint len)
+{
+  gint i = 0;
+  __m512i sum = _mm512_setzero_si512 ();
+  __m256i s;
+
+  for (; i + 32 <= len; i += 32) {
+    sum =
+        _mm512_add_epi32 (sum,
+        _mm512_madd_epi16 (_mm512_loadu_si512 (a + i),
+            _mm512_loadu_si512 (b + i)));
+  }
+  s = fold_si512_avx512 (sum);
+  for (; i < len; i += 16) {
+    s = _mm256_add_epi32 (s,
+        _mm256_madd_epi16 (_mm256_loadu_si256 ((__m256i *) (a + i)),
+            _mm256_loadu_si256 ((__m256i *) (b + i))));
+  }
+  return fold_si256_avx512 (s);
+}
+
+static inline void
+inner_product_gint16_full_1_avx512 (gint16 * o, const gint16 * a,
+    const gint16 * b, gint len, const gint16 * icoeff, gint bstride)
+{
+  __m128i s;
+
+  s = sum_gint16_avx512 (a, b, len);
+  s = _mm_add_epi32 (s, _mm_shuffle_epi32 (s, _MM_SHUFFLE (2, 3, 2, 3)));
+  s = _mm_add_epi32 (s, _mm_shuffle_epi32 (s, _MM_SHUFFLE (1, 1, 1, 1)));
+
+  s = _mm_add_epi32 (s, _mm_set1_epi32 (1 << (PRECISION_S16 - 1)));
+  s = _mm_srai_epi32 (s, PRECISION_S16);
+  s = _mm_packs_epi32 (s, s);
+  *o = _mm_extract_epi16 (s, 0);
+}
+
+static inline void
+inner_product_gint16_linear_1_avx512 (gint16 * o, const gint16 * a,
+    const gint16 * b, gint len, const gint16 * icoeff, gint bstride)
+{
+  __m128i s[2];
+  __m128i f = _mm_set_epi64x (0, *((gint64 *) icoeff));
+  const gint16 *c[2] = { (gint16 *) ((gint8 *) b + 0 * bstride),
+    (gint16 *) ((gint8 *) b + 1 * bstride)
+  };
+
+  f = _mm_unpacklo_epi16 (f, _mm_setzero_si128 ());
+
+  s[0] = _mm_srai_epi32 (sum_gint16_avx512 (a, c[0], len), PRECISION_S16);
+  s[1] = _mm_srai_epi32 (sum_gint16_avx512 (a, c[1], len), PRECISION_S16);
+
+  s[0] = _mm_madd_epi16 (s[0], _mm_shuffle_epi32 (f, _MM_SHUFFLE (0, 0, 0, 0)));
+  s[1] = _mm_madd_epi16 (s[1], _mm_shuffle_epi32 (f, _MM_SHUFFLE (1, 1, 1, 1)));
+  s[0] = _mm_add_epi32 (s[0], s[1]);
+
+  s[0] = _mm_add_epi32 (s[0], _mm_shuffle_epi32 (s[0], _MM_SHUFFLE (2, 3, 2,
+              3)));
+  s[0] = _mm_add_epi32 (s[0], _mm_shuffle_epi32 (s[0], _MM_SHUFFLE (1, 1, 1,
+              1)));
+
+  s[0] = _mm_add_epi32 (s[0], _mm_set1_epi32 (1 << (PRECISION_S16 - 1)));
+  s[0] = _mm_srai_epi32 (s[0], PRECISION_S16);
+  s[0] = _mm_packs_epi32 (s[0], s[0]);
+  *o = _mm_extract_epi16 (s[0], 0);
+}
+
+static inline void
+inner_product_gint16_cubic_1_avx512 (gint16 * o, const gint16 * a,
+    const gint16 * b, gint len, const gint16 * icoeff, gint bstride)
+{
+  __m128i s[4], u[4];
+  __m128i f = _mm_set_epi64x (0, *((gint64 *) icoeff));
+  const gint16 *c[4] = { (gint16 *) ((gint8 *) b + 0 * bstride),
+    (gint16 *) ((gint8 *) b + 1 * bstride),
+    (gint16 *) ((gint8 *) b + 2 * bstride),
+    (gint16 *) ((gint8 *) b + 3 * bstride)
+  };
+
+  f = _mm_unpacklo_epi16 (f, _mm_setzero_si128 ());
+
+  s[0] = sum_gint16_avx512 (a, c[0], len);
+  s[1] = sum_gint16_avx512 (a, c[1], len);
+  s[2] = sum_gint16_avx512 (a, c[2], len);
+  s[3] = sum_gint16_avx512 (a, c[3], len);
+
+  u[0] = _mm_unpacklo_epi32 (s[0], s[1]);
+  u[1] = _mm_unpacklo_epi32 (s[2], s[3]);
+  u[2] = _mm_unpackhi_epi32 (s[0], s[1]);
+  u[3] = _mm_unpackhi_epi32 (s[2], s[3]);
+
+  s[0] =
+      _mm_add_epi32 (_mm_unpacklo_epi64 (u[0], u[1]), _mm_unpackhi_epi64 (u[0],
+          u[1]));
+  s[2] =
+      _mm_add_epi32 (_mm_unpacklo_epi64 (u[2], u[3]), _mm_unpackhi_epi64 (u[2],
+          u[3]));
+  s[0] = _mm_add_epi32 (s[0], s[2]);
+
+  s[0] = _mm_srai_epi32 (s[0], PRECISION_S16);
+  s[0] = _mm_madd_epi16 (s[0], f);
+
+  s[0] = _mm_add_epi32 (s[0], _mm_shuffle_epi32 (s[0], _MM_SHUFFLE (2, 3, 2,
+              3)));
+  s[0] = _mm_add_epi32 (s[0], _mm_shuffle_epi32 (s[0], _MM_SHUFFLE (1, 1, 1,
+              1)));
+
+  s[0] = _mm_add_epi32 (s[0], _mm_set1_epi32 (1 << (PRECISION_S16 - 1)));
+  s[0] = _mm_srai_epi32 (s[0], PRECISION_S16);
+  s[0] = _mm_packs_epi32 (s[0], s[0]);
+  *o = _mm_extract_epi16 (s[0], 0);
+}
+
+#if defined (__x86_64__)
+static inline __m128i
+sum_gint32_avx512 (const gint32 * a, const gint32 * b, gint len)
+{
+  gint i = 0;
+  __m512i sum = _mm512_setzero_si512 (), ta, tb;
+  __m256i s, ua, ub;
+
+  for (; i + 16 <= len; i += 16) {
+    ta = _mm512_loadu_si512 (a + i);
+    tb = _mm512_loadu_si512 (b + i);
+    sum = _mm512_add_epi64 (sum,
+        _mm512_mul_epi32 (_mm512_unpacklo_epi32 (ta, ta),
+            _mm512_unpacklo_epi32 (tb, tb)));
+    sum = _mm512_add_epi64 (sum,
+        _mm512_mul_epi32 (_mm512_unpackhi_epi32 (ta, ta),
+            _mm512_unpackhi_epi32 (tb, tb)));
+  }
+  s = fold_epi64_avx512 (sum);
+  for (; i < len; i += 8) {
+    ua = _mm256_loadu_si256 ((__m256i *) (a + i));
+    ub = _mm256_loadu_si256 ((__m256i *) (b + i));
+    s = _mm256_add_epi64 (s,
+        _mm256_mul_epi32 (_mm256_unpacklo_epi32 (ua, ua),
+            _mm256_unpacklo_epi32 (ub, ub)));
+    s = _mm256_add_epi64 (s,
+        _mm256_mul_epi32 (_mm256_unpackhi_epi32 (ua, ua),
+            _mm256_unpackhi_epi32 (ub, ub)));
+  }
+  return fold_epi64x4_avx512 (s);
+}
+
+static inline void
+inner_product_gint32_full_1_avx512 (gint32 * o, const gint32 * a,
+    const gint32 * b, gint len, const gint32 * icoeff, gint bstride)
+{
+  __m128i s;
+  gint64 res;
+
+  s = sum_gint32_avx512 (a, b, len);
+  s = _mm_add_epi64 (s, _mm_unpackhi_epi64 (s, s));
+  res = _mm_cvtsi128_si64 (s);
+
+  res = (res + (1 << (PRECISION_S32 - 1))) >> PRECISION_S32;
+  *o = CLAMP (res, G_MININT32, G_MAXINT32);
+}
+
+static inline void
+inner_product_gint32_linear_1_avx512 (gint32 * o, const gint32 * a,
+    const gint32 * b, gint len, const gint32 * icoeff, gint bstride)
+{
+  gint64 res;
+  __m128i s[2];
+  __m128i f = _mm_loadu_si128 ((__m128i *) icoeff);
+  const gint32 *c[2] = { (gint32 *) ((gint8 *) b + 0 * bstride),
+    (gint32 *) ((gint8 *) b + 1 * bstride)
+  };
+
+  s[0] = _mm_srli_epi64 (sum_gint32_avx512 (a, c[0], len), PRECISION_S32);
+  s[1] = _mm_srli_epi64 (sum_gint32_avx512 (a, c[1], len), PRECISION_S32);
+  s[0] = _mm_mul_epi32 (s[0], _mm_shuffle_epi32 (f, _MM_SHUFFLE (0, 0, 0, 0)));
+  s[1] = _mm_mul_epi32 (s[1], _mm_shuffle_epi32 (f, _MM_SHUFFLE (1, 1, 1, 1)));
+  s[0] = _mm_add_epi64 (s[0], s[1]);
+  s[0] = _mm_add_epi64 (s[0], _mm_unpackhi_epi64 (s[0], s[0]));
+  res = _mm_cvtsi128_si64 (s[0]);
+
+  res = (res + (1 << (PRECISION_S32 - 1))) >> PRECISION_S32;
+  *o = CLAMP (res, G_MININT32, G_MAXINT32);
+}
+
+static inline void
+inner_product_gint32_cubic_1_avx512 (gint32 * o, const gint32 * a,
+    const gint32 * b, gint len, const gint32 * icoeff, gint bstride)
+{
+  gint64 res;
+  __m128i s[4];
+  __m128i f = _mm_loadu_si128 ((__m128i *) icoeff);
+  const gint32 *c[4] = { (gint32 *) ((gint8 *) b + 0 * bstride),
+    (gint32 *) ((gint8 *) b + 1 * bstride),
+    (gint32 *) ((gint8 *) b + 2 * bstride),
+    (gint32 *) ((gint8 *) b + 3 * bstride)
+  };
+
+  s[0] = _mm_srli_epi64 (sum_gint32_avx512 (a, c[0], len), PRECISION_S32);
+  s[1] = _mm_srli_epi64 (sum_gint32_avx512 (a, c[1], len), PRECISION_S32);
+  s[2] = _mm_srli_epi64 (sum_gint32_avx512 (a, c[2], len), PRECISION_S32);
+  s[3] = _mm_srli_epi64 (sum_gint32_avx512 (a, c[3], len), PRECISION_S32);
+  s[0] = _mm_mul_epi32 (s[0], _mm_shuffle_epi32 (f, _MM_SHUFFLE (0, 0, 0, 0)));
+  s[1] = _mm_mul_epi32 (s[1], _mm_shuffle_epi32 (f, _MM_SHUFFLE (1, 1, 1, 1)));
+  s[2] = _mm_mul_epi32 (s[2], _mm_shuffle_epi32 (f, _MM_SHUFFLE (2, 2, 2, 2)));
+  s[3] = _mm_mul_epi32 (s[3], _mm_shuffle_epi32 (f, _MM_SHUFFLE (3, 3, 3, 3)));
+  s[0] = _mm_add_epi64 (s[0], s[1]);
+  s[2] = _mm_add_epi64 (s[2], s[3]);
+  s[0] = _mm_add_epi64 (s[0], s[2]);
+  s[0] = _mm_add_epi64 (s[0], _mm_unpackhi_epi64 (s[0], s[0]));
+  res = _mm_cvtsi128_si64 (s[0]);
+
+  res = (res + (1 << (PRECISION_S32 - 1))) >> PRECISION_S32;
+  *o = CLAMP (res, G_MININT32, G_MAXINT32);
+}
+#endif
+
+static inline __m256
+sum_gfloat_avx512 (const gfloat * a, const gfloat * b, gint len)
+{
+  gint i = 0;
+  __m512 sum = _mm512_setzero_ps ();
+  __m256 s;
+
+  for (; i + 16 <= len; i += 16) {
+    sum =
+        _mm512_add_ps (sum, _mm512_mul_ps (_mm512_loadu_ps (a + i),
+            _mm512_loadu_ps (b + i)));
+  }
+  s = fold_ps_avx512 (sum);
+  for (; i < len; i += 8) {
+    s = _mm256_add_ps (s, _mm256_mul_ps (_mm256_loadu_ps (a + i),
+            _mm256_loadu_ps (b + i)));
+  }
+  return s;
+}
+
+static inline void
+inner_product_gfloat_full_1_avx512 (gfloat * o, const gfloat * a,
+    const gfloat * b, gint len, const gfloat * icoeff, gint bstride)
+{
+  _mm_store_ss (o, hadd_ps_avx512 (sum_gfloat_avx512 (a, b, len)));
+}
+
+static inline void
+inner_product_gfloat_linear_1_avx512 (gfloat * o, const gfloat * a,
+    const gfloat * b, gint len, const gfloat * icoeff, gint bstride)
+{
+  __m256 sum[2];
+  const gfloat *c[2] = { (gfloat *) ((gint8 *) b + 0 * bstride),
+    (gfloat *) ((gint8 *) b + 1 * bstride)
+  };
+
+  sum[0] = sum_gfloat_avx512 (a, c[0], len);
+  sum[1] = sum_gfloat_avx512 (a, c[1], len);
+  sum[0] =
+      _mm256_mul_ps (_mm256_sub_ps (sum[0], sum[1]),
+      _mm256_broadcast_ss (icoeff));
+  sum[0] = _mm256_add_ps (sum[0], sum[1]);
+  _mm_store_ss (o, hadd_ps_avx512 (sum[0]));
+}
+
+static inline void
+inner_product_gfloat_cubic_1_avx512 (gfloat * o, const gfloat * a,
+    const gfloat * b, gint len, const gfloat * icoeff, gint bstride)
+{
+  __m256 sum[4];
+  const gfloat *c[4] = { (gfloat *) ((gint8 *) b + 0 * bstride),
+    (gfloat *) ((gint8 *) b + 1 * bstride),
+    (gfloat *) ((gint8 *) b + 2 * bstride),
+    (gfloat *) ((gint8 *) b + 3 * bstride)
+  };
+
+  sum[0] = _mm256_mul_ps (sum_gfloat_avx512 (a, c[0], len),
+      _mm256_broadcast_ss (icoeff + 0));
+  sum[1] = _mm256_mul_ps (sum_gfloat_avx512 (a, c[1], len),
+      _mm256_broadcast_ss (icoeff + 1));
+  sum[2] = _mm256_mul_ps (sum_gfloat_avx512 (a, c[2], len),
+      _mm256_broadcast_ss (icoeff + 2));
+  sum[3] = _mm256_mul_ps (sum_gfloat_avx512 (a, c[3], len),
+      _mm256_broadcast_ss (icoeff + 3));
+  sum[0] = _mm256_add_ps (sum[0], sum[1]);
+  sum[2] = _mm256_add_ps (sum[2], sum[3]);
+  sum[0] = _mm256_add_ps (sum[0], sum[2]);
+  _mm_store_ss (o, hadd_ps_avx512 (sum[0]));
+}
+
+static inline __m256d
+sum_gdouble_avx512 (const gdouble * a, const gdouble * b, gint len)
+{
+  gint i = 0;
+  __m512d sum = _mm512_setzero_pd ();
+  __m256d s;
+
+  for (; i + 8 <= len; i += 8) {
+    sum =
+        _mm512_add_pd (sum, _mm512_mul_pd (_mm512_loadu_pd (a + i),
+            _mm512_loadu_pd (b + i)));
+  }
+  s = fold_pd_avx512 (sum);
+  for (; i < len; i += 4) {
+    s = _mm256_add_pd (s, _mm256_mul_pd (_mm256_loadu_pd (a + i),
+            _mm256_loadu_pd (b + i)));
+  }
+  return s;
+}
+
+static inline void
+inner_product_gdouble_full_1_avx512 (gdouble * o, const gdouble * a,
+    const gdouble * b, gint len, const gdouble * icoeff, gint bstride)
+{
+  _mm_store_sd (o, hadd_pd_avx512 (sum_gdouble_avx512 (a, b, len)));
+}
+
+static inline void
+inner_product_gdouble_linear_1_avx512 (gdouble * o, const gdouble * a,
+    const gdouble * b, gint len, const gdouble * icoeff, gint bstride)
+{
+  __m256d sum[2];
+  const gdouble *c[2] = { (gdouble *) ((gint8 *) b + 0 * bstride),
+    (gdouble *) ((gint8 *) b + 1 * bstride)
+  };
+
+  sum[0] = sum_gdouble_avx512 (a, c[0], len);
+  sum[1] = sum_gdouble_avx512 (a, c[1], len);
+  sum[0] =
+      _mm256_mul_pd (_mm256_sub_pd (sum[0], sum[1]),
+      _mm256_broadcast_sd (icoeff));
+  sum[0] = _mm256_add_pd (sum[0], sum[1]);
+  _mm_store_sd (o, hadd_pd_avx512 (sum[0]));
+}
+
+static inline void
+inner_product_gdouble_cubic_1_avx512 (gdouble * o, const gdouble * a,
+    const gdouble * b, gint len, const gdouble * icoeff, gint bstride)
+{
+  __m256d sum[4];
+  const gdouble *c[4] = { (gdouble *) ((gint8 *) b + 0 * bstride),
+    (gdouble *) ((gint8 *) b + 1 * bstride),
+    (gdouble *) ((gint8 *) b + 2 * bstride),
+    (gdouble *) ((gint8 *) b + 3 * bstride)
+  };
+
+  sum[0] = _mm256_mul_pd (sum_gdouble_avx512 (a, c[0], len),
+      _mm256_broadcast_sd (icoeff + 0));
+  sum[1] = _mm256_mul_pd (sum_gdouble_avx512 (a, c[1], len),
+      _mm256_broadcast_sd (icoeff + 1));
+  sum[2] = _mm256_mul_pd (sum_gdouble_avx512 (a, c[2], len),
+      _mm256_broadcast_sd (icoeff + 2));
+  sum[3] = _mm256_mul_pd (sum_gdouble_avx512 (a, c[3], len),
+      _mm256_broadcast_sd (icoeff + 3));
+  sum[0] = _mm256_add_pd (sum[0], sum[1]);
+  sum[2] = _mm256_add_pd (sum[2], sum[3]);
+  sum[0] = _mm256_add_pd (sum[0], sum[2]);
+  _mm_store_sd (o, hadd_pd_avx512 (sum[0]));
+}
+
+MAKE_RESAMPLE_FUNC (gint16, full, 1, avx512);
+MAKE_RESAMPLE_FUNC (gint16, linear, 1, avx512);
+MAKE_RESAMPLE_FUNC (gint16, cubic, 1, avx512);
+
+#if defined (__x86_64__)
+MAKE_RESAMPLE_FUNC (gint32, full, 1, avx512);
+MAKE_RESAMPLE_FUNC (gint32, linear, 1, avx512);
+MAKE_RESAMPLE_FUNC (gint32, cubic, 1, avx512);
+#endif
+
+MAKE_RESAMPLE_FUNC (gfloat, full, 1, avx512);
+MAKE_RESAMPLE_FUNC (gfloat, linear, 1, avx512);
+MAKE_RESAMPLE_FUNC (gfloat, cubic, 1, avx512);
+
+MAKE_RESAMPLE_FUNC (gdouble, full, 1, avx512);
+MAKE_RESAMPLE_FUNC (gdouble, linear, 1, avx512);
+MAKE_RESAMPLE_FUNC (gdouble, cubic, 1, avx512);
+
+void
+interpolate_gint16_linear_avx512 (gpointer op, const gpointer ap,
+    gint len, const gpointer icp, gint astride)
+{
+  gint i = 0;
+  gint16 *o = op, *a = ap, *ic = icp;
+  __m512i ta, tb, t1, t2;
+  __m512i f = _mm512_set1_epi32 (*((gint32 *) ic));
+  __m256i ua, ub, u1, u2;
+  __m256i g = _mm256_set1_epi32 (*((gint32 *) ic));
+  const gint16 *c[2] = { (gint16 *) ((gint8 *) a + 0 * astride),
+    (gint16 *) ((gint8 *) a + 1 * astride)
+  };
+
+  for (; i + 32 <= len; i += 32) {
+    ta = _mm512_loadu_si512 (c[0] + i);
+    tb = _mm512_loadu_si512 (c[1] + i);
+
+    t1 = _mm512_madd_epi16 (_mm512_unpacklo_epi16 (ta, tb), f);
+    t2 = _mm512_madd_epi16 (_mm512_unpackhi_epi16 (ta, tb), f);
+
+    t1 = _mm512_add_epi32 (t1, _mm512_set1_epi32 (1 << (PRECISION_S16 - 1)));
+    t2 = _mm512_add_epi32 (t2, _mm512_set1_epi32 (1 << (PRECISION_S16 - 1)));
+
+    t1 = _mm512_srai_epi32 (t1, PRECISION_S16);
+    t2 = _mm512_srai_epi32 (t2, PRECISION_S16);
+
+    _mm512_storeu_si512 (o + i, _mm512_packs_epi32 (t1, t2));
+  }
+  for (; i < len; i += 16) {
+    ua = _mm256_loadu_si256 ((__m256i *) (c[0] + i));
+    ub = _mm256_loadu_si256 ((__m256i *) (c[1] + i));
+
+    u1 = _mm256_madd_epi16 (_mm256_unpacklo_epi16 (ua, ub), g);
+    u2 = _mm256_madd_epi16 (_mm256_unpackhi_epi16 (ua, ub), g);
+
+    u1 = _mm256_add_epi32 (u1, _mm256_set1_epi32 (1 << (PRECISION_S16 - 1)));
+    u2 = _mm256_add_epi32 (u2, _mm256_set1_epi32 (1 << (PRECISION_S16 - 1)));
+
+    u1 = _mm256_srai_epi32 (u1, PRECISION_S16);
+    u2 = _mm256_srai_epi32 (u2, PRECISION_S16);
+
+    _mm256_storeu_si256 ((__m256i *) (o + i), _mm256_packs_epi32 (u1, u2));
+  }
+}
+
+void
+interpolate_gint16_cubic_avx512 (gpointer op, const gpointer ap,
+    gint len, const gpointer icp, gint astride)
+{
+  gint i = 0;
+  gint16 *o = op, *a = ap, *ic = icp;
+  __m512i ta, tb, tl1, tl2, th1, th2;
+  __m512i f[2];
+  __m256i ua, ub, ul1, ul2, uh1, uh2;
+  __m256i g[2];
+  const gint16 *c[4] = { (gint16 *) ((gint8 *) a + 0 * astride),
+    (gint16 *) ((gint8 *) a + 1 * astride),
+    (gint16 *) ((gint8 *) a + 2 * astride),
+    (gint16 *) ((gint8 *) a + 3 * astride)
+  };
+
+  f[0] = _mm512_set1_epi32 (*((gint32 *) (ic + 0)));
+  f[1] = _mm512_set1_epi32 (*((gint32 *) (ic + 2)));
+  g[0] = _mm256_set1_epi32 (*((gint32 *) (ic + 0)));
+  g[1] = _mm256_set1_epi32 (*((gint32 *) (ic + 2)));
+
+  for (; i + 32 <= len; i += 32) {
+    ta = _mm512_loadu_si512 (c[0] + i);
+    tb = _mm512_loadu_si512 (c[1] + i);
+
+    tl1 = _mm512_madd_epi16 (_mm512_unpacklo_epi16 (ta, tb), f[0]);
+    th1 = _mm512_madd_epi16 (_mm512_unpackhi_epi16 (ta, tb), f[0]);
+
+    ta = _mm512_loadu_si512 (c[2] + i);
+    tb = _mm512_loadu_si512 (c[3] + i);
+
+    tl2 = _mm512_madd_epi16 (_mm512_unpacklo_epi16 (ta, tb), f[1]);
+    th2 = _mm512_madd_epi16 (_mm512_unpackhi_epi16 (ta, tb), f[1]);
+
+    tl1 = _mm512_add_epi32 (tl1, tl2);
+    th1 = _mm512_add_epi32 (th1, th2);
+
+    tl1 = _mm512_add_epi32 (tl1, _mm512_set1_epi32 (1 << (PRECISION_S16 - 1)));
+    th1 = _mm512_add_epi32 (th1, _mm512_set1_epi32 (1 << (PRECISION_S16 - 1)));
+
+    tl1 = _mm512_srai_epi32 (tl1, PRECISION_S16);
+    th1 = _mm512_srai_epi32 (th1, PRECISION_S16);
+
+    _mm512_storeu_si512 (o + i, _mm512_packs_epi32 (tl1, th1));
+  }
+  for (; i < len; i += 16) {
+    ua = _mm256_loadu_si256 ((__m256i *) (c[0] + i));
+    ub = _mm256_loadu_si256 ((__m256i *) (c[1] + i));
+
+    ul1 = _mm256_madd_epi16 (_mm256_unpacklo_epi16 (ua, ub), g[0]);
+    uh1 = _mm256_madd_epi16 (_mm256_unpackhi_epi16 (ua, ub), g[0]);
+
+    ua = _mm256_loadu_si256 ((__m256i *) (c[2] + i));
+    ub = _mm256_loadu_si256 ((__m256i *) (c[3] + i));
+
+    ul2 = _mm256_madd_epi16 (_mm256_unpacklo_epi16 (ua, ub), g[1]);
+    uh2 = _mm256_madd_epi16 (_mm256_unpackhi_epi16 (ua, ub), g[1]);
+
+    ul1 = _mm256_add_epi32 (ul1, ul2);
+    uh1 = _mm256_add_epi32 (uh1, uh2);
+
+    ul1 = _mm256_add_epi32 (ul1, _mm256_set1_epi32 (1 << (PRECISION_S16 - 1)));
+    uh1 = _mm256_add_epi32 (uh1, _mm256_set1_epi32 (1 << (PRECISION_S16 - 1)));
+
+    ul1 = _mm256_srai_epi32 (ul1, PRECISION_S16);
+    uh1 = _mm256_srai_epi32 (uh1, PRECISION_S16);
+
+    _mm256_storeu_si256 ((__m256i *) (o + i), _mm256_packs_epi32 (ul1, uh1));
+  }
+}
+
+void
+interpolate_gfloat_linear_avx512 (gpointer op, const gpointer ap,
+    gint len, const gpointer icp, gint astride)
+{
+  gint i = 0;
+  gfloat *o = op, *a = ap, *ic = icp;
+  __m512 f[2], t1, t2;
+  __m256 u1, u2;
+  const gfloat *c[2] = { (gfloat *) ((gint8 *) a + 0 * astride),
+    (gfloat *) ((gint8 *) a + 1 * astride)
+  };
+
+  f[0] = _mm512_set1_ps (ic[0]);
+  f[1] = _mm512_set1_ps (ic[1]);
+
+  for (; i + 16 <= len; i += 16) {
+    t1 = _mm512_mul_ps (_mm512_loadu_ps (c[0] + i), f[0]);
+    t2 = _mm512_mul_ps (_mm512_loadu_ps (c[1] + i), f[1]);
+    _mm512_storeu_ps (o + i, _mm512_add_ps (t1, t2));
+  }
+  for (; i < len; i += 8) {
+    u1 = _mm256_mul_ps (_mm256_loadu_ps (c[0] + i),
+        _mm512_castps512_ps256 (f[0]));
+    u2 = _mm256_mul_ps (_mm256_loadu_ps (c[1] + i),
+        _mm512_castps512_ps256 (f[1]));
+    _mm256_storeu_ps (o + i, _mm256_add_ps (u1, u2));
+  }
+}
+
+void
+interpolate_gfloat_cubic_avx512 (gpointer op, const gpointer ap,
+    gint len, const gpointer icp, gint astride)
+{
+  gint i = 0;
+  gfloat *o = op, *a = ap, *ic = icp;
+  __m512 f[4], t[4];
+  __m256 u[4];
+  const gfloat *c[4] = { (gfloat *) ((gint8 *) a + 0 * astride),
+    (gfloat *) ((gint8 *) a + 1 * astride),
+    (gfloat *) ((gint8 *) a + 2 * astride),
+    (gfloat *) ((gint8 *) a + 3 * astride)
+  };
+
+  f[0] = _mm512_set1_ps (ic[0]);
+  f[1] = _mm512_set1_ps (ic[1]);
+  f[2] = _mm512_set1_ps (ic[2]);
+  f[3] = _mm512_set1_ps (ic[3]);
+
+  for (; i + 16 <= len; i += 16) {
+    t[0] = _mm512_mul_ps (_mm512_loadu_ps (c[0] + i), f[0]);
+    t[1] = _mm512_mul_ps (_mm512_loadu_ps (c[1] + i), f[1]);
+    t[2] = _mm512_mul_ps (_mm512_loadu_ps (c[2] + i), f[2]);
+    t[3] = _mm512_mul_ps (_mm512_loadu_ps (c[3] + i), f[3]);
+    t[0] = _mm512_add_ps (t[0], t[1]);
+    t[2] = _mm512_add_ps (t[2], t[3]);
+    _mm512_storeu_ps (o + i, _mm512_add_ps (t[0], t[2]));
+  }
+  for (; i < len; i += 8) {
+    u[0] = _mm256_mul_ps (_mm256_loadu_ps (c[0] + i),
+        _mm512_castps512_ps256 (f[0]));
+    u[1] = _mm256_mul_ps (_mm256_loadu_ps (c[1] + i),
+        _mm512_castps512_ps256 (f[1]));
+    u[2] = _mm256_mul_ps (_mm256_loadu_ps (c[2] + i),
+        _mm512_castps512_ps256 (f[2]));
+    u[3] = _mm256_mul_ps (_mm256_loadu_ps (c[3] + i),
+        _mm512_castps512_ps256 (f[3]));
+    u[0] = _mm256_add_ps (u[0], u[1]);
+    u[2] = _mm256_add_ps (u[2], u[3]);
+    _mm256_storeu_ps (o + i, _mm256_add_ps (u[0], u[2]));
+  }
+}
+
+void
+interpolate_gdouble_linear_avx512 (gpointer op, const gpointer ap,
+    gint len, const gpointer icp, gint astride)
+{
+  gint i = 0;
+  gdouble *o = op, *a = ap, *ic = icp;
+  __m512d f[2], t1, t2;
+  __m256d u1, u2;
+  const gdouble *c[2] = { (gdouble *) ((gint8 *) a + 0 * astride),
+    (gdouble *) ((gint8 *) a + 1 * astride)
+  };
+
+  f[0] = _mm512_set1_pd (ic[0]);
+  f[1] = _mm512_set1_pd (ic[1]);
+
+  for (; i + 8 <= len; i += 8) {
+    t1 = _mm512_mul_pd (_mm512_loadu_pd (c[0] + i), f[0]);
+    t2 = _mm512_mul_pd (_mm512_loadu_pd (c[1] + i), f[1]);
+    _mm512_storeu_pd (o + i, _mm512_add_pd (t1, t2));
+  }
+  for (; i < len; i += 4) {
+    u1 = _mm256_mul_pd (_mm256_loadu_pd (c[0] + i),
+        _mm512_castpd512_pd256 (f[0]));
+    u2 = _mm256_mul_pd (_mm256_loadu_pd (c[1] + i),
+        _mm512_castpd512_pd256 (f[1]));
+    _mm256_storeu_pd (o + i, _mm256_add_pd (u1, u2));
+  }
+}
+
+void
+interpolate_gdouble_cubic_avx512 (gpointer op, const gpointer ap,
+    gint len, const gpointer icp, gint astride)
+{
+  gint i = 0;
+  gdouble *o = op, *a = ap, *ic = icp;
+  __m512d f[4], t[4];
+  __m256d u[4];
+  const gdouble *c[4] = { (gdouble *) ((gint8 *) a + 0 * astride),
+    (gdouble *) ((gint8 *) a + 1 * astride),
+    (gdouble *) ((gint8 *) a + 2 * astride),
+    (gdouble *) ((gint8 *) a + 3 * astride)
+  };
+
+  f[0] = _mm512_set1_pd (ic[0]);
+  f[1] = _mm512_set1_pd (ic[1]);
+  f[2] = _mm512_set1_pd (ic[2]);
+  f[3] = _mm512_set1_pd (ic[3]);
+
+  for (; i + 8 <= len; i += 8) {
+    t[0] = _mm512_mul_pd (_mm512_loadu_pd (c[0] + i), f[0]);
+    t[1] = _mm512_mul_pd (_mm512_loadu_pd (c[1] + i), f[1]);
+    t[2] = _mm512_mul_pd (_mm512_loadu_pd (c[2] + i), f[2]);
+    t[3] = _mm512_mul_pd (_mm512_loadu_pd (c[3] + i), f[3]);
+    t[0] = _mm512_add_pd (t[0], t[1]);
+    t[2] = _mm512_add_pd (t[2], t[3]);
+    _mm512_storeu_pd (o + i, _mm512_add_pd (t[0], t[2]));
+  }
+  for (; i < len; i += 4) {
+    u[0] = _mm256_mul_pd (_mm256_loadu_pd (c[0] + i),
+        _mm512_castpd512_pd256 (f[0]));
+    u[1] = _mm256_mul_pd (_mm256_loadu_pd (c[1] + i),
+        _mm512_castpd512_pd256 (f[1]));
+    u[2] = _mm256_mul_pd (_mm256_loadu_pd (c[2] + i),
+        _mm512_castpd512_pd256 (f[2]));
+    u[3] = _mm256_mul_pd (_mm256_loadu_pd (c[3] + i),
+        _mm512_castpd512_pd256 (f[3]));
+    u[0] = _mm256_add_pd (u[0], u[1]);
+    u[2] = _mm256_add_pd (u[2], u[3]);
+    _mm256_storeu_pd (o + i, _mm256_add_pd (u[0], u[2]));
+  }
+}
+
+#endif
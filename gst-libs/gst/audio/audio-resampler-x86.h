@@ -21,6 +21,8 @@
 #include "audio-resampler-x86-sse.h"
 #include "audio-resampler-x86-sse2.h"
 #include "audio-resampler-x86-sse41.h"
+#include "audio-resampler-x86-avx2.h"
+#include "audio-resampler-x86-avx512.h"
 
 static void
 audio_resampler_check_x86 (const gchar *option)
@@ -66,6 +68,87 @@ audio_resampler_check_x86 (const gchar *option)
     resample_gint32_cubic_1 = resample_gint32_cubic_1_sse41;
 #else
     GST_DEBUG ("SSE41 optimisations not enabled");
+#endif
+  } else if (!strcmp (option, "avx2")) {
+#if defined (HAVE_IMMINTRIN_H) && HAVE_AVX2
+    GST_DEBUG ("enable AVX2 optimisations");
+    resample_gint16_full_1 = resample_gint16_full_1_avx2;
+    resample_gint16_linear_1 = resample_gint16_linear_1_avx2;
+    resample_gint16_cubic_1 = resample_gint16_cubic_1_avx2;
+
+    interpolate_gint16_linear = interpolate_gint16_linear_avx2;
+    interpolate_gint16_cubic = interpolate_gint16_cubic_avx2;
+
+#if defined (__x86_64__)
+    resample_gint32_full_1 = resample_gint32_full_1_avx2;
+    resample_gint32_linear_1 = resample_gint32_linear_1_avx2;
+    resample_gint32_cubic_1 = resample_gint32_cubic_1_avx2;
+#endif
+
+    resample_gfloat_full_1 = resample_gfloat_full_1_avx2;
+    resample_gfloat_linear_1 = resample_gfloat_linear_1_avx2;
+    resample_gfloat_cubic_1 = resample_gfloat_cubic_1_avx2;
+
+    interpolate_gfloat_linear = interpolate_gfloat_linear_avx2;
+    interpolate_gfloat_cubic = interpolate_gfloat_cubic_avx2;
+
+    resample_gdouble_full_1 = resample_gdouble_full_1_avx2;
+    resample_gdouble_linear_1 = resample_gdouble_linear_1_avx2;
+    resample_gdouble_cubic_1 = resample_gdouble_cubic_1_avx2;
+
+    interpolate_gdouble_linear = interpolate_gdouble_linear_avx2;
+    interpolate_gdouble_cubic = interpolate_gdouble_cubic_avx2;
+#else
+    GST_DEBUG ("AVX2 optimisations not enabled");
+#endif
+  } else if (!strcmp (option, "avx512")) {
+#if defined (HAVE_IMMINTRIN_H) && HAVE_AVX512
+    GST_DEBUG ("enable AVX-512 optimisations");
+    resample_gint16_full_1 = resample_gint16_full_1_avx512;
+    resample_gint16_linear_1 = resample_gint16_linear_1_avx512;
+    resample_gint16_cubic_1 = resample_gint16_cubic_1_avx512;
+
+    interpolate_gint16_linear = interpolate_gint16_linear_avx512;
+    interpolate_gint16_cubic = interpolate_gint16_cubic_avx512;
+
+#if defined (__x86_64__)
+    resample_gint32_full_1 = resample_gint32_full_1_avx512;
+    resample_gint32_linear_1 = resample_gint32_linear_1_avx512;
+    resample_gint32_cubic_1 = resample_gint32_cubic_1_avx512;
+#endif
+
+    resample_gfloat_full_1 = resample_gfloat_full_1_avx512;
+    resample_gfloat_linear_1 = resample_gfloat_linear_1_avx512;
+    resample_gfloat_cubic_1 = resample_gfloat_cubic_1_avx512;
+
+    interpolate_gfloat_linear = interpolate_gfloat_linear_avx512;
+    interpolate_gfloat_cubic = interpolate_gfloat_cubic_avx512;
+
+    resample_gdouble_full_1 = resample_gdouble_full_1_avx512;
+    resample_gdouble_linear_1 = resample_gdouble_linear_1_avx512;
+    resample_gdouble_cubic_1 = resample_gdouble_cubic_1_avx512;
+
+    interpolate_gdouble_linear = interpolate_gdouble_linear_avx512;
+    interpolate_gdouble_cubic = interpolate_gdouble_cubic_avx512;
+#else
+    GST_DEBUG ("AVX-512 optimisations not enabled");
 #endif
   }
 }
+
+/* ORC does not report AVX support so ask the CPU directly. The AVX-512
+ * kernels need the BW extension for the 16 bit integer versions. */
+static gboolean
+audio_resampler_x86_has_avx (const gchar *option)
+{
+#if defined (__GNUC__) && (defined (__x86_64__) || defined (__i386__))
+  __builtin_cpu_init ();
+
+  if (!strcmp (option, "avx2"))
+    return __builtin_cpu_supports ("avx2");
+  if (!strcmp (option, "avx512"))
+    return __builtin_cpu_supports ("avx512f") &&
+        __builtin_cpu_supports ("avx512bw");
+#endif
+  return FALSE;
+}
@@ -833,12 +833,40 @@ static ResampleFunc resample_funcs[] = {
 # endif
 #endif
 
+/* the SIMD levels in the order their functions are installed, every level
+ * also keeps the functions of the levels before it that the CPU supports */
+static const gchar *simd_names[] = {
+  "c", "sse", "sse2", "sse41", "avx2", "avx512", "neon"
+};
+
+#define N_SIMD_LEVELS G_N_ELEMENTS (simd_names)
+
+static ResampleFunc
+    simd_resample_funcs[N_SIMD_LEVELS][G_N_ELEMENTS (resample_funcs)];
+static InterpolateFunc
+    simd_interpolate_funcs[N_SIMD_LEVELS][G_N_ELEMENTS (interpolate_funcs)];
+
+#if defined HAVE_ORC && !defined DISABLE_ORC
+static void
+simd_mark_supported (gboolean * supported, const gchar * name)
+{
+  gint i;
+
+  for (i = 1; i < N_SIMD_LEVELS; i++) {
+    if (!strcmp (name, simd_names[i]))
+      supported[i] = TRUE;
+  }
+}
+#endif
+
 static void
 audio_resampler_init (void)
 {
   static gsize init_gonce = 0;
 
   if (g_once_init_enter (&init_gonce)) {
+    gboolean supported[N_SIMD_LEVELS] = { TRUE, };
+    gint i;
 
     GST_DEBUG_CATEGORY_INIT (audio_resampler_debug, "audio-resampler", 0,
         "audio-resampler object");
@@ -847,7 +875,6 @@ audio_resampler_init (void)
     orc_init ();
     {
       OrcTarget *target = orc_target_get_default ();
-      gint i;
 
       if (target) {
         const gchar *name;
@@ -863,22 +890,54 @@ audio_resampler_init (void)
           } else
             name = NULL;
 
-          if (name) {
+          if (name)
+            simd_mark_supported (supported, name);
+        }
+      }
+    }
+#endif
+#ifdef CHECK_X86
+    if (audio_resampler_x86_has_avx ("avx2"))
+      simd_mark_supported (supported, "avx2");
+    if (audio_resampler_x86_has_avx ("avx512"))
+      simd_mark_supported (supported, "avx512");
+#endif
+
+    for (i = 0; i < N_SIMD_LEVELS; i++) {
+      if (i > 0 && supported[i]) {
 #ifdef CHECK_X86
-            audio_resampler_check_x86 (name);
+        audio_resampler_check_x86 (simd_names[i]);
 #endif
 #ifdef CHECK_NEON
-            audio_resampler_check_neon (name);
+        audio_resampler_check_neon (simd_names[i]);
 #endif
-          }
-        }
       }
+      memcpy (simd_resample_funcs[i], resample_funcs, sizeof (resample_funcs));
+      memcpy (simd_interpolate_funcs[i], interpolate_funcs,
+          sizeof (interpolate_funcs));
     }
-#endif
     g_once_init_leave (&init_gonce, 1);
   }
 }
 
+static gint
+get_opt_simd (GstStructure * options)
+{
+  const gchar *name;
+  gint i;
+
+  if (options
+      && (name = gst_structure_get_string (options,
+              GST_AUDIO_RESAMPLER_OPT_SIMD))) {
+    for (i = 0; i < N_SIMD_LEVELS; i++) {
+      if (!strcmp (name, simd_names[i]))
+        return i;
+    }
+    GST_WARNING ("unknown SIMD level %s", name);
+  }
+  return N_SIMD_LEVELS - 1;
+}
+
 #define MAKE_DEINTERLEAVE_FUNC(type)                                    \
 static void                                                             \
 deinterleave_ ##type (GstAudioResampler * resampler, gpointer sbuf[],   \
@@ -999,12 +1058,14 @@ alloc_cache_mem (GstAudioResampler * resampler, gint bps, gint n_taps,
 static void
 setup_functions (GstAudioResampler * resampler)
 {
-  gint index, fidx;
+  gint index, fidx, simd;
 
   index = resampler->format_index;
+  simd = get_opt_simd (resampler->options);
+  GST_DEBUG ("using %s functions", simd_names[simd]);
 
   if (resampler->in_rate == resampler->out_rate)
-    resampler->resample = resample_funcs[index];
+    resampler->resample = simd_resample_funcs[simd][index];
   else {
     switch (resampler->filter_interpolation) {
       default:
@@ -1021,7 +1082,7 @@ setup_functions (GstAudioResampler * resampler)
         break;
     }
     GST_DEBUG ("using filter interpolate function %d", index + fidx);
-    resampler->interpolate = interpolate_funcs[index + fidx];
+    resampler->interpolate = simd_interpolate_funcs[simd][index + fidx];
 
     switch (resampler->method) {
       case GST_AUDIO_RESAMPLER_METHOD_NEAREST:
@@ -1042,7 +1103,7 @@ setup_functions (GstAudioResampler * resampler)
         break;
     }
     GST_DEBUG ("using resample function %d", index);
-    resampler->resample = resample_funcs[index];
+    resampler->resample = simd_resample_funcs[simd][index];
   }
 }
 
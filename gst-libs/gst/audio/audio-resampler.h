@@ -153,6 +153,19 @@ typedef enum {
  */
 #define GST_AUDIO_RESAMPLER_OPT_MAX_PHASE_ERROR "GstAudioResampler.max-phase-error"
 
+/**
+ * GST_AUDIO_RESAMPLER_OPT_SIMD:
+ *
+ * G_TYPE_STRING: the highest SIMD instruction set the resampler may use,
+ * one of "c", "sse", "sse2", "sse41", "avx2", "avx512" or "neon". Levels
+ * that the CPU does not support are skipped. Mostly useful to compare the
+ * optimized functions against the plain C versions.
+ * By default the best supported functions are used.
+ *
+ * Since: 1.16
+ */
+#define GST_AUDIO_RESAMPLER_OPT_SIMD "GstAudioResampler.simd"
+
 /**
  * GstAudioResamplerMethod:
  * @GST_AUDIO_RESAMPLER_METHOD_NEAREST: Duplicates the samples when
@@ -32,6 +32,17 @@
  * abstraction for DMA based ringbuffers as well as a pure software
  * implementations.
  *
+ * By default a writer (or reader) that finds the ringbuffer full (or empty)
+ * blocks on a condition variable until the device signals that it processed
+ * a segment with gst_audio_ring_buffer_advance(). For very low latency
+ * configurations the wakeup jitter of this can be avoided by setting the
+ * #GstAudioRingBuffer:lock-free property. In that mode there must only be a
+ * single thread committing or reading samples and a single thread advancing
+ * the ringbuffer. The waiting side first busy-polls the read pointer for up
+ * to #GstAudioRingBuffer:busy-poll-time and only then blocks on the
+ * condition variable, and the advancing side only takes the lock when there
+ * is a blocked waiter. The #GstAudioRingBuffer:latency-histogram property
+ * can be used to compare the handoff latency of both modes.
  */
 
 #include <string.h>
@@ -42,8 +53,41 @@
 GST_DEBUG_CATEGORY_STATIC (gst_audio_ring_buffer_debug);
 #define GST_CAT_DEFAULT gst_audio_ring_buffer_debug
 
+#define GST_AUDIO_RING_BUFFER_GET_PRIVATE(obj)  \
+   (G_TYPE_INSTANCE_GET_PRIVATE ((obj), GST_TYPE_AUDIO_RING_BUFFER, GstAudioRingBufferPrivate))
+
+/* bucket 0 counts handoffs of less than 1us, bucket n > 0 those that took
+ * between 2^(n-1) and 2^n us, the last one everything longer */
+#define LATENCY_HISTOGRAM_SIZE 16
+
+struct _GstAudioRingBufferPrivate
+{
+  gboolean lock_free;
+  GstClockTime busy_poll_time;
+
+  /* ATOMIC, truncated monotonic time in us of the last advance */
+  gint advance_time;
+  /* ATOMIC */
+  gint latency_histogram[LATENCY_HISTOGRAM_SIZE];
+};
+
+#define DEFAULT_LOCK_FREE       FALSE
+#define DEFAULT_BUSY_POLL_TIME  0
+
+enum
+{
+  PROP_0,
+  PROP_LOCK_FREE,
+  PROP_BUSY_POLL_TIME,
+  PROP_LATENCY_HISTOGRAM
+};
+
 static void gst_audio_ring_buffer_dispose (GObject * object);
 static void gst_audio_ring_buffer_finalize (GObject * object);
+static void gst_audio_ring_buffer_set_property (GObject * object,
+    guint prop_id, const GValue * value, GParamSpec * pspec);
+static void gst_audio_ring_buffer_get_property (GObject * object,
+    guint prop_id, GValue * value, GParamSpec * pspec);
 
 static gboolean gst_audio_ring_buffer_pause_unlocked (GstAudioRingBuffer * buf);
 static void default_clear_all (GstAudioRingBuffer * buf);
@@ -66,8 +110,66 @@ gst_audio_ring_buffer_class_init (GstAudioRingBufferClass * klass)
   GST_DEBUG_CATEGORY_INIT (gst_audio_ring_buffer_debug, "ringbuffer", 0,
       "ringbuffer class");
 
+  g_type_class_add_private (klass, sizeof (GstAudioRingBufferPrivate));
+
   gobject_class->dispose = gst_audio_ring_buffer_dispose;
   gobject_class->finalize = gst_audio_ring_buffer_finalize;
+  gobject_class->set_property = gst_audio_ring_buffer_set_property;
+  gobject_class->get_property = gst_audio_ring_buffer_get_property;
+
+  /**
+   * GstAudioRingBuffer:lock-free:
+   *
+   * Use a single-producer/single-consumer mode where writing or reading
+   * samples and advancing the ringbuffer only use atomic operations as long
+   * as the waiting side doesn't block. When the ringbuffer is full (or
+   * empty) the waiting side busy-polls for the next segment for
+   * #GstAudioRingBuffer:busy-poll-time before it blocks on the condition
+   * variable, which avoids the wakeup jitter of the latter.
+   *
+   * Only one thread may commit or read samples and only one thread may
+   * call gst_audio_ring_buffer_advance() in this mode. Should only be
+   * changed while the ringbuffer is not started.
+   *
+   * Since: 1.16
+   */
+  g_object_class_install_property (gobject_class, PROP_LOCK_FREE,
+      g_param_spec_boolean ("lock-free", "Lock Free",
+          "Wait for free segments by polling instead of blocking",
+          DEFAULT_LOCK_FREE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstAudioRingBuffer:busy-poll-time:
+   *
+   * In #GstAudioRingBuffer:lock-free mode, the amount of time to spin on the
+   * read pointer before blocking. Trades CPU time for a lower handoff
+   * latency. Setting it to about the segment duration avoids blocking
+   * altogether when the device is on time.
+   *
+   * Since: 1.16
+   */
+  g_object_class_install_property (gobject_class, PROP_BUSY_POLL_TIME,
+      g_param_spec_uint64 ("busy-poll-time", "Busy Poll Time",
+          "Time to busy-poll for a free segment in lock-free mode (in ns)",
+          0, G_MAXUINT64, DEFAULT_BUSY_POLL_TIME,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstAudioRingBuffer:latency-histogram:
+   *
+   * Histogram of the time between the device advancing the ringbuffer and
+   * a waiting writer or reader continuing, since the ringbuffer was last
+   * acquired. The "histogram" field of the structure is an array of
+   * #guint counts where entry 0 counts handoffs of less than 1 microsecond
+   * and entry n those that took less than 2^n microseconds. The last entry
+   * counts all longer ones.
+   *
+   * Since: 1.16
+   */
+  g_object_class_install_property (gobject_class, PROP_LATENCY_HISTOGRAM,
+      g_param_spec_boxed ("latency-histogram", "Latency Histogram",
+          "Histogram of the segment handoff latency", GST_TYPE_STRUCTURE,
+          G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
 
   gstaudioringbuffer_class->clear_all = GST_DEBUG_FUNCPTR (default_clear_all);
   gstaudioringbuffer_class->commit = GST_DEBUG_FUNCPTR (default_commit);
@@ -76,6 +178,10 @@ gst_audio_ring_buffer_class_init (GstAudioRingBufferClass * klass)
 static void
 gst_audio_ring_buffer_init (GstAudioRingBuffer * ringbuffer)
 {
+  ringbuffer->priv = GST_AUDIO_RING_BUFFER_GET_PRIVATE (ringbuffer);
+  ringbuffer->priv->lock_free = DEFAULT_LOCK_FREE;
+  ringbuffer->priv->busy_poll_time = DEFAULT_BUSY_POLL_TIME;
+
   ringbuffer->open = FALSE;
   ringbuffer->acquired = FALSE;
   ringbuffer->state = GST_AUDIO_RING_BUFFER_STATE_STOPPED;
@@ -113,6 +219,80 @@ gst_audio_ring_buffer_finalize (GObject * object)
       (ringbuffer));
 }
 
+static GstStructure *
+gst_audio_ring_buffer_get_latency_histogram (GstAudioRingBuffer * buf)
+{
+  GstStructure *s;
+  GValue histogram = G_VALUE_INIT;
+  GValue count = G_VALUE_INIT;
+  gint i;
+
+  g_value_init (&histogram, GST_TYPE_ARRAY);
+  g_value_init (&count, G_TYPE_UINT);
+
+  for (i = 0; i < LATENCY_HISTOGRAM_SIZE; i++) {
+    g_value_set_uint (&count,
+        g_atomic_int_get (&buf->priv->latency_histogram[i]));
+    gst_value_array_append_value (&histogram, &count);
+  }
+
+  s = gst_structure_new_empty ("application/x-audio-ring-buffer-latency");
+  gst_structure_take_value (s, "histogram", &histogram);
+  g_value_unset (&count);
+
+  return s;
+}
+
+static void
+gst_audio_ring_buffer_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec)
+{
+  GstAudioRingBuffer *ringbuffer = GST_AUDIO_RING_BUFFER (object);
+
+  switch (prop_id) {
+    case PROP_LOCK_FREE:
+      GST_OBJECT_LOCK (ringbuffer);
+      ringbuffer->priv->lock_free = g_value_get_boolean (value);
+      GST_OBJECT_UNLOCK (ringbuffer);
+      break;
+    case PROP_BUSY_POLL_TIME:
+      GST_OBJECT_LOCK (ringbuffer);
+      ringbuffer->priv->busy_poll_time = g_value_get_uint64 (value);
+      GST_OBJECT_UNLOCK (ringbuffer);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+static void
+gst_audio_ring_buffer_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec)
+{
+  GstAudioRingBuffer *ringbuffer = GST_AUDIO_RING_BUFFER (object);
+
+  switch (prop_id) {
+    case PROP_LOCK_FREE:
+      GST_OBJECT_LOCK (ringbuffer);
+      g_value_set_boolean (value, ringbuffer->priv->lock_free);
+      GST_OBJECT_UNLOCK (ringbuffer);
+      break;
+    case PROP_BUSY_POLL_TIME:
+      GST_OBJECT_LOCK (ringbuffer);
+      g_value_set_uint64 (value, ringbuffer->priv->busy_poll_time);
+      GST_OBJECT_UNLOCK (ringbuffer);
+      break;
+    case PROP_LATENCY_HISTOGRAM:
+      g_value_take_boxed (value,
+          gst_audio_ring_buffer_get_latency_histogram (ringbuffer));
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
 #ifndef GST_DISABLE_GST_DEBUG
 static const gchar *format_type_names[] = {
   "raw",
@@ -616,6 +796,8 @@ gst_audio_ring_buffer_acquire (GstAudioRingBuffer * buf,
 
   buf->acquired = TRUE;
   buf->need_reorder = FALSE;
+  for (i = 0; i < LATENCY_HISTOGRAM_SIZE; i++)
+    g_atomic_int_set (&buf->priv->latency_histogram[i], 0);
 
   rclass = GST_AUDIO_RING_BUFFER_GET_CLASS (buf);
   if (G_LIKELY (rclass->acquire))
@@ -1326,12 +1508,91 @@ gst_audio_ring_buffer_clear_all (GstAudioRingBuffer * buf)
 }
 
 
+static void
+record_handoff_latency (GstAudioRingBuffer * buf)
+{
+  guint32 latency;
+  guint bucket;
+
+  /* only the difference matters so wrapping around is fine */
+  latency = (guint32) g_get_monotonic_time () -
+      (guint32) g_atomic_int_get (&buf->priv->advance_time);
+  bucket = MIN (g_bit_storage (latency), LATENCY_HISTOGRAM_SIZE - 1);
+  if (latency == 0)
+    bucket = 0;
+
+  g_atomic_int_inc (&buf->priv->latency_histogram[bucket]);
+}
+
+/* single-producer/single-consumer variant of wait_segment(), spins on the
+ * read pointer for up to busy-poll-time and then parks on the condition
+ * variable until gst_audio_ring_buffer_advance() moves it away from
+ * @segdone */
+static gboolean
+wait_segment_lock_free (GstAudioRingBuffer * buf, gint segdone)
+{
+  GstAudioRingBufferPrivate *priv = buf->priv;
+  gint64 spin_until;
+  gboolean waited = FALSE;
+
+  if (G_UNLIKELY (g_atomic_int_get (&buf->state) !=
+          GST_AUDIO_RING_BUFFER_STATE_STARTED)) {
+    if (G_UNLIKELY (!g_atomic_int_get (&buf->may_start))) {
+      GST_DEBUG_OBJECT (buf, "not allowed to start");
+      return FALSE;
+    }
+    GST_DEBUG_OBJECT (buf, "start!");
+    gst_audio_ring_buffer_start (buf);
+  }
+
+  spin_until = g_get_monotonic_time () + priv->busy_poll_time / GST_USECOND;
+
+  while (g_atomic_int_get (&buf->segdone) == segdone) {
+    if (G_UNLIKELY (g_atomic_int_get (&buf->flushing))) {
+      GST_DEBUG_OBJECT (buf, "flushing");
+      return FALSE;
+    }
+    if (G_UNLIKELY (g_atomic_int_get (&buf->state) !=
+            GST_AUDIO_RING_BUFFER_STATE_STARTED)) {
+      GST_DEBUG_OBJECT (buf, "stopped processing");
+      return FALSE;
+    }
+
+    waited = TRUE;
+    if (g_get_monotonic_time () < spin_until)
+      continue;
+
+    /* park until the next advance. The waiting flag must be set before
+     * checking the read pointer again, advance() only signals when it
+     * sees the flag */
+    GST_OBJECT_LOCK (buf);
+    g_atomic_int_set (&buf->waiting, 1);
+    if (g_atomic_int_get (&buf->segdone) == segdone && !buf->flushing &&
+        g_atomic_int_get (&buf->state) == GST_AUDIO_RING_BUFFER_STATE_STARTED) {
+      GST_DEBUG_OBJECT (buf, "waiting..");
+      GST_AUDIO_RING_BUFFER_WAIT (buf);
+    }
+    g_atomic_int_compare_and_exchange (&buf->waiting, 1, 0);
+    GST_OBJECT_UNLOCK (buf);
+  }
+
+  /* only count handoffs where we actually had to wait for the device, like
+   * in the locked mode */
+  if (waited)
+    record_handoff_latency (buf);
+
+  return TRUE;
+}
+
 static gboolean
-wait_segment (GstAudioRingBuffer * buf)
+wait_segment (GstAudioRingBuffer * buf, gint segdone)
 {
   gint segments;
   gboolean wait = TRUE;
 
+  if (buf->priv->lock_free)
+    return wait_segment_lock_free (buf, segdone);
+
   /* buffer must be started now or we deadlock since nobody is reading */
   if (G_UNLIKELY (g_atomic_int_get (&buf->state) !=
           GST_AUDIO_RING_BUFFER_STATE_STARTED)) {
@@ -1369,6 +1630,8 @@ wait_segment (GstAudioRingBuffer * buf)
       if (G_UNLIKELY (g_atomic_int_get (&buf->state) !=
               GST_AUDIO_RING_BUFFER_STATE_STARTED))
         goto not_started;
+
+      record_handoff_latency (buf);
     }
   }
   GST_OBJECT_UNLOCK (buf);
@@ -1588,7 +1851,7 @@ default_commit (GstAudioRingBuffer * buf, guint64 * sample,
       }
 
       /* else we need to wait for the segment to become writable. */
-      if (!wait_segment (buf))
+      if (!wait_segment (buf, segdone + buf->segbase))
         goto not_started;
     }
 
@@ -1804,7 +2067,7 @@ gst_audio_ring_buffer_read (GstAudioRingBuffer * buf, guint64 sample,
         break;
 
       /* else we need to wait for the segment to become readable. */
-      if (!wait_segment (buf))
+      if (!wait_segment (buf, segdone + buf->segbase))
         goto not_started;
     }
 
@@ -1924,6 +2187,9 @@ gst_audio_ring_buffer_advance (GstAudioRingBuffer * buf, guint advance)
 {
   g_return_if_fail (GST_IS_AUDIO_RING_BUFFER (buf));
 
+  g_atomic_int_set (&buf->priv->advance_time,
+      (gint) (guint32) g_get_monotonic_time ());
+
   /* update counter */
   g_atomic_int_add (&buf->segdone, advance);
 
@@ -39,6 +39,7 @@ G_BEGIN_DECLS
 
 typedef struct _GstAudioRingBuffer GstAudioRingBuffer;
 typedef struct _GstAudioRingBufferClass GstAudioRingBufferClass;
+typedef struct _GstAudioRingBufferPrivate GstAudioRingBufferPrivate;
 typedef struct _GstAudioRingBufferSpec GstAudioRingBufferSpec;
 
 /**
@@ -216,7 +217,9 @@ struct _GstAudioRingBuffer {
   GDestroyNotify              cb_data_notify;
 
   /*< private >*/
-  gpointer _gst_reserved[GST_PADDING - 1];
+  GstAudioRingBufferPrivate  *priv;
+
+  gpointer _gst_reserved[GST_PADDING - 2];
 };
 
 /**
@@ -25,6 +25,7 @@
 #include <string.h>
 
 #include "gstglbuffer.h"
+#include "gstglbuffer_private.h"
 
 #include "gstglcontext.h"
 #include "gstglfuncs.h"
@@ -45,6 +46,15 @@
 /* Implementation notes:
  *
  * Currently does not take into account GLES2 differences (no mapbuffer)
+ *
+ * Buffers allocated with GST_GL_ALLOCATION_PARAMS_ALLOC_FLAG_BUFFER_PERSISTENT
+ * are created with glBufferStorage() and mapped once, persistently and
+ * coherently.  The mapping is used directly as the memory's data pointer so
+ * CPU maps don't need any copies.  A fence is inserted whenever a GL mapping
+ * is released and CPU access waits on it so that we never write to data the
+ * GPU is still reading from (or read data it is still writing).  CPU maps from
+ * other threads poll the fence before going to the GL thread so that waiting
+ * for the GPU doesn't keep the GL thread from running other work.
  */
 
 #define USING_OPENGL(context) (gst_gl_context_check_gl_version (context, GST_GL_API_OPENGL, 1, 0))
@@ -66,26 +76,179 @@
 #ifndef GL_COPY_WRITE_BUFFER
 #define GL_COPY_WRITE_BUFFER 0x8F37
 #endif
+#ifndef GL_MAP_PERSISTENT_BIT
+#define GL_MAP_PERSISTENT_BIT 0x0040
+#endif
+#ifndef GL_MAP_COHERENT_BIT
+#define GL_MAP_COHERENT_BIT 0x0080
+#endif
+#ifndef GL_SYNC_GPU_COMMANDS_COMPLETE
+#define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+#endif
+#ifndef GL_SYNC_FLUSH_COMMANDS_BIT
+#define GL_SYNC_FLUSH_COMMANDS_BIT 0x00000001
+#endif
+#ifndef GL_TIMEOUT_EXPIRED
+#define GL_TIMEOUT_EXPIRED 0x911B
+#endif
+
+/* usec between two polls of a fence */
+#define SYNC_POLL_INTERVAL 100
 
 GST_DEBUG_CATEGORY_STATIC (GST_CAT_GL_BUFFER);
 #define GST_CAT_DEFUALT GST_CAT_GL_BUFFER
 
 static GstAllocator *_gl_buffer_allocator;
+static GstMemoryMapFullFunction _gl_base_mem_map_full;
+
+#define PERSISTENT_MAP_FLAGS (GL_MAP_READ_BIT | GL_MAP_WRITE_BIT | \
+    GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT)
+
+/* GstGLBuffer is only ever allocated by us so we can keep the persistent
+ * mapping state out of the public structure */
+typedef struct
+{
+  GstGLBuffer buffer;
+
+  gboolean persistent;
+  gpointer persistent_data;
+  /* GLsync for the last GPU access to persistent_data */
+  gpointer sync;
+} GstGLBufferImpl;
+
+static gboolean
+_gl_buffer_create_persistent (GstGLBufferImpl * impl)
+{
+  GstGLBuffer *gl_mem = &impl->buffer;
+  const GstGLFuncs *gl = gl_mem->mem.context->gl_vtable;
+
+  if (!gl->BufferStorage || !gl->MapBufferRange || !gl->FenceSync)
+    return FALSE;
+
+  gl->BufferStorage (gl_mem->target, gl_mem->mem.mem.maxsize, NULL,
+      PERSISTENT_MAP_FLAGS);
+  impl->persistent_data = gl->MapBufferRange (gl_mem->target, 0,
+      gl_mem->mem.mem.maxsize, PERSISTENT_MAP_FLAGS);
+  if (!impl->persistent_data)
+    return FALSE;
+
+  gl_mem->mem.data = impl->persistent_data;
+
+  GST_CAT_LOG (GST_CAT_GL_BUFFER, "persistently mapped buffer id %u at %p",
+      gl_mem->id, impl->persistent_data);
+
+  return TRUE;
+}
 
 static gboolean
 _gl_buffer_create (GstGLBuffer * gl_mem, GError ** error)
 {
+  GstGLBufferImpl *impl = (GstGLBufferImpl *) gl_mem;
   const GstGLFuncs *gl = gl_mem->mem.context->gl_vtable;
 
   gl->GenBuffers (1, &gl_mem->id);
   gl->BindBuffer (gl_mem->target, gl_mem->id);
-  gl->BufferData (gl_mem->target, gl_mem->mem.mem.maxsize, NULL,
-      gl_mem->usage_hints);
+  if (impl->persistent && !_gl_buffer_create_persistent (impl)) {
+    GST_CAT_DEBUG (GST_CAT_GL_BUFFER, "persistent mapping not available, "
+        "falling back to mutable storage");
+    impl->persistent = FALSE;
+    /* immutable storage might already have been specified */
+    gl->BindBuffer (gl_mem->target, 0);
+    gl->DeleteBuffers (1, &gl_mem->id);
+    gl->GenBuffers (1, &gl_mem->id);
+    gl->BindBuffer (gl_mem->target, gl_mem->id);
+  }
+  if (!impl->persistent)
+    gl->BufferData (gl_mem->target, gl_mem->mem.mem.maxsize, NULL,
+        gl_mem->usage_hints);
   gl->BindBuffer (gl_mem->target, 0);
 
   return TRUE;
 }
 
+/* must be called with the context current */
+static void
+_gl_buffer_wait_sync (GstGLBufferImpl * impl)
+{
+  const GstGLFuncs *gl = impl->buffer.mem.context->gl_vtable;
+  GLenum res;
+
+  if (!impl->sync)
+    return;
+
+  GST_CAT_TRACE (GST_CAT_GL_BUFFER, "waiting on sync object %p", impl->sync);
+  do {
+    res = gl->ClientWaitSync ((GLsync) impl->sync, GL_SYNC_FLUSH_COMMANDS_BIT,
+        1000000000 /* 1s */ );
+  } while (res == GL_TIMEOUT_EXPIRED);
+
+  gl->DeleteSync ((GLsync) impl->sync);
+  impl->sync = NULL;
+}
+
+/* must be called with the context current */
+static void
+_gl_buffer_set_sync (GstGLBufferImpl * impl)
+{
+  const GstGLFuncs *gl = impl->buffer.mem.context->gl_vtable;
+
+  if (impl->sync)
+    gl->DeleteSync ((GLsync) impl->sync);
+  impl->sync = (gpointer) gl->FenceSync (GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+struct sync_poll
+{
+  GstGLBufferImpl *impl;
+  gboolean signaled;
+};
+
+static void
+_gl_buffer_poll_sync (GstGLContext * context, struct sync_poll *poll)
+{
+  GstGLBufferImpl *impl = poll->impl;
+  const GstGLFuncs *gl = context->gl_vtable;
+
+  poll->signaled = TRUE;
+  if (!impl->sync)
+    return;
+
+  if (gl->ClientWaitSync ((GLsync) impl->sync, GL_SYNC_FLUSH_COMMANDS_BIT,
+          0) == GL_TIMEOUT_EXPIRED) {
+    poll->signaled = FALSE;
+    return;
+  }
+
+  gl->DeleteSync ((GLsync) impl->sync);
+  impl->sync = NULL;
+}
+
+/* Waits for the last GPU access to a persistent buffer to complete.  Only the
+ * zero-timeout polls run on the GL thread, the waiting happens on the calling
+ * thread.  On the GL thread itself there is nothing else to run in the
+ * meantime and the CPU map blocks on the fence instead. */
+void
+gst_gl_buffer_wait_persistent (GstGLBuffer * buffer)
+{
+  GstGLBufferImpl *impl = (GstGLBufferImpl *) buffer;
+  GstGLContext *context = buffer->mem.context;
+  struct sync_poll poll = { impl, FALSE };
+
+  if (!impl->persistent || gst_gl_context_get_current () == context)
+    return;
+
+  while (TRUE) {
+    gst_gl_context_thread_add (context,
+        (GstGLContextThreadFunc) _gl_buffer_poll_sync, &poll);
+    if (poll.signaled)
+      break;
+
+    GST_CAT_TRACE (GST_CAT_GL_BUFFER, "buffer id %u still in use by the GPU",
+        buffer->id);
+    g_usleep (SYNC_POLL_INTERVAL);
+  }
+}
+
 struct create_data
 {
   GstGLBuffer *mem;
@@ -110,21 +273,39 @@ _gl_buffer_init (GstGLBuffer * mem, GstAllocator * allocator,
 static GstGLBuffer *
 _gl_buffer_new (GstAllocator * allocator, GstMemory * parent,
     GstGLContext * context, guint gl_target, guint gl_usage,
-    GstAllocationParams * params, gsize size)
+    gboolean persistent, GstAllocationParams * params, gsize size)
 {
-  GstGLBuffer *ret = g_new0 (GstGLBuffer, 1);
-  _gl_buffer_init (ret, allocator, parent, context, gl_target, gl_usage,
-      params, size);
+  GstGLBufferImpl *ret = g_new0 (GstGLBufferImpl, 1);
 
-  return ret;
+  /* needs to be set before _gl_buffer_create() is called */
+  ret->persistent = persistent;
+  _gl_buffer_init (&ret->buffer, allocator, parent, context, gl_target,
+      gl_usage, params, size);
+
+  return &ret->buffer;
 }
 
 static gpointer
 gst_gl_buffer_cpu_access (GstGLBuffer * mem, GstMapInfo * info, gsize size)
 {
+  GstGLBufferImpl *impl = (GstGLBufferImpl *) mem;
   const GstGLFuncs *gl = mem->mem.context->gl_vtable;
   gpointer data, ret;
 
+  if (impl->persistent) {
+    /* no-op unless mapped from the GL thread, see _gl_buffer_mem_map_full() */
+    _gl_buffer_wait_sync (impl);
+
+    /* the data pointer may have been replaced with wrapped memory */
+    if (mem->mem.data != impl->persistent_data
+        && GST_MEMORY_FLAG_IS_SET (mem,
+            GST_GL_BASE_MEMORY_TRANSFER_NEED_DOWNLOAD)
+        && (info->flags & GST_MAP_READ) != 0)
+      memcpy (mem->mem.data, impl->persistent_data, size);
+
+    return mem->mem.data;
+  }
+
   if (!gst_gl_base_memory_alloc_data (GST_GL_BASE_MEMORY_CAST (mem)))
     return NULL;
 
@@ -168,6 +349,7 @@ static void
 gst_gl_buffer_upload_cpu_write (GstGLBuffer * mem, GstMapInfo * info,
     gsize size)
 {
+  GstGLBufferImpl *impl = (GstGLBufferImpl *) mem;
   const GstGLFuncs *gl = mem->mem.context->gl_vtable;
   gpointer data;
 
@@ -175,6 +357,19 @@ gst_gl_buffer_upload_cpu_write (GstGLBuffer * mem, GstMapInfo * info,
     /* no data pointer has been written */
     return;
 
+  if (impl->persistent) {
+    /* CPU writes to the coherent mapping are already visible, only wrapped
+     * memory needs to be copied over */
+    if (mem->mem.data != impl->persistent_data
+        && (GST_MEMORY_FLAG_IS_SET (mem,
+                GST_GL_BASE_MEMORY_TRANSFER_NEED_UPLOAD)
+            || (mem->mem.map_flags & GST_MAP_WRITE) != 0)) {
+      _gl_buffer_wait_sync (impl);
+      memcpy (impl->persistent_data, mem->mem.data, size);
+    }
+    return;
+  }
+
   /* The extra data pointer indirection/memcpy is needed for coherent across
    * concurrent map()'s in both GL and CPU */
   /* FIXME: uploading potentially half-written data for libav pushing READWRITE
@@ -202,6 +397,15 @@ gst_gl_buffer_upload_cpu_write (GstGLBuffer * mem, GstMapInfo * info,
   }
 }
 
+static gpointer
+_gl_buffer_mem_map_full (GstGLBuffer * mem, GstMapInfo * info, gsize size)
+{
+  if ((info->flags & GST_MAP_GL) == 0)
+    gst_gl_buffer_wait_persistent (mem);
+
+  return _gl_base_mem_map_full ((GstMemory *) mem, info, size);
+}
+
 static gpointer
 _gl_buffer_map (GstGLBuffer * mem, GstMapInfo * info, gsize size)
 {
@@ -223,10 +427,14 @@ _gl_buffer_map (GstGLBuffer * mem, GstMapInfo * info, gsize size)
 static void
 _gl_buffer_unmap (GstGLBuffer * mem, GstMapInfo * info)
 {
+  GstGLBufferImpl *impl = (GstGLBufferImpl *) mem;
   const GstGLFuncs *gl = mem->mem.context->gl_vtable;
 
   if ((info->flags & GST_MAP_GL) != 0) {
     gl->BindBuffer (mem->target, 0);
+    /* any GL commands accessing the buffer have been issued by now */
+    if (impl->persistent)
+      _gl_buffer_set_sync (impl);
   }
   /* XXX: optimistically transfer data */
 }
@@ -287,7 +495,8 @@ _gl_buffer_copy (GstGLBuffer * src, gssize offset, gssize size)
   GstGLBuffer *dest = NULL;
 
   dest = _gl_buffer_new (allocator, NULL, src->mem.context,
-      src->target, src->usage_hints, &params, src->mem.mem.maxsize);
+      src->target, src->usage_hints, ((GstGLBufferImpl *) src)->persistent,
+      &params, src->mem.mem.maxsize);
 
   /* If not doing a full copy, then copy to sysmem, the 2D represention of the
    * texture would become wrong */
@@ -325,9 +534,17 @@ _gl_buffer_alloc (GstAllocator * allocator, gsize size,
 static void
 _gl_buffer_destroy (GstGLBuffer * mem)
 {
+  GstGLBufferImpl *impl = (GstGLBufferImpl *) mem;
   const GstGLFuncs *gl = mem->mem.context->gl_vtable;
 
+  if (impl->sync) {
+    gl->DeleteSync ((GLsync) impl->sync);
+    impl->sync = NULL;
+  }
+
+  /* deleting the buffer also releases the persistent mapping */
   gl->DeleteBuffers (1, &mem->id);
+  impl->persistent_data = NULL;
 }
 
 static void
@@ -409,6 +626,7 @@ _gl_buffer_alloc_mem (GstGLBufferAllocator * allocator,
 
   return _gl_buffer_new (GST_ALLOCATOR (allocator), NULL,
       params->parent.context, params->gl_target, params->gl_usage,
+      (alloc_flags & GST_GL_ALLOCATION_PARAMS_ALLOC_FLAG_BUFFER_PERSISTENT) != 0,
       params->parent.alloc_params, params->parent.alloc_size);
 }
 
@@ -441,6 +659,10 @@ gst_gl_buffer_allocator_init (GstGLBufferAllocator * allocator)
 
   alloc->mem_type = GST_GL_BUFFER_ALLOCATOR_NAME;
 
+  /* wait for the GPU before going to the GL thread */
+  _gl_base_mem_map_full = alloc->mem_map_full;
+  alloc->mem_map_full = (GstMemoryMapFullFunction) _gl_buffer_mem_map_full;
+
   GST_OBJECT_FLAG_SET (allocator, GST_ALLOCATOR_FLAG_CUSTOM_ALLOC);
 }
 
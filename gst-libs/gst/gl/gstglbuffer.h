@@ -67,6 +67,22 @@ GType gst_gl_buffer_allocation_params_get_type (void);
  */
 #define GST_GL_ALLOCATION_PARAMS_ALLOC_FLAG_BUFFER (1 << 4)
 
+/**
+ * GST_GL_ALLOCATION_PARAMS_ALLOC_FLAG_BUFFER_PERSISTENT:
+ *
+ * GL allocation flag requesting a GL buffer with immutable storage that stays
+ * persistently and coherently mapped for its whole lifetime.  CPU access then
+ * only waits on a fence for the last GPU access instead of mapping, copying
+ * and unmapping the buffer every time.  Requires OpenGL 4.4 or the
+ * buffer_storage extension, ignored otherwise.
+ *
+ * Also accepted in the #GstGLVideoAllocationParams of a #GstGLMemoryPBO, where
+ * it applies to the memory's pbo.
+ *
+ * Since: 1.16
+ */
+#define GST_GL_ALLOCATION_PARAMS_ALLOC_FLAG_BUFFER_PERSISTENT (1 << 5)
+
 /**
  * GstGLBufferAllocationParams:
  * @parent: parent object
@@ -28,6 +28,7 @@
 #include "gstglmemorypbo.h"
 
 #include "gstglbuffer.h"
+#include "gstglbuffer_private.h"
 #include "gstglcontext.h"
 #include "gstglfuncs.h"
 #include "gstglutils.h"
@@ -49,6 +50,12 @@
  * PBO transfer's are implemented using GstGLBuffer.  We just need to
  * ensure that the texture data is written/read to/from before/after calling
  * map (mem->pbo, READ) which performs the pbo buffer transfer.
+ *
+ * When allocated with GST_GL_ALLOCATION_PARAMS_ALLOC_FLAG_BUFFER_PERSISTENT
+ * and where supported, the pbo is persistently mapped and a CPU map of the
+ * memory returns that mapping directly, i.e. producers write straight into GL
+ * memory.  The GstGLBuffer fences the GPU accesses so a GstGLBufferPool of
+ * these memories acts as a ring of staging buffers.
  */
 
 #define USING_OPENGL(context) (gst_gl_context_check_gl_version (context, GST_GL_API_OPENGL, 1, 0))
@@ -72,6 +79,17 @@ GST_DEBUG_CATEGORY_STATIC (GST_CAT_GL_MEMORY);
 #define GST_CAT_DEFAULT GST_CAT_GL_MEMORY
 
 static GstAllocator *_gl_allocator;
+static GstMemoryMapFullFunction _gl_base_mem_map_full;
+
+/* GstGLMemoryPBO is only ever allocated by us so we can keep whether the pbo
+ * is persistent out of the public structure */
+typedef struct
+{
+  GstGLMemoryPBO mem;
+
+  /* needs to be set before _gl_mem_create() is called */
+  gboolean persistent;
+} GstGLMemoryPBOImpl;
 
 /* compatability definitions... */
 #ifndef GL_PIXEL_PACK_BUFFER
@@ -203,6 +221,9 @@ _gl_mem_create (GstGLMemoryPBO * gl_mem, GError ** error)
         gst_gl_buffer_allocation_params_new (context,
         GST_MEMORY_CAST (gl_mem)->size, &alloc_params, GL_PIXEL_UNPACK_BUFFER,
         GL_STREAM_DRAW);
+    if (((GstGLMemoryPBOImpl *) gl_mem)->persistent)
+      params->parent.alloc_flags |=
+          GST_GL_ALLOCATION_PARAMS_ALLOC_FLAG_BUFFER_PERSISTENT;
 
     /* FIXME: lazy init this for resource constrained platforms
      * Will need to fix pbo detection based on the existence of the mem.id then */
@@ -576,7 +597,9 @@ _gl_mem_copy (GstGLMemoryPBO * src, gssize offset, gssize size)
         size);
   }
 
-  dest = (GstMemory *) g_new0 (GstGLMemoryPBO, 1);
+  dest = (GstMemory *) g_new0 (GstGLMemoryPBOImpl, 1);
+  ((GstGLMemoryPBOImpl *) dest)->persistent =
+      ((GstGLMemoryPBOImpl *) src)->persistent;
   gst_gl_memory_init (GST_GL_MEMORY_CAST (dest), allocator, NULL,
       src->mem.mem.context, src->mem.tex_target, src->mem.tex_format, &params,
       &src->mem.info, src->mem.plane, &src->mem.valign, NULL, NULL);
@@ -647,7 +670,9 @@ _gl_mem_pbo_alloc (GstGLBaseMemoryAllocator * allocator,
   g_return_val_if_fail (alloc_flags & GST_GL_ALLOCATION_PARAMS_ALLOC_FLAG_VIDEO,
       NULL);
 
-  mem = g_new0 (GstGLMemoryPBO, 1);
+  mem = (GstGLMemoryPBO *) g_new0 (GstGLMemoryPBOImpl, 1);
+  ((GstGLMemoryPBOImpl *) mem)->persistent =
+      (alloc_flags & GST_GL_ALLOCATION_PARAMS_ALLOC_FLAG_BUFFER_PERSISTENT) != 0;
 
   if (alloc_flags & GST_GL_ALLOCATION_PARAMS_ALLOC_FLAG_WRAP_GPU_HANDLE) {
     mem->mem.tex_id = GPOINTER_TO_UINT (params->parent.gl_handle);
@@ -675,6 +700,17 @@ _gl_mem_pbo_alloc (GstGLBaseMemoryAllocator * allocator,
   return mem;
 }
 
+static gpointer
+_gl_mem_map_full (GstGLMemoryPBO * gl_mem, GstMapInfo * info, gsize size)
+{
+  /* the pbo is mapped from the GL thread, wait for the GPU to release it
+   * before going there */
+  if ((info->flags & GST_MAP_GL) == 0 && gl_mem->pbo)
+    gst_gl_buffer_wait_persistent (gl_mem->pbo);
+
+  return _gl_base_mem_map_full ((GstMemory *) gl_mem, info, size);
+}
+
 static void
 gst_gl_memory_pbo_allocator_class_init (GstGLMemoryPBOAllocatorClass * klass)
 {
@@ -703,6 +739,9 @@ gst_gl_memory_pbo_allocator_init (GstGLMemoryPBOAllocator * allocator)
 
   alloc->mem_type = GST_GL_MEMORY_PBO_ALLOCATOR_NAME;
 
+  _gl_base_mem_map_full = alloc->mem_map_full;
+  alloc->mem_map_full = (GstMemoryMapFullFunction) _gl_mem_map_full;
+
   GST_OBJECT_FLAG_SET (allocator, GST_ALLOCATOR_FLAG_CUSTOM_ALLOC);
 }
 
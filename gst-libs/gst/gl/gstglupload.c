@@ -111,6 +111,9 @@ struct _GstGLUploadPrivate
   const UploadMethod *method;
   gpointer method_impl;
   int method_i;
+
+  /* upload through persistently mapped pbos */
+  gboolean persistent_buffers;
 };
 
 static GstCaps *
@@ -380,6 +383,18 @@ _gl_memory_upload_propose_allocation (gpointer impl, GstQuery * decide_query,
     gst_buffer_pool_config_set_params (config, caps, size, 0, 0);
     gst_buffer_pool_config_add_option (config,
         GST_BUFFER_POOL_OPTION_GL_SYNC_META);
+    if (upload->upload->priv->persistent_buffers) {
+      GstGLVideoAllocationParams *params;
+
+      /* upstream writes straight into the mapped pbos */
+      params = gst_gl_video_allocation_params_new (upload->upload->context,
+          NULL, &info, 0, NULL, GST_GL_TEXTURE_TARGET_2D, 0);
+      params->parent.alloc_flags |=
+          GST_GL_ALLOCATION_PARAMS_ALLOC_FLAG_BUFFER_PERSISTENT;
+      gst_buffer_pool_config_set_gl_allocation_params (config,
+          (GstGLAllocationParams *) params);
+      gst_gl_allocation_params_free ((GstGLAllocationParams *) params);
+    }
     if (upload->upload->priv->out_caps) {
       GstGLTextureTarget target;
       const gchar *target_pool_option_str;
@@ -997,6 +1012,10 @@ struct RawUpload
   GstGLUpload *upload;
   struct RawUploadFrame *in_frame;
   GstGLVideoAllocationParams *params;
+
+  /* ring of persistent pbos when uploading with persistent buffers */
+  GstBufferPool *pool;
+  GstVideoInfo pool_info;
 };
 
 static struct RawUploadFrame *
@@ -1132,6 +1151,120 @@ _raw_data_upload_propose_allocation (gpointer impl, GstQuery * decide_query,
   gst_query_add_allocation_meta (query, GST_VIDEO_META_API_TYPE, 0);
 }
 
+static void
+_raw_data_upload_clear_pool (struct RawUpload *raw)
+{
+  if (raw->pool) {
+    gst_buffer_pool_set_active (raw->pool, FALSE);
+    gst_object_unref (raw->pool);
+    raw->pool = NULL;
+  }
+}
+
+static gboolean
+_raw_data_upload_ensure_pool (struct RawUpload *raw)
+{
+  GstGLContext *context = raw->upload->context;
+  GstVideoInfo *in_info = &raw->upload->priv->in_info;
+  GstGLVideoAllocationParams *params;
+  GstStructure *config;
+  GstCaps *caps;
+
+  if (raw->pool && gst_video_info_is_equal (&raw->pool_info, in_info))
+    return TRUE;
+
+  _raw_data_upload_clear_pool (raw);
+
+  caps = gst_video_info_to_caps (in_info);
+  raw->pool = gst_gl_buffer_pool_new (context);
+  config = gst_buffer_pool_get_config (raw->pool);
+  gst_buffer_pool_config_set_params (config, caps, in_info->size, 0, 0);
+  gst_buffer_pool_config_add_option (config,
+      GST_BUFFER_POOL_OPTION_GL_SYNC_META);
+  gst_buffer_pool_config_add_option (config,
+      GST_BUFFER_POOL_OPTION_GL_TEXTURE_TARGET_2D);
+  gst_caps_unref (caps);
+
+  params = gst_gl_video_allocation_params_new (context, NULL, in_info, 0,
+      NULL, GST_GL_TEXTURE_TARGET_2D, 0);
+  params->parent.alloc_flags |=
+      GST_GL_ALLOCATION_PARAMS_ALLOC_FLAG_BUFFER_PERSISTENT;
+  gst_buffer_pool_config_set_gl_allocation_params (config,
+      (GstGLAllocationParams *) params);
+  gst_gl_allocation_params_free ((GstGLAllocationParams *) params);
+
+  if (!gst_buffer_pool_set_config (raw->pool, config)
+      || !gst_buffer_pool_set_active (raw->pool, TRUE)) {
+    GST_ERROR_OBJECT (raw->upload, "Failed to configure persistent pool");
+    gst_object_unref (raw->pool);
+    raw->pool = NULL;
+    return FALSE;
+  }
+  raw->pool_info = *in_info;
+
+  return TRUE;
+}
+
+/* copies the frame into the next free buffer of the ring.  Buffers return to
+ * the pool once downstream is done with them, the CPU map of the pbos waits
+ * for pending GPU reads and the sync meta orders the texture upload after
+ * downstream's last use */
+static GstGLUploadReturn
+_raw_data_upload_perform_persistent (struct RawUpload *raw,
+    GstBuffer ** outbuf)
+{
+  GstVideoInfo *in_info = &raw->upload->priv->in_info;
+  GstGLContext *context = raw->upload->context;
+  GstGLSyncMeta *sync_meta;
+  GstVideoFrame out_frame;
+  gboolean copied;
+  guint i, n_mem;
+
+  if (!_raw_data_upload_ensure_pool (raw))
+    return GST_GL_UPLOAD_ERROR;
+
+  if (gst_buffer_pool_acquire_buffer (raw->pool, outbuf,
+          NULL) != GST_FLOW_OK) {
+    GST_ERROR_OBJECT (raw->upload, "Failed to acquire persistent buffer");
+    return GST_GL_UPLOAD_ERROR;
+  }
+
+  sync_meta = gst_buffer_get_gl_sync_meta (*outbuf);
+  if (sync_meta)
+    gst_gl_sync_meta_wait (sync_meta, context);
+
+  if (!gst_video_frame_map (&out_frame, in_info, *outbuf, GST_MAP_WRITE)) {
+    GST_ERROR_OBJECT (raw->upload, "Failed to map persistent buffer");
+    goto error;
+  }
+  copied = gst_video_frame_copy (&out_frame, &raw->in_frame->frame);
+  gst_video_frame_unmap (&out_frame);
+  if (!copied) {
+    GST_ERROR_OBJECT (raw->upload, "Failed to copy into persistent buffer");
+    goto error;
+  }
+
+  /* start the pbo -> texture transfers */
+  n_mem = gst_buffer_n_memory (*outbuf);
+  for (i = 0; i < n_mem; i++) {
+    GstMemory *mem = gst_buffer_peek_memory (*outbuf, i);
+
+    if (gst_is_gl_memory_pbo (mem))
+      gst_gl_memory_pbo_upload_transfer ((GstGLMemoryPBO *) mem);
+  }
+  if (sync_meta)
+    gst_gl_sync_meta_set_sync_point (sync_meta, context);
+
+  _raw_upload_frame_unref (raw->in_frame);
+  raw->in_frame = NULL;
+  return GST_GL_UPLOAD_DONE;
+
+error:
+  gst_buffer_unref (*outbuf);
+  *outbuf = NULL;
+  return GST_GL_UPLOAD_ERROR;
+}
+
 static GstGLUploadReturn
 _raw_data_upload_perform (gpointer impl, GstBuffer * buffer,
     GstBuffer ** outbuf)
@@ -1142,6 +1275,9 @@ _raw_data_upload_perform (gpointer impl, GstBuffer * buffer,
   GstVideoInfo *in_info = &raw->upload->priv->in_info;
   guint n_mem = GST_VIDEO_INFO_N_PLANES (in_info);
 
+  if (raw->upload->priv->persistent_buffers)
+    return _raw_data_upload_perform_persistent (raw, outbuf);
+
   allocator =
       GST_GL_BASE_MEMORY_ALLOCATOR (gst_gl_memory_allocator_get_default
       (raw->upload->context));
@@ -1184,6 +1320,7 @@ _raw_data_upload_free (gpointer impl)
 
   if (raw->params)
     gst_gl_allocation_params_free ((GstGLAllocationParams *) raw->params);
+  _raw_data_upload_clear_pool (raw);
 
   g_free (raw);
 }
@@ -1693,6 +1830,36 @@ gst_gl_upload_propose_allocation (GstGLUpload * upload, GstQuery * decide_query,
         decide_query, query);
 }
 
+/**
+ * gst_gl_upload_set_persistent_buffers:
+ * @upload: a #GstGLUpload
+ * @persistent: whether to upload through persistently mapped buffers
+ *
+ * Raw system memory frames are normally wrapped and uploaded through a new
+ * pixel buffer object for each frame.  With @persistent, they are instead
+ * copied into a ring of persistently mapped pixel buffer objects (see
+ * %GST_GL_ALLOCATION_PARAMS_ALLOC_FLAG_BUFFER_PERSISTENT) that is reused for
+ * every frame, and the #GstGLBufferPool proposed upstream for
+ * GLMemory caps allocates such buffers too so that producers can write
+ * directly into GL memory.  The texture uploads are fenced with
+ * #GstGLSyncMeta.
+ *
+ * Without OpenGL 4.4 or the buffer_storage extension the ring uses normal
+ * pixel buffer objects.  Disabled by default.
+ *
+ * Since: 1.16
+ */
+void
+gst_gl_upload_set_persistent_buffers (GstGLUpload * upload,
+    gboolean persistent)
+{
+  g_return_if_fail (GST_IS_GL_UPLOAD (upload));
+
+  GST_OBJECT_LOCK (upload);
+  upload->priv->persistent_buffers = persistent;
+  GST_OBJECT_UNLOCK (upload);
+}
+
 static gboolean
 _gst_gl_upload_set_caps_unlocked (GstGLUpload * upload, GstCaps * in_caps,
     GstCaps * out_caps)
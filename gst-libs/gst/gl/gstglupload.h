@@ -113,6 +113,10 @@ void          gst_gl_upload_propose_allocation     (GstGLUpload * upload,
                                                     GstQuery * decide_query,
                                                     GstQuery * query);
 
+GST_GL_API
+void          gst_gl_upload_set_persistent_buffers (GstGLUpload * upload,
+                                                    gboolean persistent);
+
 GST_GL_API
 GstGLUploadReturn gst_gl_upload_perform_with_buffer (GstGLUpload * upload,
                                                     GstBuffer * buffer,
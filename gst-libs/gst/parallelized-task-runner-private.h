@@ -0,0 +1,456 @@
+/* GStreamer
+ * Copyright (C) 2018 The GStreamer developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Parallelized task runner used by the audio and video converters.
+ *
+ * This is included by exactly one source file of each library that needs
+ * it, everything is static so that the libraries don't export clashing
+ * symbols. Define GST_PARALLELIZED_TASK_THREAD_NAME before including to name
+ * the worker threads, GST_CAT_DEFAULT is used for logging. */
+
+#ifndef __GST_PARALLELIZED_TASK_RUNNER_PRIVATE_H__
+#define __GST_PARALLELIZED_TASK_RUNNER_PRIVATE_H__
+
+#include <gst/gst.h>
+
+G_BEGIN_DECLS
+
+#ifndef GST_PARALLELIZED_TASK_THREAD_NAME
+#define GST_PARALLELIZED_TASK_THREAD_NAME "taskrunner"
+#endif
+
+typedef void (*GstParallelizedTaskFunc) (gpointer user_data);
+
+typedef struct _GstParallelizedTaskPool GstParallelizedTaskPool;
+typedef struct _GstParallelizedTaskRunner GstParallelizedTaskRunner;
+
+/* Pool of worker threads shared by all converters of one library.
+ *
+ * The pool is static in this header, so every library that includes it
+ * gets its own copy: libgstvideo and libgstaudio each run a separate pool.
+ * A process that converts audio and video at the same time can therefore
+ * have up to twice as many busy conversion threads as there are cores.
+ *
+ * Every runner submits itself to the job queue of the pool when it has
+ * bands to process. Idle workers pick up the runner at the head of the
+ * queue and take bands from it until none are left, the calling thread
+ * always processes one band itself and then helps with the remaining bands
+ * of its own job before waiting for the workers. The pool has one thread
+ * less than there are processors, so within one library the number of
+ * threads doing conversion work never exceeds the number of cores, no
+ * matter how many converters exist. Stages like scaling, chroma resampling
+ * and dithering don't submit jobs of their own, they run inside the band
+ * tasks of the converter.
+ *
+ * The pool lock is only taken to queue a job, for idle workers to join or
+ * leave a job, and for the caller to park once it gave up spinning. Bands
+ * are handed out with an atomic counter and completion is counted
+ * atomically. */
+struct _GstParallelizedTaskPool
+{
+  gint refcount;
+
+  guint n_threads;
+  GThread **threads;
+
+  GMutex lock;
+  GCond cond_todo;
+  GQueue jobs;
+  gboolean quit;
+
+  /* statistics, protected by lock. n_jobs counts the times a worker joined
+   * a job and processed at least one band of it. The latency is the time
+   * between queueing the job and that worker joining it, not the time until
+   * the job is done */
+  guint64 n_tasks;
+  guint64 n_jobs;
+  GstClockTime total_latency;
+  GstClockTime max_latency;
+};
+
+struct _GstParallelizedTaskRunner
+{
+  guint n_threads;
+
+  GstParallelizedTaskPool *pool;
+  GList link;
+
+  GstParallelizedTaskFunc func;
+  gpointer *task_data;
+
+  /* atomic */
+  gint n_todo, n_done;
+  gint parked;
+
+  /* protected by pool->lock */
+  GCond cond_done;
+  gboolean queued;
+  gint n_active;
+  GstClockTime queue_time;
+};
+
+/* Number of times the calling thread polls for completion before it
+ * parks on the condition variable */
+#define RUNNER_SPIN_COUNT 4000
+
+/* Tells the CPU that we are in a spin-wait loop, so that it doesn't
+ * speculate on the polled value and leaves resources to the sibling
+ * hyperthread */
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <intrin.h>
+#define RUNNER_CPU_RELAX() _mm_pause ()
+#elif defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+#define RUNNER_CPU_RELAX() __asm__ __volatile__ ("pause")
+#elif defined(__GNUC__) && (defined(__aarch64__) || \
+    (defined(__ARM_ARCH) && __ARM_ARCH >= 7))
+#define RUNNER_CPU_RELAX() __asm__ __volatile__ ("yield")
+#else
+#define RUNNER_CPU_RELAX() g_thread_yield ()
+#endif
+
+static GMutex shared_pool_lock;
+static GstParallelizedTaskPool *shared_pool;
+
+/* Returns the index of the next band to process or -1 if all bands were
+ * handed out already */
+static inline gint
+gst_parallelized_task_runner_take_task (GstParallelizedTaskRunner * runner)
+{
+  gint idx;
+
+  idx = g_atomic_int_add (&runner->n_todo, -1);
+
+  return idx >= 0 ? idx : -1;
+}
+
+static inline gboolean
+gst_parallelized_task_runner_is_done (GstParallelizedTaskRunner * runner)
+{
+  return g_atomic_int_get (&runner->n_done) == runner->n_threads - 1;
+}
+
+static void
+gst_parallelized_task_runner_task_done (GstParallelizedTaskRunner * runner)
+{
+  GstParallelizedTaskPool *pool = runner->pool;
+
+  /* Only the last band wakes up the caller, and only if it gave up
+   * spinning. The caller sets parked before checking n_done with the pool
+   * lock held, so either it sees our increment or we see its flag. */
+  if (g_atomic_int_add (&runner->n_done, 1) == runner->n_threads - 2
+      && g_atomic_int_get (&runner->parked)) {
+    g_mutex_lock (&pool->lock);
+    g_cond_signal (&runner->cond_done);
+    g_mutex_unlock (&pool->lock);
+  }
+}
+
+/* with pool->lock */
+static void
+gst_parallelized_task_pool_dequeue (GstParallelizedTaskPool * pool,
+    GstParallelizedTaskRunner * runner)
+{
+  if (runner->queued) {
+    g_queue_unlink (&pool->jobs, &runner->link);
+    runner->queued = FALSE;
+  }
+}
+
+static gpointer
+gst_parallelized_task_pool_thread_func (gpointer data)
+{
+  GstParallelizedTaskPool *pool = data;
+
+  g_mutex_lock (&pool->lock);
+  do {
+    GstParallelizedTaskRunner *runner;
+    GstClockTime latency;
+    guint n_tasks = 0;
+    gint idx;
+
+    while (g_queue_is_empty (&pool->jobs) && !pool->quit)
+      g_cond_wait (&pool->cond_todo, &pool->lock);
+
+    if (pool->quit)
+      break;
+
+    runner = g_queue_peek_head (&pool->jobs);
+    runner->n_active++;
+
+    latency = gst_util_get_timestamp () - runner->queue_time;
+    g_mutex_unlock (&pool->lock);
+
+    g_assert (runner->func != NULL);
+
+    while ((idx = gst_parallelized_task_runner_take_task (runner)) >= 0) {
+      runner->func (runner->task_data[idx]);
+      gst_parallelized_task_runner_task_done (runner);
+      n_tasks++;
+    }
+
+    g_mutex_lock (&pool->lock);
+    /* Nothing left to hand out, don't let other workers pick this up */
+    gst_parallelized_task_pool_dequeue (pool, runner);
+    /* The caller waits for all workers to leave before it returns */
+    if (--runner->n_active == 0)
+      g_cond_signal (&runner->cond_done);
+
+    if (n_tasks > 0) {
+      pool->n_tasks += n_tasks;
+      pool->n_jobs++;
+      pool->total_latency += latency;
+      pool->max_latency = MAX (pool->max_latency, latency);
+    }
+  } while (TRUE);
+  g_mutex_unlock (&pool->lock);
+
+  return NULL;
+}
+
+static void
+gst_parallelized_task_pool_free (GstParallelizedTaskPool * pool)
+{
+  guint i;
+
+  g_mutex_lock (&pool->lock);
+  pool->quit = TRUE;
+  g_cond_broadcast (&pool->cond_todo);
+  g_mutex_unlock (&pool->lock);
+
+  for (i = 0; i < pool->n_threads; i++) {
+    if (!pool->threads[i])
+      continue;
+
+    g_thread_join (pool->threads[i]);
+  }
+
+  GST_INFO ("shared pool with %u threads ran %" G_GUINT64_FORMAT
+      " tasks in %" G_GUINT64_FORMAT " jobs, average latency %"
+      GST_TIME_FORMAT ", maximum latency %" GST_TIME_FORMAT, pool->n_threads,
+      pool->n_tasks, pool->n_jobs,
+      GST_TIME_ARGS (pool->n_jobs ? pool->total_latency / pool->n_jobs : 0),
+      GST_TIME_ARGS (pool->max_latency));
+
+  g_mutex_clear (&pool->lock);
+  g_cond_clear (&pool->cond_todo);
+  g_free (pool->threads);
+  g_free (pool);
+}
+
+static GstParallelizedTaskPool *
+gst_parallelized_task_pool_new (guint n_threads)
+{
+  GstParallelizedTaskPool *pool;
+  guint i;
+  GError *err = NULL;
+
+  pool = g_new0 (GstParallelizedTaskPool, 1);
+  pool->refcount = 1;
+  pool->n_threads = n_threads;
+  pool->threads = g_new0 (GThread *, n_threads);
+
+  pool->quit = FALSE;
+  g_mutex_init (&pool->lock);
+  g_cond_init (&pool->cond_todo);
+  g_queue_init (&pool->jobs);
+
+  for (i = 0; i < n_threads; i++) {
+    pool->threads[i] =
+        g_thread_try_new (GST_PARALLELIZED_TASK_THREAD_NAME,
+        gst_parallelized_task_pool_thread_func, pool, &err);
+    if (!pool->threads[i])
+      goto error;
+  }
+
+  GST_DEBUG ("created shared pool with %u threads", n_threads);
+
+  return pool;
+
+error:
+  {
+    GST_ERROR ("Failed to start thread %u: %s", i, err->message);
+    g_clear_error (&err);
+
+    gst_parallelized_task_pool_free (pool);
+    return NULL;
+  }
+}
+
+static GstParallelizedTaskPool *
+gst_parallelized_task_pool_get_shared (void)
+{
+  GstParallelizedTaskPool *pool;
+
+  g_mutex_lock (&shared_pool_lock);
+  if (shared_pool) {
+    shared_pool->refcount++;
+  } else {
+    /* The thread calling run() is always doing work too */
+    shared_pool = gst_parallelized_task_pool_new (g_get_num_processors () - 1);
+  }
+  pool = shared_pool;
+  g_mutex_unlock (&shared_pool_lock);
+
+  return pool;
+}
+
+static void
+gst_parallelized_task_pool_unref (GstParallelizedTaskPool * pool)
+{
+  g_mutex_lock (&shared_pool_lock);
+  g_assert (pool == shared_pool);
+  if (--pool->refcount > 0) {
+    g_mutex_unlock (&shared_pool_lock);
+    return;
+  }
+  shared_pool = NULL;
+  g_mutex_unlock (&shared_pool_lock);
+
+  gst_parallelized_task_pool_free (pool);
+}
+
+/* Statistics of the shared pool, all 0 if there is no pool */
+static inline void
+gst_parallelized_task_pool_get_shared_stats (guint * n_threads,
+    guint64 * n_jobs, GstClockTime * avg_latency, GstClockTime * max_latency)
+{
+  *n_threads = 0;
+  *n_jobs = 0;
+  *avg_latency = 0;
+  *max_latency = 0;
+
+  g_mutex_lock (&shared_pool_lock);
+  if (shared_pool) {
+    GstParallelizedTaskPool *pool = shared_pool;
+
+    g_mutex_lock (&pool->lock);
+    *n_threads = pool->n_threads;
+    *n_jobs = pool->n_jobs;
+    *avg_latency = pool->n_jobs ? pool->total_latency / pool->n_jobs : 0;
+    *max_latency = pool->max_latency;
+    g_mutex_unlock (&pool->lock);
+  }
+  g_mutex_unlock (&shared_pool_lock);
+}
+
+static void
+gst_parallelized_task_runner_free (GstParallelizedTaskRunner * self)
+{
+  if (self->pool)
+    gst_parallelized_task_pool_unref (self->pool);
+
+  g_cond_clear (&self->cond_done);
+  g_free (self);
+}
+
+static GstParallelizedTaskRunner *
+gst_parallelized_task_runner_new (guint n_threads)
+{
+  GstParallelizedTaskRunner *self;
+
+  if (n_threads == 0 || n_threads > g_get_num_processors ())
+    n_threads = g_get_num_processors ();
+
+  self = g_new0 (GstParallelizedTaskRunner, 1);
+  self->n_threads = n_threads;
+
+  self->n_todo = -1;
+  self->n_done = 0;
+  self->parked = 0;
+  self->queued = FALSE;
+  self->n_active = 0;
+  g_cond_init (&self->cond_done);
+  self->link.data = self;
+
+  /* Set when scheduling a job */
+  self->func = NULL;
+  self->task_data = NULL;
+
+  if (n_threads > 1) {
+    self->pool = gst_parallelized_task_pool_get_shared ();
+    /* Run everything from the calling thread if we have no pool */
+    if (!self->pool)
+      self->n_threads = 1;
+  }
+
+  return self;
+}
+
+static void
+gst_parallelized_task_runner_run (GstParallelizedTaskRunner * self,
+    GstParallelizedTaskFunc func, gpointer * task_data)
+{
+  GstParallelizedTaskPool *pool = self->pool;
+  guint n_threads = self->n_threads;
+
+  self->func = func;
+  self->task_data = task_data;
+
+  if (n_threads > 1) {
+    g_atomic_int_set (&self->n_done, 0);
+    g_atomic_int_set (&self->n_todo, self->n_threads - 2);
+
+    g_mutex_lock (&pool->lock);
+    self->queue_time = gst_util_get_timestamp ();
+    self->queued = TRUE;
+    g_queue_push_tail_link (&pool->jobs, &self->link);
+    g_cond_broadcast (&pool->cond_todo);
+    g_mutex_unlock (&pool->lock);
+  }
+
+  self->func (self->task_data[self->n_threads - 1]);
+
+  if (n_threads > 1) {
+    gint idx, i;
+
+    /* Help with our own bands if the workers are busy with other jobs */
+    while ((idx = gst_parallelized_task_runner_take_task (self)) >= 0) {
+      self->func (self->task_data[idx]);
+      gst_parallelized_task_runner_task_done (self);
+    }
+
+    for (i = 0; i < RUNNER_SPIN_COUNT; i++) {
+      if (gst_parallelized_task_runner_is_done (self))
+        break;
+      RUNNER_CPU_RELAX ();
+    }
+
+    g_mutex_lock (&pool->lock);
+    if (i == RUNNER_SPIN_COUNT) {
+      /* needs to be a full barrier before checking n_done again */
+      g_atomic_int_inc (&self->parked);
+      while (!gst_parallelized_task_runner_is_done (self))
+        g_cond_wait (&self->cond_done, &pool->lock);
+      g_atomic_int_set (&self->parked, 0);
+    }
+    gst_parallelized_task_pool_dequeue (pool, self);
+    /* Workers that joined late still need to notice that there is nothing
+     * left to do before we can reuse the runner */
+    while (self->n_active > 0)
+      g_cond_wait (&self->cond_done, &pool->lock);
+    g_mutex_unlock (&pool->lock);
+  }
+
+  self->func = NULL;
+  self->task_data = NULL;
+}
+
+G_END_DECLS
+
+#endif /* __GST_PARALLELIZED_TASK_RUNNER_PRIVATE_H__ */
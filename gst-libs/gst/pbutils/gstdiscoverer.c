@@ -88,6 +88,12 @@ struct _GstDiscovererPrivate
   /* list of pending URI to process (current excluded) */
   GList *pending_uris;
 
+  /* number of URIs to discover in parallel in async mode */
+  guint max_concurrent;
+  /* DiscovererWorker, only used when max_concurrent > 1 */
+  GPtrArray *workers;
+  guint n_busy_workers;
+
   GMutex lock;
   /* TRUE if cleaning up discoverer */
   gboolean cleanup;
@@ -142,6 +148,14 @@ struct _GstDiscovererPrivate
 #define DISCO_LOCK(dc) g_mutex_lock (&dc->priv->lock);
 #define DISCO_UNLOCK(dc) g_mutex_unlock (&dc->priv->lock);
 
+/* A child discoverer that runs one of the parallel discoveries */
+typedef struct
+{
+  GstDiscoverer *parent;
+  GstDiscoverer *dc;
+  gboolean busy;
+} DiscovererWorker;
+
 static void
 _do_init (void)
 {
@@ -170,11 +184,13 @@ enum
 };
 
 #define DEFAULT_PROP_TIMEOUT 15 * GST_SECOND
+#define DEFAULT_PROP_MAX_CONCURRENT 1
 
 enum
 {
   PROP_0,
-  PROP_TIMEOUT
+  PROP_TIMEOUT,
+  PROP_MAX_CONCURRENT
 };
 
 static guint gst_discoverer_signals[LAST_SIGNAL] = { 0 };
@@ -229,6 +245,25 @@ gst_discoverer_class_init (GstDiscovererClass * klass)
           GST_SECOND, 3600 * GST_SECOND, DEFAULT_PROP_TIMEOUT,
           G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstDiscoverer:max-concurrent:
+   *
+   * The maximum number of URIs that are discovered in parallel in
+   * asynchronous mode. Each URI is discovered in its own pipeline and is
+   * subject to its own #GstDiscoverer:timeout. The #GstDiscoverer::discovered
+   * signals are emitted in the order in which the discoveries complete.
+   *
+   * Changing this property only has an effect on the next call to
+   * gst_discoverer_start().
+   *
+   * Since: 1.16
+   */
+  g_object_class_install_property (gobject_class, PROP_MAX_CONCURRENT,
+      g_param_spec_uint ("max-concurrent", "Max concurrent",
+          "Maximum number of URIs to discover in parallel in async mode",
+          1, 256, DEFAULT_PROP_MAX_CONCURRENT,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   /* signals */
   /**
    * GstDiscoverer::finished:
@@ -316,6 +351,7 @@ gst_discoverer_init (GstDiscoverer * dc)
       GstDiscovererPrivate);
 
   dc->priv->timeout = DEFAULT_PROP_TIMEOUT;
+  dc->priv->max_concurrent = DEFAULT_PROP_MAX_CONCURRENT;
   dc->priv->async = FALSE;
 
   g_mutex_init (&dc->priv->lock);
@@ -453,6 +489,11 @@ gst_discoverer_set_property (GObject * object, guint prop_id,
     case PROP_TIMEOUT:
       gst_discoverer_set_timeout (dc, g_value_get_uint64 (value));
       break;
+    case PROP_MAX_CONCURRENT:
+      DISCO_LOCK (dc);
+      dc->priv->max_concurrent = g_value_get_uint (value);
+      DISCO_UNLOCK (dc);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -471,6 +512,11 @@ gst_discoverer_get_property (GObject * object, guint prop_id,
       g_value_set_uint64 (value, dc->priv->timeout);
       DISCO_UNLOCK (dc);
       break;
+    case PROP_MAX_CONCURRENT:
+      DISCO_LOCK (dc);
+      g_value_set_uint (value, dc->priv->max_concurrent);
+      DISCO_UNLOCK (dc);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -1837,6 +1883,127 @@ beach:
   return res;
 }
 
+/* Parallel discovery
+ *
+ * With max-concurrent > 1 the pending URIs are handed out to a set of child
+ * discoverers, each with its own pipeline, and their results are forwarded.
+ */
+
+static void
+worker_discovered_cb (GstDiscoverer * wdc, GstDiscovererInfo * info,
+    GError * err, DiscovererWorker * worker)
+{
+  g_signal_emit (worker->parent, gst_discoverer_signals[SIGNAL_DISCOVERED], 0,
+      info, err);
+}
+
+static void
+worker_source_setup_cb (GstDiscoverer * wdc, GstElement * source,
+    DiscovererWorker * worker)
+{
+  g_signal_emit (worker->parent, gst_discoverer_signals[SIGNAL_SOURCE_SETUP],
+      0, source);
+}
+
+/* hand out pending URIs to idle workers */
+static void
+dispatch_workers (GstDiscoverer * dc)
+{
+  guint i;
+
+  DISCO_LOCK (dc);
+  for (i = 0; dc->priv->workers && i < dc->priv->workers->len; i++) {
+    DiscovererWorker *worker = g_ptr_array_index (dc->priv->workers, i);
+    gboolean starting;
+    gchar *uri;
+
+    if (dc->priv->pending_uris == NULL)
+      break;
+    if (worker->busy)
+      continue;
+
+    uri = dc->priv->pending_uris->data;
+    dc->priv->pending_uris =
+        g_list_delete_link (dc->priv->pending_uris, dc->priv->pending_uris);
+    worker->busy = TRUE;
+    starting = (dc->priv->n_busy_workers++ == 0);
+    DISCO_UNLOCK (dc);
+
+    if (starting)
+      g_signal_emit (dc, gst_discoverer_signals[SIGNAL_STARTING], 0);
+
+    GST_DEBUG_OBJECT (dc, "discovering %s in worker %u", uri, i);
+    gst_discoverer_discover_uri_async (worker->dc, uri);
+    g_free (uri);
+
+    DISCO_LOCK (dc);
+  }
+  DISCO_UNLOCK (dc);
+}
+
+static void
+worker_finished_cb (GstDiscoverer * wdc, DiscovererWorker * worker)
+{
+  GstDiscoverer *dc = worker->parent;
+  gboolean done;
+
+  DISCO_LOCK (dc);
+  worker->busy = FALSE;
+  dc->priv->n_busy_workers--;
+  DISCO_UNLOCK (dc);
+
+  dispatch_workers (dc);
+
+  DISCO_LOCK (dc);
+  done = dc->priv->running && dc->priv->n_busy_workers == 0 &&
+      dc->priv->pending_uris == NULL;
+  DISCO_UNLOCK (dc);
+
+  if (done) {
+    GST_DEBUG_OBJECT (dc, "all workers are done");
+    g_signal_emit (dc, gst_discoverer_signals[SIGNAL_FINISHED], 0);
+  }
+}
+
+static void
+discoverer_worker_free (DiscovererWorker * worker)
+{
+  g_signal_handlers_disconnect_by_data (worker->dc, worker);
+  gst_discoverer_stop (worker->dc);
+  g_object_unref (worker->dc);
+  g_slice_free (DiscovererWorker, worker);
+}
+
+/* called from gst_discoverer_start(), in the thread-default main context
+ * that the workers will share */
+static void
+start_workers (GstDiscoverer * dc, guint n_workers)
+{
+  guint i;
+
+  dc->priv->workers = g_ptr_array_new_with_free_func ((GDestroyNotify)
+      discoverer_worker_free);
+  dc->priv->n_busy_workers = 0;
+
+  for (i = 0; i < n_workers; i++) {
+    DiscovererWorker *worker = g_slice_new0 (DiscovererWorker);
+
+    worker->parent = dc;
+    worker->dc = g_object_new (GST_TYPE_DISCOVERER, "timeout",
+        dc->priv->timeout, NULL);
+    g_signal_connect (worker->dc, "discovered",
+        G_CALLBACK (worker_discovered_cb), worker);
+    g_signal_connect (worker->dc, "source-setup",
+        G_CALLBACK (worker_source_setup_cb), worker);
+    g_signal_connect (worker->dc, "finished",
+        G_CALLBACK (worker_finished_cb), worker);
+    gst_discoverer_start (worker->dc);
+
+    g_ptr_array_add (dc->priv->workers, worker);
+  }
+  GST_DEBUG_OBJECT (dc, "started %u workers", n_workers);
+}
+
 /* Serializing code */
 
 static GVariant *
@@ -2179,6 +2346,13 @@ gst_discoverer_start (GstDiscoverer * discoverer)
   discoverer->priv->async = TRUE;
   discoverer->priv->running = TRUE;
 
+  if (discoverer->priv->max_concurrent > 1) {
+    start_workers (discoverer, discoverer->priv->max_concurrent);
+    dispatch_workers (discoverer);
+    GST_DEBUG_OBJECT (discoverer, "Started");
+    return;
+  }
+
   ctx = g_main_context_get_thread_default ();
 
   /* Connect to bus signals */
@@ -2216,6 +2390,18 @@ gst_discoverer_stop (GstDiscoverer * discoverer)
     return;
   }
 
+  if (discoverer->priv->workers) {
+    GPtrArray *workers;
+
+    DISCO_LOCK (discoverer);
+    workers = discoverer->priv->workers;
+    discoverer->priv->workers = NULL;
+    discoverer->priv->n_busy_workers = 0;
+    DISCO_UNLOCK (discoverer);
+
+    g_ptr_array_unref (workers);
+  }
+
   DISCO_LOCK (discoverer);
   if (discoverer->priv->processing) {
     /* We prevent any further processing by setting the bus to
@@ -2271,7 +2457,7 @@ gboolean
 gst_discoverer_discover_uri_async (GstDiscoverer * discoverer,
     const gchar * uri)
 {
-  gboolean can_run;
+  gboolean can_run, use_workers;
 
   g_return_val_if_fail (GST_IS_DISCOVERER (discoverer), FALSE);
 
@@ -2281,9 +2467,12 @@ gst_discoverer_discover_uri_async (GstDiscoverer * discoverer,
   can_run = (discoverer->priv->pending_uris == NULL);
   discoverer->priv->pending_uris =
       g_list_append (discoverer->priv->pending_uris, g_strdup (uri));
+  use_workers = (discoverer->priv->workers != NULL);
   DISCO_UNLOCK (discoverer);
 
-  if (can_run)
+  if (use_workers)
+    dispatch_workers (discoverer);
+  else if (can_run)
     start_discovering (discoverer);
 
   return TRUE;
@@ -843,6 +843,41 @@ gst_rtcp_packet_get_rb_count (GstRTCPPacket * packet)
   return packet->count;
 }
 
+static void
+read_rb (const guint8 * data, guint32 * ssrc, guint8 * fractionlost,
+    gint32 * packetslost, guint32 * exthighestseq, guint32 * jitter,
+    guint32 * lsr, guint32 * dlsr)
+{
+  guint32 tmp;
+
+  if (ssrc)
+    *ssrc = GST_READ_UINT32_BE (data);
+  data += 4;
+  tmp = GST_READ_UINT32_BE (data);
+  if (fractionlost)
+    *fractionlost = (tmp >> 24);
+  if (packetslost) {
+    /* sign extend */
+    if (tmp & 0x00800000)
+      tmp |= 0xff000000;
+    else
+      tmp &= 0x00ffffff;
+    *packetslost = (gint32) tmp;
+  }
+  data += 4;
+  if (exthighestseq)
+    *exthighestseq = GST_READ_UINT32_BE (data);
+  data += 4;
+  if (jitter)
+    *jitter = GST_READ_UINT32_BE (data);
+  data += 4;
+  if (lsr)
+    *lsr = GST_READ_UINT32_BE (data);
+  data += 4;
+  if (dlsr)
+    *dlsr = GST_READ_UINT32_BE (data);
+}
+
 /**
  * gst_rtcp_packet_get_rb:
  * @packet: a valid SR or RR #GstRTCPPacket
@@ -864,8 +899,6 @@ gst_rtcp_packet_get_rb (GstRTCPPacket * packet, guint nth, guint32 * ssrc,
     guint32 * jitter, guint32 * lsr, guint32 * dlsr)
 {
   guint offset;
-  guint8 *data;
-  guint32 tmp;
 
   g_return_if_fail (packet != NULL);
   g_return_if_fail (packet->type == GST_RTCP_TYPE_RR ||
@@ -895,35 +928,8 @@ gst_rtcp_packet_get_rb (GstRTCPPacket * packet, guint nth, guint32 * ssrc,
   if (offset + 24 > packet->rtcp->map.size)
     return;
 
-  data = packet->rtcp->map.data;
-  data += offset;
-
-  if (ssrc)
-    *ssrc = GST_READ_UINT32_BE (data);
-  data += 4;
-  tmp = GST_READ_UINT32_BE (data);
-  if (fractionlost)
-    *fractionlost = (tmp >> 24);
-  if (packetslost) {
-    /* sign extend */
-    if (tmp & 0x00800000)
-      tmp |= 0xff000000;
-    else
-      tmp &= 0x00ffffff;
-    *packetslost = (gint32) tmp;
-  }
-  data += 4;
-  if (exthighestseq)
-    *exthighestseq = GST_READ_UINT32_BE (data);
-  data += 4;
-  if (jitter)
-    *jitter = GST_READ_UINT32_BE (data);
-  data += 4;
-  if (lsr)
-    *lsr = GST_READ_UINT32_BE (data);
-  data += 4;
-  if (dlsr)
-    *dlsr = GST_READ_UINT32_BE (data);
+  read_rb (packet->rtcp->map.data + offset, ssrc, fractionlost, packetslost,
+      exthighestseq, jitter, lsr, dlsr);
 }
 
 /**
@@ -2541,3 +2547,487 @@ gst_rtcp_packet_app_get_data (GstRTCPPacket * packet)
 
   return data + 12;
 }
+
+/**
+ * gst_rtcp_buffer_decode_data:
+ * @data: (array length=len): the data to decode
+ * @len: the length of @data
+ * @reduced: if reduced size RTCP (RFC 5506) is allowed
+ * @packets: (array length=n_packets) (out caller-allocates): the packet
+ *    descriptors to fill
+ * @n_packets: (inout): the number of descriptors in @packets, on success
+ *    updated with the number of packets in @data
+ *
+ * Validate and decode the compound RTCP packet in @data in a single pass over
+ * the headers. For each packet, one #GstRTCPPacketInfo in @packets is filled
+ * with the header fields, the fixed fields of the packet type and the offsets
+ * of the report blocks and the packet data.
+ *
+ * The same checks as gst_rtcp_buffer_validate_data_reduced() or
+ * gst_rtcp_buffer_validate_data() are performed, depending on @reduced.
+ * Additionally each packet needs to be large enough for the fixed fields and
+ * report blocks of its type.
+ *
+ * Returns: %TRUE if @data was a valid compound RTCP packet that fitted in
+ *    @packets. On failure @n_packets is set to 0.
+ *
+ * Since: 1.16
+ */
+gboolean
+gst_rtcp_buffer_decode_data (const guint8 * data, guint len, gboolean reduced,
+    GstRTCPPacketInfo * packets, guint * n_packets)
+{
+  guint16 header_mask;
+  guint offset, n, max;
+
+  g_return_val_if_fail (data != NULL, FALSE);
+  g_return_val_if_fail (packets != NULL, FALSE);
+  g_return_val_if_fail (n_packets != NULL, FALSE);
+
+  max = *n_packets;
+  *n_packets = 0;
+
+  /* we need 4 bytes for the type and length */
+  if (G_UNLIKELY (len < 4))
+    goto wrong_length;
+
+  /* first packet must be RR or SR and version must be 2, padding is only
+   * allowed for reduced size packets */
+  header_mask = ((data[0] << 8) | data[1]) &
+      (reduced ? GST_RTCP_REDUCED_SIZE_VALID_MASK : GST_RTCP_VALID_MASK);
+  if (G_UNLIKELY (header_mask != GST_RTCP_VALID_VALUE))
+    goto wrong_mask;
+
+  offset = 0;
+  n = 0;
+  while (offset < len) {
+    const guint8 *p = data + offset;
+    GstRTCPPacketInfo *info;
+    guint size, body, pad, count;
+
+    if (G_UNLIKELY (len - offset < 4))
+      goto wrong_length;
+
+    if (G_UNLIKELY ((p[0] >> 6) != GST_RTCP_VERSION))
+      goto wrong_version;
+
+    size = (GST_READ_UINT16_BE (p + 2) + 1) << 2;
+    if (G_UNLIKELY (size > len - offset))
+      goto wrong_length;
+
+    pad = 0;
+    if (p[0] & 0x20) {
+      /* padding is only allowed on the last packet */
+      if (G_UNLIKELY (offset + size != len))
+        goto wrong_padding;
+      pad = p[size - 1];
+      if (G_UNLIKELY (pad == 0 || (pad & 0x3) || pad > size - 4))
+        goto wrong_padding;
+    }
+
+    if (G_UNLIKELY (n == max))
+      goto too_many_packets;
+
+    info = &packets[n];
+    count = p[0] & 0x1f;
+    /* size of the packet after the header, without padding */
+    body = size - 4 - pad;
+
+    info->type = p[1];
+    info->count = count;
+    info->padding = pad != 0;
+    info->offset = offset;
+    info->size = size;
+    info->ssrc = 0;
+    info->media_ssrc = 0;
+    info->ntptime = 0;
+    info->rtptime = 0;
+    info->packet_count = 0;
+    info->octet_count = 0;
+    info->rb_offset = 0;
+    info->rb_count = 0;
+
+    switch (info->type) {
+      case GST_RTCP_TYPE_SR:
+        if (G_UNLIKELY (body < 24 + count * 24))
+          goto wrong_type_length;
+        info->ssrc = GST_READ_UINT32_BE (p + 4);
+        info->ntptime = GST_READ_UINT64_BE (p + 8);
+        info->rtptime = GST_READ_UINT32_BE (p + 16);
+        info->packet_count = GST_READ_UINT32_BE (p + 20);
+        info->octet_count = GST_READ_UINT32_BE (p + 24);
+        info->rb_offset = offset + 28;
+        info->rb_count = count;
+        info->data_offset = info->rb_offset + count * 24;
+        info->data_size = body - 24 - count * 24;
+        break;
+      case GST_RTCP_TYPE_RR:
+        if (G_UNLIKELY (body < 4 + count * 24))
+          goto wrong_type_length;
+        info->ssrc = GST_READ_UINT32_BE (p + 4);
+        info->rb_offset = offset + 8;
+        info->rb_count = count;
+        info->data_offset = info->rb_offset + count * 24;
+        info->data_size = body - 4 - count * 24;
+        break;
+      case GST_RTCP_TYPE_RTPFB:
+      case GST_RTCP_TYPE_PSFB:
+        if (G_UNLIKELY (body < 8))
+          goto wrong_type_length;
+        info->ssrc = GST_READ_UINT32_BE (p + 4);
+        info->media_ssrc = GST_READ_UINT32_BE (p + 8);
+        info->data_offset = offset + 12;
+        info->data_size = body - 8;
+        break;
+      case GST_RTCP_TYPE_APP:
+        /* SSRC and name */
+        if (G_UNLIKELY (body < 8))
+          goto wrong_type_length;
+        info->ssrc = GST_READ_UINT32_BE (p + 4);
+        info->data_offset = offset + 12;
+        info->data_size = body - 8;
+        break;
+      case GST_RTCP_TYPE_XR:
+        if (G_UNLIKELY (body < 4))
+          goto wrong_type_length;
+        info->ssrc = GST_READ_UINT32_BE (p + 4);
+        info->data_offset = offset + 8;
+        info->data_size = body - 4;
+        break;
+      case GST_RTCP_TYPE_SDES:
+      case GST_RTCP_TYPE_BYE:
+        /* both start with the SSRC of the first chunk */
+        if (count > 0) {
+          if (G_UNLIKELY (body < 4))
+            goto wrong_type_length;
+          info->ssrc = GST_READ_UINT32_BE (p + 4);
+        }
+        /* fallthrough */
+      default:
+        info->data_offset = offset + 4;
+        info->data_size = body;
+        break;
+    }
+
+    n++;
+    offset += size;
+  }
+
+  *n_packets = n;
+
+  return TRUE;
+
+  /* ERRORS */
+wrong_length:
+  {
+    GST_DEBUG ("len check failed");
+    return FALSE;
+  }
+wrong_mask:
+  {
+    GST_DEBUG ("mask check failed (%04x != %04x)", header_mask,
+        GST_RTCP_VALID_VALUE);
+    return FALSE;
+  }
+wrong_version:
+  {
+    GST_DEBUG ("wrong version (%d < 2)", data[offset] >> 6);
+    return FALSE;
+  }
+wrong_padding:
+  {
+    GST_DEBUG ("padding check failed");
+    return FALSE;
+  }
+wrong_type_length:
+  {
+    GST_DEBUG ("packet %u too small for its type", n);
+    return FALSE;
+  }
+too_many_packets:
+  {
+    GST_DEBUG ("more than %u packets", max);
+    return FALSE;
+  }
+}
+
+/**
+ * gst_rtcp_packet_info_get_rb:
+ * @info: a #GstRTCPPacketInfo of an SR or RR packet
+ * @data: (array): the data that was passed to gst_rtcp_buffer_decode_data()
+ * @nth: the nth report block in @info
+ * @ssrc: (out): result for data source being reported
+ * @fractionlost: (out): result for fraction lost since last SR/RR
+ * @packetslost: (out): result for the cumululative number of packets lost
+ * @exthighestseq: (out): result for the extended last sequence number received
+ * @jitter: (out): result for the interarrival jitter
+ * @lsr: (out): result for the last SR packet from this source
+ * @dlsr: (out): result for the delay since last SR packet
+ *
+ * Parse the values of the @nth report block of the packet described by @info
+ * and store the result in the values.
+ *
+ * Since: 1.16
+ */
+void
+gst_rtcp_packet_info_get_rb (const GstRTCPPacketInfo * info,
+    const guint8 * data, guint nth, guint32 * ssrc, guint8 * fractionlost,
+    gint32 * packetslost, guint32 * exthighestseq, guint32 * jitter,
+    guint32 * lsr, guint32 * dlsr)
+{
+  g_return_if_fail (info != NULL);
+  g_return_if_fail (data != NULL);
+  g_return_if_fail (nth < info->rb_count);
+
+  read_rb (data + info->rb_offset + nth * 24, ssrc, fractionlost, packetslost,
+      exthighestseq, jitter, lsr, dlsr);
+}
+
+/**
+ * gst_rtcp_writer_init:
+ * @writer: a #GstRTCPWriter
+ * @data: (array length=size): the memory to write to
+ * @size: the size of @data
+ *
+ * Initialize @writer to write a compound RTCP packet to @data. After adding
+ * packets, the first @writer->offset bytes of @data contain the compound
+ * packet.
+ *
+ * Since: 1.16
+ */
+void
+gst_rtcp_writer_init (GstRTCPWriter * writer, guint8 * data, guint size)
+{
+  g_return_if_fail (writer != NULL);
+  g_return_if_fail (data != NULL || size == 0);
+
+  writer->data = data;
+  writer->size = size;
+  writer->offset = 0;
+  writer->packet = G_MAXUINT;
+}
+
+/* write the header of a packet with @len bytes after the header and make it
+ * the current packet. Returns a pointer after the header or %NULL when there
+ * is not enough space left. */
+static guint8 *
+writer_start_packet (GstRTCPWriter * writer, GstRTCPType type, guint8 count,
+    guint len)
+{
+  guint8 *p;
+
+  if (writer->size - writer->offset < len + 4)
+    return NULL;
+
+  p = writer->data + writer->offset;
+  p[0] = (GST_RTCP_VERSION << 6) | (count & 0x1f);
+  p[1] = type;
+  GST_WRITE_UINT16_BE (p + 2, len >> 2);
+
+  writer->packet = writer->offset;
+  writer->offset += len + 4;
+
+  return p + 4;
+}
+
+/**
+ * gst_rtcp_writer_add_sr:
+ * @writer: a #GstRTCPWriter
+ * @ssrc: the SSRC of the sender
+ * @ntptime: the NTP time
+ * @rtptime: the RTP time
+ * @packet_count: the packet count
+ * @octet_count: the octet count
+ *
+ * Add a new SR packet without report blocks. Report blocks can be added with
+ * gst_rtcp_writer_add_rb().
+ *
+ * Returns: %TRUE if the packet was added, %FALSE if there was not enough
+ *    space left.
+ *
+ * Since: 1.16
+ */
+gboolean
+gst_rtcp_writer_add_sr (GstRTCPWriter * writer, guint32 ssrc,
+    guint64 ntptime, guint32 rtptime, guint32 packet_count,
+    guint32 octet_count)
+{
+  guint8 *p;
+
+  g_return_val_if_fail (writer != NULL, FALSE);
+
+  if (!(p = writer_start_packet (writer, GST_RTCP_TYPE_SR, 0, 24)))
+    return FALSE;
+
+  GST_WRITE_UINT32_BE (p, ssrc);
+  GST_WRITE_UINT64_BE (p + 4, ntptime);
+  GST_WRITE_UINT32_BE (p + 12, rtptime);
+  GST_WRITE_UINT32_BE (p + 16, packet_count);
+  GST_WRITE_UINT32_BE (p + 20, octet_count);
+
+  return TRUE;
+}
+
+/**
+ * gst_rtcp_writer_add_rr:
+ * @writer: a #GstRTCPWriter
+ * @ssrc: the SSRC of the sender
+ *
+ * Add a new RR packet without report blocks. Report blocks can be added with
+ * gst_rtcp_writer_add_rb().
+ *
+ * Returns: %TRUE if the packet was added, %FALSE if there was not enough
+ *    space left.
+ *
+ * Since: 1.16
+ */
+gboolean
+gst_rtcp_writer_add_rr (GstRTCPWriter * writer, guint32 ssrc)
+{
+  guint8 *p;
+
+  g_return_val_if_fail (writer != NULL, FALSE);
+
+  if (!(p = writer_start_packet (writer, GST_RTCP_TYPE_RR, 0, 4)))
+    return FALSE;
+
+  GST_WRITE_UINT32_BE (p, ssrc);
+
+  return TRUE;
+}
+
+/**
+ * gst_rtcp_writer_add_rb:
+ * @writer: a #GstRTCPWriter
+ * @ssrc: data source being reported
+ * @fractionlost: fraction lost since last SR/RR
+ * @packetslost: the cumululative number of packets lost
+ * @exthighestseq: the extended last sequence number received
+ * @jitter: the interarrival jitter
+ * @lsr: the last SR packet from this source
+ * @dlsr: the delay since last SR packet
+ *
+ * Add a new report block to the SR or RR packet that was last added to
+ * @writer.
+ *
+ * Returns: %TRUE if the report block was added, %FALSE if the packet already
+ *    contains #GST_RTCP_MAX_RB_COUNT report blocks or there was not enough
+ *    space left.
+ *
+ * Since: 1.16
+ */
+gboolean
+gst_rtcp_writer_add_rb (GstRTCPWriter * writer, guint32 ssrc,
+    guint8 fractionlost, gint32 packetslost, guint32 exthighestseq,
+    guint32 jitter, guint32 lsr, guint32 dlsr)
+{
+  guint8 *hdr, *p;
+
+  g_return_val_if_fail (writer != NULL, FALSE);
+  g_return_val_if_fail (writer->packet != G_MAXUINT, FALSE);
+
+  hdr = writer->data + writer->packet;
+  g_return_val_if_fail (hdr[1] == GST_RTCP_TYPE_SR
+      || hdr[1] == GST_RTCP_TYPE_RR, FALSE);
+
+  if ((hdr[0] & 0x1f) >= GST_RTCP_MAX_RB_COUNT)
+    return FALSE;
+  if (writer->size - writer->offset < 24)
+    return FALSE;
+
+  p = writer->data + writer->offset;
+  GST_WRITE_UINT32_BE (p, ssrc);
+  GST_WRITE_UINT32_BE (p + 4,
+      ((guint32) fractionlost << 24) | (packetslost & 0xffffff));
+  GST_WRITE_UINT32_BE (p + 8, exthighestseq);
+  GST_WRITE_UINT32_BE (p + 12, jitter);
+  GST_WRITE_UINT32_BE (p + 16, lsr);
+  GST_WRITE_UINT32_BE (p + 20, dlsr);
+  writer->offset += 24;
+
+  /* increment count and length */
+  hdr[0]++;
+  GST_WRITE_UINT16_BE (hdr + 2, GST_READ_UINT16_BE (hdr + 2) + 6);
+
+  return TRUE;
+}
+
+/**
+ * gst_rtcp_writer_add_fb:
+ * @writer: a #GstRTCPWriter
+ * @type: %GST_RTCP_TYPE_RTPFB or %GST_RTCP_TYPE_PSFB
+ * @fbtype: the #GstRTCPFBType
+ * @sender_ssrc: the sender SSRC
+ * @media_ssrc: the media source SSRC
+ * @fci: (array length=fci_len) (allow-none): the Feedback Control Information
+ * @fci_len: the length of @fci in bytes, a multiple of 4
+ *
+ * Add a new feedback packet with the given FCI.
+ *
+ * Returns: %TRUE if the packet was added, %FALSE if there was not enough
+ *    space left.
+ *
+ * Since: 1.16
+ */
+gboolean
+gst_rtcp_writer_add_fb (GstRTCPWriter * writer, GstRTCPType type,
+    GstRTCPFBType fbtype, guint32 sender_ssrc, guint32 media_ssrc,
+    const guint8 * fci, guint fci_len)
+{
+  guint8 *p;
+
+  g_return_val_if_fail (writer != NULL, FALSE);
+  g_return_val_if_fail (type == GST_RTCP_TYPE_RTPFB
+      || type == GST_RTCP_TYPE_PSFB, FALSE);
+  g_return_val_if_fail (fci != NULL || fci_len == 0, FALSE);
+  g_return_val_if_fail ((fci_len & 0x3) == 0, FALSE);
+  g_return_val_if_fail (fci_len <= G_MAXUINT16 * 4 - 8, FALSE);
+
+  if (!(p = writer_start_packet (writer, type, fbtype, fci_len + 8)))
+    return FALSE;
+
+  GST_WRITE_UINT32_BE (p, sender_ssrc);
+  GST_WRITE_UINT32_BE (p + 4, media_ssrc);
+  if (fci_len)
+    memcpy (p + 8, fci, fci_len);
+
+  return TRUE;
+}
+
+/**
+ * gst_rtcp_writer_add_packet:
+ * @writer: a #GstRTCPWriter
+ * @type: the #GstRTCPType
+ * @count: the count field of the header
+ * @data: (array length=len) (allow-none): the packet data after the header
+ * @len: the length of @data in bytes, a multiple of 4
+ *
+ * Add a new packet of @type with @data copied after the header. This can be
+ * used for packets that are already serialized, such as SDES chunks, BYE or
+ * APP packets.
+ *
+ * Returns: %TRUE if the packet was added, %FALSE if there was not enough
+ *    space left.
+ *
+ * Since: 1.16
+ */
+gboolean
+gst_rtcp_writer_add_packet (GstRTCPWriter * writer, GstRTCPType type,
+    guint8 count, const guint8 * data, guint len)
+{
+  guint8 *p;
+
+  g_return_val_if_fail (writer != NULL, FALSE);
+  g_return_val_if_fail (count <= 0x1f, FALSE);
+  g_return_val_if_fail (data != NULL || len == 0, FALSE);
+  g_return_val_if_fail ((len & 0x3) == 0, FALSE);
+  g_return_val_if_fail (len <= G_MAXUINT16 * 4, FALSE);
+
+  if (!(p = writer_start_packet (writer, type, count, len)))
+    return FALSE;
+
+  if (len)
+    memcpy (p, data, len);
+
+  return TRUE;
+}
@@ -465,6 +465,131 @@ gboolean        gst_rtcp_packet_fb_set_fci_length     (GstRTCPPacket *packet, gu
 GST_RTP_API
 guint8 *        gst_rtcp_packet_fb_get_fci            (GstRTCPPacket *packet);
 
+/* single pass decoding */
+
+typedef struct _GstRTCPPacketInfo GstRTCPPacketInfo;
+
+/**
+ * GstRTCPPacketInfo:
+ * @type: the packet type
+ * @count: the count field of the header: the number of report blocks, SDES
+ *    chunks or BYE SSRCs, the #GstRTCPFBType of feedback packets or the
+ *    subtype of APP packets
+ * @padding: if the packet has padding
+ * @offset: offset of the packet in the compound data
+ * @size: size of the packet in bytes, including the header and padding
+ * @ssrc: the sender SSRC of SR, RR, APP, XR and feedback packets or the first
+ *    SSRC of SDES and BYE packets, 0 when there is none
+ * @media_ssrc: the media source SSRC of feedback packets
+ * @ntptime: the NTP time of SR packets
+ * @rtptime: the RTP time of SR packets
+ * @packet_count: the packet count of SR packets
+ * @octet_count: the octet count of SR packets
+ * @rb_offset: offset of the first report block of SR and RR packets in the
+ *    compound data
+ * @rb_count: the number of report blocks of SR and RR packets
+ * @data_offset: offset in the compound data of the FCI of feedback packets,
+ *    the profile specific extension of SR and RR packets, the data of APP
+ *    packets, the report blocks of XR packets and everything after the header
+ *    of other packets
+ * @data_size: size of the data at @data_offset in bytes, without padding
+ *
+ * Describes one packet of a compound RTCP packet as filled in by
+ * gst_rtcp_buffer_decode_data().
+ *
+ * Since: 1.16
+ */
+struct _GstRTCPPacketInfo
+{
+  GstRTCPType type;
+  guint8      count;
+  gboolean    padding;
+  guint       offset;
+  guint       size;
+
+  guint32     ssrc;
+  guint32     media_ssrc;
+
+  guint64     ntptime;
+  guint32     rtptime;
+  guint32     packet_count;
+  guint32     octet_count;
+
+  guint       rb_offset;
+  guint       rb_count;
+
+  guint       data_offset;
+  guint       data_size;
+};
+
+GST_RTP_API
+gboolean        gst_rtcp_buffer_decode_data           (const guint8 *data, guint len,
+                                                       gboolean reduced,
+                                                       GstRTCPPacketInfo *packets,
+                                                       guint *n_packets);
+
+GST_RTP_API
+void            gst_rtcp_packet_info_get_rb           (const GstRTCPPacketInfo *info,
+                                                       const guint8 *data, guint nth,
+                                                       guint32 *ssrc, guint8 *fractionlost,
+                                                       gint32 *packetslost, guint32 *exthighestseq,
+                                                       guint32 *jitter, guint32 *lsr,
+                                                       guint32 *dlsr);
+
+/* writing compound packets */
+
+typedef struct _GstRTCPWriter GstRTCPWriter;
+
+/**
+ * GstRTCPWriter:
+ * @data: the memory to write to
+ * @size: the size of @data
+ * @offset: the number of bytes written
+ *
+ * Writes a compound RTCP packet directly into @data. Initialize with
+ * gst_rtcp_writer_init(), the structure can be allocated on the stack.
+ *
+ * Since: 1.16
+ */
+struct _GstRTCPWriter
+{
+  guint8 *data;
+  guint   size;
+  guint   offset;
+
+  /*< private >*/
+  guint   packet;
+};
+
+GST_RTP_API
+void            gst_rtcp_writer_init                  (GstRTCPWriter *writer, guint8 *data,
+                                                       guint size);
+
+GST_RTP_API
+gboolean        gst_rtcp_writer_add_sr                (GstRTCPWriter *writer, guint32 ssrc,
+                                                       guint64 ntptime, guint32 rtptime,
+                                                       guint32 packet_count, guint32 octet_count);
+
+GST_RTP_API
+gboolean        gst_rtcp_writer_add_rr                (GstRTCPWriter *writer, guint32 ssrc);
+
+GST_RTP_API
+gboolean        gst_rtcp_writer_add_rb                (GstRTCPWriter *writer, guint32 ssrc,
+                                                       guint8 fractionlost, gint32 packetslost,
+                                                       guint32 exthighestseq, guint32 jitter,
+                                                       guint32 lsr, guint32 dlsr);
+
+GST_RTP_API
+gboolean        gst_rtcp_writer_add_fb                (GstRTCPWriter *writer, GstRTCPType type,
+                                                       GstRTCPFBType fbtype, guint32 sender_ssrc,
+                                                       guint32 media_ssrc, const guint8 *fci,
+                                                       guint fci_len);
+
+GST_RTP_API
+gboolean        gst_rtcp_writer_add_packet            (GstRTCPWriter *writer, GstRTCPType type,
+                                                       guint8 count, const guint8 *data,
+                                                       guint len);
+
 /* helper functions */
 
 GST_RTP_API
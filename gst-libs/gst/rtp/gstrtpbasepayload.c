@@ -62,8 +62,118 @@ struct _GstRTPBasePayloadPrivate
 
   GstCaps *subclass_srccaps;
   GstCaps *sinkcaps;
+
+  /* protected by the object lock, used from the streaming thread */
+  GstBufferPool *pool;
+  /* statistics of gst_rtp_base_payload_allocate_output_buffer(), protected
+   * by the object lock */
+  guint64 pool_hits;
+  guint64 pool_misses;
+
+  guint max_list_size;
+  guint64 flush_latency;
+  /* the thread that is handling an input buffer, only packets pushed from
+   * it are collected. Accessed atomically */
+  GThread *chain_thread;
+  /* packets that are collected for the next push, protected by the object
+   * lock */
+  GstBufferList *pending_list;
 };
 
+/* A pool of MTU sized buffers for the RTP packets. Subclasses either write the
+ * payload into the buffer or append the payload memory to the header, the
+ * appended memory is removed again when the buffer is returned to the pool so
+ * that the header memory can be reused. */
+#define GST_TYPE_RTP_PAYLOAD_POOL (gst_rtp_payload_pool_get_type ())
+#define GST_RTP_PAYLOAD_POOL_CAST(obj) ((GstRTPPayloadPool *)(obj))
+
+typedef struct
+{
+  GstBufferPool parent;
+
+  guint size;
+  /* number of buffers allocated by the pool, only changed from
+   * acquire_buffer */
+  guint n_allocated;
+} GstRTPPayloadPool;
+
+typedef struct
+{
+  GstBufferPoolClass parent_class;
+} GstRTPPayloadPoolClass;
+
+static GType gst_rtp_payload_pool_get_type (void);
+
+G_DEFINE_TYPE (GstRTPPayloadPool, gst_rtp_payload_pool, GST_TYPE_BUFFER_POOL);
+
+static gboolean
+gst_rtp_payload_pool_set_config (GstBufferPool * pool, GstStructure * config)
+{
+  GstRTPPayloadPool *rtppool = GST_RTP_PAYLOAD_POOL_CAST (pool);
+
+  if (!gst_buffer_pool_config_get_params (config, NULL, &rtppool->size, NULL,
+          NULL))
+    return FALSE;
+
+  return GST_BUFFER_POOL_CLASS (gst_rtp_payload_pool_parent_class)->set_config
+      (pool, config);
+}
+
+static GstFlowReturn
+gst_rtp_payload_pool_alloc_buffer (GstBufferPool * pool, GstBuffer ** buffer,
+    GstBufferPoolAcquireParams * params)
+{
+  GstRTPPayloadPool *rtppool = GST_RTP_PAYLOAD_POOL_CAST (pool);
+  GstFlowReturn ret;
+
+  ret =
+      GST_BUFFER_POOL_CLASS (gst_rtp_payload_pool_parent_class)->alloc_buffer
+      (pool, buffer, params);
+  if (ret == GST_FLOW_OK)
+    rtppool->n_allocated++;
+
+  return ret;
+}
+
+static void
+gst_rtp_payload_pool_reset_buffer (GstBufferPool * pool, GstBuffer * buffer)
+{
+  GstRTPPayloadPool *rtppool = GST_RTP_PAYLOAD_POOL_CAST (pool);
+  guint n_mem;
+
+  n_mem = gst_buffer_n_memory (buffer);
+  if (n_mem > 0) {
+    GstMemory *mem = gst_buffer_peek_memory (buffer, 0);
+
+    /* only restore buffers whose first memory can still hold a packet,
+     * anything else stays tagged and is discarded by the pool */
+    if (mem->maxsize - mem->offset >= rtppool->size) {
+      if (n_mem > 1)
+        gst_buffer_remove_memory_range (buffer, 1, -1);
+      gst_buffer_set_size (buffer, rtppool->size);
+      GST_BUFFER_FLAG_UNSET (buffer, GST_BUFFER_FLAG_TAG_MEMORY);
+    }
+  }
+
+  GST_BUFFER_POOL_CLASS (gst_rtp_payload_pool_parent_class)->reset_buffer
+      (pool, buffer);
+}
+
+static void
+gst_rtp_payload_pool_class_init (GstRTPPayloadPoolClass * klass)
+{
+  GstBufferPoolClass *pool_class = (GstBufferPoolClass *) klass;
+
+  pool_class->set_config = gst_rtp_payload_pool_set_config;
+  pool_class->alloc_buffer = gst_rtp_payload_pool_alloc_buffer;
+  pool_class->reset_buffer = gst_rtp_payload_pool_reset_buffer;
+}
+
+static void
+gst_rtp_payload_pool_init (GstRTPPayloadPool * pool)
+{
+}
+
 /* RTPBasePayload signals and args */
 enum
 {
@@ -87,6 +197,8 @@ enum
 #define DEFAULT_PERFECT_RTPTIME         TRUE
 #define DEFAULT_PTIME_MULTIPLE          0
 #define DEFAULT_RUNNING_TIME            GST_CLOCK_TIME_NONE
+#define DEFAULT_MAX_LIST_SIZE           64
+#define DEFAULT_FLUSH_LATENCY           0
 
 enum
 {
@@ -103,6 +215,8 @@ enum
   PROP_PERFECT_RTPTIME,
   PROP_PTIME_MULTIPLE,
   PROP_STATS,
+  PROP_MAX_LIST_SIZE,
+  PROP_FLUSH_LATENCY,
   PROP_LAST
 };
 
@@ -122,6 +236,8 @@ static gboolean gst_rtp_base_payload_src_event_default (GstRTPBasePayload *
     rtpbasepayload, GstEvent * event);
 static gboolean gst_rtp_base_payload_src_event (GstPad * pad,
     GstObject * parent, GstEvent * event);
+static gboolean gst_rtp_base_payload_src_query (GstPad * pad,
+    GstObject * parent, GstQuery * query);
 static gboolean gst_rtp_base_payload_query_default (GstRTPBasePayload *
     rtpbasepayload, GstPad * pad, GstQuery * query);
 static gboolean gst_rtp_base_payload_query (GstPad * pad, GstObject * parent,
@@ -138,6 +254,12 @@ static GstStateChangeReturn gst_rtp_base_payload_change_state (GstElement *
     element, GstStateChange transition);
 
 static gboolean gst_rtp_base_payload_negotiate (GstRTPBasePayload * payload);
+static void gst_rtp_base_payload_clear_pool (GstRTPBasePayload * payload);
+static GstFlowReturn gst_rtp_base_payload_flush_pending (GstRTPBasePayload *
+    payload);
+static gboolean gst_rtp_base_payload_pending_filled (GstRTPBasePayload *
+    payload);
+static void gst_rtp_base_payload_clear_pending (GstRTPBasePayload * payload);
 
 
 static GstElementClass *parent_class = NULL;
@@ -284,11 +406,53 @@ gst_rtp_base_payload_class_init (GstRTPBasePayloadClass * klass)
    *   * `pt` :#G_TYPE_UINT, The Payload type in use, same as #GstRTPBasePayload:pt
    *   * `seqnum-offset` :#G_TYPE_UINT, The current offset added to the seqnum
    *   * `timestamp-offset` :#G_TYPE_UINT, The current offset added to the timestamp
+   *   * `pool-hits` :#G_TYPE_UINT64, The number of packets from
+   *     gst_rtp_base_payload_allocate_output_buffer() that reused the memory
+   *     of an earlier packet (Since 1.16)
+   *   * `pool-misses` :#G_TYPE_UINT64, The number of packets from
+   *     gst_rtp_base_payload_allocate_output_buffer() that needed new memory
+   *     (Since 1.16)
    **/
   g_object_class_install_property (G_OBJECT_CLASS (klass), PROP_STATS,
       g_param_spec_boxed ("stats", "Statistics", "Various statistics",
           GST_TYPE_STRUCTURE, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstRTPBasePayload:max-list-size:
+   *
+   * The packets that are pushed with gst_rtp_base_payload_push() or
+   * gst_rtp_base_payload_push_list() while handling an input buffer are
+   * collected and pushed downstream together in one #GstBufferList of at most
+   * this many packets. 0 and 1 push every packet separately.
+   *
+   * Since: 1.16
+   */
+  g_object_class_install_property (G_OBJECT_CLASS (klass), PROP_MAX_LIST_SIZE,
+      g_param_spec_uint ("max-list-size", "Maximum list size",
+          "Maximum number of packets to push in one buffer list "
+          "(0 and 1 disable buffer lists)", 0, G_MAXUINT,
+          DEFAULT_MAX_LIST_SIZE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstRTPBasePayload:flush-latency:
+   *
+   * By default the collected packets are pushed after each input buffer. With
+   * a flush latency, packets of the following input buffers are added to the
+   * same #GstBufferList until the timestamps in the list span this duration
+   * or #GstRTPBasePayload:max-list-size is reached. Serialized events and
+   * packets pushed outside of the handling of an input buffer always push the
+   * collected packets first. The flush latency is added to the latency that
+   * is reported downstream.
+   *
+   * Since: 1.16
+   */
+  g_object_class_install_property (G_OBJECT_CLASS (klass), PROP_FLUSH_LATENCY,
+      g_param_spec_uint64 ("flush-latency", "Flush latency",
+          "Maximum duration in ns of the packets collected over several input "
+          "buffers before they are pushed (0 = push after each input buffer)",
+          0, G_MAXUINT64, DEFAULT_FLUSH_LATENCY,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   gstelement_class->change_state = gst_rtp_base_payload_change_state;
 
   klass->get_caps = gst_rtp_base_payload_getcaps_default;
@@ -316,6 +480,8 @@ gst_rtp_base_payload_init (GstRTPBasePayload * rtpbasepayload, gpointer g_class)
   rtpbasepayload->srcpad = gst_pad_new_from_template (templ, "src");
   gst_pad_set_event_function (rtpbasepayload->srcpad,
       gst_rtp_base_payload_src_event);
+  gst_pad_set_query_function (rtpbasepayload->srcpad,
+      gst_rtp_base_payload_src_query);
   gst_element_add_pad (GST_ELEMENT (rtpbasepayload), rtpbasepayload->srcpad);
 
   templ =
@@ -356,6 +522,9 @@ gst_rtp_base_payload_init (GstRTPBasePayload * rtpbasepayload, gpointer g_class)
 
   rtpbasepayload->priv->caps_max_ptime = DEFAULT_MAX_PTIME;
   rtpbasepayload->priv->prop_max_ptime = DEFAULT_MAX_PTIME;
+
+  priv->max_list_size = DEFAULT_MAX_LIST_SIZE;
+  priv->flush_latency = DEFAULT_FLUSH_LATENCY;
 }
 
 static void
@@ -373,6 +542,10 @@ gst_rtp_base_payload_finalize (GObject * object)
   gst_caps_replace (&rtpbasepayload->priv->subclass_srccaps, NULL);
   gst_caps_replace (&rtpbasepayload->priv->sinkcaps, NULL);
 
+  gst_rtp_base_payload_clear_pool (rtpbasepayload);
+  if (rtpbasepayload->priv->pending_list)
+    gst_buffer_list_unref (rtpbasepayload->priv->pending_list);
+
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
@@ -470,6 +643,13 @@ gst_rtp_base_payload_sink_event (GstPad * pad, GstObject * parent,
   rtpbasepayload = GST_RTP_BASE_PAYLOAD (parent);
   rtpbasepayload_class = GST_RTP_BASE_PAYLOAD_GET_CLASS (rtpbasepayload);
 
+  /* keep the collected packets in order with the serialized events */
+  if (GST_EVENT_TYPE (event) == GST_EVENT_FLUSH_STOP) {
+    gst_rtp_base_payload_clear_pending (rtpbasepayload);
+  } else if (GST_EVENT_IS_SERIALIZED (event)) {
+    gst_rtp_base_payload_flush_pending (rtpbasepayload);
+  }
+
   if (rtpbasepayload_class->sink_event)
     res = rtpbasepayload_class->sink_event (rtpbasepayload, event);
   else
@@ -556,6 +736,51 @@ gst_rtp_base_payload_src_event (GstPad * pad, GstObject * parent,
   return res;
 }
 
+static gboolean
+gst_rtp_base_payload_src_query (GstPad * pad, GstObject * parent,
+    GstQuery * query)
+{
+  GstRTPBasePayload *rtpbasepayload;
+  gboolean res = FALSE;
+
+  rtpbasepayload = GST_RTP_BASE_PAYLOAD (parent);
+
+  switch (GST_QUERY_TYPE (query)) {
+    case GST_QUERY_LATENCY:
+    {
+      gboolean live;
+      GstClockTime min_latency, max_latency;
+      guint64 flush_latency;
+
+      res = gst_pad_peer_query (rtpbasepayload->sinkpad, query);
+      if (res) {
+        gst_query_parse_latency (query, &live, &min_latency, &max_latency);
+
+        /* packets can be held back for up to the flush latency */
+        GST_OBJECT_LOCK (rtpbasepayload);
+        flush_latency = rtpbasepayload->priv->flush_latency;
+        GST_OBJECT_UNLOCK (rtpbasepayload);
+
+        min_latency += flush_latency;
+        if (GST_CLOCK_TIME_IS_VALID (max_latency))
+          max_latency += flush_latency;
+
+        GST_DEBUG_OBJECT (rtpbasepayload, "latency min %" GST_TIME_FORMAT
+            " max %" GST_TIME_FORMAT, GST_TIME_ARGS (min_latency),
+            GST_TIME_ARGS (max_latency));
+
+        gst_query_set_latency (query, live, min_latency, max_latency);
+      }
+      break;
+    }
+    default:
+      res = gst_pad_query_default (pad, parent, query);
+      break;
+  }
+
+  return res;
+}
+
 
 static gboolean
 gst_rtp_base_payload_query_default (GstRTPBasePayload * rtpbasepayload,
@@ -634,7 +859,18 @@ gst_rtp_base_payload_chain (GstPad * pad, GstObject * parent,
     }
   }
 
+  g_atomic_pointer_set (&rtpbasepayload->priv->chain_thread, g_thread_self ());
   ret = rtpbasepayload_class->handle_buffer (rtpbasepayload, buffer);
+  g_atomic_pointer_set (&rtpbasepayload->priv->chain_thread, NULL);
+
+  if (ret != GST_FLOW_OK ||
+      gst_rtp_base_payload_pending_filled (rtpbasepayload)) {
+    GstFlowReturn flush_ret;
+
+    flush_ret = gst_rtp_base_payload_flush_pending (rtpbasepayload);
+    if (ret == GST_FLOW_OK)
+      ret = flush_ret;
+  }
 
   return ret;
 
@@ -771,6 +1007,9 @@ gst_rtp_base_payload_negotiate (GstRTPBasePayload * payload)
   GstStructure *s, *d;
   gboolean res;
 
+  /* the collected packets belong to the previous caps */
+  gst_rtp_base_payload_flush_pending (payload);
+
   payload->priv->caps_max_ptime = DEFAULT_MAX_PTIME;
   payload->ptime = 0;
 
@@ -1058,6 +1297,10 @@ gst_rtp_base_payload_negotiate (GstRTPBasePayload * payload)
   gst_caps_unref (srccaps);
   gst_caps_unref (templ);
 
+  /* the allocation parameters of downstream might have changed */
+  if (res)
+    gst_rtp_base_payload_clear_pool (payload);
+
 out:
 
   if (!res)
@@ -1091,6 +1334,174 @@ gst_rtp_base_payload_is_filled (GstRTPBasePayload * payload,
   return FALSE;
 }
 
+static void
+gst_rtp_base_payload_clear_pool (GstRTPBasePayload * payload)
+{
+  GstBufferPool *pool;
+
+  GST_OBJECT_LOCK (payload);
+  pool = payload->priv->pool;
+  payload->priv->pool = NULL;
+  GST_OBJECT_UNLOCK (payload);
+
+  if (pool) {
+    gst_buffer_pool_set_active (pool, FALSE);
+    gst_object_unref (pool);
+  }
+}
+
+/* make a new pool for packets of @size bytes, using the allocator and
+ * params of downstream when it has them */
+static GstBufferPool *
+gst_rtp_base_payload_create_pool (GstRTPBasePayload * payload, guint size)
+{
+  GstBufferPool *pool;
+  GstStructure *config;
+  GstAllocator *allocator = NULL;
+  GstAllocationParams params;
+  GstCaps *caps;
+
+  gst_allocation_params_init (&params);
+
+  caps = gst_pad_get_current_caps (payload->srcpad);
+  if (caps) {
+    GstQuery *query;
+
+    query = gst_query_new_allocation (caps, FALSE);
+    if (gst_pad_peer_query (payload->srcpad, query) &&
+        gst_query_get_n_allocation_params (query) > 0)
+      gst_query_parse_nth_allocation_param (query, 0, &allocator, &params);
+    gst_query_unref (query);
+    gst_caps_unref (caps);
+  }
+
+  pool = g_object_new (GST_TYPE_RTP_PAYLOAD_POOL, NULL);
+  config = gst_buffer_pool_get_config (pool);
+  gst_buffer_pool_config_set_params (config, NULL, size, 0, 0);
+  gst_buffer_pool_config_set_allocator (config, allocator, &params);
+  if (allocator)
+    gst_object_unref (allocator);
+
+  if (!gst_buffer_pool_set_config (pool, config) ||
+      !gst_buffer_pool_set_active (pool, TRUE)) {
+    GST_WARNING_OBJECT (payload, "failed to configure buffer pool");
+    gst_object_unref (pool);
+    return NULL;
+  }
+
+  GST_DEBUG_OBJECT (payload, "created pool %" GST_PTR_FORMAT
+      " for packets of %u bytes", pool, size);
+
+  return pool;
+}
+
+/* get a packet of @size bytes from the pool, returns NULL when the pool
+ * cannot be used */
+static GstBuffer *
+gst_rtp_base_payload_acquire_buffer (GstRTPBasePayload * payload, gsize size)
+{
+  GstRTPBasePayloadPrivate *priv = payload->priv;
+  GstBufferPool *pool;
+  GstBuffer *buffer = NULL;
+  guint mtu, n_allocated;
+
+  mtu = payload->mtu;
+  if (size > mtu)
+    return NULL;
+
+  GST_OBJECT_LOCK (payload);
+  pool = priv->pool ? gst_object_ref (priv->pool) : NULL;
+  GST_OBJECT_UNLOCK (payload);
+
+  /* make a new pool when the mtu changed */
+  if (pool == NULL || GST_RTP_PAYLOAD_POOL_CAST (pool)->size != mtu) {
+    if (pool)
+      gst_object_unref (pool);
+    gst_rtp_base_payload_clear_pool (payload);
+
+    pool = gst_rtp_base_payload_create_pool (payload, mtu);
+    if (pool == NULL)
+      return NULL;
+
+    GST_OBJECT_LOCK (payload);
+    priv->pool = gst_object_ref (pool);
+    GST_OBJECT_UNLOCK (payload);
+  }
+
+  n_allocated = GST_RTP_PAYLOAD_POOL_CAST (pool)->n_allocated;
+  if (gst_buffer_pool_acquire_buffer (pool, &buffer, NULL) == GST_FLOW_OK) {
+    GST_OBJECT_LOCK (payload);
+    if (GST_RTP_PAYLOAD_POOL_CAST (pool)->n_allocated == n_allocated)
+      priv->pool_hits++;
+    else
+      priv->pool_misses++;
+    GST_OBJECT_UNLOCK (payload);
+    gst_buffer_set_size (buffer, size);
+  }
+  gst_object_unref (pool);
+
+  return buffer;
+}
+
+/**
+ * gst_rtp_base_payload_allocate_output_buffer:
+ * @payload: a #GstRTPBasePayload
+ * @payload_len: the length of the payload
+ * @pad_len: the amount of padding
+ * @csrc_count: the minimum number of CSRC entries
+ *
+ * Allocate a new #GstBuffer with enough data to hold an RTP packet with
+ * @csrc_count CSRCs, a payload length of @payload_len and padding of @pad_len.
+ * All other RTP header fields will be set to 0/FALSE, like with
+ * gst_rtp_buffer_new_allocate().
+ *
+ * Packets that fit in the configured MTU are taken from a pool that is owned
+ * by @payload, so that their memory is reused for the next packets once
+ * downstream has released them. Payload memory can be added to the packet
+ * without copying with gst_buffer_append(), it will be removed again when
+ * the packet is returned to the pool.
+ *
+ * The number of packets that were reused or had to be allocated is available
+ * in the #GstRTPBasePayload:stats property.
+ *
+ * Returns: (transfer full): A newly allocated buffer that can hold an RTP
+ * packet with given parameters.
+ *
+ * Since: 1.16
+ */
+GstBuffer *
+gst_rtp_base_payload_allocate_output_buffer (GstRTPBasePayload * payload,
+    guint payload_len, guint8 pad_len, guint8 csrc_count)
+{
+  GstBuffer *buffer;
+  GstMapInfo map;
+  guint hlen;
+
+  g_return_val_if_fail (GST_IS_RTP_BASE_PAYLOAD (payload), NULL);
+  g_return_val_if_fail (csrc_count <= 15, NULL);
+
+  hlen = gst_rtp_buffer_calc_header_len (csrc_count);
+
+  buffer = gst_rtp_base_payload_acquire_buffer (payload,
+      hlen + payload_len + pad_len);
+  if (buffer == NULL) {
+    GST_OBJECT_LOCK (payload);
+    payload->priv->pool_misses++;
+    GST_OBJECT_UNLOCK (payload);
+    return gst_rtp_buffer_new_allocate (payload_len, pad_len, csrc_count);
+  }
+
+  /* fill in the defaults of the header and the padding */
+  gst_buffer_map (buffer, &map, GST_MAP_WRITE);
+  memset (map.data, 0, hlen);
+  map.data[0] = (GST_RTP_VERSION << 6) | (pad_len ? 0x20 : 0) | csrc_count;
+  if (pad_len)
+    map.data[map.size - 1] = pad_len;
+  gst_buffer_unmap (buffer, &map);
+
+  return buffer;
+}
+
 typedef struct
 {
   GstRTPBasePayload *payload;
@@ -1274,6 +1685,134 @@ no_rate:
   }
 }
 
+/* push the pending segment before the first data */
+static void
+gst_rtp_base_payload_push_pending_segment (GstRTPBasePayload * payload)
+{
+  if (G_UNLIKELY (payload->priv->pending_segment)) {
+    gst_pad_push_event (payload->srcpad, payload->priv->pending_segment);
+    payload->priv->pending_segment = FALSE;
+    payload->priv->delay_segment = FALSE;
+  }
+}
+
+/* push all collected packets downstream, a single packet is pushed as a
+ * buffer */
+static GstFlowReturn
+gst_rtp_base_payload_flush_pending (GstRTPBasePayload * payload)
+{
+  GstBufferList *list;
+
+  GST_OBJECT_LOCK (payload);
+  list = payload->priv->pending_list;
+  payload->priv->pending_list = NULL;
+  GST_OBJECT_UNLOCK (payload);
+
+  if (list == NULL)
+    return GST_FLOW_OK;
+
+  GST_LOG_OBJECT (payload, "pushing list of %u packets",
+      gst_buffer_list_length (list));
+
+  gst_rtp_base_payload_push_pending_segment (payload);
+
+  if (gst_buffer_list_length (list) == 1) {
+    GstBuffer *buffer = gst_buffer_ref (gst_buffer_list_get (list, 0));
+
+    gst_buffer_list_unref (list);
+    return gst_pad_push (payload->srcpad, buffer);
+  }
+  return gst_pad_push_list (payload->srcpad, list);
+}
+
+/* drop the collected packets */
+static void
+gst_rtp_base_payload_clear_pending (GstRTPBasePayload * payload)
+{
+  GstBufferList *list;
+
+  GST_OBJECT_LOCK (payload);
+  list = payload->priv->pending_list;
+  payload->priv->pending_list = NULL;
+  GST_OBJECT_UNLOCK (payload);
+
+  if (list)
+    gst_buffer_list_unref (list);
+}
+
+/* check if the collected packets need to be pushed at the end of the input
+ * buffer */
+static gboolean
+gst_rtp_base_payload_pending_filled (GstRTPBasePayload * payload)
+{
+  GstRTPBasePayloadPrivate *priv = payload->priv;
+  GstBufferList *list;
+  GstClockTime first, last;
+  gboolean res;
+  guint len;
+
+  GST_OBJECT_LOCK (payload);
+  list = priv->pending_list;
+  if (list == NULL) {
+    res = FALSE;
+    goto done;
+  }
+
+  len = gst_buffer_list_length (list);
+  if (priv->flush_latency == 0 || len >= priv->max_list_size) {
+    res = TRUE;
+    goto done;
+  }
+
+  first = GST_BUFFER_PTS (gst_buffer_list_get (list, 0));
+  last = GST_BUFFER_PTS (gst_buffer_list_get (list, len - 1));
+  if (!GST_CLOCK_TIME_IS_VALID (first) || !GST_CLOCK_TIME_IS_VALID (last))
+    res = TRUE;
+  else
+    res = last >= first + priv->flush_latency;
+
+done:
+  GST_OBJECT_UNLOCK (payload);
+
+  return res;
+}
+
+/* packets are only collected when they are pushed from the thread that is
+ * handling an input buffer, pushes from other threads go out directly */
+static gboolean
+gst_rtp_base_payload_is_collecting (GstRTPBasePayload * payload)
+{
+  return payload->priv->max_list_size > 1 &&
+      g_atomic_pointer_get (&payload->priv->chain_thread) == g_thread_self ();
+}
+
+/* add @buffer to the collected packets while handling an input buffer,
+ * takes ownership of @buffer. Returns %FALSE when packets are not collected */
+static gboolean
+gst_rtp_base_payload_add_pending (GstRTPBasePayload * payload,
+    GstBuffer * buffer, GstFlowReturn * ret)
+{
+  GstRTPBasePayloadPrivate *priv = payload->priv;
+  gboolean full;
+
+  if (!gst_rtp_base_payload_is_collecting (payload))
+    return FALSE;
+
+  GST_OBJECT_LOCK (payload);
+  if (priv->pending_list == NULL)
+    priv->pending_list = gst_buffer_list_new_sized (priv->max_list_size);
+  gst_buffer_list_add (priv->pending_list, buffer);
+  full = gst_buffer_list_length (priv->pending_list) >= priv->max_list_size;
+  GST_OBJECT_UNLOCK (payload);
+
+  if (full)
+    *ret = gst_rtp_base_payload_flush_pending (payload);
+  else
+    *ret = GST_FLOW_OK;
+
+  return TRUE;
+}
+
 /**
  * gst_rtp_base_payload_push_list:
  * @payload: a #GstRTPBasePayload
@@ -1282,6 +1821,9 @@ no_rate:
  * Push @list to the peer element of the payloader. The SSRC, payload type,
  * seqnum and timestamp of the RTP buffer will be updated first.
  *
+ * While handling an input buffer, the buffers of @list might be collected
+ * with other packets and pushed later, see #GstRTPBasePayload:max-list-size.
+ *
  * This function takes ownership of @list.
  *
  * Returns: a #GstFlowReturn.
@@ -1295,12 +1837,23 @@ gst_rtp_base_payload_push_list (GstRTPBasePayload * payload,
   res = gst_rtp_base_payload_prepare_push (payload, list, TRUE);
 
   if (G_LIKELY (res == GST_FLOW_OK)) {
-    if (G_UNLIKELY (payload->priv->pending_segment)) {
-      gst_pad_push_event (payload->srcpad, payload->priv->pending_segment);
-      payload->priv->pending_segment = FALSE;
-      payload->priv->delay_segment = FALSE;
+    if (gst_rtp_base_payload_is_collecting (payload)) {
+      guint i, len;
+
+      len = gst_buffer_list_length (list);
+      for (i = 0; i < len && res == GST_FLOW_OK; i++)
+        gst_rtp_base_payload_add_pending (payload,
+            gst_buffer_ref (gst_buffer_list_get (list, i)), &res);
+      gst_buffer_list_unref (list);
+    } else {
+      res = gst_rtp_base_payload_flush_pending (payload);
+      if (G_LIKELY (res == GST_FLOW_OK)) {
+        gst_rtp_base_payload_push_pending_segment (payload);
+        res = gst_pad_push_list (payload->srcpad, list);
+      } else {
+        gst_buffer_list_unref (list);
+      }
     }
-    res = gst_pad_push_list (payload->srcpad, list);
   } else {
     gst_buffer_list_unref (list);
   }
@@ -1316,6 +1869,10 @@ gst_rtp_base_payload_push_list (GstRTPBasePayload * payload,
  * Push @buffer to the peer element of the payloader. The SSRC, payload type,
  * seqnum and timestamp of the RTP buffer will be updated first.
  *
+ * While handling an input buffer, @buffer might be collected with other
+ * packets and pushed later in a #GstBufferList, see
+ * #GstRTPBasePayload:max-list-size.
+ *
  * This function takes ownership of @buffer.
  *
  * Returns: a #GstFlowReturn.
@@ -1328,12 +1885,16 @@ gst_rtp_base_payload_push (GstRTPBasePayload * payload, GstBuffer * buffer)
   res = gst_rtp_base_payload_prepare_push (payload, buffer, FALSE);
 
   if (G_LIKELY (res == GST_FLOW_OK)) {
-    if (G_UNLIKELY (payload->priv->pending_segment)) {
-      gst_pad_push_event (payload->srcpad, payload->priv->pending_segment);
-      payload->priv->pending_segment = FALSE;
-      payload->priv->delay_segment = FALSE;
+    if (gst_rtp_base_payload_add_pending (payload, buffer, &res))
+      return res;
+
+    res = gst_rtp_base_payload_flush_pending (payload);
+    if (G_LIKELY (res == GST_FLOW_OK)) {
+      gst_rtp_base_payload_push_pending_segment (payload);
+      res = gst_pad_push (payload->srcpad, buffer);
+    } else {
+      gst_buffer_unref (buffer);
     }
-    res = gst_pad_push (payload->srcpad, buffer);
   } else {
     gst_buffer_unref (buffer);
   }
@@ -1346,9 +1907,15 @@ gst_rtp_base_payload_create_stats (GstRTPBasePayload * rtpbasepayload)
 {
   GstRTPBasePayloadPrivate *priv;
   GstStructure *s;
+  guint64 pool_hits, pool_misses;
 
   priv = rtpbasepayload->priv;
 
+  GST_OBJECT_LOCK (rtpbasepayload);
+  pool_hits = priv->pool_hits;
+  pool_misses = priv->pool_misses;
+  GST_OBJECT_UNLOCK (rtpbasepayload);
+
   s = gst_structure_new ("application/x-rtp-payload-stats",
       "clock-rate", G_TYPE_UINT, (guint) rtpbasepayload->clock_rate,
       "running-time", G_TYPE_UINT64, priv->running_time,
@@ -1357,7 +1924,9 @@ gst_rtp_base_payload_create_stats (GstRTPBasePayload * rtpbasepayload)
       "ssrc", G_TYPE_UINT, rtpbasepayload->current_ssrc,
       "pt", G_TYPE_UINT, rtpbasepayload->pt,
       "seqnum-offset", G_TYPE_UINT, (guint) rtpbasepayload->seqnum_base,
-      "timestamp-offset", G_TYPE_UINT, (guint) rtpbasepayload->ts_base, NULL);
+      "timestamp-offset", G_TYPE_UINT, (guint) rtpbasepayload->ts_base,
+      "pool-hits", G_TYPE_UINT64, pool_hits,
+      "pool-misses", G_TYPE_UINT64, pool_misses, NULL);
 
   return s;
 }
@@ -1411,6 +1980,16 @@ gst_rtp_base_payload_set_property (GObject * object, guint prop_id,
     case PROP_PTIME_MULTIPLE:
       rtpbasepayload->ptime_multiple = g_value_get_int64 (value);
       break;
+    case PROP_MAX_LIST_SIZE:
+      priv->max_list_size = g_value_get_uint (value);
+      break;
+    case PROP_FLUSH_LATENCY:
+      GST_OBJECT_LOCK (rtpbasepayload);
+      priv->flush_latency = g_value_get_uint64 (value);
+      GST_OBJECT_UNLOCK (rtpbasepayload);
+      gst_element_post_message (GST_ELEMENT (rtpbasepayload),
+          gst_message_new_latency (GST_OBJECT (rtpbasepayload)));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -1474,6 +2053,14 @@ gst_rtp_base_payload_get_property (GObject * object, guint prop_id,
       g_value_take_boxed (value,
           gst_rtp_base_payload_create_stats (rtpbasepayload));
       break;
+    case PROP_MAX_LIST_SIZE:
+      g_value_set_uint (value, priv->max_list_size);
+      break;
+    case PROP_FLUSH_LATENCY:
+      GST_OBJECT_LOCK (rtpbasepayload);
+      g_value_set_uint64 (value, priv->flush_latency);
+      GST_OBJECT_UNLOCK (rtpbasepayload);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -1520,6 +2107,10 @@ gst_rtp_base_payload_change_state (GstElement * element,
       g_atomic_int_set (&rtpbasepayload->priv->notified_first_timestamp, 1);
       priv->base_offset = GST_BUFFER_OFFSET_NONE;
       priv->negotiated = FALSE;
+      GST_OBJECT_LOCK (rtpbasepayload);
+      priv->pool_hits = 0;
+      priv->pool_misses = 0;
+      GST_OBJECT_UNLOCK (rtpbasepayload);
       gst_caps_replace (&rtpbasepayload->priv->subclass_srccaps, NULL);
       gst_caps_replace (&rtpbasepayload->priv->sinkcaps, NULL);
       break;
@@ -1535,6 +2126,8 @@ gst_rtp_base_payload_change_state (GstElement * element,
       break;
     case GST_STATE_CHANGE_PAUSED_TO_READY:
       gst_event_replace (&rtpbasepayload->priv->pending_segment, NULL);
+      gst_rtp_base_payload_clear_pending (rtpbasepayload);
+      gst_rtp_base_payload_clear_pool (rtpbasepayload);
       break;
     default:
       break;
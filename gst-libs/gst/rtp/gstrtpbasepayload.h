@@ -164,6 +164,12 @@ GST_RTP_API
 gboolean        gst_rtp_base_payload_is_filled          (GstRTPBasePayload *payload,
                                                          guint size, GstClockTime duration);
 
+GST_RTP_API
+GstBuffer *     gst_rtp_base_payload_allocate_output_buffer (GstRTPBasePayload *payload,
+                                                         guint payload_len,
+                                                         guint8 pad_len,
+                                                         guint8 csrc_count);
+
 GST_RTP_API
 GstFlowReturn   gst_rtp_base_payload_push               (GstRTPBasePayload *payload,
                                                          GstBuffer *buffer);
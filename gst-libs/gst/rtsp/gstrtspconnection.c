@@ -83,7 +83,7 @@ typedef struct
 {
   gint state;
   guint save;
-  guchar out[3];                /* the size must be evenly divisible by 3 */
+  guchar out[3 * 256];          /* the size must be evenly divisible by 3 */
   guint cout;
   guint coutl;
 } DecodeCtx;
@@ -104,6 +104,12 @@ typedef enum
 
 #define TUNNELID_LEN   24
 
+/* size of the read-ahead buffer, large enough for any interleaved data
+ * message */
+#define READ_BUFFER_SIZE      65536
+/* compact the read-ahead buffer when less than this is free at the end */
+#define READ_BUFFER_MIN_READ  4096
+
 struct _GstRTSPConnection
 {
   /*< private > */
@@ -143,6 +149,18 @@ struct _GstRTSPConnection
   gchar *initial_buffer;
   gsize initial_buffer_offset;
 
+  /* read-ahead buffer, the bytes between read_start and read_end were
+   * received (and decoded) but not parsed yet */
+  GstMemory *read_mem;
+  GstMapInfo read_map;
+  gsize read_start;
+  gsize read_end;
+  /* the last read would have blocked, the read-ahead buffer does not contain
+   * a complete message */
+  gboolean read_starved;
+  /* hand out message bodies as sub-buffers of read_mem */
+  gboolean zero_copy;
+
   gboolean remember_session_id; /* remember the session id or not */
 
   /* Session state */
@@ -182,6 +200,10 @@ enum
   STATE_LAST
 };
 
+/* unparsed data that can be handled without reading from the socket */
+#define READ_BUFFER_PENDING(conn) \
+    ((conn)->read_start < (conn)->read_end && !(conn)->read_starved)
+
 enum
 {
   READ_AHEAD_EOH = -1,          /* end of headers */
@@ -1204,6 +1226,86 @@ error:
   }
 }
 
+/* whether the output stream of @conn writes to the write socket directly,
+ * without TLS or a proxy in between */
+static gboolean
+output_is_socket (GstRTSPConnection * conn)
+{
+  GIOStream *stream;
+
+  if (conn->write_socket == NULL)
+    return FALSE;
+
+  stream = conn->write_socket == conn->socket0 ? conn->stream0 : conn->stream1;
+
+  return G_IS_SOCKET_CONNECTION (stream) &&
+      !G_IS_TCP_WRAPPER_CONNECTION (stream) &&
+      g_io_stream_get_output_stream (stream) == conn->output_stream;
+}
+
+/* maximum number of vectors written with one call */
+#define WRITEV_MAX_VECTORS  128
+
+/* write as much of @vectors as possible without blocking, with a single
+ * sendmsg() when the output of @conn is a plain socket */
+static GstRTSPResult
+writev_bytes (GstRTSPConnection * conn, const GOutputVector * vectors,
+    guint n_vectors, gsize * bytes_written)
+{
+  GstRTSPResult res;
+  guint i;
+
+  g_assert (n_vectors <= WRITEV_MAX_VECTORS);
+
+  *bytes_written = 0;
+
+#ifdef G_OS_UNIX
+  if (output_is_socket (conn)) {
+    struct iovec iov[WRITEV_MAX_VECTORS];
+    struct msghdr msg = { 0, };
+    gssize r;
+
+    for (i = 0; i < n_vectors; i++) {
+      iov[i].iov_base = (gpointer) vectors[i].buffer;
+      iov[i].iov_len = vectors[i].size;
+    }
+    msg.msg_iov = iov;
+    msg.msg_iovlen = n_vectors;
+
+    /* the socket is always in non-blocking mode */
+    do {
+      r = sendmsg (g_socket_get_fd (conn->write_socket), &msg, SEND_FLAGS);
+    } while (G_UNLIKELY (r < 0 && errno == EINTR));
+
+    if (G_UNLIKELY (r < 0)) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK)
+        return GST_RTSP_EINTR;
+
+      GST_DEBUG ("sendmsg failed: %s", g_strerror (errno));
+      return GST_RTSP_ESYS;
+    }
+    *bytes_written = r;
+
+    return GST_RTSP_OK;
+  }
+#endif
+
+  for (i = 0; i < n_vectors; i++) {
+    guint off = 0;
+
+    res = write_bytes (conn->output_stream, vectors[i].buffer, &off,
+        vectors[i].size, FALSE, conn->cancellable);
+    *bytes_written += off;
+    if (G_UNLIKELY (res != GST_RTSP_OK)) {
+      /* report what we have written so far, the next write will block */
+      if (res == GST_RTSP_EINTR && *bytes_written > 0)
+        return GST_RTSP_OK;
+      return res;
+    }
+  }
+  return GST_RTSP_OK;
+}
+
 static gint
 fill_raw_bytes (GstRTSPConnection * conn, guint8 * buffer, guint size,
     gboolean block, GError ** err)
@@ -1269,15 +1371,15 @@ fill_bytes (GstRTSPConnection * conn, guint8 * buffer, guint size,
         out++;
       }
 
-      /* got what we needed? */
-      if (size == 0)
+      /* got what we needed? don't wait for more when we already have
+       * something */
+      if (size == 0 || out > 0)
         break;
 
       /* try to read more bytes */
       r = fill_raw_bytes (conn, in, sizeof (in), block, err);
       if (r <= 0) {
-        if (out == 0)
-          out = r;
+        out = r;
         break;
       }
 
@@ -1293,13 +1395,125 @@ fill_bytes (GstRTSPConnection * conn, guint8 * buffer, guint size,
   return out;
 }
 
+/* convert the result of a failed fill_bytes() to a #GstRTSPResult */
+static GstRTSPResult
+fill_error (GstRTSPConnection * conn, gint r, GError * err)
+{
+  if (G_UNLIKELY (r == 0))
+    return GST_RTSP_EEOF;
+
+  GST_DEBUG ("%s", err->message);
+  if (g_error_matches (err, G_IO_ERROR, G_IO_ERROR_CANCELLED)) {
+    g_clear_error (&err);
+    return GST_RTSP_EINTR;
+  } else if (g_error_matches (err, G_IO_ERROR, G_IO_ERROR_WOULD_BLOCK)) {
+    g_clear_error (&err);
+    conn->read_starved = TRUE;
+    return GST_RTSP_EINTR;
+  } else if (g_error_matches (err, G_IO_ERROR, G_IO_ERROR_TIMED_OUT)) {
+    g_clear_error (&err);
+    return GST_RTSP_ETIMEOUT;
+  }
+  g_clear_error (&err);
+  return GST_RTSP_ESYS;
+}
+
+static void
+read_buffer_free (GstRTSPConnection * conn)
+{
+  if (conn->read_mem) {
+    gst_memory_unmap (conn->read_mem, &conn->read_map);
+    gst_memory_unref (conn->read_mem);
+    conn->read_mem = NULL;
+  }
+  conn->read_start = conn->read_end = 0;
+  conn->read_starved = FALSE;
+}
+
+/* make room for at least @size contiguous bytes from read_start */
+static void
+read_buffer_prepare (GstRTSPConnection * conn, gsize size)
+{
+  gsize avail = conn->read_end - conn->read_start;
+  GstMemory *mem;
+  GstMapInfo map;
+
+  if (G_LIKELY (conn->read_mem != NULL)) {
+    /* sub-buffers handed out as message bodies keep a ref */
+    gboolean shared = GST_MINI_OBJECT_REFCOUNT_VALUE (conn->read_mem) > 1;
+
+    if (avail == 0 && !shared) {
+      conn->read_start = conn->read_end = 0;
+      return;
+    }
+    if (conn->read_start + size <= READ_BUFFER_SIZE &&
+        READ_BUFFER_SIZE - conn->read_end >= READ_BUFFER_MIN_READ)
+      return;
+    if (!shared) {
+      memmove (conn->read_map.data, conn->read_map.data + conn->read_start,
+          avail);
+      conn->read_start = 0;
+      conn->read_end = avail;
+      return;
+    }
+  }
+
+  /* continue in new memory, the old one is still used by message bodies */
+  mem = gst_allocator_alloc (NULL, READ_BUFFER_SIZE, NULL);
+  gst_memory_map (mem, &map, GST_MAP_READWRITE);
+  if (avail > 0)
+    memcpy (map.data, conn->read_map.data + conn->read_start, avail);
+
+  read_buffer_free (conn);
+  conn->read_mem = mem;
+  conn->read_map = map;
+  conn->read_end = avail;
+}
+
+/* read as much as is available into the read-ahead buffer, until it contains
+ * at least @size bytes */
+static GstRTSPResult
+read_buffer_fill (GstRTSPConnection * conn, gsize size, gboolean block)
+{
+  g_assert (size <= READ_BUFFER_SIZE);
+
+  while (conn->read_end - conn->read_start < size) {
+    GError *err = NULL;
+    gint r;
+
+    read_buffer_prepare (conn, size);
+
+    r = fill_bytes (conn, conn->read_map.data + conn->read_end,
+        READ_BUFFER_SIZE - conn->read_end, block, &err);
+    if (G_UNLIKELY (r <= 0))
+      return fill_error (conn, r, err);
+
+    conn->read_end += r;
+    conn->read_starved = FALSE;
+  }
+  return GST_RTSP_OK;
+}
+
+static inline GstRTSPResult
+read_byte (GstRTSPConnection * conn, guint8 * c, gboolean block)
+{
+  if (G_UNLIKELY (conn->read_start == conn->read_end)) {
+    GstRTSPResult res = read_buffer_fill (conn, 1, block);
+
+    if (G_UNLIKELY (res != GST_RTSP_OK))
+      return res;
+  }
+  *c = conn->read_map.data[conn->read_start++];
+
+  return GST_RTSP_OK;
+}
+
 static GstRTSPResult
 read_bytes (GstRTSPConnection * conn, guint8 * buffer, guint * idx, guint size,
     gboolean block)
 {
+  GstRTSPResult res;
   guint left;
-  gint r;
-  GError *err = NULL;
 
   if (G_UNLIKELY (*idx > size))
     return GST_RTSP_ERROR;
@@ -1307,35 +1521,37 @@ read_bytes (GstRTSPConnection * conn, guint8 * buffer, guint * idx, guint size,
   left = size - *idx;
 
   while (left) {
-    r = fill_bytes (conn, &buffer[*idx], left, block, &err);
-    if (G_UNLIKELY (r <= 0))
-      goto error;
-
-    left -= r;
-    *idx += r;
-  }
-  return GST_RTSP_OK;
-
-  /* ERRORS */
-error:
-  {
-    if (G_UNLIKELY (r == 0))
-      return GST_RTSP_EEOF;
+    gsize avail = conn->read_end - conn->read_start;
+
+    if (avail == 0) {
+      if (left >= READ_BUFFER_SIZE / 2) {
+        GError *err = NULL;
+        gint r;
+
+        /* large reads go directly into @buffer */
+        r = fill_bytes (conn, &buffer[*idx], left, block, &err);
+        if (G_UNLIKELY (r <= 0))
+          return fill_error (conn, r, err);
+
+        conn->read_starved = FALSE;
+        left -= r;
+        *idx += r;
+        continue;
+      }
 
-    GST_DEBUG ("%s", err->message);
-    if (g_error_matches (err, G_IO_ERROR, G_IO_ERROR_CANCELLED)) {
-      g_clear_error (&err);
-      return GST_RTSP_EINTR;
-    } else if (g_error_matches (err, G_IO_ERROR, G_IO_ERROR_WOULD_BLOCK)) {
-      g_clear_error (&err);
-      return GST_RTSP_EINTR;
-    } else if (g_error_matches (err, G_IO_ERROR, G_IO_ERROR_TIMED_OUT)) {
-      g_clear_error (&err);
-      return GST_RTSP_ETIMEOUT;
+      res = read_buffer_fill (conn, 1, block);
+      if (G_UNLIKELY (res != GST_RTSP_OK))
+        return res;
+      avail = conn->read_end - conn->read_start;
     }
-    g_clear_error (&err);
-    return GST_RTSP_ESYS;
+
+    avail = MIN (avail, left);
+    memcpy (&buffer[*idx], conn->read_map.data + conn->read_start, avail);
+    conn->read_start += avail;
+    left -= avail;
+    *idx += avail;
   }
+  return GST_RTSP_OK;
 }
 
 /* The code below tries to handle clients using \r, \n or \r\n to indicate the
@@ -1352,7 +1568,6 @@ read_line (GstRTSPConnection * conn, guint8 * buffer, guint * idx, guint size,
 
   while (TRUE) {
     guint8 c;
-    guint i;
 
     if (conn->read_ahead == READ_AHEAD_EOH) {
       /* the last call to read_line() already determined that we have reached
@@ -1370,11 +1585,35 @@ read_line (GstRTSPConnection * conn, guint8 * buffer, guint * idx, guint size,
       c = (guint8) conn->read_ahead;
       conn->read_ahead = 0;
     } else {
-      /* read the next character */
-      i = 0;
-      res = read_bytes (conn, &c, &i, 1, block);
-      if (G_UNLIKELY (res != GST_RTSP_OK))
-        return res;
+      guint8 *data, *eol, *cr;
+      gsize len;
+
+      if (G_UNLIKELY (conn->read_start == conn->read_end)) {
+        res = read_buffer_fill (conn, 1, block);
+        if (G_UNLIKELY (res != GST_RTSP_OK))
+          return res;
+      }
+
+      /* copy everything up to the next line ending in one go */
+      data = conn->read_map.data + conn->read_start;
+      len = conn->read_end - conn->read_start;
+      eol = memchr (data, '\n', len);
+      cr = memchr (data, '\r', eol ? eol - data : len);
+      if (cr)
+        eol = cr;
+      if (eol != data) {
+        len = eol ? eol - data : len;
+        if (G_LIKELY (*idx < size - 1)) {
+          guint n = MIN (len, size - 1 - *idx);
+
+          memcpy (&buffer[*idx], data, n);
+          *idx += n;
+        }
+        conn->read_start += len;
+        continue;
+      }
+      c = *data;
+      conn->read_start++;
     }
 
     /* special treatment of line endings */
@@ -1383,8 +1622,7 @@ read_line (GstRTSPConnection * conn, guint8 * buffer, guint * idx, guint size,
 
     retry:
       /* need to read ahead one more character to know what to do... */
-      i = 0;
-      res = read_bytes (conn, &read_ahead, &i, 1, block);
+      res = read_byte (conn, &read_ahead, block);
       if (G_UNLIKELY (res != GST_RTSP_OK))
         return res;
 
@@ -1493,6 +1731,12 @@ static GString *
 message_to_string (GstRTSPConnection * conn, GstRTSPMessage * message)
 {
   GString *str = NULL;
+  guint8 *body;
+  guint body_size;
+
+  /* also maps the body buffer, if any */
+  if (gst_rtsp_message_get_body (message, &body, &body_size) != GST_RTSP_OK)
+    return NULL;
 
   str = g_string_new ("");
 
@@ -1542,14 +1786,12 @@ message_to_string (GstRTSPConnection * conn, GstRTSPMessage * message)
       /* prepare data header */
       data_header[0] = '$';
       data_header[1] = message->type_data.data.channel;
-      data_header[2] = (message->body_size >> 8) & 0xff;
-      data_header[3] = message->body_size & 0xff;
+      data_header[2] = (body_size >> 8) & 0xff;
+      data_header[3] = body_size & 0xff;
 
       /* create string with header and data */
       str = g_string_append_len (str, (gchar *) data_header, 4);
-      str =
-          g_string_append_len (str, (gchar *) message->body,
-          message->body_size);
+      str = g_string_append_len (str, (gchar *) body, body_size);
       break;
     }
     default:
@@ -1572,18 +1814,16 @@ message_to_string (GstRTSPConnection * conn, GstRTSPMessage * message)
     gst_rtsp_message_append_headers (message, str);
 
     /* append Content-Length and body if needed */
-    if (message->body != NULL && message->body_size > 0) {
+    if (body != NULL && body_size > 0) {
       gchar *len;
 
-      len = g_strdup_printf ("%d", message->body_size);
+      len = g_strdup_printf ("%d", body_size);
       g_string_append_printf (str, "%s: %s\r\n",
           gst_rtsp_header_as_text (GST_RTSP_HDR_CONTENT_LENGTH), len);
       g_free (len);
       /* header ends here */
       g_string_append (str, "\r\n");
-      str =
-          g_string_append_len (str, (gchar *) message->body,
-          message->body_size);
+      str = g_string_append_len (str, (gchar *) body, body_size);
     } else {
       /* just end headers */
       g_string_append (str, "\r\n");
@@ -2013,14 +2253,39 @@ build_next (GstRTSPBuilder * builder, GstRTSPMessage * message,
         gst_rtsp_message_init_data (message, builder->buffer[1]);
 
         builder->body_len = (builder->buffer[2] << 8) | builder->buffer[3];
-        builder->body_data = g_malloc (builder->body_len + 1);
-        builder->body_data[builder->body_len] = '\0';
+        if (!conn->zero_copy) {
+          builder->body_data = g_malloc (builder->body_len + 1);
+          builder->body_data[builder->body_len] = '\0';
+        }
         builder->offset = 0;
         builder->state = STATE_DATA_BODY;
         break;
       }
       case STATE_DATA_BODY:
       {
+        if (builder->body_data == NULL) {
+          GstBuffer *buffer;
+
+          /* the body fits in the read-ahead buffer, hand it out as a
+           * sub-buffer of it */
+          res = read_buffer_fill (conn, builder->body_len, block);
+          if (res != GST_RTSP_OK)
+            goto done;
+
+          if (builder->body_len > 0) {
+            buffer = gst_buffer_new ();
+            gst_buffer_append_memory (buffer,
+                gst_memory_share (conn->read_mem, conn->read_start,
+                    builder->body_len));
+            conn->read_start += builder->body_len;
+            gst_rtsp_message_take_body_buffer (message, buffer);
+          }
+          builder->body_len = 0;
+
+          builder->state = STATE_END;
+          break;
+        }
+
         res =
             read_bytes (conn, builder->body_data, &builder->offset,
             builder->body_len, block);
@@ -2059,14 +2324,17 @@ build_next (GstRTSPBuilder * builder, GstRTSPMessage * message,
                       GST_RTSP_HDR_X_SESSIONCOOKIE, NULL, 0) != GST_RTSP_OK)) {
             /* there is, prepare to read the body */
             builder->body_len = atol (hdrval);
-            builder->body_data = g_try_malloc (builder->body_len + 1);
-            /* we can't do much here, we need the length to know how many bytes
-             * we need to read next and when allocation fails, something is
-             * probably wrong with the length. */
-            if (builder->body_data == NULL)
-              goto invalid_body_len;
-
-            builder->body_data[builder->body_len] = '\0';
+            if (!conn->zero_copy || builder->body_len < 0 ||
+                builder->body_len > READ_BUFFER_SIZE) {
+              builder->body_data = g_try_malloc (builder->body_len + 1);
+              /* we can't do much here, we need the length to know how many
+               * bytes we need to read next and when allocation fails,
+               * something is probably wrong with the length. */
+              if (builder->body_data == NULL)
+                goto invalid_body_len;
+
+              builder->body_data[builder->body_len] = '\0';
+            }
             builder->offset = 0;
             builder->state = STATE_DATA_BODY;
           } else {
@@ -2381,6 +2649,8 @@ gst_rtsp_connection_close (GstRTSPConnection * conn)
   conn->initial_buffer = NULL;
   conn->initial_buffer_offset = 0;
 
+  read_buffer_free (conn);
+
   conn->write_socket = NULL;
   conn->read_socket = NULL;
   conn->tunneled = FALSE;
@@ -2467,6 +2737,17 @@ gst_rtsp_connection_poll (GstRTSPConnection * conn, GstRTSPEvent events,
   g_return_val_if_fail (conn->read_socket != NULL, GST_RTSP_EINVAL);
   g_return_val_if_fail (conn->write_socket != NULL, GST_RTSP_EINVAL);
 
+  if ((events & GST_RTSP_EV_READ) && READ_BUFFER_PENDING (conn)) {
+    /* no need to wait, there is unparsed data in the read-ahead buffer */
+    *revents = GST_RTSP_EV_READ;
+    if (events & GST_RTSP_EV_WRITE) {
+      condition = g_socket_condition_check (conn->write_socket, G_IO_OUT);
+      if ((condition & G_IO_OUT))
+        *revents |= GST_RTSP_EV_WRITE;
+    }
+    return GST_RTSP_OK;
+  }
+
   ctx = g_main_context_new ();
 
   /* configure timeout if any */
@@ -3008,6 +3289,34 @@ gst_rtsp_connection_get_tunnelid (const GstRTSPConnection * conn)
   return conn->tunnelid;
 }
 
+/* move the bytes @from read ahead but did not parse yet in front of the
+ * initial buffer of @conn, so that they are passed through base64 decoding */
+static void
+read_buffer_to_initial_buffer (GstRTSPConnection * conn,
+    GstRTSPConnection * from)
+{
+  gsize avail = from->read_end - from->read_start;
+
+  if (avail > 0) {
+    const gchar *rest = "";
+    gchar *initial_buffer;
+    gsize rest_len;
+
+    if (conn->initial_buffer)
+      rest = &conn->initial_buffer[conn->initial_buffer_offset];
+    rest_len = strlen (rest);
+
+    initial_buffer = g_malloc (avail + rest_len + 1);
+    memcpy (initial_buffer, from->read_map.data + from->read_start, avail);
+    memcpy (initial_buffer + avail, rest, rest_len + 1);
+
+    g_free (conn->initial_buffer);
+    conn->initial_buffer = initial_buffer;
+    conn->initial_buffer_offset = 0;
+  }
+  from->read_start = from->read_end = 0;
+}
+
 /**
  * gst_rtsp_connection_do_tunnel:
  * @conn: a #GstRTSPConnection
@@ -3083,6 +3392,16 @@ gst_rtsp_connection_do_tunnel (GstRTSPConnection * conn,
     conn->initial_buffer = conn2->initial_buffer;
     conn2->initial_buffer = NULL;
     conn->initial_buffer_offset = conn2->initial_buffer_offset;
+
+    /* the GET channel is only used to detect disconnects from now on */
+    if (ts1 == TUNNEL_STATE_GET) {
+      read_buffer_to_initial_buffer (conn, conn2);
+      conn->read_start = conn->read_end = 0;
+    } else {
+      read_buffer_to_initial_buffer (conn, conn);
+    }
+  } else {
+    read_buffer_to_initial_buffer (conn, conn);
   }
 
   /* we need base64 decoding for the readfd */
@@ -3129,6 +3448,50 @@ gst_rtsp_connection_get_remember_session_id (GstRTSPConnection * conn)
   return conn->remember_session_id;
 }
 
+/**
+ * gst_rtsp_connection_set_zero_copy:
+ * @conn: a #GstRTSPConnection
+ * @zero_copy: %TRUE to receive message bodies without copying them
+ *
+ * Sets if the bodies of messages received on @conn are stored as a #GstBuffer
+ * sharing the memory they were read into, instead of being copied into a
+ * newly allocated body. Many interleaved data messages then end up as
+ * sub-buffers of a single read. Use gst_rtsp_message_steal_body_buffer() to
+ * get them without copying.
+ *
+ * Unlike copied bodies, the size of these bodies does not include a
+ * terminating '\0'.
+ *
+ * The default value is %FALSE
+ *
+ * Since: 1.16
+ */
+void
+gst_rtsp_connection_set_zero_copy (GstRTSPConnection * conn,
+    gboolean zero_copy)
+{
+  g_return_if_fail (conn != NULL);
+
+  conn->zero_copy = zero_copy;
+}
+
+/**
+ * gst_rtsp_connection_get_zero_copy:
+ * @conn: a #GstRTSPConnection
+ *
+ * Returns: %TRUE if the bodies of received messages are stored as buffers
+ * sharing the memory they were read into.
+ *
+ * Since: 1.16
+ */
+gboolean
+gst_rtsp_connection_get_zero_copy (GstRTSPConnection * conn)
+{
+  g_return_val_if_fail (conn != NULL, FALSE);
+
+  return conn->zero_copy;
+}
+
 
 #define READ_ERR    (G_IO_HUP | G_IO_ERR | G_IO_NVAL)
 #define READ_COND   (G_IO_IN | READ_ERR)
@@ -3137,11 +3500,135 @@ gst_rtsp_connection_get_remember_session_id (GstRTSPConnection * conn)
 
 typedef struct
 {
-  guint8 *data;
-  guint size;
+  /* the vectors to send, pointing into data and maps */
+  GOutputVector *vectors;
+  guint n_vectors;
+  gsize size;
   guint id;
+
+  guint8 *data;
+  GstMapInfo *maps;
+  guint n_maps;
+
+  GOutputVector vector;
 } GstRTSPRec;
 
+static void
+gst_rtsp_rec_free (gpointer data)
+{
+  GstRTSPRec *rec = data;
+  guint i;
+
+  for (i = 0; i < rec->n_maps; i++) {
+    GstMemory *mem = rec->maps[i].memory;
+
+    gst_memory_unmap (mem, &rec->maps[i]);
+    gst_memory_unref (mem);
+  }
+  g_free (rec->maps);
+  if (rec->vectors != &rec->vector)
+    g_free (rec->vectors);
+  g_free (rec->data);
+  g_slice_free (GstRTSPRec, rec);
+}
+
+static GstRTSPRec *
+gst_rtsp_rec_new_data (guint8 * data, guint size)
+{
+  GstRTSPRec *rec;
+
+  rec = g_slice_new0 (GstRTSPRec);
+  rec->data = data;
+  rec->vector.buffer = data;
+  rec->vector.size = size;
+  rec->vectors = &rec->vector;
+  rec->n_vectors = 1;
+  rec->size = size;
+
+  return rec;
+}
+
+/* a record with the buffers in @list as interleaved data messages on
+ * @channel. The memory of the buffers is sent as is, only the data headers
+ * are stored in the record */
+static GstRTSPRec *
+gst_rtsp_rec_new_buffer_list (guint8 channel, GstBufferList * list)
+{
+  GstRTSPRec *rec;
+  guint i, j, n_buffers, n_maps = 0;
+
+  n_buffers = gst_buffer_list_length (list);
+  for (i = 0; i < n_buffers; i++)
+    n_maps += gst_buffer_n_memory (gst_buffer_list_get (list, i));
+
+  rec = g_slice_new0 (GstRTSPRec);
+  rec->data = g_malloc (4 * n_buffers);
+  rec->maps = g_new (GstMapInfo, n_maps);
+  rec->vectors = g_new (GOutputVector, n_buffers + n_maps);
+
+  for (i = 0; i < n_buffers; i++) {
+    GstBuffer *buffer = gst_buffer_list_get (list, i);
+    gsize size = gst_buffer_get_size (buffer);
+    guint8 *header = &rec->data[4 * i];
+
+    header[0] = '$';
+    header[1] = channel;
+    header[2] = (size >> 8) & 0xff;
+    header[3] = size & 0xff;
+    rec->vectors[rec->n_vectors].buffer = header;
+    rec->vectors[rec->n_vectors].size = 4;
+    rec->n_vectors++;
+    rec->size += 4 + size;
+
+    for (j = 0; j < gst_buffer_n_memory (buffer); j++) {
+      GstMemory *mem = gst_buffer_peek_memory (buffer, j);
+      GstMapInfo *map = &rec->maps[rec->n_maps];
+
+      if (!gst_memory_map (mem, map, GST_MAP_READ))
+        goto map_failed;
+      gst_memory_ref (mem);
+      rec->n_maps++;
+
+      rec->vectors[rec->n_vectors].buffer = map->data;
+      rec->vectors[rec->n_vectors].size = map->size;
+      rec->n_vectors++;
+    }
+  }
+
+  return rec;
+
+  /* ERRORS */
+map_failed:
+  {
+    GST_ERROR ("failed to map memory");
+    gst_rtsp_rec_free (rec);
+    return NULL;
+  }
+}
+
+/* adds the vectors of @rec, skipping @offset bytes, to @vectors and returns
+ * how many were added */
+static guint
+gst_rtsp_rec_fill_vectors (GstRTSPRec * rec, gsize offset,
+    GOutputVector * vectors, guint max_vectors)
+{
+  guint i, n = 0;
+
+  for (i = 0; i < rec->n_vectors && n < max_vectors; i++) {
+    const GOutputVector *vector = &rec->vectors[i];
+
+    if (offset >= vector->size) {
+      offset -= vector->size;
+      continue;
+    }
+    vectors[n].buffer = (const guint8 *) vector->buffer + offset;
+    vectors[n].size = vector->size - offset;
+    offset = 0;
+    n++;
+  }
+  return n;
+}
+
 /* async functions */
 struct _GstRTSPWatch
 {
@@ -3163,10 +3650,8 @@ struct _GstRTSPWatch
   GMutex mutex;
   GQueue *messages;
   gsize messages_bytes;
-  guint8 *write_data;
-  guint write_off;
-  guint write_size;
-  guint write_id;
+  /* bytes of the oldest message that were written already */
+  gsize write_off;
   gsize max_bytes;
   guint max_messages;
   GCond queue_not_full;
@@ -3189,6 +3674,10 @@ gst_rtsp_source_prepare (GSource * source, gint * timeout)
   if (watch->conn->initial_buffer != NULL)
     return TRUE;
 
+  /* a complete message might still be waiting in the read-ahead buffer */
+  if (watch->conn->input_stream != NULL && READ_BUFFER_PENDING (watch->conn))
+    return TRUE;
+
   *timeout = (watch->conn->timeout * 1000);
 
   return FALSE;
@@ -3284,6 +3773,7 @@ gst_rtsp_source_dispatch_read (GPollableInputStream * stream,
       conn->stream1 = NULL;
       conn->socket1 = NULL;
       conn->input_stream = NULL;
+      conn->read_start = conn->read_end = 0;
     }
     g_mutex_unlock (&watch->mutex);
 
@@ -3410,7 +3900,8 @@ gst_rtsp_source_dispatch (GSource * source, GSourceFunc callback G_GNUC_UNUSED,
   GstRTSPWatch *watch = (GstRTSPWatch *) source;
   GstRTSPConnection *conn = watch->conn;
 
-  if (conn->initial_buffer != NULL) {
+  if (conn->initial_buffer != NULL || (conn->input_stream != NULL &&
+          READ_BUFFER_PENDING (conn))) {
     gst_rtsp_source_dispatch_read (G_POLLABLE_INPUT_STREAM (conn->input_stream),
         watch);
   }
@@ -3423,6 +3914,7 @@ gst_rtsp_source_dispatch_write (GPollableOutputStream * stream,
 {
   GstRTSPResult res = GST_RTSP_ERROR;
   GstRTSPConnection *conn = watch->conn;
+  guint id = 0;
 
   /* if this connection was already closed, stop now */
   if (G_POLLABLE_OUTPUT_STREAM (conn->output_stream) != stream)
@@ -3430,67 +3922,79 @@ gst_rtsp_source_dispatch_write (GPollableOutputStream * stream,
 
   g_mutex_lock (&watch->mutex);
   do {
-    if (watch->write_data == NULL) {
-      GstRTSPRec *rec;
-
-      /* get a new message from the queue */
-      rec = g_queue_pop_tail (watch->messages);
-      if (rec == NULL) {
-        if (watch->writesrc) {
-          if (!g_source_is_destroyed ((GSource *) watch))
-            g_source_remove_child_source ((GSource *) watch, watch->writesrc);
-          g_source_unref (watch->writesrc);
-          watch->writesrc = NULL;
-          /* we create and add the write source again when we actually have
-           * something to write */
-
-          /* since write source is now removed we add read source on the write
-           * socket instead to be able to detect when client closes get channel
-           * in tunneled mode */
-          if (watch->conn->control_stream) {
-            watch->controlsrc =
-                g_pollable_input_stream_create_source (G_POLLABLE_INPUT_STREAM
-                (watch->conn->control_stream), NULL);
-            g_source_set_callback (watch->controlsrc,
-                (GSourceFunc) gst_rtsp_source_dispatch_read_get_channel, watch,
-                NULL);
-            g_source_add_child_source ((GSource *) watch, watch->controlsrc);
-          } else {
-            watch->controlsrc = NULL;
-          }
+    GOutputVector vectors[WRITEV_MAX_VECTORS];
+    guint n_vectors = 0;
+    gsize offset, written;
+    GList *walk, *sent = NULL;
+    GstRTSPRec *rec;
+
+    /* gather as many queued messages as possible, oldest first */
+    offset = watch->write_off;
+    for (walk = watch->messages->tail; walk && n_vectors < WRITEV_MAX_VECTORS;
+        walk = walk->prev) {
+      n_vectors += gst_rtsp_rec_fill_vectors (walk->data, offset,
+          &vectors[n_vectors], WRITEV_MAX_VECTORS - n_vectors);
+      offset = 0;
+    }
+
+    if (n_vectors == 0) {
+      if (watch->writesrc) {
+        if (!g_source_is_destroyed ((GSource *) watch))
+          g_source_remove_child_source ((GSource *) watch, watch->writesrc);
+        g_source_unref (watch->writesrc);
+        watch->writesrc = NULL;
+        /* we create and add the write source again when we actually have
+         * something to write */
+
+        /* since write source is now removed we add read source on the write
+         * socket instead to be able to detect when client closes get channel
+         * in tunneled mode */
+        if (watch->conn->control_stream) {
+          watch->controlsrc =
+              g_pollable_input_stream_create_source (G_POLLABLE_INPUT_STREAM
+              (watch->conn->control_stream), NULL);
+          g_source_set_callback (watch->controlsrc,
+              (GSourceFunc) gst_rtsp_source_dispatch_read_get_channel, watch,
+              NULL);
+          g_source_add_child_source ((GSource *) watch, watch->controlsrc);
+        } else {
+          watch->controlsrc = NULL;
         }
-        break;
       }
+      break;
+    }
 
-      watch->messages_bytes -= rec->size;
-
-      watch->write_off = 0;
-      watch->write_data = rec->data;
-      watch->write_size = rec->size;
-      watch->write_id = rec->id;
+    res = writev_bytes (conn, vectors, n_vectors, &written);
 
-      g_slice_free (GstRTSPRec, rec);
+    /* remove the messages that were written completely */
+    written += watch->write_off;
+    while ((rec = g_queue_peek_tail (watch->messages)) && written >= rec->size) {
+      g_queue_pop_tail (watch->messages);
+      watch->messages_bytes -= rec->size;
+      written -= rec->size;
+      sent = g_list_prepend (sent, rec);
     }
-
-    res = write_bytes (conn->output_stream, watch->write_data,
-        &watch->write_off, watch->write_size, FALSE, conn->cancellable);
+    watch->write_off = written;
+    id = rec ? rec->id : 0;
 
     if (!IS_BACKLOG_FULL (watch))
       g_cond_signal (&watch->queue_not_full);
     g_mutex_unlock (&watch->mutex);
 
+    for (walk = g_list_last (sent); walk; walk = walk->prev) {
+      rec = walk->data;
+      if (watch->funcs.message_sent)
+        watch->funcs.message_sent (watch, rec->id, watch->user_data);
+      gst_rtsp_rec_free (rec);
+    }
+    g_list_free (sent);
+
     if (res == GST_RTSP_EINTR)
       goto write_blocked;
-    else if (G_LIKELY (res == GST_RTSP_OK)) {
-      if (watch->funcs.message_sent)
-        watch->funcs.message_sent (watch, watch->write_id, watch->user_data);
-    } else {
+    else if (G_UNLIKELY (res != GST_RTSP_OK))
       goto write_error;
-    }
-    g_mutex_lock (&watch->mutex);
 
-    g_free (watch->write_data);
-    watch->write_data = NULL;
+    g_mutex_lock (&watch->mutex);
   } while (TRUE);
   g_mutex_unlock (&watch->mutex);
 
@@ -3505,8 +4009,7 @@ eof:
 write_error:
   {
     if (watch->funcs.error_full)
-      watch->funcs.error_full (watch, res, NULL,
-          watch->write_id, watch->user_data);
+      watch->funcs.error_full (watch, res, NULL, id, watch->user_data);
     else if (watch->funcs.error)
       watch->funcs.error (watch, res, watch->user_data);
 
@@ -3514,15 +4017,6 @@ write_error:
   }
 }
 
-static void
-gst_rtsp_rec_free (gpointer data)
-{
-  GstRTSPRec *rec = data;
-
-  g_free (rec->data);
-  g_slice_free (GstRTSPRec, rec);
-}
-
 static void
 gst_rtsp_source_finalize (GSource * source)
 {
@@ -3539,7 +4033,6 @@ gst_rtsp_source_finalize (GSource * source)
   watch->messages = NULL;
   watch->messages_bytes = 0;
 
-  g_free (watch->write_data);
   g_cond_clear (&watch->queue_not_full);
 
   if (watch->readsrc)
@@ -3755,55 +4248,47 @@ gst_rtsp_watch_get_send_backlog (GstRTSPWatch * watch,
   g_mutex_unlock (&watch->mutex);
 }
 
-/**
- * gst_rtsp_watch_write_data:
- * @watch: a #GstRTSPWatch
- * @data: (array length=size) (transfer full): the data to queue
- * @size: the size of @data
- * @id: (out) (allow-none): location for a message ID or %NULL
- *
- * Write @data using the connection of the @watch. If it cannot be sent
- * immediately, it will be queued for transmission in @watch. The contents of
- * @message will then be serialized and transmitted when the connection of the
- * @watch becomes writable. In case the @message is queued, the ID returned in
- * @id will be non-zero and used as the ID argument in the message_sent
- * callback.
- *
- * This function will take ownership of @data and g_free() it after use.
- *
- * If the amount of queued data exceeds the limits set with
- * gst_rtsp_watch_set_send_backlog(), this function will return
- * #GST_RTSP_ENOMEM.
- *
- * Returns: #GST_RTSP_OK on success. #GST_RTSP_ENOMEM when the backlog limits
- * are reached. #GST_RTSP_EINTR when @watch was flushing.
- */
-GstRTSPResult
-gst_rtsp_watch_write_data (GstRTSPWatch * watch, const guint8 * data,
-    guint size, guint * id)
+/* try to write the whole @rec without blocking */
+static GstRTSPResult
+gst_rtsp_rec_write (GstRTSPRec * rec, GstRTSPConnection * conn, gsize * off)
 {
+  GOutputVector vectors[WRITEV_MAX_VECTORS];
   GstRTSPResult res;
-  GstRTSPRec *rec;
-  guint off = 0;
-  GMainContext *context = NULL;
 
-  g_return_val_if_fail (watch != NULL, GST_RTSP_EINVAL);
-  g_return_val_if_fail (data != NULL, GST_RTSP_EINVAL);
-  g_return_val_if_fail (size != 0, GST_RTSP_EINVAL);
+  while (*off < rec->size) {
+    guint n_vectors;
+    gsize written;
+
+    n_vectors = gst_rtsp_rec_fill_vectors (rec, *off, vectors,
+        WRITEV_MAX_VECTORS);
+    res = writev_bytes (conn, vectors, n_vectors, &written);
+    *off += written;
+    if (res != GST_RTSP_OK)
+      return res;
+  }
+  return GST_RTSP_OK;
+}
+
+/* send @rec or queue it when the connection is not writable, takes ownership
+ * of @rec */
+static GstRTSPResult
+gst_rtsp_watch_send_rec (GstRTSPWatch * watch, GstRTSPRec * rec, guint * id)
+{
+  GstRTSPResult res;
+  gsize off = 0;
+  GMainContext *context = NULL;
 
   g_mutex_lock (&watch->mutex);
   if (watch->flushing)
     goto flushing;
 
   /* try to send the message synchronously first */
-  if (watch->messages->length == 0 && watch->write_data == NULL) {
-    res =
-        write_bytes (watch->conn->output_stream, data, &off, size,
-        FALSE, watch->conn->cancellable);
+  if (watch->messages->length == 0) {
+    res = gst_rtsp_rec_write (rec, watch->conn, &off);
     if (res != GST_RTSP_EINTR) {
       if (id != NULL)
         *id = 0;
-      g_free ((gpointer) data);
+      gst_rtsp_rec_free (rec);
       goto done;
     }
   }
@@ -3812,23 +4297,15 @@ gst_rtsp_watch_write_data (GstRTSPWatch * watch, const guint8 * data,
   if (IS_BACKLOG_FULL (watch))
     goto too_much_backlog;
 
-  /* make a record with the data and id for sending async */
-  rec = g_slice_new (GstRTSPRec);
-  if (off == 0) {
-    rec->data = (guint8 *) data;
-    rec->size = size;
-  } else {
-    rec->data = g_memdup (data + off, size - off);
-    rec->size = size - off;
-    g_free ((gpointer) data);
-  }
-
   do {
     /* make sure rec->id is never 0 */
     rec->id = ++watch->id;
   } while (G_UNLIKELY (rec->id == 0));
 
-  /* add the record to a queue. */
+  /* add the record to a queue, the queue was empty when we already wrote
+   * part of it */
+  if (off > 0)
+    watch->write_off = off;
   g_queue_push_head (watch->messages, rec);
   watch->messages_bytes += rec->size;
 
@@ -3869,7 +4346,7 @@ flushing:
   {
     GST_DEBUG ("we are flushing");
     g_mutex_unlock (&watch->mutex);
-    g_free ((gpointer) data);
+    gst_rtsp_rec_free (rec);
     return GST_RTSP_EINTR;
   }
 too_much_backlog:
@@ -3878,11 +4355,46 @@ too_much_backlog:
         G_GSIZE_FORMAT ", max_messages %u, current %u", watch->max_bytes,
         watch->messages_bytes, watch->max_messages, watch->messages->length);
     g_mutex_unlock (&watch->mutex);
-    g_free ((gpointer) data);
+    gst_rtsp_rec_free (rec);
     return GST_RTSP_ENOMEM;
   }
 }
 
+/**
+ * gst_rtsp_watch_write_data:
+ * @watch: a #GstRTSPWatch
+ * @data: (array length=size) (transfer full): the data to queue
+ * @size: the size of @data
+ * @id: (out) (allow-none): location for a message ID or %NULL
+ *
+ * Write @data using the connection of the @watch. If it cannot be sent
+ * immediately, it will be queued for transmission in @watch. The contents of
+ * @message will then be serialized and transmitted when the connection of the
+ * @watch becomes writable. In case the @message is queued, the ID returned in
+ * @id will be non-zero and used as the ID argument in the message_sent
+ * callback.
+ *
+ * This function will take ownership of @data and g_free() it after use.
+ *
+ * If the amount of queued data exceeds the limits set with
+ * gst_rtsp_watch_set_send_backlog(), this function will return
+ * #GST_RTSP_ENOMEM.
+ *
+ * Returns: #GST_RTSP_OK on success. #GST_RTSP_ENOMEM when the backlog limits
+ * are reached. #GST_RTSP_EINTR when @watch was flushing.
+ */
+GstRTSPResult
+gst_rtsp_watch_write_data (GstRTSPWatch * watch, const guint8 * data,
+    guint size, guint * id)
+{
+  g_return_val_if_fail (watch != NULL, GST_RTSP_EINVAL);
+  g_return_val_if_fail (data != NULL, GST_RTSP_EINVAL);
+  g_return_val_if_fail (size != 0, GST_RTSP_EINVAL);
+
+  return gst_rtsp_watch_send_rec (watch,
+      gst_rtsp_rec_new_data ((guint8 *) data, size), id);
+}
+
 /**
  * gst_rtsp_watch_send_message:
  * @watch: a #GstRTSPWatch
@@ -3908,13 +4420,93 @@ gst_rtsp_watch_send_message (GstRTSPWatch * watch, GstRTSPMessage * message,
   g_return_val_if_fail (watch != NULL, GST_RTSP_EINVAL);
   g_return_val_if_fail (message != NULL, GST_RTSP_EINVAL);
 
+  /* send data in a buffer without copying it into a string */
+  if (message->type == GST_RTSP_MESSAGE_DATA
+      && gst_rtsp_message_has_body_buffer (message)) {
+    GstBufferList *list;
+    GstBuffer *buffer;
+    GstRTSPResult res;
+
+    gst_rtsp_message_get_body_buffer (message, &buffer);
+    list = gst_buffer_list_new_sized (1);
+    gst_buffer_list_add (list, gst_buffer_ref (buffer));
+    res = gst_rtsp_watch_send_buffer_list (watch,
+        message->type_data.data.channel, list, id);
+    gst_buffer_list_unref (list);
+
+    return res;
+  }
+
   /* make a record with the message as a string and id */
   str = message_to_string (watch->conn, message);
+  if (G_UNLIKELY (str == NULL))
+    return GST_RTSP_EINVAL;
   size = str->len;
   return gst_rtsp_watch_write_data (watch,
       (guint8 *) g_string_free (str, FALSE), size, id);
 }
 
+/**
+ * gst_rtsp_watch_send_buffer_list:
+ * @watch: a #GstRTSPWatch
+ * @channel: the interleaved channel
+ * @list: (transfer none): a #GstBufferList
+ * @id: (out) (allow-none): location for a message ID or %NULL
+ *
+ * Send all buffers in @list as interleaved data messages on @channel using
+ * the connection of the @watch. If they cannot be sent immediately, they will
+ * be queued for transmission in @watch and the ID returned in @id will be
+ * non-zero and used as the ID argument in the message_sent callback, which
+ * is called once for the complete @list.
+ *
+ * Unlike gst_rtsp_watch_send_message(), the memory of the buffers is not
+ * copied but written directly to the connection together with the data
+ * message headers, with one system call for many buffers when possible.
+ * The memory is kept alive until it has been written, the buffers must not
+ * be written to in the meantime.
+ *
+ * If the amount of queued data exceeds the limits set with
+ * gst_rtsp_watch_set_send_backlog(), this function will return
+ * #GST_RTSP_ENOMEM.
+ *
+ * Returns: #GST_RTSP_OK on success. #GST_RTSP_ENOMEM when the backlog limits
+ * are reached. #GST_RTSP_EINTR when @watch was flushing. #GST_RTSP_EINVAL
+ * when a buffer is too big for a data message.
+ *
+ * Since: 1.16
+ */
+GstRTSPResult
+gst_rtsp_watch_send_buffer_list (GstRTSPWatch * watch, guint8 channel,
+    GstBufferList * list, guint * id)
+{
+  GstRTSPRec *rec;
+  guint i, n_buffers;
+
+  g_return_val_if_fail (watch != NULL, GST_RTSP_EINVAL);
+  g_return_val_if_fail (GST_IS_BUFFER_LIST (list), GST_RTSP_EINVAL);
+
+  n_buffers = gst_buffer_list_length (list);
+  g_return_val_if_fail (n_buffers > 0, GST_RTSP_EINVAL);
+
+  for (i = 0; i < n_buffers; i++) {
+    if (gst_buffer_get_size (gst_buffer_list_get (list, i)) > G_MAXUINT16)
+      goto too_big;
+  }
+
+  rec = gst_rtsp_rec_new_buffer_list (channel, list);
+  if (G_UNLIKELY (rec == NULL))
+    return GST_RTSP_ERROR;
+
+  return gst_rtsp_watch_send_rec (watch, rec, id);
+
+  /* ERRORS */
+too_big:
+  {
+    GST_WARNING ("buffer %u too big for a data message", i);
+    return GST_RTSP_EINVAL;
+  }
+}
+
 /**
  * gst_rtsp_watch_wait_backlog:
  * @watch: a #GstRTSPWatch
@@ -4002,8 +4594,21 @@ gst_rtsp_watch_set_flushing (GstRTSPWatch * watch, gboolean flushing)
   watch->flushing = flushing;
   g_cond_signal (&watch->queue_not_full);
   if (flushing) {
+    GstRTSPRec *partial = NULL;
+
+    /* a partially written message needs to be completed or the stream
+     * is corrupted */
+    if (watch->write_off > 0)
+      partial = g_queue_pop_tail (watch->messages);
+
     g_queue_foreach (watch->messages, (GFunc) gst_rtsp_rec_free, NULL);
     g_queue_clear (watch->messages);
+    watch->messages_bytes = 0;
+
+    if (partial) {
+      g_queue_push_head (watch->messages, partial);
+      watch->messages_bytes = partial->size;
+    }
   }
   g_mutex_unlock (&watch->mutex);
 }
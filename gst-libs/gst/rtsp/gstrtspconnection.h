@@ -226,6 +226,12 @@ void               gst_rtsp_connection_set_remember_session_id (GstRTSPConnectio
 GST_RTSP_API
 gboolean           gst_rtsp_connection_get_remember_session_id (GstRTSPConnection *conn);
 
+GST_RTSP_API
+void               gst_rtsp_connection_set_zero_copy  (GstRTSPConnection *conn, gboolean zero_copy);
+
+GST_RTSP_API
+gboolean           gst_rtsp_connection_get_zero_copy  (GstRTSPConnection *conn);
+
 /* async IO */
 
 /**
@@ -313,6 +319,12 @@ GstRTSPResult      gst_rtsp_watch_send_message       (GstRTSPWatch *watch,
                                                       GstRTSPMessage *message,
                                                       guint *id);
 
+GST_RTSP_API
+GstRTSPResult      gst_rtsp_watch_send_buffer_list   (GstRTSPWatch *watch,
+                                                      guint8 channel,
+                                                      GstBufferList *list,
+                                                      guint *id);
+
 GST_RTSP_API
 GstRTSPResult      gst_rtsp_watch_wait_backlog       (GstRTSPWatch * watch,
                                                       GTimeVal *timeout);
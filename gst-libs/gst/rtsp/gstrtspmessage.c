@@ -504,6 +504,7 @@ gst_rtsp_message_unset (GstRTSPMessage * msg)
     g_array_free (msg->hdr_fields, TRUE);
   }
   g_free (msg->body);
+  gst_buffer_replace (&msg->body_buffer, NULL);
 
   memset (msg, 0, sizeof (GstRTSPMessage));
 
@@ -583,7 +584,10 @@ gst_rtsp_message_copy (const GstRTSPMessage * msg, GstRTSPMessage ** copy)
   }
 
   key_value_foreach (msg->hdr_fields, (GFunc) key_value_append, cp->hdr_fields);
-  gst_rtsp_message_set_body (cp, msg->body, msg->body_size);
+  if (msg->body_buffer)
+    gst_rtsp_message_set_body_buffer (cp, msg->body_buffer);
+  else
+    gst_rtsp_message_set_body (cp, msg->body, msg->body_size);
 
   return GST_RTSP_OK;
 }
@@ -956,6 +960,7 @@ gst_rtsp_message_take_body (GstRTSPMessage * msg, guint8 * data, guint size)
   g_return_val_if_fail (data != NULL || size == 0, GST_RTSP_EINVAL);
 
   g_free (msg->body);
+  gst_buffer_replace (&msg->body_buffer, NULL);
 
   msg->body = data;
   msg->body_size = size;
@@ -972,6 +977,9 @@ gst_rtsp_message_take_body (GstRTSPMessage * msg, guint8 * data, guint size)
  * Get the body of @msg. @data remains valid for as long as @msg is valid and
  * unchanged.
  *
+ * If the body of @msg was set with gst_rtsp_message_take_body_buffer(), this
+ * returns the data of the buffer without copying it.
+ *
  * Returns: #GST_RTSP_OK.
  */
 GstRTSPResult
@@ -982,8 +990,23 @@ gst_rtsp_message_get_body (const GstRTSPMessage * msg, guint8 ** data,
   g_return_val_if_fail (data != NULL, GST_RTSP_EINVAL);
   g_return_val_if_fail (size != NULL, GST_RTSP_EINVAL);
 
-  *data = msg->body;
-  *size = msg->body_size;
+  if (msg->body_buffer && gst_buffer_get_size (msg->body_buffer) == 0) {
+    *data = NULL;
+    *size = 0;
+  } else if (msg->body_buffer) {
+    GstMapInfo map;
+
+    /* the buffer has exactly one memory, so the data stays valid after
+     * unmapping for as long as the buffer is alive */
+    if (!gst_buffer_map (msg->body_buffer, &map, GST_MAP_READ))
+      return GST_RTSP_ERROR;
+    *data = map.data;
+    *size = map.size;
+    gst_buffer_unmap (msg->body_buffer, &map);
+  } else {
+    *data = msg->body;
+    *size = msg->body_size;
+  }
 
   return GST_RTSP_OK;
 }
@@ -997,6 +1020,9 @@ gst_rtsp_message_get_body (const GstRTSPMessage * msg, guint8 ** data,
  * Take the body of @msg and store it in @data and @size. After this method,
  * the body and size of @msg will be set to %NULL and 0 respectively.
  *
+ * If the body of @msg was set with gst_rtsp_message_take_body_buffer(), the
+ * data of the buffer is copied into @data.
+ *
  * Returns: #GST_RTSP_OK.
  */
 GstRTSPResult
@@ -1006,8 +1032,17 @@ gst_rtsp_message_steal_body (GstRTSPMessage * msg, guint8 ** data, guint * size)
   g_return_val_if_fail (data != NULL, GST_RTSP_EINVAL);
   g_return_val_if_fail (size != NULL, GST_RTSP_EINVAL);
 
-  *data = msg->body;
-  *size = msg->body_size;
+  if (msg->body_buffer) {
+    gsize body_size;
+
+    gst_buffer_extract_dup (msg->body_buffer, 0, -1, (gpointer *) data,
+        &body_size);
+    *size = body_size;
+    gst_buffer_replace (&msg->body_buffer, NULL);
+  } else {
+    *data = msg->body;
+    *size = msg->body_size;
+  }
 
   msg->body = NULL;
   msg->body_size = 0;
@@ -1015,6 +1050,141 @@ gst_rtsp_message_steal_body (GstRTSPMessage * msg, guint8 ** data, guint * size)
   return GST_RTSP_OK;
 }
 
+/**
+ * gst_rtsp_message_set_body_buffer:
+ * @msg: a #GstRTSPMessage
+ * @buffer: (transfer none): a #GstBuffer
+ *
+ * Set the body of @msg to @buffer. This method adds a reference to @buffer.
+ *
+ * Returns: #GST_RTSP_OK.
+ *
+ * Since: 1.16
+ */
+GstRTSPResult
+gst_rtsp_message_set_body_buffer (GstRTSPMessage * msg, GstBuffer * buffer)
+{
+  g_return_val_if_fail (msg != NULL, GST_RTSP_EINVAL);
+  g_return_val_if_fail (GST_IS_BUFFER (buffer), GST_RTSP_EINVAL);
+
+  return gst_rtsp_message_take_body_buffer (msg, gst_buffer_ref (buffer));
+}
+
+/**
+ * gst_rtsp_message_take_body_buffer:
+ * @msg: a #GstRTSPMessage
+ * @buffer: (transfer full): a #GstBuffer
+ *
+ * Set the body of @msg to @buffer. This method takes ownership of @buffer.
+ *
+ * The memory of @buffer is merged when it consists of more than one
+ * #GstMemory, so that gst_rtsp_message_get_body() can hand out a pointer
+ * into it.
+ *
+ * Returns: #GST_RTSP_OK.
+ *
+ * Since: 1.16
+ */
+GstRTSPResult
+gst_rtsp_message_take_body_buffer (GstRTSPMessage * msg, GstBuffer * buffer)
+{
+  g_return_val_if_fail (msg != NULL, GST_RTSP_EINVAL);
+  g_return_val_if_fail (GST_IS_BUFFER (buffer), GST_RTSP_EINVAL);
+
+  if (gst_buffer_n_memory (buffer) > 1) {
+    GstMemory *mem = gst_buffer_get_all_memory (buffer);
+
+    gst_buffer_unref (buffer);
+    buffer = gst_buffer_new ();
+    gst_buffer_append_memory (buffer, mem);
+  }
+
+  g_free (msg->body);
+  msg->body = NULL;
+  msg->body_size = 0;
+
+  gst_buffer_replace (&msg->body_buffer, NULL);
+  msg->body_buffer = buffer;
+
+  return GST_RTSP_OK;
+}
+
+/**
+ * gst_rtsp_message_get_body_buffer:
+ * @msg: a #GstRTSPMessage
+ * @buffer: (out) (transfer none): location for the buffer
+ *
+ * Get the body of @msg as set with gst_rtsp_message_take_body_buffer(). The
+ * buffer remains valid for as long as @msg is valid and unchanged. @buffer
+ * is set to %NULL when the body of @msg is not stored in a #GstBuffer.
+ *
+ * Returns: #GST_RTSP_OK.
+ *
+ * Since: 1.16
+ */
+GstRTSPResult
+gst_rtsp_message_get_body_buffer (const GstRTSPMessage * msg,
+    GstBuffer ** buffer)
+{
+  g_return_val_if_fail (msg != NULL, GST_RTSP_EINVAL);
+  g_return_val_if_fail (buffer != NULL, GST_RTSP_EINVAL);
+
+  *buffer = msg->body_buffer;
+
+  return GST_RTSP_OK;
+}
+
+/**
+ * gst_rtsp_message_steal_body_buffer:
+ * @msg: a #GstRTSPMessage
+ * @buffer: (out) (transfer full): location for the buffer
+ *
+ * Take the body of @msg and store it in @buffer. After this method, @msg
+ * has no body anymore. If the body was not stored in a #GstBuffer, a buffer
+ * wrapping the body data is created.
+ *
+ * Returns: #GST_RTSP_OK.
+ *
+ * Since: 1.16
+ */
+GstRTSPResult
+gst_rtsp_message_steal_body_buffer (GstRTSPMessage * msg, GstBuffer ** buffer)
+{
+  g_return_val_if_fail (msg != NULL, GST_RTSP_EINVAL);
+  g_return_val_if_fail (buffer != NULL, GST_RTSP_EINVAL);
+
+  if (msg->body_buffer) {
+    *buffer = msg->body_buffer;
+    msg->body_buffer = NULL;
+  } else if (msg->body) {
+    *buffer = gst_buffer_new_wrapped (msg->body, msg->body_size);
+    msg->body = NULL;
+    msg->body_size = 0;
+  } else {
+    *buffer = NULL;
+  }
+
+  return GST_RTSP_OK;
+}
+
+/**
+ * gst_rtsp_message_has_body_buffer:
+ * @msg: a #GstRTSPMessage
+ *
+ * Checks if @msg has a body stored in a #GstBuffer.
+ *
+ * Returns: %TRUE if @msg has a body buffer.
+ *
+ * Since: 1.16
+ */
+gboolean
+gst_rtsp_message_has_body_buffer (const GstRTSPMessage * msg)
+{
+  g_return_val_if_fail (msg != NULL, FALSE);
+
+  return msg->body_buffer != NULL;
+}
+
 static void
 dump_key_value (gpointer data, gpointer user_data G_GNUC_UNUSED)
 {
@@ -1103,8 +1273,8 @@ gst_rtsp_message_dump (GstRTSPMessage * msg)
     case GST_RTSP_MESSAGE_DATA:
       g_print ("RTSP data message %p\n", msg);
       g_print (" channel: '%d'\n", msg->type_data.data.channel);
-      g_print (" size:    '%d'\n", msg->body_size);
       gst_rtsp_message_get_body (msg, &data, &size);
+      g_print (" size:    '%d'\n", size);
       gst_util_dump_mem (data, size);
       break;
     default:
@@ -369,7 +369,19 @@ struct _GstVideoDecoderPrivate
   guint32 system_frame_number;
   guint32 decode_frame_number;
 
-  GList *frames;                /* Protected with OBJECT_LOCK */
+  GQueue frames;                /* Protected with OBJECT_LOCK */
+  /* system_frame_number -> link in frames */
+  GHashTable *frames_by_number;
+
+  /* parallel decoding, see gst_video_decoder_dispatch_frame().
+   * decode_threads is written with STREAM_LOCK, read atomically */
+  gint decode_threads;
+  GThreadPool *decode_pool;
+  GMutex dispatch_lock;
+  GCond dispatch_cond;
+  GQueue dispatched;            /* DispatchedFrame, protected by dispatch_lock */
+  guint dispatch_busy;          /* frames being decoded, dispatch_lock */
+  GstFlowReturn dispatch_ret;   /* STREAM_LOCK */
   GstVideoCodecState *input_state;
   GstVideoCodecState *output_state;     /* OBJECT_LOCK and STREAM_LOCK */
   gboolean output_state_changed;
@@ -571,6 +583,13 @@ gst_video_decoder_init (GstVideoDecoder * decoder, GstVideoDecoderClass * klass)
   decoder->priv->input_adapter = gst_adapter_new ();
   decoder->priv->output_adapter = gst_adapter_new ();
   decoder->priv->packetized = TRUE;
+
+  g_queue_init (&decoder->priv->frames);
+  decoder->priv->frames_by_number = g_hash_table_new (NULL, NULL);
+
+  g_mutex_init (&decoder->priv->dispatch_lock);
+  g_cond_init (&decoder->priv->dispatch_cond);
+  g_queue_init (&decoder->priv->dispatched);
   decoder->priv->needs_format = FALSE;
 
   decoder->priv->min_latency = 0;
@@ -746,6 +765,13 @@ gst_video_decoder_finalize (GObject * object)
 
   g_rec_mutex_clear (&decoder->stream_lock);
 
+  g_hash_table_destroy (decoder->priv->frames_by_number);
+
+  if (decoder->priv->decode_pool)
+    g_thread_pool_free (decoder->priv->decode_pool, FALSE, TRUE);
+  g_mutex_clear (&decoder->priv->dispatch_lock);
+  g_cond_clear (&decoder->priv->dispatch_cond);
+
   if (decoder->priv->input_adapter) {
     g_object_unref (decoder->priv->input_adapter);
     decoder->priv->input_adapter = NULL;
@@ -773,6 +799,93 @@ gst_video_decoder_finalize (GObject * object)
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
+typedef struct
+{
+  GstVideoCodecFrame *frame;
+  GstFlowReturn ret;
+  gboolean done;
+} DispatchedFrame;
+
+/* Finishes decoded frames from the head of the reorder queue until at most
+ * @keep frames are left in it. When the head is still being decoded, waits
+ * for it if @wait is %TRUE and stops otherwise. The first flow error is kept
+ * in dispatch_ret. Call with the STREAM_LOCK held, from the streaming
+ * thread. */
+static void
+gst_video_decoder_finish_dispatched (GstVideoDecoder * dec, guint keep,
+    gboolean wait)
+{
+  GstVideoDecoderPrivate *priv = dec->priv;
+  DispatchedFrame *df;
+  GstFlowReturn ret;
+
+  g_mutex_lock (&priv->dispatch_lock);
+  while (priv->dispatched.length > keep) {
+    df = g_queue_peek_head (&priv->dispatched);
+    if (!df->done) {
+      if (!wait)
+        break;
+      g_cond_wait (&priv->dispatch_cond, &priv->dispatch_lock);
+      continue;
+    }
+    g_queue_pop_head (&priv->dispatched);
+    g_mutex_unlock (&priv->dispatch_lock);
+
+    if (df->ret == GST_FLOW_OK) {
+      ret = gst_video_decoder_finish_frame (dec, df->frame);
+    } else {
+      GST_DEBUG_OBJECT (dec, "frame %d failed to decode: %s",
+          df->frame->system_frame_number, gst_flow_get_name (df->ret));
+      gst_video_decoder_drop_frame (dec, df->frame);
+      ret = df->ret;
+    }
+    if (priv->dispatch_ret == GST_FLOW_OK)
+      priv->dispatch_ret = ret;
+    g_slice_free (DispatchedFrame, df);
+
+    g_mutex_lock (&priv->dispatch_lock);
+  }
+  g_mutex_unlock (&priv->dispatch_lock);
+}
+
+/* Waits for the workers and releases all dispatched frames without
+ * pushing them. Call with the STREAM_LOCK held. */
+static void
+gst_video_decoder_discard_dispatched (GstVideoDecoder * dec)
+{
+  GstVideoDecoderPrivate *priv = dec->priv;
+  DispatchedFrame *df;
+
+  g_mutex_lock (&priv->dispatch_lock);
+  while (priv->dispatch_busy > 0)
+    g_cond_wait (&priv->dispatch_cond, &priv->dispatch_lock);
+  while ((df = g_queue_pop_head (&priv->dispatched))) {
+    gst_video_decoder_release_frame (dec, df->frame);
+    g_slice_free (DispatchedFrame, df);
+  }
+  g_mutex_unlock (&priv->dispatch_lock);
+
+  priv->dispatch_ret = GST_FLOW_OK;
+}
+
+static void
+gst_video_decoder_dispatch_func (DispatchedFrame * df, GstVideoDecoder * dec)
+{
+  GstVideoDecoderClass *decoder_class = GST_VIDEO_DECODER_GET_CLASS (dec);
+  GstVideoDecoderPrivate *priv = dec->priv;
+  GstFlowReturn ret;
+
+  ret = decoder_class->decode_frame (dec, df->frame);
+
+  /* the streaming thread finishes the frame, in presentation order */
+  g_mutex_lock (&priv->dispatch_lock);
+  df->ret = ret;
+  df->done = TRUE;
+  priv->dispatch_busy--;
+  g_cond_broadcast (&priv->dispatch_cond);
+  g_mutex_unlock (&priv->dispatch_lock);
+}
+
 /* hard == FLUSH, otherwise discont */
 static GstFlowReturn
 gst_video_decoder_flush (GstVideoDecoder * dec, gboolean hard)
@@ -782,6 +895,9 @@ gst_video_decoder_flush (GstVideoDecoder * dec, gboolean hard)
 
   GST_LOG_OBJECT (dec, "flush hard %d", hard);
 
+  /* wait for the workers before the subclass resets its state */
+  gst_video_decoder_discard_dispatched (dec);
+
   /* Inform subclass */
   if (klass->reset) {
     GST_FIXME_OBJECT (dec, "GstVideoDecoder::reset() is deprecated");
@@ -923,6 +1039,10 @@ gst_video_decoder_drain_out (GstVideoDecoder * dec, gboolean at_eos)
       ret = gst_video_decoder_parse_available (dec, TRUE, FALSE);
     }
 
+    /* output what the workers are still decoding before anything the
+     * subclass has left */
+    gst_video_decoder_finish_dispatched (dec, 0, TRUE);
+
     if (at_eos) {
       if (decoder_class->finish)
         ret = decoder_class->finish (dec);
@@ -933,6 +1053,11 @@ gst_video_decoder_drain_out (GstVideoDecoder * dec, gboolean at_eos)
         GST_FIXME_OBJECT (dec, "Sub-class should implement drain()");
       }
     }
+
+    gst_video_decoder_finish_dispatched (dec, 0, TRUE);
+    if (ret == GST_FLOW_OK)
+      ret = priv->dispatch_ret;
+    priv->dispatch_ret = GST_FLOW_OK;
   } else {
     /* Reverse playback mode */
     ret = gst_video_decoder_flush_parse (dec, TRUE);
@@ -1297,7 +1422,7 @@ gst_video_decoder_sink_event_default (GstVideoDecoder * decoder,
       GList *l;
 
       GST_VIDEO_DECODER_STREAM_LOCK (decoder);
-      for (l = priv->frames; l; l = l->next) {
+      for (l = priv->frames.head; l; l = l->next) {
         GstVideoCodecFrame *frame = l->data;
 
         frame->events = _flush_events (decoder->srcpad, frame->events);
@@ -1970,6 +2095,41 @@ gst_video_decoder_get_buffer_info_at_offset (GstVideoDecoder *
       GST_TIME_ARGS (*pts), GST_TIME_ARGS (*dts), *flags, got_offset, offset);
 }
 
+/* frames are kept in decoding order in a queue and indexed by their
+ * system_frame_number so that lookups and removals don't need to walk
+ * the queue. Call with the STREAM_LOCK held. */
+static void
+gst_video_decoder_add_frame (GstVideoDecoder * dec, GstVideoCodecFrame * frame)
+{
+  GstVideoDecoderPrivate *priv = dec->priv;
+
+  g_queue_push_tail (&priv->frames, frame);
+  g_hash_table_insert (priv->frames_by_number,
+      GINT_TO_POINTER (frame->system_frame_number), priv->frames.tail);
+}
+
+static gboolean
+gst_video_decoder_remove_frame (GstVideoDecoder * dec,
+    GstVideoCodecFrame * frame)
+{
+  GstVideoDecoderPrivate *priv = dec->priv;
+  gpointer key = GINT_TO_POINTER (frame->system_frame_number);
+  GList *link;
+
+  link = g_hash_table_lookup (priv->frames_by_number, key);
+  if (link == NULL || link->data != frame) {
+    /* not indexed under its number, the subclass changed it */
+    link = g_queue_find (&priv->frames, frame);
+    if (link == NULL)
+      return FALSE;
+  } else {
+    g_hash_table_remove (priv->frames_by_number, key);
+  }
+  g_queue_delete_link (&priv->frames, link);
+
+  return TRUE;
+}
+
 static void
 gst_video_decoder_clear_queues (GstVideoDecoder * dec)
 {
@@ -1988,8 +2148,9 @@ gst_video_decoder_clear_queues (GstVideoDecoder * dec)
   g_list_free_full (priv->parse_gather,
       (GDestroyNotify) gst_video_codec_frame_unref);
   priv->parse_gather = NULL;
-  g_list_free_full (priv->frames, (GDestroyNotify) gst_video_codec_frame_unref);
-  priv->frames = NULL;
+  g_queue_foreach (&priv->frames, (GFunc) gst_video_codec_frame_unref, NULL);
+  g_queue_clear (&priv->frames);
+  g_hash_table_remove_all (priv->frames_by_number);
 }
 
 static void
@@ -2055,6 +2216,7 @@ gst_video_decoder_reset (GstVideoDecoder * decoder, gboolean full,
 
     priv->dropped = 0;
     priv->processed = 0;
+    priv->dispatch_ret = GST_FLOW_OK;
 
     priv->decode_frame_number = 0;
     priv->base_picture_number = 0;
@@ -2195,6 +2357,9 @@ gst_video_decoder_flush_decode (GstVideoDecoder * dec)
     walk = next;
   }
 
+  /* the decoded frames need to be queued for output before we return */
+  gst_video_decoder_finish_dispatched (dec, 0, TRUE);
+
   return res;
 }
 
@@ -2457,7 +2622,18 @@ gst_video_decoder_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
   else
     ret = gst_video_decoder_chain_reverse (decoder, buf);
 
+  /* output the frames the workers have completed so far, except for the
+   * last ones that may still be reordered with frames dispatched later */
+  if (decoder->priv->decode_pool) {
+    gst_video_decoder_finish_dispatched (decoder,
+        decoder->priv->decode_threads, FALSE);
+    if (ret == GST_FLOW_OK)
+      ret = decoder->priv->dispatch_ret;
+    decoder->priv->dispatch_ret = GST_FLOW_OK;
+  }
+
   GST_VIDEO_DECODER_STREAM_UNLOCK (decoder);
+
   return ret;
 
   /* ERRORS */
@@ -2505,6 +2681,14 @@ gst_video_decoder_change_state (GstElement * element, GstStateChange transition)
     case GST_STATE_CHANGE_PAUSED_TO_READY:{
       gboolean stopped = TRUE;
 
+      GST_VIDEO_DECODER_STREAM_LOCK (decoder);
+      gst_video_decoder_discard_dispatched (decoder);
+      GST_VIDEO_DECODER_STREAM_UNLOCK (decoder);
+      if (decoder->priv->decode_pool) {
+        g_thread_pool_free (decoder->priv->decode_pool, FALSE, TRUE);
+        decoder->priv->decode_pool = NULL;
+      }
+
       if (decoder_class->stop)
         stopped = decoder_class->stop (decoder);
 
@@ -2611,7 +2795,7 @@ gst_video_decoder_prepare_finish_frame (GstVideoDecoder *
 
 #ifndef GST_DISABLE_GST_DEBUG
   GST_LOG_OBJECT (decoder, "n %d in %" G_GSIZE_FORMAT " out %" G_GSIZE_FORMAT,
-      g_list_length (priv->frames),
+      priv->frames.length,
       gst_adapter_available (priv->input_adapter),
       gst_adapter_available (priv->output_adapter));
 #endif
@@ -2625,7 +2809,7 @@ gst_video_decoder_prepare_finish_frame (GstVideoDecoder *
       sync, GST_TIME_ARGS (frame->pts), GST_TIME_ARGS (frame->dts));
 
   /* Push all pending events that arrived before this frame */
-  for (l = priv->frames; l; l = l->next) {
+  for (l = priv->frames.head; l; l = l->next) {
     GstVideoCodecFrame *tmp = l->data;
 
     if (tmp->events) {
@@ -2685,7 +2869,7 @@ gst_video_decoder_prepare_finish_frame (GstVideoDecoder *
     gboolean seen_none = FALSE;
 
     /* some maintenance regardless */
-    for (l = priv->frames; l; l = l->next) {
+    for (l = priv->frames.head; l; l = l->next) {
       GstVideoCodecFrame *tmp = l->data;
 
       if (!GST_CLOCK_TIME_IS_VALID (tmp->abidata.ABI.ts)) {
@@ -2719,7 +2903,7 @@ gst_video_decoder_prepare_finish_frame (GstVideoDecoder *
     /* some more maintenance, ts2 holds PTS */
     min_ts = GST_CLOCK_TIME_NONE;
     seen_none = FALSE;
-    for (l = priv->frames; l; l = l->next) {
+    for (l = priv->frames.head; l; l = l->next) {
       GstVideoCodecFrame *tmp = l->data;
 
       if (!GST_CLOCK_TIME_IS_VALID (tmp->abidata.ABI.ts2)) {
@@ -2811,15 +2995,10 @@ void
 gst_video_decoder_release_frame (GstVideoDecoder * dec,
     GstVideoCodecFrame * frame)
 {
-  GList *link;
-
   /* unref once from the list */
   GST_VIDEO_DECODER_STREAM_LOCK (dec);
-  link = g_list_find (dec->priv->frames, frame);
-  if (link) {
+  if (gst_video_decoder_remove_frame (dec, frame))
     gst_video_codec_frame_unref (frame);
-    dec->priv->frames = g_list_delete_link (dec->priv->frames, link);
-  }
   if (frame->events) {
     dec->priv->pending_events =
         g_list_concat (frame->events, dec->priv->pending_events);
@@ -2891,6 +3070,119 @@ gst_video_decoder_drop_frame (GstVideoDecoder * dec, GstVideoCodecFrame * frame)
   return GST_FLOW_OK;
 }
 
+/**
+ * gst_video_decoder_dispatch_frame:
+ * @decoder: a #GstVideoDecoder
+ * @frame: (transfer full): the #GstVideoCodecFrame to decode
+ *
+ * Hands @frame to a worker thread that decodes it with the
+ * #GstVideoDecoderClass.decode_frame() vfunc, for frames that can be decoded
+ * independently of the frames before and after them, e.g. in intra-only
+ * formats. This is typically called from #GstVideoDecoderClass.handle_frame()
+ * after the output buffer was allocated with
+ * gst_video_decoder_allocate_output_frame(). The timestamps of @frame must be
+ * set before, the worker may only fill the output buffer.
+ *
+ * The decoded frames are kept in a reorder queue and finished from the
+ * streaming thread in presentation order, as if
+ * gst_video_decoder_finish_frame() had been called for them, or dropped if
+ * decoding failed. To allow for reordering, the last frames are only
+ * finished once as many frames as there are decode threads were dispatched
+ * after them, or when the decoder is drained.
+ *
+ * When no decode threads were configured with
+ * gst_video_decoder_set_decode_threads(), @frame is decoded and finished
+ * right away. Otherwise this blocks while too many frames are in flight.
+ *
+ * Returns: a #GstFlowReturn resulting from finishing previously dispatched
+ *     frames, usually GST_FLOW_OK.
+ *
+ * Since: 1.16
+ */
+GstFlowReturn
+gst_video_decoder_dispatch_frame (GstVideoDecoder * decoder,
+    GstVideoCodecFrame * frame)
+{
+  GstVideoDecoderClass *decoder_class = GST_VIDEO_DECODER_GET_CLASS (decoder);
+  GstVideoDecoderPrivate *priv = decoder->priv;
+  DispatchedFrame *df;
+  GList *link;
+  GstFlowReturn ret;
+
+  g_return_val_if_fail (GST_IS_VIDEO_DECODER (decoder), GST_FLOW_ERROR);
+  g_return_val_if_fail (decoder_class->decode_frame != NULL, GST_FLOW_ERROR);
+
+  GST_VIDEO_DECODER_STREAM_LOCK (decoder);
+
+  if (priv->decode_threads == 0) {
+    ret = decoder_class->decode_frame (decoder, frame);
+    if (ret == GST_FLOW_OK)
+      ret = gst_video_decoder_finish_frame (decoder, frame);
+    else
+      gst_video_decoder_drop_frame (decoder, frame);
+    GST_VIDEO_DECODER_STREAM_UNLOCK (decoder);
+    return ret;
+  }
+
+  if (priv->decode_pool == NULL) {
+    GError *err = NULL;
+
+    priv->decode_pool =
+        g_thread_pool_new ((GFunc) gst_video_decoder_dispatch_func, decoder,
+        priv->decode_threads, FALSE, &err);
+    if (priv->decode_pool == NULL)
+      goto no_pool;
+  }
+
+  /* keep the workers busy, but don't let the output fall behind more than
+   * a few frames per thread */
+  gst_video_decoder_finish_dispatched (decoder, 2 * priv->decode_threads - 1,
+      TRUE);
+
+  df = g_slice_new0 (DispatchedFrame);
+  df->frame = frame;
+
+  /* the reorder queue is kept in presentation order, frames without
+   * timestamps stay in the order they were dispatched */
+  g_mutex_lock (&priv->dispatch_lock);
+  link = priv->dispatched.tail;
+  if (GST_CLOCK_TIME_IS_VALID (frame->pts)) {
+    while (link) {
+      GstClockTime pts = ((DispatchedFrame *) link->data)->frame->pts;
+
+      if (!GST_CLOCK_TIME_IS_VALID (pts) || pts <= frame->pts)
+        break;
+      link = link->prev;
+    }
+  }
+  if (link)
+    g_queue_insert_after (&priv->dispatched, link, df);
+  else
+    g_queue_push_head (&priv->dispatched, df);
+  priv->dispatch_busy++;
+  g_mutex_unlock (&priv->dispatch_lock);
+
+  g_thread_pool_push (priv->decode_pool, df, NULL);
+
+  ret = priv->dispatch_ret;
+  priv->dispatch_ret = GST_FLOW_OK;
+
+  GST_VIDEO_DECODER_STREAM_UNLOCK (decoder);
+
+  return ret;
+
+  /* ERRORS */
+no_pool:
+  {
+    GST_ERROR_OBJECT (decoder, "failed to create decode threads: %s",
+        err->message);
+    g_clear_error (&err);
+    gst_video_decoder_drop_frame (decoder, frame);
+    GST_VIDEO_DECODER_STREAM_UNLOCK (decoder);
+    return GST_FLOW_ERROR;
+  }
+}
+
 static gboolean
 gst_video_decoder_transform_meta_default (GstVideoDecoder *
     decoder, GstVideoCodecFrame * frame, GstMeta * meta)
@@ -3401,11 +3693,11 @@ gst_video_decoder_decode_frame (GstVideoDecoder * decoder,
       frame->distance_from_sync);
 
   gst_video_codec_frame_ref (frame);
-  priv->frames = g_list_append (priv->frames, frame);
+  gst_video_decoder_add_frame (decoder, frame);
 
-  if (g_list_length (priv->frames) > 10) {
+  if (priv->frames.length > 10) {
     GST_DEBUG_OBJECT (decoder, "decoder frame list getting long: %d frames,"
-        "possible internal leaking?", g_list_length (priv->frames));
+        "possible internal leaking?", priv->frames.length);
   }
 
   frame->deadline =
@@ -3523,8 +3815,8 @@ gst_video_decoder_get_oldest_frame (GstVideoDecoder * decoder)
   GstVideoCodecFrame *frame = NULL;
 
   GST_VIDEO_DECODER_STREAM_LOCK (decoder);
-  if (decoder->priv->frames)
-    frame = gst_video_codec_frame_ref (decoder->priv->frames->data);
+  if (decoder->priv->frames.head)
+    frame = gst_video_codec_frame_ref (decoder->priv->frames.head->data);
   GST_VIDEO_DECODER_STREAM_UNLOCK (decoder);
 
   return (GstVideoCodecFrame *) frame;
@@ -3548,14 +3840,20 @@ gst_video_decoder_get_frame (GstVideoDecoder * decoder, int frame_number)
   GST_DEBUG_OBJECT (decoder, "frame_number : %d", frame_number);
 
   GST_VIDEO_DECODER_STREAM_LOCK (decoder);
-  for (g = decoder->priv->frames; g; g = g->next) {
-    GstVideoCodecFrame *tmp = g->data;
-
-    if (tmp->system_frame_number == frame_number) {
-      frame = gst_video_codec_frame_ref (tmp);
-      break;
+  g = g_hash_table_lookup (decoder->priv->frames_by_number,
+      GINT_TO_POINTER (frame_number));
+  if (g == NULL || ((GstVideoCodecFrame *) g->data)->system_frame_number !=
+      frame_number) {
+    /* not indexed under this number, the subclass may have changed it */
+    for (g = decoder->priv->frames.head; g; g = g->next) {
+      GstVideoCodecFrame *tmp = g->data;
+
+      if (tmp->system_frame_number == frame_number)
+        break;
     }
   }
+  if (g)
+    frame = gst_video_codec_frame_ref (g->data);
   GST_VIDEO_DECODER_STREAM_UNLOCK (decoder);
 
   return frame;
@@ -3575,7 +3873,7 @@ gst_video_decoder_get_frames (GstVideoDecoder * decoder)
   GList *frames;
 
   GST_VIDEO_DECODER_STREAM_LOCK (decoder);
-  frames = g_list_copy (decoder->priv->frames);
+  frames = g_list_copy (decoder->priv->frames.head);
   g_list_foreach (frames, (GFunc) gst_video_codec_frame_ref, NULL);
   GST_VIDEO_DECODER_STREAM_UNLOCK (decoder);
 
@@ -3815,7 +4113,7 @@ gst_video_decoder_negotiate_default (GstVideoDecoder * decoder)
 
   /* Push all pending pre-caps events of the oldest frame before
    * setting caps */
-  frame = decoder->priv->frames ? decoder->priv->frames->data : NULL;
+  frame = decoder->priv->frames.head ? decoder->priv->frames.head->data : NULL;
   if (frame || decoder->priv->current_frame_events) {
     GList **events, *l;
 
@@ -4412,6 +4710,53 @@ gst_video_decoder_get_allocator (GstVideoDecoder * decoder,
     *params = decoder->priv->params;
 }
 
+/**
+ * gst_video_decoder_set_decode_threads:
+ * @decoder: a #GstVideoDecoder
+ * @n_threads: number of worker threads, 0 to decode on the streaming thread
+ *
+ * Sets the number of threads that decode the frames handed to
+ * gst_video_decoder_dispatch_frame(). Subclasses that implement
+ * #GstVideoDecoderClass.decode_frame() usually call this from
+ * #GstVideoDecoderClass.start(), e.g. with g_get_num_processors().
+ *
+ * The threads are only created when the first frame is dispatched and are
+ * kept until the decoder is stopped. Changes made after that take effect
+ * the next time the decoder is started.
+ *
+ * Since: 1.16
+ */
+void
+gst_video_decoder_set_decode_threads (GstVideoDecoder * decoder,
+    guint n_threads)
+{
+  g_return_if_fail (GST_IS_VIDEO_DECODER (decoder));
+
+  GST_VIDEO_DECODER_STREAM_LOCK (decoder);
+  if (decoder->priv->decode_pool == NULL)
+    g_atomic_int_set (&decoder->priv->decode_threads, n_threads);
+  else
+    GST_WARNING_OBJECT (decoder, "decode threads already running");
+  GST_VIDEO_DECODER_STREAM_UNLOCK (decoder);
+}
+
+/**
+ * gst_video_decoder_get_decode_threads:
+ * @decoder: a #GstVideoDecoder
+ *
+ * Returns: the number of decode threads configured with
+ *     gst_video_decoder_set_decode_threads().
+ *
+ * Since: 1.16
+ */
+guint
+gst_video_decoder_get_decode_threads (GstVideoDecoder * decoder)
+{
+  g_return_val_if_fail (GST_IS_VIDEO_DECODER (decoder), 0);
+
+  return g_atomic_int_get (&decoder->priv->decode_threads);
+}
+
 /**
  * gst_video_decoder_set_use_default_pad_acceptcaps:
  * @decoder: a #GstVideoDecoder
@@ -272,6 +272,17 @@ struct _GstVideoDecoder
  *                  tags and meta with only the "video" tag. subclasses can
  *                  implement this method and return %TRUE if the metadata is to be
  *                  copied. Since 1.6
+ * @decode_frame:   Optional.
+ *                  Decodes a frame that was handed to
+ *                  gst_video_decoder_dispatch_frame(). Called from a worker
+ *                  thread without the stream lock, possibly for several frames
+ *                  at once, so it must only fill the output buffer of the
+ *                  frame, read its input buffer and use thread-safe subclass
+ *                  state. The timestamps and flags of the frame are owned by
+ *                  the streaming thread while it is decoded, and it must not
+ *                  call back into the base class.
+ *                  Returning %GST_FLOW_OK finishes the frame, any other value
+ *                  drops it. Since: 1.16
  *
  * Subclasses can override any of the available virtual methods or not, as
  * needed. At minimum @handle_frame needs to be overridden, and @set_format
@@ -337,8 +348,11 @@ struct _GstVideoDecoderClass
                                    GstVideoCodecFrame *frame,
                                    GstMeta * meta);
 
+  GstFlowReturn (*decode_frame)   (GstVideoDecoder *decoder,
+                                   GstVideoCodecFrame *frame);
+
   /*< private >*/
-  gpointer padding[GST_PADDING_LARGE-6];
+  gpointer padding[GST_PADDING_LARGE-7];
 };
 
 GST_VIDEO_API
@@ -392,6 +406,13 @@ void     gst_video_decoder_get_allocator (GstVideoDecoder *decoder,
 GST_VIDEO_API
 GstBufferPool *gst_video_decoder_get_buffer_pool (GstVideoDecoder *decoder);
 
+GST_VIDEO_API
+void     gst_video_decoder_set_decode_threads (GstVideoDecoder *decoder,
+                                               guint n_threads);
+
+GST_VIDEO_API
+guint    gst_video_decoder_get_decode_threads (GstVideoDecoder *decoder);
+
 /* Object methods */
 
 GST_VIDEO_API
@@ -454,6 +475,10 @@ GST_VIDEO_API
 GstFlowReturn    gst_video_decoder_drop_frame (GstVideoDecoder *dec,
 					       GstVideoCodecFrame *frame);
 
+GST_VIDEO_API
+GstFlowReturn    gst_video_decoder_dispatch_frame (GstVideoDecoder *decoder,
+						   GstVideoCodecFrame *frame);
+
 GST_VIDEO_API
 void             gst_video_decoder_release_frame (GstVideoDecoder * dec,
 						  GstVideoCodecFrame * frame);
@@ -146,7 +146,9 @@ struct _GstVideoEncoderPrivate
 
   guint32 system_frame_number;
 
-  GList *frames;                /* Protected with OBJECT_LOCK */
+  GQueue frames;                /* Protected with OBJECT_LOCK */
+  /* system_frame_number -> link in frames */
+  GHashTable *frames_by_number;
   GstVideoCodecState *input_state;
   GstVideoCodecState *output_state;
   gboolean output_state_changed;
@@ -236,6 +238,8 @@ static gboolean gst_video_encoder_src_query (GstPad * pad, GstObject * parent,
 static GstVideoCodecFrame *gst_video_encoder_new_frame (GstVideoEncoder *
     encoder, GstBuffer * buf, GstClockTime pts, GstClockTime dts,
     GstClockTime duration);
+static void gst_video_encoder_add_frame (GstVideoEncoder * enc,
+    GstVideoCodecFrame * frame);
 
 static gboolean gst_video_encoder_sink_event_default (GstVideoEncoder * encoder,
     GstEvent * event);
@@ -451,7 +455,7 @@ gst_video_encoder_reset (GstVideoEncoder * encoder, gboolean hard)
   } else {
     GList *l;
 
-    for (l = priv->frames; l; l = l->next) {
+    for (l = priv->frames.head; l; l = l->next) {
       GstVideoCodecFrame *frame = l->data;
 
       frame->events = _flush_events (encoder->srcpad, frame->events);
@@ -460,9 +464,9 @@ gst_video_encoder_reset (GstVideoEncoder * encoder, gboolean hard)
         encoder->priv->current_frame_events);
   }
 
-  g_list_foreach (priv->frames, (GFunc) gst_video_codec_frame_unref, NULL);
-  g_list_free (priv->frames);
-  priv->frames = NULL;
+  g_queue_foreach (&priv->frames, (GFunc) gst_video_codec_frame_unref, NULL);
+  g_queue_clear (&priv->frames);
+  g_hash_table_remove_all (priv->frames_by_number);
 
   GST_VIDEO_ENCODER_STREAM_UNLOCK (encoder);
 
@@ -523,6 +527,9 @@ gst_video_encoder_init (GstVideoEncoder * encoder, GstVideoEncoderClass * klass)
 
   g_rec_mutex_init (&encoder->stream_lock);
 
+  g_queue_init (&priv->frames);
+  priv->frames_by_number = g_hash_table_new (NULL, NULL);
+
   priv->headers = NULL;
   priv->new_headers = FALSE;
 
@@ -909,6 +916,8 @@ gst_video_encoder_finalize (GObject * object)
   encoder = GST_VIDEO_ENCODER (object);
   g_rec_mutex_clear (&encoder->stream_lock);
 
+  g_hash_table_destroy (encoder->priv->frames_by_number);
+
   if (encoder->priv->allocator) {
     gst_object_unref (encoder->priv->allocator);
     encoder->priv->allocator = NULL;
@@ -1533,7 +1542,7 @@ gst_video_encoder_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
   GST_OBJECT_UNLOCK (encoder);
 
   gst_video_codec_frame_ref (frame);
-  priv->frames = g_list_append (priv->frames, frame);
+  gst_video_encoder_add_frame (encoder, frame);
 
   /* new data, more finish needed */
   priv->drained = FALSE;
@@ -1722,7 +1731,7 @@ gst_video_encoder_negotiate_default (GstVideoEncoder * encoder)
 
   /* Push all pending pre-caps events of the oldest frame before
    * setting caps */
-  frame = encoder->priv->frames ? encoder->priv->frames->data : NULL;
+  frame = encoder->priv->frames.head ? encoder->priv->frames.head->data : NULL;
   if (frame || encoder->priv->current_frame_events) {
     GList **events, *l;
 
@@ -1940,18 +1949,48 @@ gst_video_encoder_allocate_output_frame (GstVideoEncoder *
   return frame->output_buffer ? GST_FLOW_OK : GST_FLOW_ERROR;
 }
 
+/* frames are kept in input order in a queue and indexed by their
+ * system_frame_number so that lookups and removals don't need to walk
+ * the queue. Call with the STREAM_LOCK held. */
 static void
-gst_video_encoder_release_frame (GstVideoEncoder * enc,
+gst_video_encoder_add_frame (GstVideoEncoder * enc, GstVideoCodecFrame * frame)
+{
+  GstVideoEncoderPrivate *priv = enc->priv;
+
+  g_queue_push_tail (&priv->frames, frame);
+  g_hash_table_insert (priv->frames_by_number,
+      GINT_TO_POINTER (frame->system_frame_number), priv->frames.tail);
+}
+
+static gboolean
+gst_video_encoder_remove_frame (GstVideoEncoder * enc,
     GstVideoCodecFrame * frame)
 {
+  GstVideoEncoderPrivate *priv = enc->priv;
+  gpointer key = GINT_TO_POINTER (frame->system_frame_number);
   GList *link;
 
+  link = g_hash_table_lookup (priv->frames_by_number, key);
+  if (link == NULL || link->data != frame) {
+    /* not indexed under its number, the subclass changed it */
+    link = g_queue_find (&priv->frames, frame);
+    if (link == NULL)
+      return FALSE;
+  } else {
+    g_hash_table_remove (priv->frames_by_number, key);
+  }
+  g_queue_delete_link (&priv->frames, link);
+
+  return TRUE;
+}
+
+static void
+gst_video_encoder_release_frame (GstVideoEncoder * enc,
+    GstVideoCodecFrame * frame)
+{
   /* unref once from the list */
-  link = g_list_find (enc->priv->frames, frame);
-  if (link) {
+  if (gst_video_encoder_remove_frame (enc, frame))
     gst_video_codec_frame_unref (frame);
-    enc->priv->frames = g_list_delete_link (enc->priv->frames, link);
-  }
   /* unref because this function takes ownership */
   gst_video_codec_frame_unref (frame);
 }
@@ -2107,7 +2146,7 @@ gst_video_encoder_finish_frame (GstVideoEncoder * encoder,
     goto no_output_state;
 
   /* Push all pending events that arrived before this frame */
-  for (l = priv->frames; l; l = l->next) {
+  for (l = priv->frames.head; l; l = l->next) {
     GstVideoCodecFrame *tmp = l->data;
 
     if (tmp->events) {
@@ -2216,7 +2255,7 @@ gst_video_encoder_finish_frame (GstVideoEncoder * encoder,
     gboolean seen_none = FALSE;
 
     /* some maintenance regardless */
-    for (l = priv->frames; l; l = l->next) {
+    for (l = priv->frames.head; l; l = l->next) {
       GstVideoCodecFrame *tmp = l->data;
 
       if (!GST_CLOCK_TIME_IS_VALID (tmp->abidata.ABI.ts)) {
@@ -2487,8 +2526,8 @@ gst_video_encoder_get_oldest_frame (GstVideoEncoder * encoder)
   GstVideoCodecFrame *frame = NULL;
 
   GST_VIDEO_ENCODER_STREAM_LOCK (encoder);
-  if (encoder->priv->frames)
-    frame = gst_video_codec_frame_ref (encoder->priv->frames->data);
+  if (encoder->priv->frames.head)
+    frame = gst_video_codec_frame_ref (encoder->priv->frames.head->data);
   GST_VIDEO_ENCODER_STREAM_UNLOCK (encoder);
 
   return (GstVideoCodecFrame *) frame;
@@ -2512,14 +2551,20 @@ gst_video_encoder_get_frame (GstVideoEncoder * encoder, int frame_number)
   GST_DEBUG_OBJECT (encoder, "frame_number : %d", frame_number);
 
   GST_VIDEO_ENCODER_STREAM_LOCK (encoder);
-  for (g = encoder->priv->frames; g; g = g->next) {
-    GstVideoCodecFrame *tmp = g->data;
-
-    if (tmp->system_frame_number == frame_number) {
-      frame = gst_video_codec_frame_ref (tmp);
-      break;
+  g = g_hash_table_lookup (encoder->priv->frames_by_number,
+      GINT_TO_POINTER (frame_number));
+  if (g == NULL || ((GstVideoCodecFrame *) g->data)->system_frame_number !=
+      frame_number) {
+    /* not indexed under this number, the subclass may have changed it */
+    for (g = encoder->priv->frames.head; g; g = g->next) {
+      GstVideoCodecFrame *tmp = g->data;
+
+      if (tmp->system_frame_number == frame_number)
+        break;
     }
   }
+  if (g)
+    frame = gst_video_codec_frame_ref (g->data);
   GST_VIDEO_ENCODER_STREAM_UNLOCK (encoder);
 
   return frame;
@@ -2539,7 +2584,7 @@ gst_video_encoder_get_frames (GstVideoEncoder * encoder)
   GList *frames;
 
   GST_VIDEO_ENCODER_STREAM_LOCK (encoder);
-  frames = g_list_copy (encoder->priv->frames);
+  frames = g_list_copy (encoder->priv->frames.head);
   g_list_foreach (frames, (GFunc) gst_video_codec_frame_ref, NULL);
   GST_VIDEO_ENCODER_STREAM_UNLOCK (encoder);
 
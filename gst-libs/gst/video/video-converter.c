@@ -22,13 +22,6 @@
 #include "config.h"
 #endif
 
-#if 0
-#ifdef HAVE_PTHREAD
-#define _GNU_SOURCE
-#include <pthread.h>
-#endif
-#endif
-
 #include "video-converter.h"
 
 #include <glib.h>
@@ -115,198 +108,8 @@ ensure_debug_category (void)
 #define ensure_debug_category() /* NOOP */
 #endif /* GST_DISABLE_GST_DEBUG */
 
-typedef void (*GstParallelizedTaskFunc) (gpointer user_data);
-
-typedef struct _GstParallelizedTaskRunner GstParallelizedTaskRunner;
-typedef struct _GstParallelizedTaskThread GstParallelizedTaskThread;
-
-struct _GstParallelizedTaskThread
-{
-  GstParallelizedTaskRunner *runner;
-  guint idx;
-  GThread *thread;
-};
-
-struct _GstParallelizedTaskRunner
-{
-  guint n_threads;
-
-  GstParallelizedTaskThread *threads;
-
-  GstParallelizedTaskFunc func;
-  gpointer *task_data;
-
-  GMutex lock;
-  GCond cond_todo, cond_done;
-  gint n_todo, n_done;
-  gboolean quit;
-};
-
-static gpointer
-gst_parallelized_task_thread_func (gpointer data)
-{
-  GstParallelizedTaskThread *self = data;
-
-#if 0
-#ifdef HAVE_PTHREAD
-  {
-    pthread_t thread = pthread_self ();
-    cpu_set_t cpuset;
-    int r;
-
-    CPU_ZERO (&cpuset);
-    CPU_SET (self->idx, &cpuset);
-    if ((r = pthread_setaffinity_np (thread, sizeof (cpuset), &cpuset)) != 0)
-      GST_ERROR ("Failed to set thread affinity for thread %d: %s", self->idx,
-          g_strerror (r));
-  }
-#endif
-#endif
-
-  g_mutex_lock (&self->runner->lock);
-  self->runner->n_done++;
-  if (self->runner->n_done == self->runner->n_threads - 1)
-    g_cond_signal (&self->runner->cond_done);
-
-  do {
-    gint idx;
-
-    while (self->runner->n_todo == -1 && !self->runner->quit)
-      g_cond_wait (&self->runner->cond_todo, &self->runner->lock);
-
-    if (self->runner->quit)
-      break;
-
-    idx = self->runner->n_todo--;
-    g_assert (self->runner->n_todo >= -1);
-    g_mutex_unlock (&self->runner->lock);
-
-    g_assert (self->runner->func != NULL);
-
-    self->runner->func (self->runner->task_data[idx]);
-
-    g_mutex_lock (&self->runner->lock);
-    self->runner->n_done++;
-    if (self->runner->n_done == self->runner->n_threads - 1)
-      g_cond_signal (&self->runner->cond_done);
-  } while (TRUE);
-
-  g_mutex_unlock (&self->runner->lock);
-
-  return NULL;
-}
-
-static void
-gst_parallelized_task_runner_free (GstParallelizedTaskRunner * self)
-{
-  guint i;
-
-  g_mutex_lock (&self->lock);
-  self->quit = TRUE;
-  g_cond_broadcast (&self->cond_todo);
-  g_mutex_unlock (&self->lock);
-
-  for (i = 1; i < self->n_threads; i++) {
-    if (!self->threads[i].thread)
-      continue;
-
-    g_thread_join (self->threads[i].thread);
-  }
-
-  g_mutex_clear (&self->lock);
-  g_cond_clear (&self->cond_todo);
-  g_cond_clear (&self->cond_done);
-  g_free (self->threads);
-  g_free (self);
-}
-
-static GstParallelizedTaskRunner *
-gst_parallelized_task_runner_new (guint n_threads)
-{
-  GstParallelizedTaskRunner *self;
-  guint i;
-  GError *err = NULL;
-
-  if (n_threads == 0)
-    n_threads = g_get_num_processors ();
-
-  self = g_new0 (GstParallelizedTaskRunner, 1);
-  self->n_threads = n_threads;
-  self->threads = g_new0 (GstParallelizedTaskThread, n_threads);
-
-  self->quit = FALSE;
-  self->n_todo = -1;
-  self->n_done = 0;
-  g_mutex_init (&self->lock);
-  g_cond_init (&self->cond_todo);
-  g_cond_init (&self->cond_done);
-
-  /* Set when scheduling a job */
-  self->func = NULL;
-  self->task_data = NULL;
-
-  for (i = 0; i < n_threads; i++) {
-    self->threads[i].runner = self;
-    self->threads[i].idx = i;
-
-    /* First thread is the one calling run() */
-    if (i > 0) {
-      self->threads[i].thread =
-          g_thread_try_new ("videoconvert", gst_parallelized_task_thread_func,
-          &self->threads[i], &err);
-      if (!self->threads[i].thread)
-        goto error;
-    }
-  }
-
-  g_mutex_lock (&self->lock);
-  while (self->n_done < self->n_threads - 1)
-    g_cond_wait (&self->cond_done, &self->lock);
-  self->n_done = 0;
-  g_mutex_unlock (&self->lock);
-
-  return self;
-
-error:
-  {
-    GST_ERROR ("Failed to start thread %u: %s", i, err->message);
-    g_clear_error (&err);
-
-    gst_parallelized_task_runner_free (self);
-    return NULL;
-  }
-}
-
-static void
-gst_parallelized_task_runner_run (GstParallelizedTaskRunner * self,
-    GstParallelizedTaskFunc func, gpointer * task_data)
-{
-  guint n_threads = self->n_threads;
-
-  self->func = func;
-  self->task_data = task_data;
-
-  if (n_threads > 1) {
-    g_mutex_lock (&self->lock);
-    self->n_todo = self->n_threads - 2;
-    self->n_done = 0;
-    g_cond_broadcast (&self->cond_todo);
-    g_mutex_unlock (&self->lock);
-  }
-
-  self->func (self->task_data[self->n_threads - 1]);
-
-  if (n_threads > 1) {
-    g_mutex_lock (&self->lock);
-    while (self->n_done < self->n_threads - 1)
-      g_cond_wait (&self->cond_done, &self->lock);
-    self->n_done = 0;
-    g_mutex_unlock (&self->lock);
-  }
-
-  self->func = NULL;
-  self->task_data = NULL;
-}
+#define GST_PARALLELIZED_TASK_THREAD_NAME "videoconvert"
+#include "gst/parallelized-task-runner-private.h"
 
 typedef struct _GstLineCache GstLineCache;
 
@@ -361,6 +164,9 @@ typedef struct
 typedef void (*FastConvertFunc) (GstVideoConverter * convert,
     const GstVideoFrame * src, GstVideoFrame * dest, gint plane);
 
+typedef void (*MatrixPackFunc) (MatrixData * data, gpointer dest,
+    gpointer src);
+
 struct _GstVideoConverter
 {
   gint flags;
@@ -475,6 +281,9 @@ struct _GstVideoConverter
   gconstpointer pack_pal;
   gsize pack_palsize;
 
+  /* fused matrix and pack, reads from the lines before the conversion */
+  MatrixPackFunc matrix_pack_func;
+
   const GstVideoFrame *src;
   GstVideoFrame *dest;
 
@@ -1229,6 +1038,48 @@ video_converter_matrix8_AYUV_ARGB (MatrixData * data, gpointer pixels)
       data->im[2][1], data->im[1][1], data->im[1][2], data->width, 1);
 }
 
+#if G_BYTE_ORDER == G_LITTLE_ENDIAN
+/* Fused matrix and pack functions. These do the AYUV -> RGB conversion of
+ * video_converter_matrix8_AYUV_ARGB() and write the result in the final
+ * packed RGB format directly into the destination line, saving a pass over
+ * the line for the in-place matrix and one for packing. */
+static void
+video_converter_matrix8_AYUV_pack_ARGB (MatrixData * data, gpointer dest,
+    gpointer src)
+{
+  video_orc_convert_AYUV_ARGB (dest, 0, src, 0,
+      data->im[0][0], data->im[0][2],
+      data->im[2][1], data->im[1][1], data->im[1][2], data->width, 1);
+}
+
+static void
+video_converter_matrix8_AYUV_pack_BGRA (MatrixData * data, gpointer dest,
+    gpointer src)
+{
+  video_orc_convert_AYUV_BGRA (dest, 0, src, 0,
+      data->im[0][0], data->im[0][2],
+      data->im[2][1], data->im[1][1], data->im[1][2], data->width, 1);
+}
+
+static void
+video_converter_matrix8_AYUV_pack_ABGR (MatrixData * data, gpointer dest,
+    gpointer src)
+{
+  video_orc_convert_AYUV_ABGR (dest, 0, src, 0,
+      data->im[0][0], data->im[0][2],
+      data->im[2][1], data->im[1][1], data->im[1][2], data->width, 1);
+}
+
+static void
+video_converter_matrix8_AYUV_pack_RGBA (MatrixData * data, gpointer dest,
+    gpointer src)
+{
+  video_orc_convert_AYUV_RGBA (dest, 0, src, 0,
+      data->im[0][0], data->im[0][2],
+      data->im[2][1], data->im[1][1], data->im[1][2], data->width, 1);
+}
+#endif
+
 static gboolean
 is_ayuv_to_rgb_matrix (MatrixData * data)
 {
@@ -2067,6 +1918,54 @@ chain_pack (GstVideoConverter * convert, GstLineCache * prev, gint idx)
   return prev;
 }
 
+/* When the color conversion is the last step before packing and it can be
+ * done with one of the AYUV -> RGB kernels, convert straight into the
+ * destination frame */
+static void
+setup_matrix_pack (GstVideoConverter * convert)
+{
+#if G_BYTE_ORDER == G_LITTLE_ENDIAN
+  MatrixPackFunc func;
+  gint i;
+
+  if (convert->convert_matrix.matrix_func != video_converter_matrix8_AYUV_ARGB)
+    return;
+  if (convert->borderline || convert->pack_nlines != 1)
+    return;
+
+  for (i = 0; i < convert->conversion_runner->n_threads; i++) {
+    if (convert->convert_lines[i] == NULL
+        || convert->pack_lines[i] != convert->convert_lines[i])
+      return;
+  }
+
+  switch (GST_VIDEO_INFO_FORMAT (&convert->out_info)) {
+    case GST_VIDEO_FORMAT_ARGB:
+    case GST_VIDEO_FORMAT_xRGB:
+      func = video_converter_matrix8_AYUV_pack_ARGB;
+      break;
+    case GST_VIDEO_FORMAT_BGRA:
+    case GST_VIDEO_FORMAT_BGRx:
+      func = video_converter_matrix8_AYUV_pack_BGRA;
+      break;
+    case GST_VIDEO_FORMAT_ABGR:
+    case GST_VIDEO_FORMAT_xBGR:
+      func = video_converter_matrix8_AYUV_pack_ABGR;
+      break;
+    case GST_VIDEO_FORMAT_RGBA:
+    case GST_VIDEO_FORMAT_RGBx:
+      func = video_converter_matrix8_AYUV_pack_RGBA;
+      break;
+    default:
+      return;
+  }
+
+  GST_DEBUG ("use fused AYUV -> %s matrix and pack",
+      gst_video_format_to_string (GST_VIDEO_INFO_FORMAT (&convert->out_info)));
+  convert->matrix_pack_func = func;
+#endif
+}
+
 static void
 setup_allocators (GstVideoConverter * convert)
 {
@@ -2427,6 +2326,8 @@ gst_video_converter_new (GstVideoInfo * in_info, GstVideoInfo * out_info,
   }
 
   setup_borderline (convert);
+  /* see if we can convert and pack in one go */
+  setup_matrix_pack (convert);
   /* now figure out allocators */
   setup_allocators (convert);
 
@@ -2645,6 +2546,45 @@ gst_video_converter_frame (GstVideoConverter * convert,
   convert->convert (convert, src, dest);
 }
 
+/**
+ * gst_video_converter_get_pool_stats:
+ * @n_threads: (out) (optional): number of worker threads in the pool
+ * @n_jobs: (out) (optional): number of times a worker joined a conversion
+ *     and processed part of it
+ * @avg_latency: (out) (optional): average time between a conversion being
+ *     queued and a worker joining it
+ * @max_latency: (out) (optional): maximum time between a conversion being
+ *     queued and a worker joining it
+ *
+ * Video converters configured with more than one thread share one pool of
+ * worker threads. Audio converters use a separate pool. Get the size of the
+ * video pool and statistics about how fast the workers picked up work, the
+ * latencies don't include the time to finish the conversion. The pool and
+ * its statistics only exist while there is a converter using it, otherwise
+ * all values are 0.
+ *
+ * Since: 1.16
+ */
+void
+gst_video_converter_get_pool_stats (guint * n_threads, guint64 * n_jobs,
+    GstClockTime * avg_latency, GstClockTime * max_latency)
+{
+  guint threads;
+  guint64 jobs;
+  GstClockTime avg, max;
+
+  gst_parallelized_task_pool_get_shared_stats (&threads, &jobs, &avg, &max);
+
+  if (n_threads)
+    *n_threads = threads;
+  if (n_jobs)
+    *n_jobs = jobs;
+  if (avg_latency)
+    *avg_latency = avg;
+  if (max_latency)
+    *max_latency = max;
+}
+
 static void
 video_converter_compute_matrix (GstVideoConverter * convert)
 {
@@ -3061,6 +3001,8 @@ typedef struct
   gboolean identity_pack;
   gint lb_width, out_maxwidth;
   GstVideoFrame *dest;
+  MatrixPackFunc matrix_pack_func;
+  MatrixData *matrix_pack_data;
 } ConvertTask;
 
 static void
@@ -3076,7 +3018,14 @@ convert_generic_task (ConvertTask * task)
         gst_line_cache_get_lines (task->pack_lines, task->idx, i + task->out_y,
         i, task->pack_lines_count);
 
-    if (!task->identity_pack) {
+    if (task->matrix_pack_func) {
+      guint8 *d = FRAME_GET_LINE (task->dest, i + task->out_y);
+
+      /* convert and pack straight into the destination */
+      GST_DEBUG ("matrix pack line %d %p", i + task->out_y, lines[0]);
+      task->matrix_pack_func (task->matrix_pack_data, d + task->lb_width,
+          lines[0]);
+    } else if (!task->identity_pack) {
       /* take away the border */
       guint8 *l = ((guint8 *) lines[0]) - task->lb_width;
       /* and pack into destination */
@@ -3156,13 +3105,18 @@ video_converter_generic (GstVideoConverter * convert, const GstVideoFrame * src,
 
   for (i = 0; i < n_threads; i++) {
     tasks[i].dest = dest;
-    tasks[i].pack_lines = convert->pack_lines[i];
     tasks[i].idx = i;
     tasks[i].pack_lines_count = pack_lines;
     tasks[i].out_y = out_y;
     tasks[i].identity_pack = convert->identity_pack;
     tasks[i].lb_width = lb_width;
     tasks[i].out_maxwidth = out_maxwidth;
+    tasks[i].matrix_pack_func = convert->matrix_pack_func;
+    tasks[i].matrix_pack_data = &convert->convert_matrix;
+    if (convert->matrix_pack_func)
+      tasks[i].pack_lines = convert->convert_lines[i]->prev;
+    else
+      tasks[i].pack_lines = convert->pack_lines[i];
 
     tasks[i].h_0 = i * lines_per_thread;
     tasks[i].h_1 = MIN ((i + 1) * lines_per_thread, out_height);
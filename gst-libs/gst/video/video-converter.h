@@ -270,6 +270,10 @@ typedef enum {
  *
  * #G_TYPE_UINT, maximum number of threads to use. Default 1, 0 for the number
  * of cores.
+ *
+ * The work is distributed over a pool of threads that is shared by all
+ * converters in the process, so having many converters does not result in
+ * more threads than there are cores.
  */
 #define GST_VIDEO_CONVERTER_OPT_THREADS   "GstVideoConverter.threads"
 
@@ -293,6 +297,11 @@ GST_VIDEO_API
 void                 gst_video_converter_frame          (GstVideoConverter * convert,
                                                          const GstVideoFrame *src, GstVideoFrame *dest);
 
+GST_VIDEO_API
+void                 gst_video_converter_get_pool_stats (guint *n_threads, guint64 *n_jobs,
+                                                         GstClockTime *avg_latency,
+                                                         GstClockTime *max_latency);
+
 
 G_END_DECLS
 
@@ -201,6 +201,15 @@ get_lanczos_tap (ResamplerParams * params, gint l, gint xi, gdouble x)
   return (sinc ((x - xl) * params->fx) - params->sharpen) * env;
 }
 
+static gdouble
+get_box_tap (ResamplerParams * params, gint l, gint xi, gdouble x)
+{
+  gint xl = xi + l;
+  /* take all source samples that fall inside the footprint of the
+   * destination sample */
+  return fabs ((x - xl) * params->fx) <= 0.5 ? 1.0 : 0.0;
+}
+
 static void
 resampler_calculate_taps (ResamplerParams * params)
 {
@@ -403,6 +412,10 @@ gst_video_resampler_init (GstVideoResampler * resampler,
       params.envelope = GET_OPT_ENVELOPE (options);
       params.get_tap = get_lanczos_tap;
       break;
+    case GST_VIDEO_RESAMPLER_METHOD_BOX:
+      params.envelope = 0.5;
+      params.get_tap = get_box_tap;
+      break;
     default:
       break;
   }
@@ -416,6 +429,10 @@ gst_video_resampler_init (GstVideoResampler * resampler,
   params.fx = 2.0 * params.envelope / n_taps;
   params.ex = 2.0 / n_taps;
 
+  /* a box of one sample is just nearest neighbour */
+  if (method == GST_VIDEO_RESAMPLER_METHOD_BOX && n_taps == 1)
+    params.get_tap = get_nearest_tap;
+
   if (n_taps > in_size)
     n_taps = in_size;
 
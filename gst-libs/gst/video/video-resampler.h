@@ -36,6 +36,8 @@ typedef struct _GstVideoResampler GstVideoResampler;
  * @GST_VIDEO_RESAMPLER_METHOD_CUBIC: Uses cubic interpolation
  * @GST_VIDEO_RESAMPLER_METHOD_SINC: Uses sinc interpolation
  * @GST_VIDEO_RESAMPLER_METHOD_LANCZOS: Uses lanczos interpolation
+ * @GST_VIDEO_RESAMPLER_METHOD_BOX: Averages all samples covered by the
+ *    destination sample. (Since: 1.16)
  *
  * Different subsampling and upsampling methods
  *
@@ -46,7 +48,8 @@ typedef enum {
   GST_VIDEO_RESAMPLER_METHOD_LINEAR,
   GST_VIDEO_RESAMPLER_METHOD_CUBIC,
   GST_VIDEO_RESAMPLER_METHOD_SINC,
-  GST_VIDEO_RESAMPLER_METHOD_LANCZOS
+  GST_VIDEO_RESAMPLER_METHOD_LANCZOS,
+  GST_VIDEO_RESAMPLER_METHOD_BOX
 } GstVideoResamplerMethod;
 
 /**
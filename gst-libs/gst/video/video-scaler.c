@@ -82,14 +82,19 @@ typedef void (*GstVideoScalerVFunc) (GstVideoScaler * scale,
     gpointer srcs[], gpointer dest, guint dest_offset, guint width,
     guint n_elems);
 
+typedef struct _ScalerCoeffs ScalerCoeffs;
+
 struct _GstVideoScaler
 {
   GstVideoResamplerMethod method;
   GstVideoScalerFlags flags;
 
   GstVideoResampler resampler;
+  ScalerCoeffs *coeffs;         /* owner of the resampler, NULL when merged */
 
   gboolean merged;
+  /* decimation factor when the taps average exactly 2 or 4 source pixels */
+  guint box;
   gint in_y_offset;
   gint out_y_offset;
 
@@ -145,6 +150,213 @@ resampler_zip (GstVideoResampler * resampler, const GstVideoResampler * r1,
   }
 }
 
+/* Resampler coefficients are expensive to calculate for the sinc and lanczos
+ * methods, scalers with the same parameters share them. Unused coefficients
+ * are kept around for a while because converters are often recreated with
+ * the same sizes */
+struct _ScalerCoeffs
+{
+  gint refcount;
+
+  /* key */
+  GstVideoResamplerMethod method;
+  GstVideoScalerFlags flags;
+  guint n_taps;
+  guint in_size;
+  guint out_size;
+  GstStructure *options;
+
+  GstVideoResampler resampler;
+};
+
+#define MAX_IDLE_COEFFS 32
+#define INTERLACE_SHIFT 0.5
+
+static GMutex coeffs_lock;
+static GHashTable *coeffs_cache;
+static GQueue coeffs_idle = G_QUEUE_INIT;
+static guint64 coeffs_hits;
+static guint64 coeffs_misses;
+
+static guint
+scaler_coeffs_hash (gconstpointer key)
+{
+  const ScalerCoeffs *c = key;
+
+  return (c->method << 28) ^ (c->flags << 24) ^ (c->n_taps << 16) ^
+      (c->in_size * 31) ^ c->out_size;
+}
+
+static gboolean
+scaler_coeffs_equal (gconstpointer a, gconstpointer b)
+{
+  const ScalerCoeffs *c1 = a, *c2 = b;
+
+  if (c1->method != c2->method || c1->flags != c2->flags ||
+      c1->n_taps != c2->n_taps || c1->in_size != c2->in_size ||
+      c1->out_size != c2->out_size)
+    return FALSE;
+
+  if (c1->options == NULL || c2->options == NULL)
+    return c1->options == c2->options;
+
+  return gst_structure_is_equal (c1->options, c2->options);
+}
+
+static void
+scaler_coeffs_free (ScalerCoeffs * coeffs)
+{
+  gst_video_resampler_clear (&coeffs->resampler);
+  if (coeffs->options)
+    gst_structure_free (coeffs->options);
+  g_slice_free (ScalerCoeffs, coeffs);
+}
+
+/* call with coeffs_lock */
+static ScalerCoeffs *
+scaler_coeffs_ref_unlocked (ScalerCoeffs * coeffs)
+{
+  if (coeffs->refcount++ == 0)
+    g_queue_remove (&coeffs_idle, coeffs);
+
+  return coeffs;
+}
+
+static void
+scaler_coeffs_make (ScalerCoeffs * coeffs)
+{
+  GstVideoResamplerMethod method = coeffs->method;
+  guint n_taps = coeffs->n_taps;
+  guint in_size = coeffs->in_size;
+  guint out_size = coeffs->out_size;
+  GstStructure *options = coeffs->options;
+
+  if (coeffs->flags & GST_VIDEO_SCALER_FLAG_INTERLACED) {
+    GstVideoResampler tresamp, bresamp;
+    gdouble shift;
+
+    shift = (INTERLACE_SHIFT * out_size) / in_size;
+
+    gst_video_resampler_init (&tresamp, method,
+        GST_VIDEO_RESAMPLER_FLAG_HALF_TAPS, (out_size + 1) / 2, n_taps, shift,
+        (in_size + 1) / 2, (out_size + 1) / 2, options);
+
+    n_taps = tresamp.max_taps;
+
+    gst_video_resampler_init (&bresamp, method, 0, out_size - tresamp.out_size,
+        n_taps, -shift, in_size - tresamp.in_size,
+        out_size - tresamp.out_size, options);
+
+    resampler_zip (&coeffs->resampler, &tresamp, &bresamp);
+    gst_video_resampler_clear (&tresamp);
+    gst_video_resampler_clear (&bresamp);
+  } else {
+    gst_video_resampler_init (&coeffs->resampler, method,
+        GST_VIDEO_RESAMPLER_FLAG_NONE, out_size, n_taps, 0.0, in_size, out_size,
+        options);
+  }
+}
+
+static ScalerCoeffs *
+scaler_coeffs_acquire (GstVideoResamplerMethod method,
+    GstVideoScalerFlags flags, guint n_taps, guint in_size, guint out_size,
+    GstStructure * options)
+{
+  ScalerCoeffs key, *coeffs, *other;
+
+  key.method = method;
+  key.flags = flags & GST_VIDEO_SCALER_FLAG_INTERLACED;
+  key.n_taps = n_taps;
+  key.in_size = in_size;
+  key.out_size = out_size;
+  key.options = options;
+
+  g_mutex_lock (&coeffs_lock);
+  if (coeffs_cache == NULL)
+    coeffs_cache = g_hash_table_new (scaler_coeffs_hash, scaler_coeffs_equal);
+
+  coeffs = g_hash_table_lookup (coeffs_cache, &key);
+  if (coeffs) {
+    coeffs_hits++;
+    scaler_coeffs_ref_unlocked (coeffs);
+    g_mutex_unlock (&coeffs_lock);
+    GST_DEBUG ("reuse coefficients %p", coeffs);
+    return coeffs;
+  }
+  coeffs_misses++;
+  g_mutex_unlock (&coeffs_lock);
+
+  /* calculate without the lock, other scalers can be made meanwhile */
+  coeffs = g_slice_new0 (ScalerCoeffs);
+  coeffs->refcount = 1;
+  coeffs->method = key.method;
+  coeffs->flags = key.flags;
+  coeffs->n_taps = key.n_taps;
+  coeffs->in_size = key.in_size;
+  coeffs->out_size = key.out_size;
+  coeffs->options = options ? gst_structure_copy (options) : NULL;
+  scaler_coeffs_make (coeffs);
+
+  g_mutex_lock (&coeffs_lock);
+  other = g_hash_table_lookup (coeffs_cache, coeffs);
+  if (other) {
+    /* someone else made the same coefficients */
+    scaler_coeffs_ref_unlocked (other);
+    g_mutex_unlock (&coeffs_lock);
+    scaler_coeffs_free (coeffs);
+    return other;
+  }
+  g_hash_table_add (coeffs_cache, coeffs);
+  g_mutex_unlock (&coeffs_lock);
+
+  GST_DEBUG ("made coefficients %p", coeffs);
+
+  return coeffs;
+}
+
+static void
+scaler_coeffs_release (ScalerCoeffs * coeffs)
+{
+  ScalerCoeffs *expired = NULL;
+
+  g_mutex_lock (&coeffs_lock);
+  if (--coeffs->refcount == 0) {
+    g_queue_push_tail (&coeffs_idle, coeffs);
+    if (coeffs_idle.length > MAX_IDLE_COEFFS) {
+      expired = g_queue_pop_head (&coeffs_idle);
+      g_hash_table_remove (coeffs_cache, expired);
+    }
+  }
+  g_mutex_unlock (&coeffs_lock);
+
+  if (expired) {
+    GST_DEBUG ("expire coefficients %p", expired);
+    scaler_coeffs_free (expired);
+  }
+}
+
+/**
+ * gst_video_scaler_get_cache_stats:
+ * @hits: (out) (optional): number of scalers that reused coefficients
+ * @misses: (out) (optional): number of scalers that calculated coefficients
+ *
+ * Scalers made with the same method, flags, number of taps, sizes and options
+ * share their filter coefficients through a process-wide cache. Get how often
+ * gst_video_scaler_new() found its coefficients in the cache.
+ *
+ * Since: 1.16
+ */
+void
+gst_video_scaler_get_cache_stats (guint64 * hits, guint64 * misses)
+{
+  g_mutex_lock (&coeffs_lock);
+  if (hits)
+    *hits = coeffs_hits;
+  if (misses)
+    *misses = coeffs_misses;
+  g_mutex_unlock (&coeffs_lock);
+}
+
 static void
 realloc_tmplines (GstVideoScaler * scale, gint n_elems, gint width)
 {
@@ -186,7 +398,33 @@ scaler_dump (GstVideoScaler * scale)
 #endif
 }
 
-#define INTERLACE_SHIFT 0.5
+/* check if every output pixel is the plain average of the next @k input
+ * pixels so that we can use the box kernels */
+static guint
+scaler_get_box_factor (GstVideoScaler * scale)
+{
+  GstVideoResampler *r = &scale->resampler;
+  guint i, j, k;
+
+  if (scale->flags & GST_VIDEO_SCALER_FLAG_INTERLACED)
+    return 0;
+
+  k = r->max_taps;
+  if ((k != 2 && k != 4) || r->in_size != r->out_size * k)
+    return 0;
+
+  for (i = 0; i < r->out_size; i++) {
+    const gdouble *taps = r->taps + r->phase[i] * k;
+
+    if (r->offset[i] != i * k || r->n_taps[i] != k)
+      return 0;
+    for (j = 0; j < k; j++) {
+      if (fabs (taps[j] - 1.0 / k) > 1e-9)
+        return 0;
+    }
+  }
+  return k;
+}
 
 /**
  * gst_video_scaler_new: (skip)
@@ -222,36 +460,22 @@ gst_video_scaler_new (GstVideoResamplerMethod method, GstVideoScalerFlags flags,
   scale->method = method;
   scale->flags = flags;
 
-  if (flags & GST_VIDEO_SCALER_FLAG_INTERLACED) {
-    GstVideoResampler tresamp, bresamp;
-    gdouble shift;
-
-    shift = (INTERLACE_SHIFT * out_size) / in_size;
-
-    gst_video_resampler_init (&tresamp, method,
-        GST_VIDEO_RESAMPLER_FLAG_HALF_TAPS, (out_size + 1) / 2, n_taps, shift,
-        (in_size + 1) / 2, (out_size + 1) / 2, options);
-
-    n_taps = tresamp.max_taps;
-
-    gst_video_resampler_init (&bresamp, method, 0, out_size - tresamp.out_size,
-        n_taps, -shift, in_size - tresamp.in_size,
-        out_size - tresamp.out_size, options);
-
-    resampler_zip (&scale->resampler, &tresamp, &bresamp);
-    gst_video_resampler_clear (&tresamp);
-    gst_video_resampler_clear (&bresamp);
-  } else {
-    gst_video_resampler_init (&scale->resampler, method,
-        GST_VIDEO_RESAMPLER_FLAG_NONE, out_size, n_taps, 0.0, in_size, out_size,
-        options);
-  }
+  scale->coeffs =
+      scaler_coeffs_acquire (method, flags, n_taps, in_size, out_size,
+      options);
+  /* the arrays are owned by the coefficients */
+  scale->resampler = scale->coeffs->resampler;
 
   if (out_size == 1)
     scale->inc = 0;
   else
     scale->inc = ((in_size - 1) << 16) / (out_size - 1) - 1;
 
+  /* only the box method uses the box kernels, the other methods keep their
+   * own rounding even when their taps happen to be a plain average */
+  if (method == GST_VIDEO_RESAMPLER_METHOD_BOX)
+    scale->box = scaler_get_box_factor (scale);
+
   scaler_dump (scale);
   GST_DEBUG ("max_taps %d", scale->resampler.max_taps);
 
@@ -269,7 +493,10 @@ gst_video_scaler_free (GstVideoScaler * scale)
 {
   g_return_if_fail (scale != NULL);
 
-  gst_video_resampler_clear (&scale->resampler);
+  if (scale->coeffs)
+    scaler_coeffs_release (scale->coeffs);
+  else
+    gst_video_resampler_clear (&scale->resampler);
   g_free (scale->taps_s16);
   g_free (scale->taps_s16_4);
   g_free (scale->offset_n);
@@ -1101,6 +1328,133 @@ video_scale_v_ntap_u16 (GstVideoScaler * scale,
   video_orc_resample_scaletaps_u16 (d, temp, count);
 }
 
+/* box kernels for exact 2:1 and 4:1 decimation. Every output sample is
+ * (sum + k / 2) / k of the k covered input samples, the 8 bit 2:1 cases use
+ * the ORC averaging functions that compute the same value */
+static void
+video_scale_h_box_u8 (GstVideoScaler * scale,
+    gpointer src, gpointer dest, guint dest_offset, guint width, guint n_elems)
+{
+  const guint8 *s;
+  guint8 *d;
+  guint i, j, step;
+
+  step = scale->box * n_elems;
+  s = (const guint8 *) src + dest_offset * step;
+  d = (guint8 *) dest + dest_offset * n_elems;
+
+  if (scale->box == 2) {
+    if (n_elems == 1) {
+      video_orc_planar_chroma_444_422 (d, 0, s, 0, width, 1);
+      return;
+    }
+    for (i = 0; i < width; i++) {
+      for (j = 0; j < n_elems; j++)
+        d[j] = (s[j] + s[n_elems + j] + 1) >> 1;
+      s += step;
+      d += n_elems;
+    }
+  } else {
+    for (i = 0; i < width; i++) {
+      for (j = 0; j < n_elems; j++)
+        d[j] = (s[j] + s[n_elems + j] + s[2 * n_elems + j] +
+            s[3 * n_elems + j] + 2) >> 2;
+      s += step;
+      d += n_elems;
+    }
+  }
+}
+
+/* merged packed 4:2:2, Y samples are 2 bytes apart and U/V samples 4 */
+static void
+video_scale_h_box_yuy2 (GstVideoScaler * scale,
+    gpointer src, gpointer dest, guint dest_offset, guint width, guint n_elems)
+{
+  const guint32 *offset = scale->resampler.offset + dest_offset;
+  const guint8 *s = src;
+  guint8 *d = (guint8 *) dest + dest_offset;
+  guint i, stride, k = scale->box;
+
+  for (i = 0; i < width; i++) {
+    const guint8 *p = s + offset[i];
+
+    stride = ((dest_offset + i) & 1) == scale->out_y_offset ? 2 : 4;
+    if (k == 2)
+      d[i] = (p[0] + p[stride] + 1) >> 1;
+    else
+      d[i] = (p[0] + p[stride] + p[2 * stride] + p[3 * stride] + 2) >> 2;
+  }
+}
+
+static void
+video_scale_h_box_u16 (GstVideoScaler * scale,
+    gpointer src, gpointer dest, guint dest_offset, guint width, guint n_elems)
+{
+  const guint16 *s;
+  guint16 *d;
+  guint i, j, step;
+
+  step = scale->box * n_elems;
+  s = (const guint16 *) src + dest_offset * step;
+  d = (guint16 *) dest + dest_offset * n_elems;
+
+  if (scale->box == 2) {
+    for (i = 0; i < width; i++) {
+      for (j = 0; j < n_elems; j++)
+        d[j] = (s[j] + s[n_elems + j] + 1) >> 1;
+      s += step;
+      d += n_elems;
+    }
+  } else {
+    for (i = 0; i < width; i++) {
+      for (j = 0; j < n_elems; j++)
+        d[j] = (s[j] + s[n_elems + j] + s[2 * n_elems + j] +
+            s[3 * n_elems + j] + 2) >> 2;
+      s += step;
+      d += n_elems;
+    }
+  }
+}
+
+static void
+video_scale_v_box_u8 (GstVideoScaler * scale,
+    gpointer srcs[], gpointer dest, guint dest_offset, guint width,
+    guint n_elems)
+{
+  const guint8 *s0 = srcs[0], *s1 = srcs[1];
+  guint8 *d = dest;
+  guint i, count = width * n_elems;
+
+  if (scale->box == 2) {
+    video_orc_planar_chroma_422_420 (d, 0, s0, 0, s1, 0, count, 1);
+  } else {
+    const guint8 *s2 = srcs[2], *s3 = srcs[3];
+
+    for (i = 0; i < count; i++)
+      d[i] = (s0[i] + s1[i] + s2[i] + s3[i] + 2) >> 2;
+  }
+}
+
+static void
+video_scale_v_box_u16 (GstVideoScaler * scale,
+    gpointer srcs[], gpointer dest, guint dest_offset, guint width,
+    guint n_elems)
+{
+  const guint16 *s0 = srcs[0], *s1 = srcs[1];
+  guint16 *d = dest;
+  guint i, count = width * n_elems;
+
+  if (scale->box == 2) {
+    for (i = 0; i < count; i++)
+      d[i] = (s0[i] + s1[i] + 1) >> 1;
+  } else {
+    const guint16 *s2 = srcs[2], *s3 = srcs[3];
+
+    for (i = 0; i < count; i++)
+      d[i] = (s0[i] + s1[i] + s2[i] + s3[i] + 2) >> 2;
+  }
+}
+
 static gint
 get_y_offset (GstVideoFormat format)
 {
@@ -1148,6 +1502,8 @@ gst_video_scaler_combine_packed_YUV (GstVideoScaler * y_scale,
   scale->method = y_scale->method;
   scale->flags = y_scale->flags;
   scale->merged = TRUE;
+  if (y_scale->box == uv_scale->box)
+    scale->box = y_scale->box;
 
   resampler = &scale->resampler;
 
@@ -1326,6 +1682,15 @@ get_functions (GstVideoScaler * hscale, GstVideoScaler * vscale,
         break;
     }
   }
+  if (hscale && hscale->box) {
+    if (hscale->merged)
+      *hfunc = video_scale_h_box_yuy2;
+    else
+      *hfunc = *bits == 8 ? video_scale_h_box_u8 : video_scale_h_box_u16;
+  }
+  if (vscale && vscale->box)
+    *vfunc = *bits == 8 ? video_scale_v_box_u8 : video_scale_v_box_u16;
+
   return TRUE;
 }
 
@@ -1585,3 +1950,173 @@ no_func:
     GST_WARNING ("no scaler function for format");
   }
 }
+
+typedef struct
+{
+  GstVideoScaler *hscale;
+  GstVideoScaler *vscale;
+  GstVideoScalerHFunc hfunc;
+  GstVideoScalerVFunc vfunc;
+  gpointer dest;
+  gint dest_stride;
+  guint width;
+  guint height;
+  guint v_taps;
+  gboolean v_first;             /* scale vertically before horizontally */
+  guint out;                    /* next output line */
+  gpointer *lines;
+} ScalerOutput;
+
+#define OUT_TMP_LINE(o,i) ((guint8 *)((o)->vscale->tmpline1) + \
+    (((i) % (o)->v_taps) * (sizeof (gint32) * (o)->width * n_elems)))
+
+/**
+ * gst_video_scaler_2d_multi:
+ * @hscale: (array length=n_outputs): a horizontal #GstVideoScaler for each
+ *   output
+ * @vscale: (array length=n_outputs): a vertical #GstVideoScaler for each output
+ * @n_outputs: the number of outputs
+ * @format: a #GstVideoFormat for @src and @dest
+ * @src: source pixels
+ * @src_stride: source pixels stride
+ * @dest: (array length=n_outputs): destination pixels for each output
+ * @dest_stride: (array length=n_outputs): destination pixels stride for each
+ *   output
+ * @width: (array length=n_outputs): the number of output pixels of each output
+ * @height: (array length=n_outputs): the number of output lines of each output
+ *
+ * Scale all lines of @src to @n_outputs destinations in one pass. Each source
+ * line is read once and, while it is in the cache, scaled horizontally for all
+ * the outputs that need it. The output lines are made as soon as all their
+ * source lines are available, so the memory traffic grows with the output
+ * sizes instead of with @n_outputs times the source size.
+ *
+ * Like with gst_video_scaler_2d(), @hscale and @vscale entries can be NULL to
+ * not scale in that direction. A scaler can only be used for one output.
+ *
+ * Since: 1.16
+ */
+void
+gst_video_scaler_2d_multi (GstVideoScaler ** hscale, GstVideoScaler ** vscale,
+    guint n_outputs, GstVideoFormat format, gpointer src, gint src_stride,
+    gpointer dest[], gint dest_stride[], guint width[], guint height[])
+{
+  ScalerOutput *outs;
+  gint n_elems = 0, bits = 0;
+  guint i, sl, n_lines = 0, n_done = 0;
+
+  g_return_if_fail (n_outputs == 0 || src != NULL);
+  g_return_if_fail (n_outputs == 0 || dest != NULL);
+
+  outs = g_newa (ScalerOutput, n_outputs);
+
+  for (i = 0; i < n_outputs; i++) {
+    ScalerOutput *o = &outs[i];
+
+    o->hscale = hscale[i];
+    o->vscale = vscale[i];
+    o->hfunc = NULL;
+    o->vfunc = NULL;
+    o->dest = dest[i];
+    o->dest_stride = dest_stride[i];
+    o->width = width[i];
+    o->height = height[i];
+    o->out = 0;
+
+    if (!get_functions (o->hscale, o->vscale, format, &o->hfunc, &o->vfunc,
+            &n_elems, &o->width, &bits))
+      goto no_func;
+
+    if (o->hscale && o->hscale->tmpwidth < o->width)
+      realloc_tmplines (o->hscale, n_elems, o->width);
+
+    if (o->vscale) {
+      guint tmpwidth = o->width;
+
+      o->v_taps = o->vscale->resampler.max_taps;
+      o->lines = g_newa (gpointer, o->v_taps);
+      n_lines = MAX (n_lines, o->vscale->resampler.in_size);
+
+      /* same choice as gst_video_scaler_2d(), vertically first when that
+       * scales less pixels */
+      o->v_first = o->hscale && o->height > 0 &&
+          o->vscale->resampler.offset[o->height - 1] > o->height;
+      if (o->v_first)
+        tmpwidth = o->hscale->resampler.in_size;
+
+      if (o->vscale->tmpwidth < tmpwidth)
+        realloc_tmplines (o->vscale, n_elems, tmpwidth);
+    } else {
+      o->v_taps = 1;
+      o->v_first = FALSE;
+      o->lines = NULL;
+      n_lines = MAX (n_lines, o->height);
+    }
+    if (o->height == 0)
+      n_done++;
+  }
+
+  for (sl = 0; sl < n_lines && n_done < n_outputs; sl++) {
+    guint8 *s = LINE (src, src_stride, sl);
+
+    for (i = 0; i < n_outputs; i++) {
+      ScalerOutput *o = &outs[i];
+
+      if (o->out >= o->height)
+        continue;
+
+      if (o->vscale == NULL) {
+        /* one output line for each source line */
+        guint8 *d = LINE (o->dest, o->dest_stride, sl);
+
+        if (o->hfunc)
+          o->hfunc (o->hscale, s, d, 0, o->width, n_elems);
+        else
+          memcpy (d, s, o->width * n_elems * (bits / 8));
+        o->out++;
+      } else {
+        guint32 *offset = o->vscale->resampler.offset;
+
+        /* not needed for the next output line */
+        if (sl < offset[o->out])
+          continue;
+
+        if (o->hfunc && !o->v_first)
+          o->hfunc (o->hscale, s, OUT_TMP_LINE (o, sl), 0, o->width, n_elems);
+
+        /* make all the output lines that have all their source lines, the
+         * source lines are still in the cache */
+        while (o->out < o->height && offset[o->out] + o->v_taps - 1 <= sl) {
+          guint in = offset[o->out], j;
+          guint8 *d = LINE (o->dest, o->dest_stride, o->out);
+
+          for (j = 0; j < o->v_taps; j++) {
+            if (o->hfunc && !o->v_first)
+              o->lines[j] = OUT_TMP_LINE (o, in + j);
+            else
+              o->lines[j] = LINE (src, src_stride, in + j);
+          }
+          if (o->v_first) {
+            o->vfunc (o->vscale, o->lines, o->vscale->tmpline1, o->out,
+                o->hscale->resampler.in_size, n_elems);
+            o->hfunc (o->hscale, o->vscale->tmpline1, d, 0, o->width,
+                n_elems);
+          } else {
+            o->vfunc (o->vscale, o->lines, d, o->out, o->width, n_elems);
+          }
+          o->out++;
+        }
+      }
+      if (o->out == o->height)
+        n_done++;
+    }
+  }
+  return;
+
+no_func:
+  {
+    GST_WARNING ("no scaler function for format");
+  }
+}
+
+#undef OUT_TMP_LINE
@@ -96,6 +96,18 @@ void                  gst_video_scaler_2d             (GstVideoScaler *hscale,
                                                        guint x, guint y,
                                                        guint width, guint height);
 
+GST_VIDEO_API
+void                  gst_video_scaler_2d_multi       (GstVideoScaler **hscale,
+                                                       GstVideoScaler **vscale,
+                                                       guint n_outputs,
+                                                       GstVideoFormat format,
+                                                       gpointer src, gint src_stride,
+                                                       gpointer dest[], gint dest_stride[],
+                                                       guint width[], guint height[]);
+
+GST_VIDEO_API
+void                  gst_video_scaler_get_cache_stats (guint64 *hits, guint64 *misses);
+
 G_END_DECLS
 
 #endif /* __GST_VIDEO_SCALER_H__ */
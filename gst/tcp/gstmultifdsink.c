@@ -113,20 +113,41 @@
 #endif
 
 #include <string.h>
+#include <limits.h>
 #include <fcntl.h>
 #include <sys/types.h>
 #include <sys/socket.h>
 #include <sys/stat.h>
+#include <sys/uio.h>
 #include <netinet/in.h>
 
 #ifdef HAVE_FIONREAD_IN_SYS_FILIO
 #include <sys/filio.h>
 #endif
 
+#ifdef HAVE_SYS_EPOLL_H
+#include <sys/epoll.h>
+#endif
+
 #include "gstmultifdsink.h"
 
 #define NOT_IMPLEMENTED 0
 
+/* maximum number of memory blocks we gather into one writev()/sendmsg().
+ * The mappings are kept on the stack so don't go all the way up to IOV_MAX
+ * on systems where that is large. */
+#ifdef IOV_MAX
+#define MAX_WRITE_VECTORS MIN (IOV_MAX, 64)
+#else
+#define MAX_WRITE_VECTORS 16
+#endif
+
+#ifdef MSG_NOSIGNAL
+#define FLAGS MSG_NOSIGNAL
+#else
+#define FLAGS 0
+#endif
+
 GST_DEBUG_CATEGORY_STATIC (multifdsink_debug);
 #define GST_CAT_DEFAULT (multifdsink_debug)
 
@@ -150,13 +171,35 @@ enum
 
 /* this is really arbitrarily chosen */
 #define DEFAULT_HANDLE_READ             TRUE
+#define DEFAULT_WORKER_THREADS          0
 
 enum
 {
   PROP_0,
-  PROP_HANDLE_READ
+  PROP_HANDLE_READ,
+  PROP_WORKER_THREADS
+};
+
+/* a thread servicing a subset of the clients with its own epoll set */
+struct _GstMultiFdSinkWorker
+{
+  GstMultiFdSink *sink;
+  GThread *thread;
+
+  gint epfd;
+  gint control[2];              /* pipe to wake up the thread */
+
+  GMutex lock;
+  GCond cond;                   /* signaled when a client leaves in_io */
+  GArray *pending;              /* fds with new data, protected by lock */
+  gboolean signaled;            /* control pipe was written, protected by lock */
+  gboolean stopping;            /* protected by lock */
+
+  guint n_clients;              /* protected by the clients lock */
 };
 
+#define MAX_WORKER_EVENTS 64
+
 static void gst_multi_fd_sink_stop_pre (GstMultiHandleSink * mhsink);
 static void gst_multi_fd_sink_stop_post (GstMultiHandleSink * mhsink);
 static gboolean gst_multi_fd_sink_start_pre (GstMultiHandleSink * mhsink);
@@ -225,6 +268,23 @@ gst_multi_fd_sink_class_init (GstMultiFdSinkClass * klass)
           "Handle client reads and discard the data",
           DEFAULT_HANDLE_READ, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstMultiFdSink::worker-threads
+   *
+   * Number of threads to service the clients with. When not 0, clients are
+   * distributed over this many threads that each wait on their own
+   * edge-triggered epoll set instead of having one thread poll all clients.
+   * The threads share the buffer queue. Only has an effect on systems with
+   * epoll and takes effect the next time the element is started.
+   *
+   * Since: 1.16
+   */
+  g_object_class_install_property (gobject_class, PROP_WORKER_THREADS,
+      g_param_spec_uint ("worker-threads", "Worker Threads",
+          "Number of epoll threads to service the clients with "
+          "(0 = poll all clients from one thread)", 0, 256,
+          DEFAULT_WORKER_THREADS, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   /**
    * GstMultiFdSink::add:
    * @gstmultifdsink: the multifdsink element to emit this signal on
@@ -412,6 +472,7 @@ gst_multi_fd_sink_init (GstMultiFdSink * this)
   mhsink->handle_hash = g_hash_table_new (g_direct_hash, g_direct_equal);
 
   this->handle_read = DEFAULT_HANDLE_READ;
+  this->n_worker_threads = DEFAULT_WORKER_THREADS;
 }
 
 /* methods to emit signals */
@@ -436,6 +497,18 @@ static void
 gst_multi_fd_sink_client_free (GstMultiHandleSink * mhsink,
     GstMultiHandleClient * client)
 {
+  GstTCPClient *tclient = (GstTCPClient *) client;
+  GstMultiFdSinkWorker *worker = tclient->worker;
+
+  /* the worker might still be writing to the fd, wait for it before
+   * the application gets to close it */
+  if (worker) {
+    g_mutex_lock (&worker->lock);
+    while (tclient->in_io)
+      g_cond_wait (&worker->cond, &worker->lock);
+    g_mutex_unlock (&worker->lock);
+  }
+
   g_signal_emit (mhsink, gst_multi_fd_sink_signals[SIGNAL_CLIENT_FD_REMOVED],
       0, client->handle.fd);
 }
@@ -492,6 +565,84 @@ gst_multi_fd_sink_get_stats (GstMultiFdSink * sink, int fd)
       handle);
 }
 
+/* worker threads */
+
+/* called with the clients lock held when new data is available for @fd or it
+ * needs to be checked again */
+static void
+gst_multi_fd_sink_worker_wakeup (GstMultiFdSinkWorker * worker, gint fd)
+{
+  g_mutex_lock (&worker->lock);
+  g_array_append_val (worker->pending, fd);
+  if (!worker->signaled) {
+    const gchar c = 'W';
+
+    while (write (worker->control[1], &c, 1) < 0 && errno == EINTR);
+    worker->signaled = TRUE;
+  }
+  g_mutex_unlock (&worker->lock);
+}
+
+/* called with the clients lock held, hands the client to the least busy
+ * worker */
+static void
+gst_multi_fd_sink_worker_add_client (GstMultiFdSink * sink,
+    GstTCPClient * client)
+{
+  GstMultiFdSinkWorker *worker = &sink->workers[0];
+  guint i;
+
+  for (i = 1; i < sink->n_workers; i++) {
+    if (sink->workers[i].n_clients < worker->n_clients)
+      worker = &sink->workers[i];
+  }
+  client->worker = worker;
+  worker->n_clients++;
+
+#ifdef HAVE_SYS_EPOLL_H
+  {
+    struct epoll_event ev = { 0, };
+
+    /* edge triggered, the worker writes until EAGAIN or until it runs out of
+     * data, in which case it is woken up again from hash_adding */
+    ev.events = EPOLLOUT | EPOLLET;
+    ev.data.fd = client->gfd.fd;
+
+    /* we don't try to read from write only fds */
+    if (sink->handle_read) {
+      gint flags;
+
+      flags = fcntl (client->gfd.fd, F_GETFL, 0);
+      if ((flags & O_ACCMODE) != O_WRONLY)
+        ev.events |= EPOLLIN;
+    }
+
+    if (epoll_ctl (worker->epfd, EPOLL_CTL_ADD, client->gfd.fd, &ev) < 0) {
+      GST_WARNING_OBJECT (sink, "%s failed to add to worker: %s",
+          ((GstMultiHandleClient *) client)->debug, g_strerror (errno));
+      /* let the worker remove the client */
+      ((GstMultiHandleClient *) client)->status = GST_CLIENT_STATUS_ERROR;
+      gst_multi_fd_sink_worker_wakeup (worker, client->gfd.fd);
+    }
+  }
+#endif
+}
+
+/* called with the clients lock held */
+static void
+gst_multi_fd_sink_worker_remove_client (GstMultiFdSink * sink,
+    GstTCPClient * client)
+{
+  GstMultiFdSinkWorker *worker = client->worker;
+
+#ifdef HAVE_SYS_EPOLL_H
+  epoll_ctl (worker->epfd, EPOLL_CTL_DEL, client->gfd.fd, NULL);
+#endif
+  /* from now on the worker must not touch the client anymore */
+  client->worker_removed = TRUE;
+  worker->n_clients--;
+}
+
 /* vfuncs */
 
 static GstMultiHandleClient *
@@ -523,16 +674,20 @@ gst_multi_fd_sink_new_client (GstMultiHandleSink * mhsink,
         mhclient->debug, g_strerror (errno));
   }
 
-  /* we always read from a client */
-  gst_poll_add_fd (sink->fdset, &client->gfd);
+  if (sink->n_workers > 0) {
+    gst_multi_fd_sink_worker_add_client (sink, client);
+  } else {
+    /* we always read from a client */
+    gst_poll_add_fd (sink->fdset, &client->gfd);
 
-  /* we don't try to read from write only fds */
-  if (sink->handle_read) {
-    gint flags;
+    /* we don't try to read from write only fds */
+    if (sink->handle_read) {
+      gint flags;
 
-    flags = fcntl (handle.fd, F_GETFL, 0);
-    if ((flags & O_ACCMODE) != O_WRONLY) {
-      gst_poll_fd_ctl_read (sink->fdset, &client->gfd, TRUE);
+      flags = fcntl (handle.fd, F_GETFL, 0);
+      if ((flags & O_ACCMODE) != O_WRONLY) {
+        gst_poll_fd_ctl_read (sink->fdset, &client->gfd, TRUE);
+      }
     }
   }
   /* figure out the mode, can't use send() for non sockets */
@@ -569,7 +724,9 @@ gst_multi_fd_sink_hash_changed (GstMultiHandleSink * mhsink)
 {
   GstMultiFdSink *sink = GST_MULTI_FD_SINK (mhsink);
 
-  gst_poll_restart (sink->fdset);
+  /* the workers are woken up per client */
+  if (sink->n_workers == 0)
+    gst_poll_restart (sink->fdset);
 }
 
 /* handle a read on a client fd,
@@ -647,6 +804,114 @@ ioctl_failed:
   }
 }
 
+/* take the next buffer from the global queue and add it to the
+ * mhclient->sending queue of @mhclient */
+static void
+gst_multi_fd_sink_client_take_buffer (GstMultiFdSink * sink,
+    GstMultiHandleClient * mhclient)
+{
+  GstMultiHandleSink *mhsink = GST_MULTI_HANDLE_SINK (sink);
+  GstMultiHandleSinkClass *mhsinkclass =
+      GST_MULTI_HANDLE_SINK_GET_CLASS (mhsink);
+  GstBuffer *buf;
+  GstClockTime timestamp;
+
+  /* grab buffer */
+  buf = g_array_index (mhsink->bufqueue, GstBuffer *, mhclient->bufpos);
+  mhclient->bufpos--;
+
+  /* update stats */
+  timestamp = GST_BUFFER_TIMESTAMP (buf);
+  if (mhclient->first_buffer_ts == GST_CLOCK_TIME_NONE)
+    mhclient->first_buffer_ts = timestamp;
+  if (timestamp != -1)
+    mhclient->last_buffer_ts = timestamp;
+
+  /* decrease flushcount */
+  if (mhclient->flushcount != -1)
+    mhclient->flushcount--;
+
+  GST_LOG_OBJECT (sink, "%s client %p at position %d",
+      mhclient->debug, mhclient, mhclient->bufpos);
+
+  /* queueing a buffer will ref it */
+  mhsinkclass->client_queue_buffer (mhsink, mhclient, buf);
+}
+
+/* Map the memory of the buffers in the mhclient->sending queue, starting
+ * at mhclient->bufoffset in the first buffer, into @vecs. Returns the
+ * number of vectors used or -1 when mapping failed, the total number of
+ * bytes is stored in @total. */
+static gint
+gst_multi_fd_sink_client_map_vectors (GstMultiHandleClient * mhclient,
+    struct iovec *vecs, GstMapInfo * maps, gsize * total)
+{
+  GSList *walk;
+  gsize skip = mhclient->bufoffset;
+  gint n_vecs = 0;
+
+  *total = 0;
+
+  for (walk = mhclient->sending; walk && n_vecs < MAX_WRITE_VECTORS;
+      walk = walk->next) {
+    GstBuffer *buf = GST_BUFFER (walk->data);
+    guint i, n_mem;
+
+    n_mem = gst_buffer_n_memory (buf);
+    for (i = 0; i < n_mem && n_vecs < MAX_WRITE_VECTORS; i++) {
+      GstMemory *mem = gst_buffer_peek_memory (buf, i);
+      gsize size = gst_memory_get_sizes (mem, NULL, NULL);
+
+      /* skip what we already sent of the first buffer */
+      if (skip >= size) {
+        skip -= size;
+        continue;
+      }
+      if (!gst_memory_map (mem, &maps[n_vecs], GST_MAP_READ))
+        goto map_failed;
+
+      vecs[n_vecs].iov_base = maps[n_vecs].data + skip;
+      vecs[n_vecs].iov_len = maps[n_vecs].size - skip;
+      *total += vecs[n_vecs].iov_len;
+      skip = 0;
+      n_vecs++;
+    }
+  }
+  return n_vecs;
+
+  /* ERRORS */
+map_failed:
+  {
+    while (n_vecs--)
+      gst_memory_unmap (maps[n_vecs].memory, &maps[n_vecs]);
+    return -1;
+  }
+}
+
+/* Remove @wrote bytes from the mhclient->sending queue, buffers that were
+ * completely written are unreffed. */
+static void
+gst_multi_fd_sink_client_consume (GstMultiHandleClient * mhclient,
+    gsize wrote)
+{
+  while (mhclient->sending) {
+    GstBuffer *head = GST_BUFFER (mhclient->sending->data);
+    gsize left = gst_buffer_get_size (head) - mhclient->bufoffset;
+
+    if (wrote < left) {
+      mhclient->bufoffset += wrote;
+      break;
+    }
+    /* complete buffer was written, we can proceed to the next one */
+    mhclient->sending = g_slist_delete_link (mhclient->sending,
+        mhclient->sending);
+    gst_buffer_unref (head);
+    /* make sure we start from byte 0 for the next buffer */
+    mhclient->bufoffset = 0;
+    wrote -= left;
+  }
+}
+
 /* Handle a write on a client,
  * which indicates a read request from a client.
  *
@@ -659,12 +924,13 @@ ioctl_failed:
  * possible. It will first exhaust the mhclient->sending queue and if the queue
  * is empty, it will pick a buffer from the global queue.
  *
- * Sending the buffers from the mhclient->sending queue is basically writing
- * the bytes to the socket and maintaining a count of the bytes that were
- * sent. When the buffer is completely sent, it is removed from the
- * mhclient->sending queue and we try to pick a new buffer for sending.
+ * The mhclient->sending queue is topped up with buffers that are already
+ * waiting in the global queue and all of them are written with a single
+ * writev() or sendmsg(), we keep a count of the bytes that were sent.
+ * Buffers that were completely sent are removed from the mhclient->sending
+ * queue.
  *
- * When the sending returns a partial buffer we stop sending more data as
+ * When the sending returns a partial write we stop sending more data as
  * the next send operation could block.
  *
  * This functions returns FALSE if some error occured.
@@ -678,8 +944,6 @@ gst_multi_fd_sink_handle_client_write (GstMultiFdSink * sink,
   GstClockTime now;
   GTimeVal nowtv;
   GstMultiHandleSink *mhsink = GST_MULTI_HANDLE_SINK (sink);
-  GstMultiHandleSinkClass *mhsinkclass =
-      GST_MULTI_HANDLE_SINK_GET_CLASS (mhsink);
   GstMultiHandleClient *mhclient = (GstMultiHandleClient *) client;
   int fd = mhclient->handle.fd;
 
@@ -687,8 +951,6 @@ gst_multi_fd_sink_handle_client_write (GstMultiFdSink * sink,
 
   more = TRUE;
   do {
-    gint maxsize;
-
     g_get_current_time (&nowtv);
     now = GST_TIMEVAL_TO_TIME (nowtv);
 
@@ -698,7 +960,8 @@ gst_multi_fd_sink_handle_client_write (GstMultiFdSink * sink,
         /* client is too fast, remove from write queue until new buffer is
          * available */
         /* FIXME: specific */
-        gst_poll_fd_ctl_write (sink->fdset, &client->gfd, FALSE);
+        if (!client->worker)
+          gst_poll_fd_ctl_write (sink->fdset, &client->gfd, FALSE);
 
         /* if we flushed out all of the client buffers, we can stop */
         if (mhclient->flushcount == 0)
@@ -707,8 +970,6 @@ gst_multi_fd_sink_handle_client_write (GstMultiFdSink * sink,
         return TRUE;
       } else {
         /* client can pick a buffer from the global queue */
-        GstBuffer *buf;
-        GstClockTime timestamp;
 
         /* for new connections, we need to find a good spot in the
          * bufqueue to start streaming from */
@@ -723,7 +984,8 @@ gst_multi_fd_sink_handle_client_write (GstMultiFdSink * sink,
           } else {
             /* cannot send data to this client yet */
             /* FIXME: specific */
-            gst_poll_fd_ctl_write (sink->fdset, &client->gfd, FALSE);
+            if (!client->worker)
+              gst_poll_fd_ctl_write (sink->fdset, &client->gfd, FALSE);
             return TRUE;
           }
         }
@@ -732,26 +994,7 @@ gst_multi_fd_sink_handle_client_write (GstMultiFdSink * sink,
         if (mhclient->flushcount == 0)
           goto flushed;
 
-        /* grab buffer */
-        buf = g_array_index (mhsink->bufqueue, GstBuffer *, mhclient->bufpos);
-        mhclient->bufpos--;
-
-        /* update stats */
-        timestamp = GST_BUFFER_TIMESTAMP (buf);
-        if (mhclient->first_buffer_ts == GST_CLOCK_TIME_NONE)
-          mhclient->first_buffer_ts = timestamp;
-        if (timestamp != -1)
-          mhclient->last_buffer_ts = timestamp;
-
-        /* decrease flushcount */
-        if (mhclient->flushcount != -1)
-          mhclient->flushcount--;
-
-        GST_LOG_OBJECT (sink, "%s client %p at position %d",
-            mhclient->debug, client, mhclient->bufpos);
-
-        /* queueing a buffer will ref it */
-        mhsinkclass->client_queue_buffer (mhsink, mhclient, buf);
+        gst_multi_fd_sink_client_take_buffer (sink, mhclient);
 
         /* need to start from the first byte for this new buffer */
         mhclient->bufoffset = 0;
@@ -761,32 +1004,75 @@ gst_multi_fd_sink_handle_client_write (GstMultiFdSink * sink,
     /* see if we need to send something */
     if (mhclient->sending) {
       ssize_t wrote;
-      GstBuffer *head;
-      GstMapInfo info;
-      guint8 *data;
-
-      /* pick first buffer from list */
-      head = GST_BUFFER (mhclient->sending->data);
+      struct iovec vecs[MAX_WRITE_VECTORS];
+      GstMapInfo maps[MAX_WRITE_VECTORS];
+      gint i, n_vecs, errsv;
+      guint n_queued;
+      gsize maxsize;
+      GstMultiFdSinkWorker *worker = client->worker;
+      GSList *held = NULL;
+
+      /* add whatever is already waiting in the global queue so that it can
+       * go out with the same write */
+      n_queued = g_slist_length (mhclient->sending);
+      while (n_queued < MAX_WRITE_VECTORS && mhclient->bufpos != -1 &&
+          mhclient->flushcount != 0 && (!mhclient->new_connection
+              || flushing)) {
+        gst_multi_fd_sink_client_take_buffer (sink, mhclient);
+        n_queued = g_slist_length (mhclient->sending);
+      }
 
-      if (!gst_buffer_map (head, &info, GST_MAP_READ))
+      n_vecs = gst_multi_fd_sink_client_map_vectors (mhclient, vecs, maps,
+          &maxsize);
+      if (n_vecs < 0)
         g_return_val_if_reached (FALSE);
 
-      data = info.data;
-      maxsize = info.size - mhclient->bufoffset;
+      if (worker) {
+        /* let the other threads continue while we write, keep the buffers
+         * alive in case the client is removed meanwhile */
+        held = g_slist_copy_deep (mhclient->sending,
+            (GCopyFunc) gst_buffer_ref, NULL);
+        g_mutex_lock (&worker->lock);
+        client->in_io = TRUE;
+        g_mutex_unlock (&worker->lock);
+        CLIENTS_UNLOCK (mhsink);
+      }
 
       /* FIXME: specific */
-      /* try to write the complete buffer */
-#ifdef MSG_NOSIGNAL
-#define FLAGS MSG_NOSIGNAL
-#else
-#define FLAGS 0
-#endif
-      if (client->is_socket) {
-        wrote = send (fd, data + mhclient->bufoffset, maxsize, FLAGS);
+      /* try to write everything we gathered */
+      if (n_vecs == 0) {
+        /* only empty buffers */
+        wrote = 0;
+      } else if (client->is_socket) {
+        struct msghdr msg = { 0, };
+
+        msg.msg_iov = vecs;
+        msg.msg_iovlen = n_vecs;
+
+        wrote = sendmsg (fd, &msg, FLAGS);
       } else {
-        wrote = write (fd, data + mhclient->bufoffset, maxsize);
+        wrote = writev (fd, vecs, n_vecs);
+      }
+      errsv = errno;
+      for (i = 0; i < n_vecs; i++)
+        gst_memory_unmap (maps[i].memory, &maps[i]);
+
+      if (worker) {
+        gboolean removed;
+
+        CLIENTS_LOCK (mhsink);
+        /* the client can be freed as soon as it leaves in_io */
+        removed = client->worker_removed;
+        g_mutex_lock (&worker->lock);
+        client->in_io = FALSE;
+        g_cond_broadcast (&worker->cond);
+        g_mutex_unlock (&worker->lock);
+        g_slist_free_full (held, (GDestroyNotify) gst_buffer_unref);
+
+        if (removed)
+          return TRUE;
+        errno = errsv;
       }
-      gst_buffer_unmap (head, &info);
 
       if (wrote < 0) {
         /* hmm error.. */
@@ -799,21 +1085,19 @@ gst_multi_fd_sink_handle_client_write (GstMultiFdSink * sink,
           goto write_error;
         }
       } else {
-        if (wrote < maxsize) {
+        if ((gsize) wrote < maxsize) {
           /* partial write means that the client cannot read more and we should
-           * stop sending more */
+           * stop sending more. The workers poll edge triggered and only get
+           * woken up again after a write failed with EAGAIN, so they keep
+           * writing until then */
           GST_LOG_OBJECT (sink,
               "partial write on %s of %" G_GSSIZE_FORMAT " bytes",
               mhclient->debug, wrote);
-          mhclient->bufoffset += wrote;
-          more = FALSE;
-        } else {
-          /* complete buffer was written, we can proceed to the next one */
-          mhclient->sending = g_slist_remove (mhclient->sending, head);
-          gst_buffer_unref (head);
-          /* make sure we start from byte 0 for the next buffer */
-          mhclient->bufoffset = 0;
+          if (!worker)
+            more = FALSE;
         }
+        gst_multi_fd_sink_client_consume (mhclient, wrote);
+
         /* update stats */
         mhclient->bytes_sent += wrote;
         mhclient->last_activity_time = now;
@@ -855,7 +1139,10 @@ gst_multi_fd_sink_hash_adding (GstMultiHandleSink * mhsink,
   GstMultiFdSink *sink = GST_MULTI_FD_SINK (mhsink);
   GstTCPClient *client = (GstTCPClient *) mhclient;
 
-  gst_poll_fd_ctl_write (sink->fdset, &client->gfd, TRUE);
+  if (client->worker)
+    gst_multi_fd_sink_worker_wakeup (client->worker, client->gfd.fd);
+  else
+    gst_poll_fd_ctl_write (sink->fdset, &client->gfd, TRUE);
 }
 
 static void
@@ -865,7 +1152,10 @@ gst_multi_fd_sink_hash_removing (GstMultiHandleSink * mhsink,
   GstMultiFdSink *sink = GST_MULTI_FD_SINK (mhsink);
   GstTCPClient *client = (GstTCPClient *) mhclient;
 
-  gst_poll_remove_fd (sink->fdset, &client->gfd);
+  if (client->worker)
+    gst_multi_fd_sink_worker_remove_client (sink, client);
+  else
+    gst_poll_remove_fd (sink->fdset, &client->gfd);
 }
 
 
@@ -1015,6 +1305,10 @@ restart2:
       continue;
     }
 
+    /* the fd is polled by its worker thread */
+    if (client->worker)
+      continue;
+
     if (gst_poll_fd_has_closed (sink->fdset, &client->gfd)) {
       mhclient->status = GST_CLIENT_STATUS_CLOSED;
       gst_multi_handle_sink_remove_client_link (mhsink, clients);
@@ -1057,6 +1351,206 @@ gst_multi_fd_sink_thread (GstMultiHandleSink * mhsink)
   return NULL;
 }
 
+#ifdef HAVE_SYS_EPOLL_H
+/* called with the clients lock held */
+static void
+gst_multi_fd_sink_worker_service (GstMultiFdSinkWorker * worker, gint fd,
+    guint32 events)
+{
+  GstMultiFdSink *sink = worker->sink;
+  GstMultiHandleSink *mhsink = GST_MULTI_HANDLE_SINK (sink);
+  GstMultiHandleClient *mhclient;
+  GstTCPClient *client;
+  GList *clink;
+
+  clink = g_hash_table_lookup (mhsink->handle_hash, GINT_TO_POINTER (fd));
+  if (clink == NULL)
+    return;
+
+  client = (GstTCPClient *) clink->data;
+  mhclient = (GstMultiHandleClient *) client;
+
+  /* being removed or not ours */
+  if (client->worker != worker || client->worker_removed)
+    return;
+
+  if (mhclient->status != GST_CLIENT_STATUS_FLUSHING
+      && mhclient->status != GST_CLIENT_STATUS_OK) {
+    gst_multi_handle_sink_remove_client_link (mhsink, clink);
+    return;
+  }
+  if (events & EPOLLERR) {
+    GST_WARNING_OBJECT (sink, "%s error on fd", mhclient->debug);
+    mhclient->status = GST_CLIENT_STATUS_ERROR;
+    gst_multi_handle_sink_remove_client_link (mhsink, clink);
+    return;
+  }
+  if ((events & EPOLLHUP) && !(events & EPOLLIN)) {
+    mhclient->status = GST_CLIENT_STATUS_CLOSED;
+    gst_multi_handle_sink_remove_client_link (mhsink, clink);
+    return;
+  }
+  if (events & EPOLLIN) {
+    if (!gst_multi_fd_sink_handle_client_read (sink, client)) {
+      gst_multi_handle_sink_remove_client_link (mhsink, clink);
+      return;
+    }
+  }
+  if (events & EPOLLOUT) {
+    if (!gst_multi_fd_sink_handle_client_write (sink, client)) {
+      /* the lock was released while writing, look the client up again */
+      clink = g_hash_table_lookup (mhsink->handle_hash, GINT_TO_POINTER (fd));
+      if (clink && clink->data == (gpointer) client)
+        gst_multi_handle_sink_remove_client_link (mhsink, clink);
+    }
+  }
+}
+
+static gpointer
+gst_multi_fd_sink_worker_thread (GstMultiFdSinkWorker * worker)
+{
+  GstMultiHandleSink *mhsink = GST_MULTI_HANDLE_SINK (worker->sink);
+  struct epoll_event events[MAX_WORKER_EVENTS];
+  GArray *pending;
+  gboolean stopping = FALSE;
+  gint i, n;
+  guint j;
+
+  pending = g_array_new (FALSE, FALSE, sizeof (gint));
+
+  while (!stopping) {
+    n = epoll_wait (worker->epfd, events, MAX_WORKER_EVENTS, -1);
+    if (n < 0) {
+      if (errno == EINTR)
+        continue;
+      GST_ELEMENT_ERROR (worker->sink, RESOURCE, READ, (NULL),
+          ("epoll_wait failed: %s (%d)", g_strerror (errno), errno));
+      break;
+    }
+
+    /* the clients lock is only taken per client, so that the workers can
+     * service their clients in parallel */
+    for (i = 0; i < n; i++) {
+      if (events[i].data.fd == worker->control[0]) {
+        gchar buf[64];
+        GArray *tmp;
+
+        while (read (worker->control[0], buf, sizeof (buf)) > 0);
+
+        g_mutex_lock (&worker->lock);
+        tmp = worker->pending;
+        worker->pending = pending;
+        pending = tmp;
+        worker->signaled = FALSE;
+        stopping = worker->stopping;
+        g_mutex_unlock (&worker->lock);
+
+        for (j = 0; j < pending->len; j++) {
+          CLIENTS_LOCK (mhsink);
+          gst_multi_fd_sink_worker_service (worker,
+              g_array_index (pending, gint, j), EPOLLOUT);
+          CLIENTS_UNLOCK (mhsink);
+        }
+        g_array_set_size (pending, 0);
+      } else {
+        CLIENTS_LOCK (mhsink);
+        gst_multi_fd_sink_worker_service (worker, events[i].data.fd,
+            events[i].events);
+        CLIENTS_UNLOCK (mhsink);
+      }
+    }
+  }
+  g_array_free (pending, TRUE);
+
+  return NULL;
+}
+
+static gboolean
+gst_multi_fd_sink_start_workers (GstMultiFdSink * sink)
+{
+  guint i;
+
+  sink->workers = g_new0 (GstMultiFdSinkWorker, sink->n_worker_threads);
+
+  for (i = 0; i < sink->n_worker_threads; i++) {
+    GstMultiFdSinkWorker *worker = &sink->workers[i];
+    struct epoll_event ev = { 0, };
+
+    worker->sink = sink;
+    worker->control[0] = worker->control[1] = -1;
+    g_mutex_init (&worker->lock);
+    g_cond_init (&worker->cond);
+    worker->pending = g_array_new (FALSE, FALSE, sizeof (gint));
+    sink->n_workers++;
+
+    if ((worker->epfd = epoll_create1 (EPOLL_CLOEXEC)) < 0)
+      return FALSE;
+    if (pipe (worker->control) < 0)
+      return FALSE;
+    fcntl (worker->control[0], F_SETFL, O_NONBLOCK);
+    fcntl (worker->control[1], F_SETFL, O_NONBLOCK);
+
+    ev.events = EPOLLIN;
+    ev.data.fd = worker->control[0];
+    if (epoll_ctl (worker->epfd, EPOLL_CTL_ADD, worker->control[0], &ev) < 0)
+      return FALSE;
+
+    worker->thread = g_thread_new ("multifdsink-worker",
+        (GThreadFunc) gst_multi_fd_sink_worker_thread, worker);
+  }
+  return TRUE;
+}
+
+static void
+gst_multi_fd_sink_stop_workers (GstMultiFdSink * sink)
+{
+  guint i;
+
+  for (i = 0; i < sink->n_workers; i++) {
+    GstMultiFdSinkWorker *worker = &sink->workers[i];
+    const gchar c = 'S';
+
+    if (worker->thread == NULL)
+      continue;
+
+    g_mutex_lock (&worker->lock);
+    worker->stopping = TRUE;
+    if (!worker->signaled) {
+      while (write (worker->control[1], &c, 1) < 0 && errno == EINTR);
+      worker->signaled = TRUE;
+    }
+    g_mutex_unlock (&worker->lock);
+
+    g_thread_join (worker->thread);
+    worker->thread = NULL;
+  }
+}
+#endif
+
+/* called after the clients were removed */
+static void
+gst_multi_fd_sink_free_workers (GstMultiFdSink * sink)
+{
+  guint i;
+
+  for (i = 0; i < sink->n_workers; i++) {
+    GstMultiFdSinkWorker *worker = &sink->workers[i];
+
+    if (worker->epfd >= 0)
+      close (worker->epfd);
+    if (worker->control[0] >= 0)
+      close (worker->control[0]);
+    if (worker->control[1] >= 0)
+      close (worker->control[1]);
+    g_array_free (worker->pending, TRUE);
+    g_mutex_clear (&worker->lock);
+    g_cond_clear (&worker->cond);
+  }
+  g_free (sink->workers);
+  sink->workers = NULL;
+  sink->n_workers = 0;
+}
+
 static void
 gst_multi_fd_sink_set_property (GObject * object, guint prop_id,
     const GValue * value, GParamSpec * pspec)
@@ -1069,6 +1563,9 @@ gst_multi_fd_sink_set_property (GObject * object, guint prop_id,
     case PROP_HANDLE_READ:
       multifdsink->handle_read = g_value_get_boolean (value);
       break;
+    case PROP_WORKER_THREADS:
+      multifdsink->n_worker_threads = g_value_get_uint (value);
+      break;
 
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
@@ -1088,6 +1585,9 @@ gst_multi_fd_sink_get_property (GObject * object, guint prop_id, GValue * value,
     case PROP_HANDLE_READ:
       g_value_set_boolean (value, multifdsink->handle_read);
       break;
+    case PROP_WORKER_THREADS:
+      g_value_set_uint (value, multifdsink->n_worker_threads);
+      break;
 
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
@@ -1104,6 +1604,16 @@ gst_multi_fd_sink_start_pre (GstMultiHandleSink * mhsink)
   if ((mfsink->fdset = gst_poll_new (TRUE)) == NULL)
     goto socket_pair;
 
+  if (mfsink->n_worker_threads > 0) {
+#ifdef HAVE_SYS_EPOLL_H
+    if (!gst_multi_fd_sink_start_workers (mfsink))
+      goto workers;
+#else
+    GST_WARNING_OBJECT (mfsink, "worker threads not supported on this "
+        "platform, serving all clients from one thread");
+#endif
+  }
+
   return TRUE;
 
   /* ERRORS */
@@ -1113,6 +1623,18 @@ socket_pair:
         GST_ERROR_SYSTEM);
     return FALSE;
   }
+#ifdef HAVE_SYS_EPOLL_H
+workers:
+  {
+    GST_ELEMENT_ERROR (mfsink, RESOURCE, OPEN_READ_WRITE, (NULL),
+        GST_ERROR_SYSTEM);
+    gst_multi_fd_sink_stop_workers (mfsink);
+    gst_multi_fd_sink_free_workers (mfsink);
+    gst_poll_free (mfsink->fdset);
+    mfsink->fdset = NULL;
+    return FALSE;
+  }
+#endif
 }
 
 static gboolean
@@ -1127,6 +1649,10 @@ gst_multi_fd_sink_stop_pre (GstMultiHandleSink * mhsink)
   GstMultiFdSink *mfsink = GST_MULTI_FD_SINK (mhsink);
 
   gst_poll_set_flushing (mfsink->fdset, TRUE);
+
+#ifdef HAVE_SYS_EPOLL_H
+  gst_multi_fd_sink_stop_workers (mfsink);
+#endif
 }
 
 static void
@@ -1140,4 +1666,6 @@ gst_multi_fd_sink_stop_post (GstMultiHandleSink * mhsink)
   }
   g_hash_table_foreach_remove (mhsink->handle_hash, multifdsink_hash_remove,
       mfsink);
+
+  gst_multi_fd_sink_free_workers (mfsink);
 }
@@ -45,6 +45,7 @@ G_BEGIN_DECLS
 
 typedef struct _GstMultiFdSink GstMultiFdSink;
 typedef struct _GstMultiFdSinkClass GstMultiFdSinkClass;
+typedef struct _GstMultiFdSinkWorker GstMultiFdSinkWorker;
 
 
 /* structure for a client
@@ -55,6 +56,11 @@ typedef struct {
   GstPollFD gfd;
 
   gboolean is_socket;
+
+  /* when serviced by a worker thread */
+  GstMultiFdSinkWorker *worker;
+  gboolean in_io;               /* writing without the clients lock */
+  gboolean worker_removed;      /* removed from its worker */
 } GstTCPClient;
 
 /**
@@ -69,6 +75,10 @@ struct _GstMultiFdSink {
   GstPoll *fdset;
 
   gboolean handle_read;
+
+  guint n_worker_threads;
+  GstMultiFdSinkWorker *workers;
+  guint n_workers;              /* number of running workers */
 };
 
 struct _GstMultiFdSinkClass {
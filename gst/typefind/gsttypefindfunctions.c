@@ -118,6 +118,135 @@ data_scan_ctx_memcmp (GstTypeFind * tf, DataScanCtx * c, guint offset,
   return (memcmp (c->data + offset, data, len) == 0);
 }
 
+/* Container signatures: fixed magic bytes of container formats whose
+ * typefinder is guaranteed to suggest GST_TYPE_FIND_MAXIMUM if they match.
+ * This does not change which typefinders run or in which order, the core
+ * decides that. Instead the scanning typefinders for elementary streams
+ * (mpeg audio, ac3, h264 etc.) look the first bytes up here before doing
+ * anything else and return early if the data clearly belongs to one of these
+ * containers, since their suggestion could never win against the container's
+ * anyway. If nothing matches they fall back to the full scan. */
+
+#define TYPE_FIND_SIGNATURE_MAX_OFFSET 4
+#define TYPE_FIND_SIGNATURE_ANY_OFFSET G_MAXUINT8
+#define TYPE_FIND_SIGNATURE_PEEK_SIZE 64
+
+typedef struct
+{
+  const gchar *media_type;
+  guint8 offset;
+  guint8 size;
+  const gchar *magic;
+  /* optional second signature that has to match as well, either at a fixed
+   * offset or anywhere in the first TYPE_FIND_SIGNATURE_PEEK_SIZE bytes */
+  guint8 offset2;
+  guint8 size2;
+  const gchar *magic2;
+} TypeFindSignature;
+
+static const TypeFindSignature type_find_signatures[] = {
+  {"application/ogg", 0, 5, "OggS\0", 0, 0, NULL},
+  {"audio/x-flac", 0, 4, "fLaC", 0, 0, NULL},
+  {"audio/x-wav", 0, 4, "RIFF", 8, 4, "WAVE"},
+  {"video/x-msvideo", 0, 4, "RIFF", 8, 4, "AVI "},
+  {"video/x-matroska", 0, 4, "\032\105\337\243",
+      TYPE_FIND_SIGNATURE_ANY_OFFSET, 8, "matroska"},
+  {"video/webm", 0, 4, "\032\105\337\243",
+      TYPE_FIND_SIGNATURE_ANY_OFFSET, 4, "webm"},
+  {"video/x-flv", 0, 4, "FLV\001", 0, 0, NULL},
+  {"video/x-ms-asf", 0, 16,
+      "\060\046\262\165\216\146\317\021\246\331\000\252\000\142\316\154",
+      0, 0, NULL},
+  {"image/png", 0, 8, "\211PNG\015\012\032\012", 0, 0, NULL},
+  {"audio/x-m4a", 4, 8, "ftypM4A ", 0, 0, NULL},
+  {"video/quicktime", 4, 8, "ftypqt  ", 0, 0, NULL},
+  {"video/quicktime", 4, 8, "ftypisom", 0, 0, NULL},
+  {"video/quicktime", 4, 8, "ftypavc1", 0, 0, NULL},
+  {"video/quicktime", 4, 8, "ftypmp42", 0, 0, NULL},
+  {"video/quicktime", 4, 8, "ftypisml", 0, 0, NULL},
+  {"video/quicktime", 4, 8, "ftypavc3", 0, 0, NULL},
+};
+
+/* signatures by offset and first magic byte, built in plugin_init */
+static GSList
+    * type_find_signature_index[TYPE_FIND_SIGNATURE_MAX_OFFSET + 1][256];
+
+static void
+type_find_signature_index_init (void)
+{
+  gint i;
+
+  for (i = G_N_ELEMENTS (type_find_signatures) - 1; i >= 0; i--) {
+    const TypeFindSignature *sig = &type_find_signatures[i];
+    GSList **bucket;
+
+    g_assert (sig->offset <= TYPE_FIND_SIGNATURE_MAX_OFFSET);
+    g_assert (sig->offset + sig->size <= TYPE_FIND_SIGNATURE_PEEK_SIZE);
+
+    bucket =
+        &type_find_signature_index[sig->offset][(guint8) sig->magic[0]];
+
+    *bucket = g_slist_prepend (*bucket, (gpointer) sig);
+  }
+}
+
+static gboolean
+type_find_signature_matches (const TypeFindSignature * sig,
+    const guint8 * data, guint size)
+{
+  guint i;
+
+  if (sig->offset + sig->size > size ||
+      memcmp (data + sig->offset, sig->magic, sig->size) != 0)
+    return FALSE;
+
+  if (sig->magic2 == NULL)
+    return TRUE;
+
+  if (sig->offset2 != TYPE_FIND_SIGNATURE_ANY_OFFSET) {
+    return (sig->offset2 + sig->size2 <= size &&
+        memcmp (data + sig->offset2, sig->magic2, sig->size2) == 0);
+  }
+
+  size = MIN (size, TYPE_FIND_SIGNATURE_PEEK_SIZE);
+  for (i = 0; i + sig->size2 <= size; i++) {
+    if (memcmp (data + i, sig->magic2, sig->size2) == 0)
+      return TRUE;
+  }
+
+  return FALSE;
+}
+
+/* returns TRUE if the data starts with the signature of a container format
+ * that is certain to be detected with maximum probability */
+static gboolean
+type_find_has_container_signature (GstTypeFind * tf)
+{
+  DataScanCtx c = { 0, NULL, 0 };
+  GSList *l;
+  guint offset;
+
+  if (!data_scan_ctx_ensure_data (tf, &c, 8))
+    return FALSE;
+
+  for (offset = 0; offset <= TYPE_FIND_SIGNATURE_MAX_OFFSET; offset++) {
+    if (offset >= c.size)
+      break;
+
+    l = type_find_signature_index[offset][c.data[offset]];
+    for (; l != NULL; l = l->next) {
+      const TypeFindSignature *sig = l->data;
+
+      if (type_find_signature_matches (sig, c.data, c.size)) {
+        GST_LOG ("found %s signature, skipping scan", sig->media_type);
+        return TRUE;
+      }
+    }
+  }
+
+  return FALSE;
+}
+
 /*** text/plain ***/
 static gboolean xml_check_first_element (GstTypeFind * tf,
     const gchar * element, guint elen, gboolean strict);
@@ -1098,6 +1227,9 @@ aac_type_find (GstTypeFind * tf, gpointer unused)
   GstCaps *best_caps = NULL;
   guint best_count = 0;
 
+  if (type_find_has_container_signature (tf))
+    return;
+
   while (c.offset < AAC_AMOUNT) {
     guint snc, len, offset, i;
 
@@ -1561,6 +1693,9 @@ mp3_type_find (GstTypeFind * tf, gpointer unused)
   guint layer, mid_layer;
   guint64 length;
 
+  if (type_find_has_container_signature (tf))
+    return;
+
   mp3_type_find_at_offset (tf, 0, &layer, &prob);
   length = gst_type_find_get_length (tf);
 
@@ -1712,6 +1847,9 @@ ac3_type_find (GstTypeFind * tf, gpointer unused)
 {
   DataScanCtx c = { 0, NULL, 0 };
 
+  if (type_find_has_container_signature (tf))
+    return;
+
   /* Search for an ac3 frame; not necessarily right at the start, but give it
    * a lower probability if not found right at the start. Check that the
    * frame is followed by a second frame at the expected offset.
@@ -1879,6 +2017,9 @@ dts_type_find (GstTypeFind * tf, gpointer unused)
 {
   DataScanCtx c = { 0, NULL, 0 };
 
+  if (type_find_has_container_signature (tf))
+    return;
+
   /* Search for an dts frame; not necessarily right at the start, but give it
    * a lower probability if not found right at the start. Check that the
    * frame is followed by a second frame at the expected offset. */
@@ -2278,6 +2419,9 @@ mpeg_sys_type_find (GstTypeFind * tf, gpointer unused)
   guint32 sync_word = 0xffffffff;
   guint potential_headers = 0;
 
+  if (type_find_has_container_signature (tf))
+    return;
+
   G_STMT_START {
     gint len;
 
@@ -2460,6 +2604,9 @@ mpeg_ts_type_find (GstTypeFind * tf, gpointer unused)
   guint size = 0;
   guint64 skipped = 0;
 
+  if (type_find_has_container_signature (tf))
+    return;
+
   while (skipped < GST_MPEGTS_TYPEFIND_SCAN_LENGTH) {
     if (size < MPEGTS_HDR_SIZE) {
       data = gst_type_find_peek (tf, skipped, GST_MPEGTS_TYPEFIND_SYNC_SIZE);
@@ -2549,6 +2696,9 @@ mpeg4_video_type_find (GstTypeFind * tf, gpointer unused)
   guint num_vop_headers = 0;
   guint8 sc;
 
+  if (type_find_has_container_signature (tf))
+    return;
+
   while (c.offset < GST_MPEGVID_TYPEFIND_TRY_SYNC) {
     if (num_vop_headers >= GST_MPEGVID_TYPEFIND_TRY_PICTURES)
       break;
@@ -2670,6 +2820,9 @@ h263_video_type_find (GstTypeFind * tf, gpointer unused)
   guint bad = 0;
   guint pc_type, pb_mode;
 
+  if (type_find_has_container_signature (tf))
+    return;
+
   while (c.offset < H263_MAX_PROBE_LENGTH) {
     if (G_UNLIKELY (!data_scan_ctx_ensure_data (tf, &c, 4)))
       break;
@@ -2735,6 +2888,9 @@ h264_video_type_find (GstTypeFind * tf, gpointer unused)
   int good = 0;
   int bad = 0;
 
+  if (type_find_has_container_signature (tf))
+    return;
+
   while (c.offset < H264_MAX_PROBE_LENGTH) {
     if (G_UNLIKELY (!data_scan_ctx_ensure_data (tf, &c, 4)))
       break;
@@ -2832,6 +2988,9 @@ h265_video_type_find (GstTypeFind * tf, gpointer unused)
   int good = 0;
   int bad = 0;
 
+  if (type_find_has_container_signature (tf))
+    return;
+
   while (c.offset < H265_MAX_PROBE_LENGTH) {
     if (G_UNLIKELY (!data_scan_ctx_ensure_data (tf, &c, 5)))
       break;
@@ -2926,6 +3085,9 @@ mpeg_video_stream_type_find (GstTypeFind * tf, gpointer unused)
   guint num_pic_headers = 0;
   gint found = 0;
 
+  if (type_find_has_container_signature (tf))
+    return;
+
   while (c.offset < GST_MPEGVID_TYPEFIND_TRY_SYNC) {
     if (found >= GST_MPEGVID_TYPEFIND_TRY_PICTURES)
       break;
@@ -5758,6 +5920,8 @@ plugin_init (GstPlugin * plugin)
   GST_DEBUG_CATEGORY_INIT (type_find_debug, "typefindfunctions",
       GST_DEBUG_FG_GREEN | GST_DEBUG_BG_RED, "generic type find functions");
 
+  type_find_signature_index_init ();
+
   /* note: asx/wax/wmx are XML files, asf doesn't handle them */
   /* must use strings, macros don't accept initializers */
   TYPE_FIND_REGISTER_START_WITH (plugin, "video/x-ms-asf", GST_RANK_SECONDARY,
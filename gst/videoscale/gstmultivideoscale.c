@@ -0,0 +1,685 @@
+/* GStreamer
+ * Copyright (C) 2018 The GStreamer developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/**
+ * SECTION:element-multivideoscale
+ * @title: multivideoscale
+ * @see_also: videoscale, tee
+ *
+ * This element resizes video frames to a different size on each of its
+ * source pads. The size of each source pad is negotiated with downstream
+ * independently.
+ *
+ * All the sizes are made in one pass over the input frame with
+ * gst_video_scaler_2d_multi(), each input line is read once for all outputs.
+ * This is much cheaper than a tee followed by a videoscale for each size, as
+ * used for adaptive streaming ladders.
+ *
+ * ## Example pipelines
+ * |[
+ * gst-launch-1.0 videotestsrc ! video/x-raw,width=1920,height=1080 ! multivideoscale name=s \
+ *     s.src_0 ! video/x-raw,width=1280,height=720 ! queue ! fakesink \
+ *     s.src_1 ! video/x-raw,width=640,height=360 ! queue ! fakesink
+ * ]|
+ *  Scale a 1080p stream to 720p and 360p.
+ *
+ * Since: 1.16
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h>
+#include <string.h>
+
+#include "gstmultivideoscale.h"
+
+GST_DEBUG_CATEGORY_STATIC (multi_video_scale_debug);
+#define GST_CAT_DEFAULT multi_video_scale_debug
+
+#define DEFAULT_PROP_METHOD       GST_VIDEO_RESAMPLER_METHOD_CUBIC
+
+enum
+{
+  PROP_0,
+  PROP_METHOD
+};
+
+/* the formats that gst_video_scaler_2d() can handle, per plane */
+#define MULTI_VIDEO_SCALE_FORMATS "{ I420, YV12, Y41B, Y42B, Y444, NV12, " \
+    "NV21, NV16, NV61, NV24, GRAY8, AYUV, RGBx, BGRx, xRGB, xBGR, RGBA, " \
+    "BGRA, ARGB, ABGR, RGB, BGR, v308, IYU2, ARGB64, AYUV64 }"
+
+static GstStaticPadTemplate sink_template = GST_STATIC_PAD_TEMPLATE ("sink",
+    GST_PAD_SINK,
+    GST_PAD_ALWAYS,
+    GST_STATIC_CAPS (GST_VIDEO_CAPS_MAKE (MULTI_VIDEO_SCALE_FORMATS))
+    );
+
+static GstStaticPadTemplate src_template = GST_STATIC_PAD_TEMPLATE ("src_%u",
+    GST_PAD_SRC,
+    GST_PAD_REQUEST,
+    GST_STATIC_CAPS (GST_VIDEO_CAPS_MAKE (MULTI_VIDEO_SCALE_FORMATS))
+    );
+
+G_DEFINE_TYPE (GstMultiVideoScalePad, gst_multi_video_scale_pad, GST_TYPE_PAD);
+
+static void
+gst_multi_video_scale_pad_clear_scalers (GstMultiVideoScalePad * spad)
+{
+  guint i;
+
+  for (i = 0; i < GST_VIDEO_MAX_PLANES; i++) {
+    if (spad->hscale[i])
+      gst_video_scaler_free (spad->hscale[i]);
+    spad->hscale[i] = NULL;
+    if (spad->vscale[i])
+      gst_video_scaler_free (spad->vscale[i]);
+    spad->vscale[i] = NULL;
+  }
+}
+
+static void
+gst_multi_video_scale_pad_finalize (GObject * object)
+{
+  gst_multi_video_scale_pad_clear_scalers (GST_MULTI_VIDEO_SCALE_PAD (object));
+
+  G_OBJECT_CLASS (gst_multi_video_scale_pad_parent_class)->finalize (object);
+}
+
+static void
+gst_multi_video_scale_pad_class_init (GstMultiVideoScalePadClass * klass)
+{
+  GObjectClass *gobject_class = (GObjectClass *) klass;
+
+  gobject_class->finalize = gst_multi_video_scale_pad_finalize;
+}
+
+static void
+gst_multi_video_scale_pad_init (GstMultiVideoScalePad * spad)
+{
+  gst_video_info_init (&spad->info);
+}
+
+#define gst_multi_video_scale_parent_class parent_class
+G_DEFINE_TYPE (GstMultiVideoScale, gst_multi_video_scale, GST_TYPE_ELEMENT);
+
+static void gst_multi_video_scale_finalize (GObject * object);
+static void gst_multi_video_scale_set_property (GObject * object,
+    guint prop_id, const GValue * value, GParamSpec * pspec);
+static void gst_multi_video_scale_get_property (GObject * object,
+    guint prop_id, GValue * value, GParamSpec * pspec);
+
+static GstPad *gst_multi_video_scale_request_new_pad (GstElement * element,
+    GstPadTemplate * templ, const gchar * name, const GstCaps * caps);
+static void gst_multi_video_scale_release_pad (GstElement * element,
+    GstPad * pad);
+static GstStateChangeReturn gst_multi_video_scale_change_state (GstElement *
+    element, GstStateChange transition);
+
+static gboolean gst_multi_video_scale_sink_event (GstPad * pad,
+    GstObject * parent, GstEvent * event);
+static gboolean gst_multi_video_scale_sink_query (GstPad * pad,
+    GstObject * parent, GstQuery * query);
+static GstFlowReturn gst_multi_video_scale_chain (GstPad * pad,
+    GstObject * parent, GstBuffer * buffer);
+
+static void
+gst_multi_video_scale_class_init (GstMultiVideoScaleClass * klass)
+{
+  GObjectClass *gobject_class = (GObjectClass *) klass;
+  GstElementClass *element_class = (GstElementClass *) klass;
+
+  GST_DEBUG_CATEGORY_INIT (multi_video_scale_debug, "multivideoscale", 0,
+      "multivideoscale element");
+
+  gobject_class->finalize = gst_multi_video_scale_finalize;
+  gobject_class->set_property = gst_multi_video_scale_set_property;
+  gobject_class->get_property = gst_multi_video_scale_get_property;
+
+  g_object_class_install_property (gobject_class, PROP_METHOD,
+      g_param_spec_enum ("method", "method", "method",
+          GST_TYPE_VIDEO_RESAMPLER_METHOD, DEFAULT_PROP_METHOD,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  gst_element_class_set_static_metadata (element_class,
+      "Multi video scaler", "Filter/Converter/Video/Scaler",
+      "Resizes video to several sizes in one pass",
+      "The GStreamer developers <gstreamer-devel@lists.freedesktop.org>");
+
+  gst_element_class_add_static_pad_template (element_class, &sink_template);
+  gst_element_class_add_static_pad_template (element_class, &src_template);
+
+  element_class->request_new_pad =
+      GST_DEBUG_FUNCPTR (gst_multi_video_scale_request_new_pad);
+  element_class->release_pad =
+      GST_DEBUG_FUNCPTR (gst_multi_video_scale_release_pad);
+  element_class->change_state =
+      GST_DEBUG_FUNCPTR (gst_multi_video_scale_change_state);
+}
+
+static void
+gst_multi_video_scale_init (GstMultiVideoScale * self)
+{
+  self->sinkpad = gst_pad_new_from_static_template (&sink_template, "sink");
+  gst_pad_set_event_function (self->sinkpad,
+      GST_DEBUG_FUNCPTR (gst_multi_video_scale_sink_event));
+  gst_pad_set_query_function (self->sinkpad,
+      GST_DEBUG_FUNCPTR (gst_multi_video_scale_sink_query));
+  gst_pad_set_chain_function (self->sinkpad,
+      GST_DEBUG_FUNCPTR (gst_multi_video_scale_chain));
+  gst_element_add_pad (GST_ELEMENT (self), self->sinkpad);
+
+  self->method = DEFAULT_PROP_METHOD;
+  self->flow_combiner = gst_flow_combiner_new ();
+  gst_video_info_init (&self->in_info);
+}
+
+static void
+gst_multi_video_scale_finalize (GObject * object)
+{
+  GstMultiVideoScale *self = GST_MULTI_VIDEO_SCALE (object);
+
+  gst_flow_combiner_free (self->flow_combiner);
+
+  G_OBJECT_CLASS (parent_class)->finalize (object);
+}
+
+static void
+gst_multi_video_scale_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec)
+{
+  GstMultiVideoScale *self = GST_MULTI_VIDEO_SCALE (object);
+
+  switch (prop_id) {
+    case PROP_METHOD:
+      GST_OBJECT_LOCK (self);
+      self->method = g_value_get_enum (value);
+      GST_OBJECT_UNLOCK (self);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+static void
+gst_multi_video_scale_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec)
+{
+  GstMultiVideoScale *self = GST_MULTI_VIDEO_SCALE (object);
+
+  switch (prop_id) {
+    case PROP_METHOD:
+      GST_OBJECT_LOCK (self);
+      g_value_set_enum (value, self->method);
+      GST_OBJECT_UNLOCK (self);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+static GList *
+gst_multi_video_scale_get_src_pads (GstMultiVideoScale * self)
+{
+  GList *pads;
+
+  GST_OBJECT_LOCK (self);
+  pads = g_list_copy_deep (GST_ELEMENT_CAST (self)->srcpads,
+      (GCopyFunc) gst_object_ref, NULL);
+  GST_OBJECT_UNLOCK (self);
+
+  return pads;
+}
+
+static GstPad *
+gst_multi_video_scale_request_new_pad (GstElement * element,
+    GstPadTemplate * templ, const gchar * name, const GstCaps * caps)
+{
+  GstMultiVideoScale *self = GST_MULTI_VIDEO_SCALE (element);
+  GstPad *pad;
+  gchar *pad_name;
+  guint id;
+
+  GST_OBJECT_LOCK (self);
+  if (name && sscanf (name, "src_%u", &id) == 1) {
+    if (id >= self->next_pad_id)
+      self->next_pad_id = id + 1;
+  } else {
+    id = self->next_pad_id++;
+  }
+  GST_OBJECT_UNLOCK (self);
+
+  pad_name = g_strdup_printf ("src_%u", id);
+  pad = g_object_new (GST_TYPE_MULTI_VIDEO_SCALE_PAD, "name", pad_name,
+      "direction", GST_PAD_SRC, "template", templ, NULL);
+  g_free (pad_name);
+
+  GST_PAD_STREAM_LOCK (self->sinkpad);
+  gst_flow_combiner_add_pad (self->flow_combiner, pad);
+  GST_PAD_STREAM_UNLOCK (self->sinkpad);
+
+  if (!gst_element_add_pad (element, pad))
+    goto add_failed;
+
+  return pad;
+
+  /* ERRORS */
+add_failed:
+  {
+    GST_WARNING_OBJECT (self, "could not add pad %s", name);
+    GST_PAD_STREAM_LOCK (self->sinkpad);
+    gst_flow_combiner_remove_pad (self->flow_combiner, pad);
+    GST_PAD_STREAM_UNLOCK (self->sinkpad);
+    gst_object_unref (pad);
+    return NULL;
+  }
+}
+
+static void
+gst_multi_video_scale_release_pad (GstElement * element, GstPad * pad)
+{
+  GstMultiVideoScale *self = GST_MULTI_VIDEO_SCALE (element);
+
+  GST_PAD_STREAM_LOCK (self->sinkpad);
+  gst_flow_combiner_remove_pad (self->flow_combiner, pad);
+  GST_PAD_STREAM_UNLOCK (self->sinkpad);
+
+  gst_pad_set_active (pad, FALSE);
+  gst_element_remove_pad (element, pad);
+}
+
+static GstVideoFormat
+get_plane_format (GstVideoFormat format, guint plane)
+{
+  switch (format) {
+    case GST_VIDEO_FORMAT_I420:
+    case GST_VIDEO_FORMAT_YV12:
+    case GST_VIDEO_FORMAT_Y41B:
+    case GST_VIDEO_FORMAT_Y42B:
+    case GST_VIDEO_FORMAT_Y444:
+      return GST_VIDEO_FORMAT_GRAY8;
+    case GST_VIDEO_FORMAT_NV12:
+    case GST_VIDEO_FORMAT_NV21:
+    case GST_VIDEO_FORMAT_NV16:
+    case GST_VIDEO_FORMAT_NV61:
+    case GST_VIDEO_FORMAT_NV24:
+      /* the interleaved chroma plane is scaled with 2 elements per pixel */
+      return plane == 0 ? GST_VIDEO_FORMAT_GRAY8 : GST_VIDEO_FORMAT_NV12;
+    default:
+      return format;
+  }
+}
+
+static void
+get_plane_size (const GstVideoInfo * info, guint plane, guint * width,
+    guint * height)
+{
+  guint comp;
+
+  for (comp = 0; comp < GST_VIDEO_INFO_N_COMPONENTS (info) - 1; comp++) {
+    if (GST_VIDEO_FORMAT_INFO_PLANE (info->finfo, comp) == plane)
+      break;
+  }
+  *width = GST_VIDEO_INFO_COMP_WIDTH (info, comp);
+  *height = GST_VIDEO_INFO_COMP_HEIGHT (info, comp);
+}
+
+/* call with the stream lock of the sinkpad */
+static gboolean
+gst_multi_video_scale_negotiate_pad (GstMultiVideoScale * self,
+    GstMultiVideoScalePad * spad)
+{
+  GstVideoInfo *in_info = &self->in_info;
+  GstVideoResamplerMethod method;
+  GstVideoScalerFlags vflags;
+  GstVideoInfo info;
+  GstCaps *filter, *caps;
+  GstStructure *s;
+  gint width, height, par_n, par_d;
+  guint i;
+
+  filter = gst_video_info_to_caps (in_info);
+  s = gst_caps_get_structure (filter, 0);
+  gst_structure_remove_fields (s, "width", "height", "pixel-aspect-ratio",
+      NULL);
+
+  caps = gst_pad_peer_query_caps (GST_PAD (spad), filter);
+  gst_caps_unref (filter);
+
+  if (gst_caps_is_empty (caps))
+    goto no_caps;
+
+  caps = gst_caps_truncate (caps);
+  caps = gst_caps_make_writable (caps);
+  s = gst_caps_get_structure (caps, 0);
+
+  gst_structure_fixate_field_nearest_int (s, "width",
+      GST_VIDEO_INFO_WIDTH (in_info));
+  gst_structure_fixate_field_nearest_int (s, "height",
+      GST_VIDEO_INFO_HEIGHT (in_info));
+  if (!gst_structure_get_int (s, "width", &width) ||
+      !gst_structure_get_int (s, "height", &height))
+    goto invalid_caps;
+
+  /* keep the display aspect ratio */
+  if (!gst_util_fraction_multiply (GST_VIDEO_INFO_PAR_N (in_info),
+          GST_VIDEO_INFO_PAR_D (in_info),
+          GST_VIDEO_INFO_WIDTH (in_info) * height,
+          GST_VIDEO_INFO_HEIGHT (in_info) * width, &par_n, &par_d)) {
+    par_n = par_d = 1;
+  }
+  if (gst_structure_has_field (s, "pixel-aspect-ratio"))
+    gst_structure_fixate_field_nearest_fraction (s, "pixel-aspect-ratio",
+        par_n, par_d);
+  else
+    gst_structure_set (s, "pixel-aspect-ratio", GST_TYPE_FRACTION, par_n,
+        par_d, NULL);
+
+  caps = gst_caps_fixate (caps);
+  if (!gst_video_info_from_caps (&info, caps))
+    goto invalid_caps;
+
+  GST_DEBUG_OBJECT (spad, "negotiated %" GST_PTR_FORMAT, caps);
+
+  gst_pad_push_event (GST_PAD (spad), gst_event_new_caps (caps));
+  gst_caps_unref (caps);
+
+  GST_OBJECT_LOCK (self);
+  method = self->method;
+  GST_OBJECT_UNLOCK (self);
+
+  vflags = GST_VIDEO_INFO_IS_INTERLACED (in_info) ?
+      GST_VIDEO_SCALER_FLAG_INTERLACED : GST_VIDEO_SCALER_FLAG_NONE;
+
+  gst_multi_video_scale_pad_clear_scalers (spad);
+  for (i = 0; i < GST_VIDEO_INFO_N_PLANES (in_info); i++) {
+    guint in_width, in_height, out_width, out_height;
+
+    get_plane_size (in_info, i, &in_width, &in_height);
+    get_plane_size (&info, i, &out_width, &out_height);
+
+    if (in_width != out_width)
+      spad->hscale[i] = gst_video_scaler_new (method,
+          GST_VIDEO_SCALER_FLAG_NONE, 0, in_width, out_width, NULL);
+    if (in_height != out_height)
+      spad->vscale[i] = gst_video_scaler_new (method, vflags, 0, in_height,
+          out_height, NULL);
+  }
+  spad->info = info;
+  spad->negotiated = TRUE;
+
+  return TRUE;
+
+  /* ERRORS */
+no_caps:
+  {
+    GST_WARNING_OBJECT (spad, "no compatible caps downstream");
+    gst_caps_unref (caps);
+    return FALSE;
+  }
+invalid_caps:
+  {
+    GST_WARNING_OBJECT (spad, "invalid caps %" GST_PTR_FORMAT, caps);
+    gst_caps_unref (caps);
+    return FALSE;
+  }
+}
+
+static gboolean
+forward_sticky_events (GstPad * pad, GstEvent ** event, gpointer user_data)
+{
+  GstMultiVideoScalePad *spad = user_data;
+  GstMultiVideoScale *self = GST_MULTI_VIDEO_SCALE (GST_OBJECT_PARENT (pad));
+
+  /* the caps are negotiated for each pad, the other events are passed on in
+   * the order they were received */
+  if (GST_EVENT_TYPE (*event) == GST_EVENT_CAPS) {
+    if (!gst_multi_video_scale_negotiate_pad (self, spad))
+      return FALSE;
+  } else if (GST_EVENT_TYPE (*event) != GST_EVENT_EOS) {
+    gst_pad_push_event (GST_PAD (spad), gst_event_ref (*event));
+  }
+  return TRUE;
+}
+
+static gboolean
+gst_multi_video_scale_sink_event (GstPad * pad, GstObject * parent,
+    GstEvent * event)
+{
+  GstMultiVideoScale *self = GST_MULTI_VIDEO_SCALE (parent);
+  GList *pads, *l;
+
+  switch (GST_EVENT_TYPE (event)) {
+    case GST_EVENT_CAPS:
+    {
+      GstCaps *caps;
+      GstVideoInfo info;
+
+      gst_event_parse_caps (event, &caps);
+      if (!gst_video_info_from_caps (&info, caps)) {
+        GST_WARNING_OBJECT (self, "invalid caps %" GST_PTR_FORMAT, caps);
+        gst_event_unref (event);
+        return FALSE;
+      }
+      self->in_info = info;
+      self->have_info = TRUE;
+
+      /* the source pads negotiate with the next buffer */
+      pads = gst_multi_video_scale_get_src_pads (self);
+      for (l = pads; l; l = l->next)
+        GST_MULTI_VIDEO_SCALE_PAD (l->data)->negotiated = FALSE;
+      g_list_free_full (pads, gst_object_unref);
+
+      gst_event_unref (event);
+      return TRUE;
+    }
+    case GST_EVENT_FLUSH_STOP:
+      gst_flow_combiner_reset (self->flow_combiner);
+      break;
+    case GST_EVENT_EOS:
+      break;
+    default:
+      if (GST_EVENT_IS_STICKY (event)) {
+        /* pads that still need to negotiate get all sticky events in order
+         * when they do */
+        pads = gst_multi_video_scale_get_src_pads (self);
+        for (l = pads; l; l = l->next) {
+          GstMultiVideoScalePad *spad = l->data;
+
+          if (spad->negotiated)
+            gst_pad_push_event (GST_PAD (spad), gst_event_ref (event));
+        }
+        g_list_free_full (pads, gst_object_unref);
+        gst_event_unref (event);
+        return TRUE;
+      }
+      break;
+  }
+  return gst_pad_event_default (pad, parent, event);
+}
+
+static gboolean
+gst_multi_video_scale_sink_query (GstPad * pad, GstObject * parent,
+    GstQuery * query)
+{
+  switch (GST_QUERY_TYPE (query)) {
+    case GST_QUERY_ALLOCATION:
+      /* all outputs have a different size, nothing to propose */
+      return FALSE;
+    default:
+      return gst_pad_query_default (pad, parent, query);
+  }
+}
+
+static GstFlowReturn
+gst_multi_video_scale_chain (GstPad * pad, GstObject * parent,
+    GstBuffer * buffer)
+{
+  GstMultiVideoScale *self = GST_MULTI_VIDEO_SCALE (parent);
+  GstFlowReturn ret = GST_FLOW_OK;
+  GstMultiVideoScalePad **spads;
+  GstVideoFrame in_frame, *out_frames;
+  GstVideoFormat format;
+  GList *pads, *l;
+  guint i, plane, n_pads, n_out = 0;
+
+  if (!self->have_info)
+    goto not_negotiated;
+
+  pads = gst_multi_video_scale_get_src_pads (self);
+  n_pads = g_list_length (pads);
+
+  spads = g_newa (GstMultiVideoScalePad *, n_pads);
+  out_frames = g_newa (GstVideoFrame, n_pads);
+
+  for (l = pads; l; l = l->next) {
+    GstMultiVideoScalePad *spad = l->data;
+    GstBuffer *outbuf;
+
+    if (!spad->negotiated) {
+      gst_pad_sticky_events_foreach (self->sinkpad, forward_sticky_events,
+          spad);
+      if (!spad->negotiated) {
+        ret = gst_flow_combiner_update_pad_flow (self->flow_combiner,
+            GST_PAD (spad), GST_FLOW_NOT_NEGOTIATED);
+        continue;
+      }
+    }
+
+    outbuf =
+        gst_buffer_new_allocate (NULL, GST_VIDEO_INFO_SIZE (&spad->info),
+        NULL);
+    gst_buffer_copy_into (outbuf, buffer,
+        GST_BUFFER_COPY_FLAGS | GST_BUFFER_COPY_TIMESTAMPS, 0, -1);
+
+    if (!gst_video_frame_map (&out_frames[n_out], &spad->info, outbuf,
+            GST_MAP_WRITE)) {
+      gst_buffer_unref (outbuf);
+      continue;
+    }
+    spads[n_out++] = spad;
+  }
+
+  if (!gst_video_frame_map (&in_frame, &self->in_info, buffer, GST_MAP_READ))
+    goto invalid_buffer;
+
+  format = GST_VIDEO_FRAME_FORMAT (&in_frame);
+
+  for (plane = 0; plane < GST_VIDEO_FRAME_N_PLANES (&in_frame); plane++) {
+    GstVideoScaler **hscale, **vscale;
+    gpointer *dest;
+    gint *dest_stride;
+    guint *width, *height;
+
+    hscale = g_newa (GstVideoScaler *, n_out);
+    vscale = g_newa (GstVideoScaler *, n_out);
+    dest = g_newa (gpointer, n_out);
+    dest_stride = g_newa (gint, n_out);
+    width = g_newa (guint, n_out);
+    height = g_newa (guint, n_out);
+
+    for (i = 0; i < n_out; i++) {
+      hscale[i] = spads[i]->hscale[plane];
+      vscale[i] = spads[i]->vscale[plane];
+      dest[i] = GST_VIDEO_FRAME_PLANE_DATA (&out_frames[i], plane);
+      dest_stride[i] = GST_VIDEO_FRAME_PLANE_STRIDE (&out_frames[i], plane);
+      get_plane_size (&spads[i]->info, plane, &width[i], &height[i]);
+    }
+
+    gst_video_scaler_2d_multi (hscale, vscale, n_out,
+        get_plane_format (format, plane),
+        GST_VIDEO_FRAME_PLANE_DATA (&in_frame, plane),
+        GST_VIDEO_FRAME_PLANE_STRIDE (&in_frame, plane), dest, dest_stride,
+        width, height);
+  }
+  gst_video_frame_unmap (&in_frame);
+  gst_buffer_unref (buffer);
+
+  for (i = 0; i < n_out; i++) {
+    GstBuffer *outbuf = out_frames[i].buffer;
+    GstFlowReturn pad_ret;
+
+    gst_video_frame_unmap (&out_frames[i]);
+    pad_ret = gst_pad_push (GST_PAD (spads[i]), outbuf);
+    ret = gst_flow_combiner_update_pad_flow (self->flow_combiner,
+        GST_PAD (spads[i]), pad_ret);
+  }
+  g_list_free_full (pads, gst_object_unref);
+
+  return ret;
+
+  /* ERRORS */
+not_negotiated:
+  {
+    GST_ELEMENT_ERROR (self, CORE, NEGOTIATION, (NULL),
+        ("received buffer before caps"));
+    gst_buffer_unref (buffer);
+    return GST_FLOW_NOT_NEGOTIATED;
+  }
+invalid_buffer:
+  {
+    GST_ELEMENT_ERROR (self, STREAM, FORMAT, (NULL),
+        ("failed to map input buffer"));
+    for (i = 0; i < n_out; i++) {
+      GstBuffer *outbuf = out_frames[i].buffer;
+
+      gst_video_frame_unmap (&out_frames[i]);
+      gst_buffer_unref (outbuf);
+    }
+    g_list_free_full (pads, gst_object_unref);
+    gst_buffer_unref (buffer);
+    return GST_FLOW_ERROR;
+  }
+}
+
+static GstStateChangeReturn
+gst_multi_video_scale_change_state (GstElement * element,
+    GstStateChange transition)
+{
+  GstMultiVideoScale *self = GST_MULTI_VIDEO_SCALE (element);
+  GstStateChangeReturn ret;
+  GList *pads, *l;
+
+  ret = GST_ELEMENT_CLASS (parent_class)->change_state (element, transition);
+
+  switch (transition) {
+    case GST_STATE_CHANGE_PAUSED_TO_READY:
+      self->have_info = FALSE;
+      gst_video_info_init (&self->in_info);
+      gst_flow_combiner_reset (self->flow_combiner);
+
+      pads = gst_multi_video_scale_get_src_pads (self);
+      for (l = pads; l; l = l->next) {
+        GstMultiVideoScalePad *spad = l->data;
+
+        spad->negotiated = FALSE;
+        gst_multi_video_scale_pad_clear_scalers (spad);
+      }
+      g_list_free_full (pads, gst_object_unref);
+      break;
+    default:
+      break;
+  }
+
+  return ret;
+}
@@ -0,0 +1,99 @@
+/* GStreamer
+ * Copyright (C) 2018 The GStreamer developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __GST_MULTI_VIDEO_SCALE_H__
+#define __GST_MULTI_VIDEO_SCALE_H__
+
+#include <gst/gst.h>
+#include <gst/base/gstflowcombiner.h>
+#include <gst/video/video.h>
+
+G_BEGIN_DECLS
+
+#define GST_TYPE_MULTI_VIDEO_SCALE \
+  (gst_multi_video_scale_get_type())
+#define GST_MULTI_VIDEO_SCALE(obj) \
+  (G_TYPE_CHECK_INSTANCE_CAST((obj),GST_TYPE_MULTI_VIDEO_SCALE,GstMultiVideoScale))
+#define GST_MULTI_VIDEO_SCALE_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_CAST((klass),GST_TYPE_MULTI_VIDEO_SCALE,GstMultiVideoScaleClass))
+#define GST_IS_MULTI_VIDEO_SCALE(obj) \
+  (G_TYPE_CHECK_INSTANCE_TYPE((obj),GST_TYPE_MULTI_VIDEO_SCALE))
+#define GST_IS_MULTI_VIDEO_SCALE_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_TYPE((klass),GST_TYPE_MULTI_VIDEO_SCALE))
+
+#define GST_TYPE_MULTI_VIDEO_SCALE_PAD \
+  (gst_multi_video_scale_pad_get_type())
+#define GST_MULTI_VIDEO_SCALE_PAD(obj) \
+  (G_TYPE_CHECK_INSTANCE_CAST((obj),GST_TYPE_MULTI_VIDEO_SCALE_PAD,GstMultiVideoScalePad))
+
+typedef struct _GstMultiVideoScale GstMultiVideoScale;
+typedef struct _GstMultiVideoScaleClass GstMultiVideoScaleClass;
+typedef struct _GstMultiVideoScalePad GstMultiVideoScalePad;
+typedef struct _GstMultiVideoScalePadClass GstMultiVideoScalePadClass;
+
+/**
+ * GstMultiVideoScalePad:
+ *
+ * Opaque data structure
+ */
+struct _GstMultiVideoScalePad {
+  GstPad pad;
+
+  /* with the stream lock of the sinkpad */
+  gboolean negotiated;
+  GstVideoInfo info;
+  GstVideoScaler *hscale[GST_VIDEO_MAX_PLANES];
+  GstVideoScaler *vscale[GST_VIDEO_MAX_PLANES];
+};
+
+struct _GstMultiVideoScalePadClass {
+  GstPadClass parent_class;
+};
+
+/**
+ * GstMultiVideoScale:
+ *
+ * Opaque data structure
+ */
+struct _GstMultiVideoScale {
+  GstElement element;
+
+  GstPad *sinkpad;
+
+  /* properties */
+  GstVideoResamplerMethod method;
+
+  /* with the stream lock of the sinkpad */
+  gboolean have_info;
+  GstVideoInfo in_info;
+  GstFlowCombiner *flow_combiner;
+
+  guint next_pad_id;
+};
+
+struct _GstMultiVideoScaleClass {
+  GstElementClass parent_class;
+};
+
+G_GNUC_INTERNAL GType gst_multi_video_scale_get_type (void);
+G_GNUC_INTERNAL GType gst_multi_video_scale_pad_get_type (void);
+
+G_END_DECLS
+
+#endif /* __GST_MULTI_VIDEO_SCALE_H__ */
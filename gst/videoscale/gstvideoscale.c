@@ -79,6 +79,7 @@
 #include <gst/video/gstvideopool.h>
 
 #include "gstvideoscale.h"
+#include "gstmultivideoscale.h"
 
 #define GST_CAT_DEFAULT video_scale_debug
 GST_DEBUG_CATEGORY_STATIC (video_scale_debug);
@@ -144,6 +145,7 @@ gst_video_scale_method_get_type (void)
     {GST_VIDEO_SCALE_SPLINE, "Spline (multi-tap)", "spline"},
     {GST_VIDEO_SCALE_CATROM, "Catmull-Rom (multi-tap)", "catrom"},
     {GST_VIDEO_SCALE_MITCHELL, "Mitchell (multi-tap)", "mitchell"},
+    {GST_VIDEO_SCALE_BOX, "Box (area average)", "box"},
     {0, NULL, NULL},
   };
 
@@ -611,6 +613,12 @@ gst_video_scale_set_info (GstVideoFilter * filter, GstCaps * in,
             GST_VIDEO_RESAMPLER_OPT_CUBIC_C, G_TYPE_DOUBLE, (gdouble) 1.0 / 3.0,
             NULL);
         break;
+      case GST_VIDEO_SCALE_BOX:
+        gst_structure_set (options,
+            GST_VIDEO_CONVERTER_OPT_RESAMPLER_METHOD,
+            GST_TYPE_VIDEO_RESAMPLER_METHOD, GST_VIDEO_RESAMPLER_METHOD_BOX,
+            NULL);
+        break;
     }
     gst_structure_set (options,
         GST_VIDEO_RESAMPLER_OPT_ENVELOPE, G_TYPE_DOUBLE, videoscale->envelope,
@@ -1153,6 +1161,9 @@ plugin_init (GstPlugin * plugin)
   if (!gst_element_register (plugin, "videoscale", GST_RANK_NONE,
           GST_TYPE_VIDEO_SCALE))
     return FALSE;
+  if (!gst_element_register (plugin, "multivideoscale", GST_RANK_NONE,
+          GST_TYPE_MULTI_VIDEO_SCALE))
+    return FALSE;
 
   GST_DEBUG_CATEGORY_INIT (video_scale_debug, "videoscale", 0,
       "videoscale element");
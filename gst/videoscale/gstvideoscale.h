@@ -51,6 +51,7 @@ G_BEGIN_DECLS
  * @GST_VIDEO_SCALE_SPLINE: use a multitap bicubic spline filter
  * @GST_VIDEO_SCALE_CATROM: use a multitap bicubic Catmull-Rom filter
  * @GST_VIDEO_SCALE_MITCHELL: use a multitap bicubic Mitchell filter
+ * @GST_VIDEO_SCALE_BOX: average the covered source pixels
  *
  * The videoscale method to use.
  */
@@ -65,7 +66,8 @@ typedef enum {
   GST_VIDEO_SCALE_HERMITE,
   GST_VIDEO_SCALE_SPLINE,
   GST_VIDEO_SCALE_CATROM,
-  GST_VIDEO_SCALE_MITCHELL
+  GST_VIDEO_SCALE_MITCHELL,
+  GST_VIDEO_SCALE_BOX
 } GstVideoScaleMethod;
 
 typedef struct _GstVideoScale GstVideoScale;
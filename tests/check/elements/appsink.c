@@ -506,6 +506,74 @@ GST_START_TEST (test_pull_with_timeout)
 
 GST_END_TEST;
 
+static GstFlowReturn
+new_samples_callback (GstAppSink * appsink, guint n_samples, gpointer user_data)
+{
+  guint *calls = user_data;
+
+  fail_unless (n_samples > 0);
+  (*calls)++;
+
+  return GST_FLOW_OK;
+}
+
+GST_START_TEST (test_pull_samples)
+{
+  GstAppSinkCallbacks callbacks = { NULL };
+  GstElement *sink;
+  GstBuffer *buffer;
+  GPtrArray *samples;
+  guint i, calls = 0;
+
+  sink = setup_appsink ();
+
+  callbacks.new_samples = new_samples_callback;
+  gst_app_sink_set_callbacks (GST_APP_SINK (sink), &callbacks, &calls, NULL);
+
+  ASSERT_SET_STATE (sink, GST_STATE_PLAYING, GST_STATE_CHANGE_ASYNC);
+
+  for (i = 0; i < 5; i++) {
+    buffer = gst_buffer_new_and_alloc (4);
+    GST_BUFFER_OFFSET (buffer) = i;
+    fail_unless (gst_pad_push (mysrcpad, buffer) == GST_FLOW_OK);
+  }
+  /* only the first buffer notifies until the queue is drained */
+  fail_unless_equals_int (calls, 1);
+
+  samples = gst_app_sink_try_pull_samples (GST_APP_SINK (sink), 3, 0);
+  fail_unless (samples != NULL);
+  fail_unless_equals_int (samples->len, 3);
+  for (i = 0; i < samples->len; i++) {
+    GstSample *sample = g_ptr_array_index (samples, i);
+
+    buffer = gst_sample_get_buffer (sample);
+    fail_unless_equals_uint64 (GST_BUFFER_OFFSET (buffer), i);
+    fail_unless (gst_sample_get_caps (sample) != NULL);
+  }
+  g_ptr_array_unref (samples);
+
+  samples = gst_app_sink_try_pull_samples (GST_APP_SINK (sink), 0, 0);
+  fail_unless (samples != NULL);
+  fail_unless_equals_int (samples->len, 2);
+  buffer = gst_sample_get_buffer (g_ptr_array_index (samples, 1));
+  fail_unless_equals_uint64 (GST_BUFFER_OFFSET (buffer), 4);
+  g_ptr_array_unref (samples);
+
+  /* drained, nothing left */
+  samples = gst_app_sink_try_pull_samples (GST_APP_SINK (sink), 0, 0);
+  fail_unless (samples == NULL);
+
+  /* the next buffer notifies again */
+  buffer = gst_buffer_new_and_alloc (4);
+  fail_unless (gst_pad_push (mysrcpad, buffer) == GST_FLOW_OK);
+  fail_unless_equals_int (calls, 2);
+
+  ASSERT_SET_STATE (sink, GST_STATE_NULL, GST_STATE_CHANGE_SUCCESS);
+  cleanup_appsink (sink);
+}
+
+GST_END_TEST;
+
 GST_START_TEST (test_pull_preroll)
 {
   GstElement *sink = NULL;
@@ -731,6 +799,7 @@ appsink_suite (void)
   tcase_add_test (tc_chain, test_buffer_list_signal);
   tcase_add_test (tc_chain, test_segment);
   tcase_add_test (tc_chain, test_pull_with_timeout);
+  tcase_add_test (tc_chain, test_pull_samples);
   tcase_add_test (tc_chain, test_query_drain);
   tcase_add_test (tc_chain, test_pull_preroll);
   tcase_add_test (tc_chain, test_do_not_care_preroll);
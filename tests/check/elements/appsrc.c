@@ -606,6 +606,149 @@ GST_START_TEST (test_appsrc_push_buffer_list)
 
 GST_END_TEST;
 
+static void
+push_timestamped_buffers (GstElement * src, guint start, guint n)
+{
+  guint i;
+
+  for (i = start; i < start + n; i++) {
+    GstBuffer *buf = gst_buffer_new_and_alloc (4);
+
+    GST_BUFFER_PTS (buf) = i * 10 * GST_MSECOND;
+    GST_BUFFER_OFFSET (buf) = i;
+    fail_unless_equals_int (gst_app_src_push_buffer (GST_APP_SRC (src), buf),
+        GST_FLOW_OK);
+  }
+}
+
+static guint64
+get_dropped (GstElement * src)
+{
+  GstStructure *stats;
+  guint64 dropped = 0;
+
+  g_object_get (src, "stats", &stats, NULL);
+  fail_unless (gst_structure_get_uint64 (stats, "dropped", &dropped));
+  gst_structure_free (stats);
+
+  return dropped;
+}
+
+GST_START_TEST (test_appsrc_leaky)
+{
+  GstElement *src;
+
+  /* drop the oldest buffers when more than 3 are queued */
+  src = gst_element_factory_make ("appsrc", NULL);
+  g_object_set (src, "max-bytes", (guint64) 0, "max-buffers", (guint64) 3,
+      "leaky-type", GST_APP_LEAKY_TYPE_DOWNSTREAM, NULL);
+
+  push_timestamped_buffers (src, 0, 5);
+  fail_unless_equals_uint64 (gst_app_src_get_current_level_buffers
+      (GST_APP_SRC (src)), 3);
+  fail_unless_equals_uint64 (get_dropped (src), 2);
+  /* buffer 1 was the last one leaving the queue, buffer 4 the last queued */
+  fail_unless_equals_uint64 (gst_app_src_get_current_level_time (GST_APP_SRC
+          (src)), 30 * GST_MSECOND);
+  gst_object_unref (src);
+
+  /* drop new buffers once 20ms are queued */
+  src = gst_element_factory_make ("appsrc", NULL);
+  g_object_set (src, "max-bytes", (guint64) 0,
+      "max-time", (guint64) 20 * GST_MSECOND,
+      "leaky-type", GST_APP_LEAKY_TYPE_UPSTREAM, NULL);
+
+  push_timestamped_buffers (src, 0, 5);
+  fail_unless_equals_uint64 (gst_app_src_get_current_level_buffers
+      (GST_APP_SRC (src)), 3);
+  fail_unless_equals_uint64 (gst_app_src_get_current_level_time (GST_APP_SRC
+          (src)), 20 * GST_MSECOND);
+  fail_unless_equals_uint64 (get_dropped (src), 2);
+  gst_object_unref (src);
+}
+
+GST_END_TEST;
+
+static GstBufferPool *downstream_pool;
+
+static gboolean
+allocation_query_func (GstPad * pad, GstObject * parent, GstQuery * query)
+{
+  if (GST_QUERY_TYPE (query) == GST_QUERY_ALLOCATION) {
+    GstCaps *caps;
+
+    gst_query_parse_allocation (query, &caps, NULL);
+    if (caps == NULL)
+      return FALSE;
+
+    gst_query_add_allocation_pool (query, downstream_pool, 1024, 0, 0);
+    return TRUE;
+  }
+  return gst_pad_query_default (pad, parent, query);
+}
+
+GST_START_TEST (test_appsrc_acquire_buffer)
+{
+  GstElement *src;
+  GstBufferPool *pool = NULL;
+  GstBuffer *buffer;
+  GstCaps *caps;
+  gint64 end_time;
+
+  downstream_pool = gst_buffer_pool_new ();
+
+  src = setup_appsrc ();
+  gst_pad_set_query_function (mysinkpad, allocation_query_func);
+
+  caps = gst_caps_from_string (SAMPLE_CAPS);
+  g_object_set (src, "caps", caps, NULL);
+  gst_caps_unref (caps);
+
+  /* not negotiated yet, falls back to the default allocator */
+  fail_unless_equals_int (gst_app_src_acquire_buffer (GST_APP_SRC (src), 512,
+          &buffer), GST_FLOW_OK);
+  fail_unless (buffer->pool == NULL);
+  fail_unless_equals_int (gst_buffer_get_size (buffer), 512);
+
+  ASSERT_SET_STATE (src, GST_STATE_PLAYING, GST_STATE_CHANGE_SUCCESS);
+
+  fail_unless_equals_int (gst_app_src_push_buffer (GST_APP_SRC (src), buffer),
+      GST_FLOW_OK);
+
+  /* wait until the allocation for the caps was done */
+  end_time = g_get_monotonic_time () + 5 * G_TIME_SPAN_SECOND;
+  while (g_get_monotonic_time () < end_time) {
+    pool = gst_base_src_get_buffer_pool (GST_BASE_SRC (src));
+    if (pool == downstream_pool)
+      break;
+    if (pool)
+      gst_object_unref (pool);
+    pool = NULL;
+    g_usleep (G_USEC_PER_SEC / 100);
+  }
+  fail_unless (pool == downstream_pool);
+  gst_object_unref (pool);
+
+  fail_unless_equals_int (gst_app_src_acquire_buffer (GST_APP_SRC (src), 512,
+          &buffer), GST_FLOW_OK);
+  fail_unless (buffer->pool == downstream_pool);
+  fail_unless_equals_int (gst_buffer_get_size (buffer), 512);
+  fail_unless_equals_int (gst_app_src_push_buffer (GST_APP_SRC (src), buffer),
+      GST_FLOW_OK);
+
+  /* too large for the pool */
+  fail_unless_equals_int (gst_app_src_acquire_buffer (GST_APP_SRC (src), 4096,
+          &buffer), GST_FLOW_OK);
+  fail_unless (buffer->pool == NULL);
+  gst_buffer_unref (buffer);
+
+  ASSERT_SET_STATE (src, GST_STATE_NULL, GST_STATE_CHANGE_SUCCESS);
+  cleanup_appsrc (src);
+  gst_object_unref (downstream_pool);
+}
+
+GST_END_TEST;
+
 static Suite *
 appsrc_suite (void)
 {
@@ -617,6 +760,8 @@ appsrc_suite (void)
   tcase_add_test (tc_chain, test_appsrc_caps_in_push_modes);
   tcase_add_test (tc_chain, test_appsrc_blocked_on_caps);
   tcase_add_test (tc_chain, test_appsrc_push_buffer_list);
+  tcase_add_test (tc_chain, test_appsrc_leaky);
+  tcase_add_test (tc_chain, test_appsrc_acquire_buffer);
 
   if (RUNNING_ON_VALGRIND)
     tcase_add_loop_test (tc_chain, test_appsrc_block_deadlock, 0, 5);
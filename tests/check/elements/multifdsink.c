@@ -141,6 +141,193 @@ GST_START_TEST (test_add_client)
 
 GST_END_TEST;
 
+static GstBuffer *
+buffer_new_split (const gchar * data)
+{
+  GstBuffer *buffer = gst_buffer_new ();
+  gsize len = strlen (data);
+
+  gst_buffer_append_memory (buffer,
+      gst_memory_new_wrapped (GST_MEMORY_FLAG_READONLY, (gpointer) data, len,
+          0, len / 2, NULL, NULL));
+  gst_buffer_append_memory (buffer,
+      gst_memory_new_wrapped (GST_MEMORY_FLAG_READONLY, (gpointer) data, len,
+          len / 2, len - len / 2, NULL, NULL));
+
+  return buffer;
+}
+
+GST_START_TEST (test_add_client_multi_memory)
+{
+  GstElement *sink;
+  GstCaps *caps;
+  int pfd[2];
+  gchar data[12];
+  gssize n, len;
+
+  sink = setup_multifdsink ();
+
+  fail_if (pipe (pfd) == -1);
+
+  ASSERT_SET_STATE (sink, GST_STATE_PLAYING, GST_STATE_CHANGE_ASYNC);
+
+  /* add the client */
+  g_signal_emit_by_name (sink, "add", pfd[1]);
+
+  caps = gst_caps_from_string ("application/x-gst-check");
+  gst_check_setup_events (mysrcpad, sink, caps, GST_FORMAT_BYTES);
+
+  /* buffers made of several memories and an empty buffer should all arrive
+   * in order */
+  fail_unless (gst_pad_push (mysrcpad,
+          buffer_new_split ("dead")) == GST_FLOW_OK);
+  fail_unless (gst_pad_push (mysrcpad, gst_buffer_new ()) == GST_FLOW_OK);
+  fail_unless (gst_pad_push (mysrcpad,
+          buffer_new_split ("beef")) == GST_FLOW_OK);
+  fail_unless (gst_pad_push (mysrcpad,
+          buffer_new_split ("cafe")) == GST_FLOW_OK);
+
+  GST_DEBUG ("reading");
+  for (n = 0; n < 12; n += len) {
+    len = read (pfd[0], data + n, 12 - n);
+    fail_if (len <= 0);
+  }
+  fail_unless (strncmp (data, "deadbeefcafe", 12) == 0);
+  wait_bytes_served (sink, 12);
+
+  GST_DEBUG ("cleaning up multifdsink");
+  ASSERT_SET_STATE (sink, GST_STATE_NULL, GST_STATE_CHANGE_SUCCESS);
+  cleanup_multifdsink (sink);
+
+  close (pfd[0]);
+  close (pfd[1]);
+  gst_caps_unref (caps);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_worker_threads)
+{
+  GstElement *sink;
+  GstCaps *caps;
+  int pfd1[2], pfd2[2];
+  gchar data[8];
+  gssize n, len;
+
+  sink = setup_multifdsink ();
+  g_object_set (sink, "worker-threads", 2, NULL);
+
+  fail_if (pipe (pfd1) == -1);
+  fail_if (pipe (pfd2) == -1);
+
+  ASSERT_SET_STATE (sink, GST_STATE_PLAYING, GST_STATE_CHANGE_ASYNC);
+
+  /* the clients end up on different workers */
+  g_signal_emit_by_name (sink, "add", pfd1[1]);
+  g_signal_emit_by_name (sink, "add", pfd2[1]);
+
+  caps = gst_caps_from_string ("application/x-gst-check");
+  gst_check_setup_events (mysrcpad, sink, caps, GST_FORMAT_BYTES);
+
+  fail_unless (gst_pad_push (mysrcpad,
+          buffer_new_split ("dead")) == GST_FLOW_OK);
+  fail_unless (gst_pad_push (mysrcpad,
+          buffer_new_split ("beef")) == GST_FLOW_OK);
+
+  GST_DEBUG ("reading");
+  for (n = 0; n < 8; n += len) {
+    len = read (pfd1[0], data + n, 8 - n);
+    fail_if (len <= 0);
+  }
+  fail_unless (strncmp (data, "deadbeef", 8) == 0);
+  for (n = 0; n < 8; n += len) {
+    len = read (pfd2[0], data + n, 8 - n);
+    fail_if (len <= 0);
+  }
+  fail_unless (strncmp (data, "deadbeef", 8) == 0);
+
+  /* removing a client while the other one keeps going */
+  g_signal_emit_by_name (sink, "remove", pfd1[1]);
+
+  fail_unless (gst_pad_push (mysrcpad,
+          buffer_new_split ("cafe")) == GST_FLOW_OK);
+  for (n = 0; n < 4; n += len) {
+    len = read (pfd2[0], data + n, 4 - n);
+    fail_if (len <= 0);
+  }
+  fail_unless (strncmp (data, "cafe", 4) == 0);
+
+  GST_DEBUG ("cleaning up multifdsink");
+  ASSERT_SET_STATE (sink, GST_STATE_NULL, GST_STATE_CHANGE_SUCCESS);
+  cleanup_multifdsink (sink);
+
+  close (pfd1[0]);
+  close (pfd1[1]);
+  close (pfd2[0]);
+  close (pfd2[1]);
+
+  gst_caps_unref (caps);
+}
+
+GST_END_TEST;
+
+#define LARGE_BUFFER_SIZE (64 * 1024)
+#define N_LARGE_BUFFERS 4
+
+/* more data than fits in a pipe, the worker has to wait for the reader
+ * between partial writes */
+GST_START_TEST (test_worker_threads_partial_writes)
+{
+  GstElement *sink;
+  GstCaps *caps;
+  GstBuffer *buffer;
+  int pfd[2];
+  guint8 *data;
+  gssize n, len;
+  gint i;
+
+  sink = setup_multifdsink ();
+  g_object_set (sink, "worker-threads", 2, NULL);
+
+  fail_if (pipe (pfd) == -1);
+
+  ASSERT_SET_STATE (sink, GST_STATE_PLAYING, GST_STATE_CHANGE_ASYNC);
+
+  g_signal_emit_by_name (sink, "add", pfd[1]);
+
+  caps = gst_caps_from_string ("application/x-gst-check");
+  gst_check_setup_events (mysrcpad, sink, caps, GST_FORMAT_BYTES);
+
+  for (i = 0; i < N_LARGE_BUFFERS; i++) {
+    buffer = gst_buffer_new_allocate (NULL, LARGE_BUFFER_SIZE, NULL);
+    gst_buffer_memset (buffer, 0, 'a' + i, LARGE_BUFFER_SIZE);
+    fail_unless (gst_pad_push (mysrcpad, buffer) == GST_FLOW_OK);
+  }
+
+  GST_DEBUG ("reading");
+  data = g_malloc (N_LARGE_BUFFERS * LARGE_BUFFER_SIZE);
+  for (n = 0; n < N_LARGE_BUFFERS * LARGE_BUFFER_SIZE; n += len) {
+    len = read (pfd[0], data + n, N_LARGE_BUFFERS * LARGE_BUFFER_SIZE - n);
+    fail_if (len <= 0);
+  }
+  for (n = 0; n < N_LARGE_BUFFERS * LARGE_BUFFER_SIZE; n++)
+    fail_unless_equals_int (data[n], 'a' + n / LARGE_BUFFER_SIZE);
+  g_free (data);
+
+  GST_DEBUG ("cleaning up multifdsink");
+  ASSERT_SET_STATE (sink, GST_STATE_NULL, GST_STATE_CHANGE_SUCCESS);
+  cleanup_multifdsink (sink);
+
+  close (pfd[0]);
+  close (pfd[1]);
+  gst_caps_unref (caps);
+}
+
+GST_END_TEST;
+
+#undef LARGE_BUFFER_SIZE
+#undef N_LARGE_BUFFERS
+
 GST_START_TEST (test_add_client_in_null_state)
 {
   GstElement *sink;
@@ -962,6 +1149,9 @@ multifdsink_suite (void)
   suite_add_tcase (s, tc_chain);
   tcase_add_test (tc_chain, test_no_clients);
   tcase_add_test (tc_chain, test_add_client);
+  tcase_add_test (tc_chain, test_add_client_multi_memory);
+  tcase_add_test (tc_chain, test_worker_threads);
+  tcase_add_test (tc_chain, test_worker_threads_partial_writes);
   tcase_add_test (tc_chain, test_add_client_in_null_state);
   tcase_add_test (tc_chain, test_streamheader);
   tcase_add_test (tc_chain, test_change_streamheader);
@@ -916,6 +916,64 @@ GST_START_TEST (test_basetransform_negotiation)
 
 GST_END_TEST;
 
+static void
+check_sink_size (GstElement * pipeline, const gchar * name, gint width,
+    gint height)
+{
+  GstElement *sink;
+  GstPad *pad;
+  GstCaps *caps;
+  GstVideoInfo info;
+
+  sink = gst_bin_get_by_name (GST_BIN (pipeline), name);
+  pad = gst_element_get_static_pad (sink, "sink");
+  caps = gst_pad_get_current_caps (pad);
+  fail_unless (caps != NULL);
+  fail_unless (gst_video_info_from_caps (&info, caps));
+  fail_unless_equals_int (GST_VIDEO_INFO_WIDTH (&info), width);
+  fail_unless_equals_int (GST_VIDEO_INFO_HEIGHT (&info), height);
+  gst_caps_unref (caps);
+  gst_object_unref (pad);
+  gst_object_unref (sink);
+}
+
+GST_START_TEST (test_multivideoscale)
+{
+  GstElement *pipeline;
+  GstBus *bus;
+  GstMessage *msg;
+
+  pipeline = gst_parse_launch ("videotestsrc num-buffers=5 ! "
+      "video/x-raw,format=I420,width=320,height=240 ! "
+      "multivideoscale name=s "
+      "s.src_0 ! video/x-raw,width=160,height=120 ! queue ! "
+      "fakesink name=sink0 "
+      "s.src_1 ! video/x-raw,width=64,height=36 ! queue ! "
+      "fakesink name=sink1 "
+      "s.src_2 ! queue ! fakesink name=sink2", NULL);
+  fail_unless (pipeline != NULL);
+
+  fail_unless (gst_element_set_state (pipeline,
+          GST_STATE_PLAYING) != GST_STATE_CHANGE_FAILURE);
+
+  bus = gst_element_get_bus (pipeline);
+  msg = gst_bus_timed_pop_filtered (bus, GST_CLOCK_TIME_NONE,
+      GST_MESSAGE_EOS | GST_MESSAGE_ERROR);
+  fail_unless_equals_int (GST_MESSAGE_TYPE (msg), GST_MESSAGE_EOS);
+  gst_message_unref (msg);
+  gst_object_unref (bus);
+
+  check_sink_size (pipeline, "sink0", 160, 120);
+  check_sink_size (pipeline, "sink1", 64, 36);
+  /* unconstrained outputs keep the input size */
+  check_sink_size (pipeline, "sink2", 320, 240);
+
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  gst_object_unref (pipeline);
+}
+
+GST_END_TEST;
+
 #endif /* !defined(VSCALE_TEST_GROUP) */
 
 static Suite *
@@ -937,6 +995,7 @@ videoscale_suite (void)
   tcase_add_test (tc_chain, test_reverse_negotiation);
 #endif
   tcase_add_test (tc_chain, test_basetransform_negotiation);
+  tcase_add_test (tc_chain, test_multivideoscale);
 #elif VSCALE_TEST_GROUP == 1
   tcase_add_test (tc_chain, test_downscale_640x480_320x240_method_0);
   tcase_add_test (tc_chain, test_downscale_640x480_320x240_method_1);
@@ -310,6 +310,38 @@ make_eac3_packet (guint8 * data, guint bytesize, guint bsid)
   memset (data + 6, 0, bytesize - 6);
 }
 
+GST_START_TEST (test_ac3_in_wav)
+{
+  GstTypeFindProbability prob;
+  const gchar *type;
+  GstCaps *caps;
+  guint8 *data;
+  gsize data_size;
+  gint i;
+
+  /* ac3 frames right after a wav header are still found as wav when the
+   * ac3 scanner returns early on the RIFF signature */
+  data_size = 44 + 4 * 512;
+  data = g_malloc0 (data_size);
+  memcpy (data, "RIFF", 4);
+  GST_WRITE_UINT32_LE (data + 4, data_size - 8);
+  memcpy (data + 8, "WAVEfmt ", 8);
+  for (i = 0; i < 4; i++)
+    make_ac3_packet (data + 44 + i * 512, 512, 8);
+
+  caps = typefind_data (data, data_size, &prob);
+
+  fail_unless (caps != NULL);
+  type = gst_structure_get_name (gst_caps_get_structure (caps, 0));
+  fail_unless_equals_string (type, "audio/x-wav");
+  fail_unless_equals_int (prob, GST_TYPE_FIND_MAXIMUM);
+
+  gst_caps_unref (caps);
+  g_free (data);
+}
+
+GST_END_TEST;
+
 GST_START_TEST (test_eac3)
 {
   GstTypeFindProbability prob;
@@ -490,6 +522,7 @@ typefindfunctions_suite (void)
   tcase_add_test (tc_chain, test_jpeg_not_ac3);
   tcase_add_test (tc_chain, test_mpegts);
   tcase_add_test (tc_chain, test_ac3);
+  tcase_add_test (tc_chain, test_ac3_in_wav);
   tcase_add_test (tc_chain, test_eac3);
   tcase_add_test (tc_chain, test_random_data);
   tcase_add_test (tc_chain, test_hls_m3u8);
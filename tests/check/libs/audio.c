@@ -29,6 +29,7 @@
 
 #include <gst/audio/audio.h>
 #include <string.h>
+#include <math.h>
 
 static GstBuffer *
 make_buffer (guint8 ** _data)
@@ -705,6 +706,270 @@ GST_START_TEST (test_fill_silence)
 
 GST_END_TEST;
 
+GST_START_TEST (test_converter_threads)
+{
+  GstAudioFormat formats[] = { GST_AUDIO_FORMAT_S16, GST_AUDIO_FORMAT_F32 };
+  gint in_rates[] = { 44100, 48000 };
+  gint channels = 6, n_frames = 4096;
+  guint f, r;
+  gint i;
+
+  for (f = 0; f < G_N_ELEMENTS (formats); f++) {
+    for (r = 0; r < G_N_ELEMENTS (in_rates); r++) {
+      GstAudioInfo in_info, out_info;
+      GstAudioConverter *serial, *threaded;
+      gpointer in[1], out_serial[1], out_threaded[1];
+      gsize out_frames;
+      gint16 *in_s16;
+
+      gst_audio_info_set_format (&in_info, formats[f], in_rates[r], channels,
+          NULL);
+      gst_audio_info_set_format (&out_info, GST_AUDIO_FORMAT_S16, 48000,
+          channels, NULL);
+
+      serial = gst_audio_converter_new (0, &in_info, &out_info, NULL);
+      threaded = gst_audio_converter_new (0, &in_info, &out_info,
+          gst_structure_new ("GstAudioConverter",
+              GST_AUDIO_CONVERTER_OPT_THREADS, G_TYPE_UINT, 4, NULL));
+      fail_unless (serial != NULL);
+      fail_unless (threaded != NULL);
+
+      in[0] = g_malloc (n_frames * GST_AUDIO_INFO_BPF (&in_info));
+      in_s16 = in[0];
+      for (i = 0; i < n_frames * channels; i++) {
+        if (formats[f] == GST_AUDIO_FORMAT_S16)
+          in_s16[i] = (i * 37) % 20000 - 10000;
+        else
+          ((gfloat *) in[0])[i] = ((i * 37) % 20000 - 10000) / 10000.0;
+      }
+
+      out_frames = gst_audio_converter_get_out_frames (serial, n_frames);
+      fail_unless_equals_int (out_frames,
+          gst_audio_converter_get_out_frames (threaded, n_frames));
+      out_serial[0] = g_malloc0 (out_frames * GST_AUDIO_INFO_BPF (&out_info));
+      out_threaded[0] = g_malloc0 (out_frames * GST_AUDIO_INFO_BPF (&out_info));
+
+      fail_unless (gst_audio_converter_samples (serial, 0, in, n_frames,
+              out_serial, out_frames));
+      fail_unless (gst_audio_converter_samples (threaded, 0, in, n_frames,
+              out_threaded, out_frames));
+      fail_unless (memcmp (out_serial[0], out_threaded[0],
+              out_frames * GST_AUDIO_INFO_BPF (&out_info)) == 0);
+
+      g_free (in[0]);
+      g_free (out_serial[0]);
+      g_free (out_threaded[0]);
+      gst_audio_converter_free (serial);
+      gst_audio_converter_free (threaded);
+    }
+  }
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_converter_threads_arena_resample)
+{
+  /* S16 goes through the generic chain, F32 only resamples */
+  GstAudioFormat formats[] = { GST_AUDIO_FORMAT_S16, GST_AUDIO_FORMAT_F32 };
+  /* growing sizes reallocate the arena, and the resample planes with it,
+   * between calls */
+  gint sizes[] = { 300, 1024, 5000, 700, 17000, 2048 };
+  gint channels = 6;
+  guint f, s;
+  gint i, pos = 0;
+
+  for (f = 0; f < G_N_ELEMENTS (formats); f++) {
+    GstAudioInfo in_info, out_info;
+    GstAudioConverter *serial, *threaded;
+
+    gst_audio_info_set_format (&in_info, formats[f], 44100, channels, NULL);
+    gst_audio_info_set_format (&out_info, formats[f], 48000, channels, NULL);
+
+    serial = gst_audio_converter_new (0, &in_info, &out_info, NULL);
+    threaded = gst_audio_converter_new (0, &in_info, &out_info,
+        gst_structure_new ("GstAudioConverter",
+            GST_AUDIO_CONVERTER_OPT_THREADS, G_TYPE_UINT, 4, NULL));
+    fail_unless (serial != NULL);
+    fail_unless (threaded != NULL);
+
+    for (s = 0; s < G_N_ELEMENTS (sizes); s++) {
+      gpointer in[1], out_serial[1], out_threaded[1];
+      gsize n_frames = sizes[s], out_frames;
+
+      in[0] = g_malloc (n_frames * GST_AUDIO_INFO_BPF (&in_info));
+      for (i = 0; i < n_frames * channels; i++, pos++) {
+        if (formats[f] == GST_AUDIO_FORMAT_S16)
+          ((gint16 *) in[0])[i] = (pos * 37) % 20000 - 10000;
+        else
+          ((gfloat *) in[0])[i] = ((pos * 37) % 20000 - 10000) / 10000.0;
+      }
+
+      out_frames = gst_audio_converter_get_out_frames (serial, n_frames);
+      fail_unless_equals_int (out_frames,
+          gst_audio_converter_get_out_frames (threaded, n_frames));
+      out_serial[0] = g_malloc0 (out_frames * GST_AUDIO_INFO_BPF (&out_info));
+      out_threaded[0] = g_malloc0 (out_frames * GST_AUDIO_INFO_BPF (&out_info));
+
+      fail_unless (gst_audio_converter_samples (serial, 0, in, n_frames,
+              out_serial, out_frames));
+      fail_unless (gst_audio_converter_samples (threaded, 0, in, n_frames,
+              out_threaded, out_frames));
+      fail_unless (memcmp (out_serial[0], out_threaded[0],
+              out_frames * GST_AUDIO_INFO_BPF (&out_info)) == 0);
+
+      g_free (in[0]);
+      g_free (out_serial[0]);
+      g_free (out_threaded[0]);
+    }
+
+    gst_audio_converter_free (serial);
+    gst_audio_converter_free (threaded);
+  }
+}
+
+GST_END_TEST;
+
+#define SIMD_IN_FRAMES 4096
+#define SIMD_CHANNELS 2
+
+static gpointer
+resample_simd (GstAudioFormat format, GstAudioResamplerFilterMode mode,
+    GstAudioResamplerFilterInterpolation interpolation, const gchar * simd,
+    gpointer in, gsize * out_frames)
+{
+  const GstAudioFormatInfo *finfo = gst_audio_format_get_info (format);
+  GstAudioResampler *resampler;
+  GstStructure *options;
+  gpointer out;
+
+  options = gst_structure_new_empty ("resampler");
+  gst_audio_resampler_options_set_quality (GST_AUDIO_RESAMPLER_METHOD_KAISER,
+      GST_AUDIO_RESAMPLER_QUALITY_DEFAULT, 44100, 48000, options);
+  gst_structure_set (options,
+      GST_AUDIO_RESAMPLER_OPT_FILTER_MODE, GST_TYPE_AUDIO_RESAMPLER_FILTER_MODE,
+      mode, GST_AUDIO_RESAMPLER_OPT_FILTER_INTERPOLATION,
+      GST_TYPE_AUDIO_RESAMPLER_FILTER_INTERPOLATION, interpolation,
+      GST_AUDIO_RESAMPLER_OPT_SIMD, G_TYPE_STRING, simd, NULL);
+
+  resampler = gst_audio_resampler_new (GST_AUDIO_RESAMPLER_METHOD_KAISER,
+      GST_AUDIO_RESAMPLER_FLAG_NONE, format, SIMD_CHANNELS, 44100, 48000,
+      options);
+  gst_structure_free (options);
+  fail_unless (resampler != NULL);
+
+  *out_frames = gst_audio_resampler_get_out_frames (resampler, SIMD_IN_FRAMES);
+  out = g_malloc0 (*out_frames * SIMD_CHANNELS *
+      GST_AUDIO_FORMAT_INFO_WIDTH (finfo) / 8);
+  gst_audio_resampler_resample (resampler, &in, SIMD_IN_FRAMES, &out,
+      *out_frames);
+  gst_audio_resampler_free (resampler);
+
+  return out;
+}
+
+static gdouble
+simd_sample (GstAudioFormat format, gpointer data, gsize i)
+{
+  switch (format) {
+    case GST_AUDIO_FORMAT_S16:
+      return ((gint16 *) data)[i] / 32768.0;
+    case GST_AUDIO_FORMAT_S32:
+      return ((gint32 *) data)[i] / 2147483648.0;
+    case GST_AUDIO_FORMAT_F32:
+      return ((gfloat *) data)[i];
+    default:
+      return ((gdouble *) data)[i];
+  }
+}
+
+GST_START_TEST (test_resampler_simd)
+{
+  GstAudioFormat formats[] = { GST_AUDIO_FORMAT_S16, GST_AUDIO_FORMAT_S32,
+    GST_AUDIO_FORMAT_F32, GST_AUDIO_FORMAT_F64
+  };
+  /* relative to full scale, the integer versions round the same way as the
+   * C code except for the filter interpolation */
+  gdouble tolerance[] = { 1e-4, 1e-4, 1e-5, 1e-9 };
+  const struct
+  {
+    GstAudioResamplerFilterMode mode;
+    GstAudioResamplerFilterInterpolation interpolation;
+  } filters[] = {
+    {GST_AUDIO_RESAMPLER_FILTER_MODE_FULL,
+        GST_AUDIO_RESAMPLER_FILTER_INTERPOLATION_NONE},
+    {GST_AUDIO_RESAMPLER_FILTER_MODE_INTERPOLATED,
+        GST_AUDIO_RESAMPLER_FILTER_INTERPOLATION_LINEAR},
+    {GST_AUDIO_RESAMPLER_FILTER_MODE_INTERPOLATED,
+        GST_AUDIO_RESAMPLER_FILTER_INTERPOLATION_CUBIC},
+  };
+  const gchar *levels[] = { "sse", "sse2", "sse41", "avx2", "avx512", "neon" };
+  guint f, m, l;
+  gsize i;
+
+  for (f = 0; f < G_N_ELEMENTS (formats); f++) {
+    gpointer in, ref, sse41, out;
+    gsize ref_frames, out_frames, sse41_frames;
+    gint bps = GST_AUDIO_FORMAT_INFO_WIDTH (gst_audio_format_get_info
+        (formats[f])) / 8;
+
+    in = g_malloc (SIMD_IN_FRAMES * SIMD_CHANNELS * bps);
+    for (i = 0; i < SIMD_IN_FRAMES * SIMD_CHANNELS; i++) {
+      gdouble v = 0.4 * sin (i * 0.031) + 0.3 * sin (i * 0.2917);
+
+      switch (formats[f]) {
+        case GST_AUDIO_FORMAT_S16:
+          ((gint16 *) in)[i] = v * 32767;
+          break;
+        case GST_AUDIO_FORMAT_S32:
+          ((gint32 *) in)[i] = v * 2147483647;
+          break;
+        case GST_AUDIO_FORMAT_F32:
+          ((gfloat *) in)[i] = v;
+          break;
+        default:
+          ((gdouble *) in)[i] = v;
+          break;
+      }
+    }
+
+    for (m = 0; m < G_N_ELEMENTS (filters); m++) {
+      ref = resample_simd (formats[f], filters[m].mode,
+          filters[m].interpolation, "c", in, &ref_frames);
+      sse41 = resample_simd (formats[f], filters[m].mode,
+          filters[m].interpolation, "sse41", in, &sse41_frames);
+
+      for (l = 0; l < G_N_ELEMENTS (levels); l++) {
+        out = resample_simd (formats[f], filters[m].mode,
+            filters[m].interpolation, levels[l], in, &out_frames);
+        fail_unless_equals_int (out_frames, ref_frames);
+
+        for (i = 0; i < out_frames * SIMD_CHANNELS; i++) {
+          gdouble diff = simd_sample (formats[f], out, i) -
+              simd_sample (formats[f], ref, i);
+
+          fail_unless (fabs (diff) <= tolerance[f],
+              "%s %s filter %u sample %" G_GSIZE_FORMAT " differs by %g",
+              levels[l], gst_audio_format_to_string (formats[f]), m, i, diff);
+        }
+
+        /* the wider integer versions give the same result as SSE4.1 */
+        if ((formats[f] == GST_AUDIO_FORMAT_S16
+                || formats[f] == GST_AUDIO_FORMAT_S32)
+            && (!strcmp (levels[l], "avx2") || !strcmp (levels[l], "avx512")))
+          fail_unless (memcmp (out, sse41,
+                  out_frames * SIMD_CHANNELS * bps) == 0);
+
+        g_free (out);
+      }
+      g_free (ref);
+      g_free (sse41);
+    }
+    g_free (in);
+  }
+}
+
+GST_END_TEST;
+
 GST_START_TEST (test_stream_align)
 {
   GstAudioStreamAlign *align;
@@ -1065,6 +1330,171 @@ GST_START_TEST (test_stream_align_reverse)
 
 GST_END_TEST;
 
+typedef GstAudioRingBuffer TestRingBuffer;
+typedef GstAudioRingBufferClass TestRingBufferClass;
+
+GType test_ring_buffer_get_type (void);
+G_DEFINE_TYPE (TestRingBuffer, test_ring_buffer, GST_TYPE_AUDIO_RING_BUFFER);
+
+static gboolean
+test_ring_buffer_device (GstAudioRingBuffer * buf)
+{
+  return TRUE;
+}
+
+static gboolean
+test_ring_buffer_acquire (GstAudioRingBuffer * buf,
+    GstAudioRingBufferSpec * spec)
+{
+  buf->size = spec->segtotal * spec->segsize;
+  buf->memory = g_malloc0 (buf->size);
+
+  return TRUE;
+}
+
+static gboolean
+test_ring_buffer_release (GstAudioRingBuffer * buf)
+{
+  g_free (buf->memory);
+  buf->memory = NULL;
+
+  return TRUE;
+}
+
+static void
+test_ring_buffer_class_init (TestRingBufferClass * klass)
+{
+  klass->open_device = test_ring_buffer_device;
+  klass->close_device = test_ring_buffer_device;
+  klass->acquire = test_ring_buffer_acquire;
+  klass->release = test_ring_buffer_release;
+  klass->start = test_ring_buffer_device;
+  klass->pause = test_ring_buffer_device;
+  klass->stop = test_ring_buffer_device;
+}
+
+static void
+test_ring_buffer_init (TestRingBuffer * buf)
+{
+}
+
+#define RINGBUFFER_SEGMENTS 24
+
+static gpointer
+ringbuffer_advance_thread (gpointer data)
+{
+  GstAudioRingBuffer *buf = data;
+  gint i;
+
+  for (i = 0; i < RINGBUFFER_SEGMENTS; i++) {
+    g_usleep (1000);
+    gst_audio_ring_buffer_advance (buf, 1);
+  }
+
+  return NULL;
+}
+
+/* writes 10 segments into a ringbuffer of 4 segments that the device
+ * advances every millisecond, so the writer has to wait for the device up to
+ * 6 times. Returns the latency histogram */
+static GstStructure *
+run_ringbuffer_handoff (gboolean lock_free, GstClockTime busy_poll_time)
+{
+  GstAudioRingBuffer *buf;
+  GstCaps *caps;
+  GThread *thread;
+  GstStructure *s;
+  gint16 samples[480] = { 0, };
+  guint64 sample = 0;
+  guint written, total = 0;
+  gint accum = 0;
+
+  buf = g_object_new (test_ring_buffer_get_type (), NULL);
+  g_object_set (buf, "lock-free", lock_free, "busy-poll-time", busy_poll_time,
+      NULL);
+
+  /* 48 samples per segment, 4 segments */
+  buf->spec.latency_time = 1000;
+  buf->spec.buffer_time = 4000;
+  caps = gst_caps_from_string ("audio/x-raw, format=S16LE, "
+      "layout=interleaved, rate=48000, channels=1");
+  fail_unless (gst_audio_ring_buffer_parse_caps (&buf->spec, caps));
+  gst_caps_unref (caps);
+
+  fail_unless (gst_audio_ring_buffer_open_device (buf));
+  fail_unless (gst_audio_ring_buffer_acquire (buf, &buf->spec));
+  fail_unless_equals_int (buf->spec.segsize, 48 * 2);
+  fail_unless_equals_int (buf->spec.segtotal, 4);
+  gst_audio_ring_buffer_may_start (buf, TRUE);
+
+  thread = g_thread_new ("advance", ringbuffer_advance_thread, buf);
+
+  while (total < G_N_ELEMENTS (samples)) {
+    written = gst_audio_ring_buffer_commit (buf, &sample,
+        (guint8 *) (samples + total), G_N_ELEMENTS (samples) - total,
+        G_N_ELEMENTS (samples) - total, &accum);
+    fail_unless (written > 0);
+    total += written;
+    sample += written;
+  }
+  fail_unless_equals_int (total, G_N_ELEMENTS (samples));
+
+  g_thread_join (thread);
+
+  g_object_get (buf, "latency-histogram", &s, NULL);
+  fail_unless (s != NULL);
+
+  fail_unless (gst_audio_ring_buffer_stop (buf));
+  fail_unless (gst_audio_ring_buffer_release (buf));
+  fail_unless (gst_audio_ring_buffer_close_device (buf));
+  gst_object_unref (buf);
+
+  return s;
+}
+
+/* only the handoffs where the writer waited are counted, and with the device
+ * advancing every millisecond none of them should take anywhere near the
+ * last bucket (more than 16ms). Returns the number of handoffs that took
+ * less than 2^@fast_bucket microseconds */
+static guint
+check_handoff_histogram (GstStructure * s, guint fast_bucket)
+{
+  const GValue *histogram;
+  guint i, n, count = 0, fast = 0;
+
+  histogram = gst_structure_get_value (s, "histogram");
+  fail_unless (histogram != NULL);
+  fail_unless_equals_int (gst_value_array_get_size (histogram), 16);
+
+  for (i = 0; i < 16; i++) {
+    n = g_value_get_uint (gst_value_array_get_value (histogram, i));
+    count += n;
+    if (i <= fast_bucket)
+      fast += n;
+  }
+  fail_unless_equals_int (g_value_get_uint (gst_value_array_get_value
+          (histogram, 15)), 0);
+  fail_unless (count >= 1 && count <= 6, "%u handoffs", count);
+
+  gst_structure_free (s);
+
+  return fast;
+}
+
+GST_START_TEST (test_ringbuffer_lock_free)
+{
+  /* blocking on the condition variable in both modes */
+  check_handoff_histogram (run_ringbuffer_handoff (FALSE, 0), 15);
+  check_handoff_histogram (run_ringbuffer_handoff (TRUE, 0), 15);
+
+  /* spinning for longer than a segment, the writer never blocks and
+   * notices at least one of the advances within 64us */
+  fail_unless (check_handoff_histogram (run_ringbuffer_handoff (TRUE,
+              20 * GST_MSECOND), 6) >= 1);
+}
+
+GST_END_TEST;
+
 static Suite *
 audio_suite (void)
 {
@@ -1092,8 +1522,12 @@ audio_suite (void)
   tcase_add_test (tc_chain, test_audio_format_s8);
   tcase_add_test (tc_chain, test_audio_format_u8);
   tcase_add_test (tc_chain, test_fill_silence);
+  tcase_add_test (tc_chain, test_converter_threads);
+  tcase_add_test (tc_chain, test_converter_threads_arena_resample);
+  tcase_add_test (tc_chain, test_resampler_simd);
   tcase_add_test (tc_chain, test_stream_align);
   tcase_add_test (tc_chain, test_stream_align_reverse);
+  tcase_add_test (tc_chain, test_ringbuffer_lock_free);
 
   return s;
 }
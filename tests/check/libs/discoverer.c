@@ -245,6 +245,73 @@ GST_START_TEST (test_disco_missing_plugins)
 
 GST_END_TEST;
 
+typedef struct
+{
+  GMainLoop *loop;
+  guint n_discovered;
+  gboolean finished;
+} AsyncData;
+
+static void
+async_discovered_cb (GstDiscoverer * dc, GstDiscovererInfo * info,
+    GError * err, AsyncData * data)
+{
+  fail_unless (info != NULL);
+  fail_unless (gst_discoverer_info_get_uri (info) != NULL);
+  data->n_discovered++;
+}
+
+static void
+async_finished_cb (GstDiscoverer * dc, AsyncData * data)
+{
+  data->finished = TRUE;
+  g_main_loop_quit (data->loop);
+}
+
+GST_START_TEST (test_disco_async_concurrent)
+{
+  const gchar *files[] = { "theora-vorbis.ogg", "test.mp3", "test.mkv",
+    "partialframe.mjpeg", "theora-vorbis.ogg"
+  };
+  AsyncData data = { NULL, };
+  GError *err = NULL;
+  GstDiscoverer *dc;
+  gchar *uri, *path;
+  guint i;
+
+  dc = gst_discoverer_new (5 * GST_SECOND, &err);
+  fail_unless (dc != NULL);
+  fail_unless (err == NULL);
+  g_object_set (dc, "max-concurrent", 3, NULL);
+
+  data.loop = g_main_loop_new (NULL, FALSE);
+  g_signal_connect (dc, "discovered", G_CALLBACK (async_discovered_cb),
+      &data);
+  g_signal_connect (dc, "finished", G_CALLBACK (async_finished_cb), &data);
+
+  gst_discoverer_start (dc);
+
+  for (i = 0; i < G_N_ELEMENTS (files); i++) {
+    path = g_build_filename (GST_TEST_FILES_PATH, files[i], NULL);
+    uri = gst_filename_to_uri (path, &err);
+    g_free (path);
+    fail_unless (err == NULL);
+    fail_unless (gst_discoverer_discover_uri_async (dc, uri));
+    g_free (uri);
+  }
+
+  g_main_loop_run (data.loop);
+
+  fail_unless (data.finished);
+  fail_unless_equals_int (data.n_discovered, G_N_ELEMENTS (files));
+
+  gst_discoverer_stop (dc);
+  g_main_loop_unref (data.loop);
+  g_object_unref (dc);
+}
+
+GST_END_TEST;
+
 static Suite *
 discoverer_suite (void)
 {
@@ -264,6 +331,7 @@ discoverer_suite (void)
   tcase_add_test (tc_chain, test_disco_sync_reuse_timeout);
   tcase_add_test (tc_chain, test_disco_missing_plugins);
   tcase_add_test (tc_chain, test_disco_serializing);
+  tcase_add_test (tc_chain, test_disco_async_concurrent);
   return s;
 }
 
@@ -25,6 +25,7 @@
 #endif
 
 #include <gst/check/gstcheck.h>
+#include <gst/gl/gstglfuncs.h>
 
 #include <gst/gl/gl.h>
 
@@ -331,6 +332,175 @@ GST_START_TEST (test_separate_transfer)
 
 GST_END_TEST;
 
+#ifndef GL_BUFFER_IMMUTABLE_STORAGE
+#define GL_BUFFER_IMMUTABLE_STORAGE 0x821F
+#endif
+#ifndef GL_BUFFER_MAPPED
+#define GL_BUFFER_MAPPED 0x88BC
+#endif
+
+struct buffer_state
+{
+  GstGLBuffer *buffer;
+  GLint immutable;
+  GLint mapped;
+};
+
+static void
+_get_buffer_state (GstGLContext * context, struct buffer_state *state)
+{
+  const GstGLFuncs *gl = context->gl_vtable;
+
+  state->immutable = state->mapped = 0;
+  if (!gl->BufferStorage)
+    return;
+
+  gl->BindBuffer (state->buffer->target, state->buffer->id);
+  gl->GetBufferParameteriv (state->buffer->target,
+      GL_BUFFER_IMMUTABLE_STORAGE, &state->immutable);
+  gl->GetBufferParameteriv (state->buffer->target, GL_BUFFER_MAPPED,
+      &state->mapped);
+  gl->BindBuffer (state->buffer->target, 0);
+}
+
+/* persistent buffers have immutable storage and stay mapped outside of any
+ * map() */
+static gboolean
+buffer_is_persistent (GstGLBuffer * buffer)
+{
+  struct buffer_state state = { buffer, 0, 0 };
+
+  gst_gl_context_thread_add (context,
+      (GstGLContextThreadFunc) _get_buffer_state, &state);
+
+  return state.immutable && state.mapped;
+}
+
+GST_START_TEST (test_persistent_buffer)
+{
+  GstGLBaseMemoryAllocator *base_mem_alloc;
+  GstGLBufferAllocationParams *params;
+  GstAllocator *buf_allocator;
+  GstMemory *mem, *copy;
+  GstMapInfo info;
+  gsize j;
+  gint i;
+
+  gst_gl_buffer_init_once ();
+
+  buf_allocator = gst_allocator_find (GST_GL_BUFFER_ALLOCATOR_NAME);
+  fail_if (buf_allocator == NULL);
+  base_mem_alloc = GST_GL_BASE_MEMORY_ALLOCATOR (buf_allocator);
+
+  /* falls back to a normal buffer if persistent mapping isn't supported */
+  params = gst_gl_buffer_allocation_params_new (context, 4096, NULL,
+      GL_ARRAY_BUFFER, GL_STREAM_DRAW);
+  params->parent.alloc_flags |=
+      GST_GL_ALLOCATION_PARAMS_ALLOC_FLAG_BUFFER_PERSISTENT;
+  mem = (GstMemory *) gst_gl_base_memory_alloc (base_mem_alloc,
+      (GstGLAllocationParams *) params);
+  gst_gl_allocation_params_free ((GstGLAllocationParams *) params);
+  fail_if (mem == NULL);
+  fail_unless_equals_int (buffer_is_persistent ((GstGLBuffer *) mem),
+      context->gl_vtable->BufferStorage != NULL);
+
+  /* reuse the same buffer a few times like a pool would */
+  for (i = 0; i < 3; i++) {
+    fail_unless (gst_memory_map (mem, &info, GST_MAP_WRITE));
+    memset (info.data, i + 1, info.size);
+    gst_memory_unmap (mem, &info);
+
+    /* GPU access, inserts a fence for the next CPU map */
+    fail_unless (gst_memory_map (mem, &info, GST_MAP_READ | GST_MAP_GL));
+    gst_memory_unmap (mem, &info);
+
+    /* copies on the GPU if possible */
+    copy = gst_memory_copy (mem, 0, -1);
+    fail_if (copy == NULL);
+    fail_unless_equals_int (buffer_is_persistent ((GstGLBuffer *) copy),
+        context->gl_vtable->BufferStorage != NULL);
+
+    fail_unless (gst_memory_map (copy, &info, GST_MAP_READ));
+    for (j = 0; j < info.size; j++)
+      fail_unless_equals_int (info.data[j], i + 1);
+    gst_memory_unmap (copy, &info);
+    gst_memory_unref (copy);
+  }
+
+  gst_memory_unref (mem);
+  gst_object_unref (buf_allocator);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_persistent_pbo)
+{
+  GstGLBaseMemoryAllocator *base_mem_alloc;
+  GstGLVideoAllocationParams *params;
+  GstGLMemoryPBO *pbo_mem;
+  GstVideoInfo v_info;
+  GstMapInfo info;
+  guint8 *data;
+  gint i;
+
+  base_mem_alloc =
+      GST_GL_BASE_MEMORY_ALLOCATOR (gst_allocator_find
+      (GST_GL_MEMORY_PBO_ALLOCATOR_NAME));
+  fail_if (base_mem_alloc == NULL);
+
+  gst_video_info_set_format (&v_info, GST_VIDEO_FORMAT_RGBA, 16, 16);
+
+  /* only on request */
+  params = gst_gl_video_allocation_params_new (context, NULL, &v_info, 0,
+      NULL, GST_GL_TEXTURE_TARGET_2D, GST_GL_RGBA);
+  pbo_mem = (GstGLMemoryPBO *) gst_gl_base_memory_alloc (base_mem_alloc,
+      (GstGLAllocationParams *) params);
+  fail_if (pbo_mem == NULL);
+  if (pbo_mem->pbo)
+    fail_if (buffer_is_persistent (pbo_mem->pbo));
+  gst_memory_unref (GST_MEMORY_CAST (pbo_mem));
+
+  params->parent.alloc_flags |=
+      GST_GL_ALLOCATION_PARAMS_ALLOC_FLAG_BUFFER_PERSISTENT;
+  pbo_mem = (GstGLMemoryPBO *) gst_gl_base_memory_alloc (base_mem_alloc,
+      (GstGLAllocationParams *) params);
+  gst_gl_allocation_params_free ((GstGLAllocationParams *) params);
+  fail_if (pbo_mem == NULL);
+  if (!pbo_mem->pbo) {
+    GST_INFO ("no pbo support, skipping");
+    goto out;
+  }
+  fail_unless_equals_int (buffer_is_persistent (pbo_mem->pbo),
+      context->gl_vtable->BufferStorage != NULL);
+
+  /* CPU writes go straight into the persistent mapping */
+  for (i = 0; i < 3; i++) {
+    fail_unless (gst_memory_map (GST_MEMORY_CAST (pbo_mem), &info,
+            GST_MAP_WRITE));
+    data = info.data;
+    memset (data, 0x10 * (i + 1), info.size);
+    gst_memory_unmap (GST_MEMORY_CAST (pbo_mem), &info);
+
+    /* pbo -> texture, fences the pbo for the next CPU map */
+    fail_unless (gst_memory_map (GST_MEMORY_CAST (pbo_mem), &info,
+            GST_MAP_READ | GST_MAP_GL));
+    gst_memory_unmap (GST_MEMORY_CAST (pbo_mem), &info);
+
+    fail_unless (gst_memory_map (GST_MEMORY_CAST (pbo_mem), &info,
+            GST_MAP_READ));
+    fail_unless_equals_int (((guint8 *) info.data)[0], 0x10 * (i + 1));
+    if (context->gl_vtable->BufferStorage)
+      fail_unless (info.data == data);
+    gst_memory_unmap (GST_MEMORY_CAST (pbo_mem), &info);
+  }
+
+out:
+  gst_memory_unref (GST_MEMORY_CAST (pbo_mem));
+  gst_object_unref (base_mem_alloc);
+}
+
+GST_END_TEST;
+
 static Suite *
 gst_gl_memory_suite (void)
 {
@@ -342,6 +512,8 @@ gst_gl_memory_suite (void)
   tcase_add_test (tc_chain, test_basic);
   tcase_add_test (tc_chain, test_transfer);
   tcase_add_test (tc_chain, test_separate_transfer);
+  tcase_add_test (tc_chain, test_persistent_buffer);
+  tcase_add_test (tc_chain, test_persistent_pbo);
 
   return s;
 }
@@ -414,6 +414,73 @@ GST_START_TEST (test_upload_gl_memory)
 
 GST_END_TEST;
 
+static void
+check_texture_data (GstBuffer * buffer, const guint8 * data)
+{
+  GstMemory *copy;
+  GstMapInfo map_info;
+  gint j;
+
+  /* copies the texture on the GPU so the result is downloaded from the
+   * texture rather than read back from the pbo */
+  copy = gst_memory_copy (gst_buffer_peek_memory (buffer, 0), 0, -1);
+  fail_if (copy == NULL);
+  fail_unless (gst_memory_map (copy, &map_info, GST_MAP_READ));
+  for (j = 0; j < WIDTH * HEIGHT * 4; j++)
+    fail_unless_equals_int (((guint8 *) map_info.data)[j], data[j]);
+  gst_memory_unmap (copy, &map_info);
+  gst_memory_unref (copy);
+}
+
+GST_START_TEST (test_upload_data_persistent)
+{
+  GstCaps *in_caps, *out_caps;
+  GstBuffer *inbuf, *outbuf;
+  GstMemory *first_mem = NULL;
+  guint8 data[2][WIDTH * HEIGHT * 4];
+  gint i, j;
+
+  for (j = 0; j < WIDTH * HEIGHT * 4; j++) {
+    data[0][j] = rgba_data[j];
+    data[1][j] = ~rgba_data[j];
+  }
+
+  in_caps = gst_caps_from_string ("video/x-raw,format=RGBA,"
+      "width=10,height=10");
+  out_caps = gst_caps_from_string ("video/x-raw(memory:GLMemory),"
+      "format=RGBA,width=10,height=10");
+
+  gst_gl_upload_set_persistent_buffers (upload, TRUE);
+  gst_gl_upload_set_caps (upload, in_caps, out_caps);
+
+  for (i = 0; i < 4; i++) {
+    inbuf = gst_buffer_new_wrapped_full (0, data[i % 2], WIDTH * HEIGHT * 4,
+        0, WIDTH * HEIGHT * 4, NULL, NULL);
+
+    fail_unless_equals_int (gst_gl_upload_perform_with_buffer (upload, inbuf,
+            &outbuf), GST_GL_UPLOAD_DONE);
+    fail_unless (GST_IS_BUFFER (outbuf));
+    /* comes from the ring, not wrapped around the input */
+    fail_unless (outbuf->pool != NULL);
+    fail_unless (gst_buffer_get_gl_sync_meta (outbuf) != NULL);
+
+    /* the previous output was released so its buffer is reused */
+    if (first_mem)
+      fail_unless (gst_buffer_peek_memory (outbuf, 0) == first_mem);
+    else
+      first_mem = gst_buffer_peek_memory (outbuf, 0);
+
+    check_texture_data (outbuf, data[i % 2]);
+
+    gst_buffer_unref (inbuf);
+    gst_buffer_unref (outbuf);
+  }
+
+  gst_caps_unref (in_caps);
+  gst_caps_unref (out_caps);
+}
+
+GST_END_TEST;
 
 static Suite *
 gst_gl_upload_suite (void)
@@ -425,6 +492,7 @@ gst_gl_upload_suite (void)
   tcase_add_checked_fixture (tc_chain, setup, teardown);
   tcase_add_test (tc_chain, test_upload_data);
   tcase_add_test (tc_chain, test_upload_gl_memory);
+  tcase_add_test (tc_chain, test_upload_data_persistent);
 
   return s;
 }
@@ -1137,6 +1137,196 @@ GST_START_TEST (test_rtcp_buffer_app)
 
 GST_END_TEST;
 
+GST_START_TEST (test_rtcp_writer_decode)
+{
+  guint8 data[1000];
+  GstRTCPWriter writer;
+  GstRTCPPacketInfo info[8];
+  guint n_packets = G_N_ELEMENTS (info);
+  GstBuffer *buf;
+  GstRTCPBuffer rtcp = GST_RTCP_BUFFER_INIT;
+  GstRTCPPacket packet;
+  guint32 ssrc, exthighestseq, jitter, lsr, dlsr;
+  guint8 fractionlost;
+  gint32 packetslost;
+  guint i;
+  /* SSRC, CNAME "test", end of chunk */
+  const guint8 sdes[] = { 0x44, 0x44, 0x44, 0x44, 0x01, 0x04, 't', 'e', 's',
+    't', 0x00, 0x00
+  };
+  const guint8 nack[] = { 0x00, 0x10, 0x00, 0x05 };
+
+  gst_rtcp_writer_init (&writer, data, sizeof (data));
+  fail_unless (gst_rtcp_writer_add_rr (&writer, 0x44444444));
+  for (i = 0; i < 3; i++)
+    fail_unless (gst_rtcp_writer_add_rb (&writer, 0x10000000 + i, 0x20, -5,
+            0x30000 + i, 0x40, 0x50, 0x60));
+  fail_unless (gst_rtcp_writer_add_packet (&writer, GST_RTCP_TYPE_SDES, 1,
+          sdes, sizeof (sdes)));
+  fail_unless (gst_rtcp_writer_add_fb (&writer, GST_RTCP_TYPE_RTPFB,
+          GST_RTCP_RTPFB_TYPE_NACK, 0x44444444, 0x55555555, nack,
+          sizeof (nack)));
+  fail_unless (gst_rtcp_writer_add_fb (&writer, GST_RTCP_TYPE_PSFB,
+          GST_RTCP_PSFB_TYPE_PLI, 0x44444444, 0x55555555, NULL, 0));
+  fail_unless_equals_int (writer.offset, 8 + 3 * 24 + 16 + 16 + 12);
+
+  /* report blocks can only be added to SR and RR packets */
+  ASSERT_CRITICAL (gst_rtcp_writer_add_rb (&writer, 0, 0, 0, 0, 0, 0, 0));
+
+  /* the legacy API agrees */
+  fail_unless (gst_rtcp_buffer_validate_data (data, writer.offset));
+  buf = gst_rtcp_buffer_new_copy_data (data, writer.offset);
+  gst_rtcp_buffer_map (buf, GST_MAP_READ, &rtcp);
+  fail_unless_equals_int (gst_rtcp_buffer_get_packet_count (&rtcp), 4);
+  fail_unless (gst_rtcp_buffer_get_first_packet (&rtcp, &packet));
+  fail_unless_equals_int (gst_rtcp_packet_get_type (&packet),
+      GST_RTCP_TYPE_RR);
+  fail_unless_equals_int (gst_rtcp_packet_get_rb_count (&packet), 3);
+  gst_rtcp_packet_get_rb (&packet, 2, &ssrc, &fractionlost, &packetslost,
+      &exthighestseq, &jitter, &lsr, &dlsr);
+  fail_unless_equals_int (ssrc, 0x10000002);
+  fail_unless_equals_int (packetslost, -5);
+  fail_unless_equals_int (exthighestseq, 0x30002);
+  gst_rtcp_buffer_unmap (&rtcp);
+  gst_buffer_unref (buf);
+
+  fail_unless (gst_rtcp_buffer_decode_data (data, writer.offset, FALSE, info,
+          &n_packets));
+  fail_unless_equals_int (n_packets, 4);
+
+  fail_unless_equals_int (info[0].type, GST_RTCP_TYPE_RR);
+  fail_unless_equals_int (info[0].offset, 0);
+  fail_unless_equals_int (info[0].size, 8 + 3 * 24);
+  fail_unless_equals_int (info[0].ssrc, 0x44444444);
+  fail_unless_equals_int (info[0].rb_offset, 8);
+  fail_unless_equals_int (info[0].rb_count, 3);
+  fail_unless_equals_int (info[0].data_size, 0);
+  for (i = 0; i < 3; i++) {
+    gst_rtcp_packet_info_get_rb (&info[0], data, i, &ssrc, &fractionlost,
+        &packetslost, &exthighestseq, &jitter, &lsr, &dlsr);
+    fail_unless_equals_int (ssrc, 0x10000000 + i);
+    fail_unless_equals_int (fractionlost, 0x20);
+    fail_unless_equals_int (packetslost, -5);
+    fail_unless_equals_int (exthighestseq, 0x30000 + i);
+    fail_unless_equals_int (jitter, 0x40);
+    fail_unless_equals_int (lsr, 0x50);
+    fail_unless_equals_int (dlsr, 0x60);
+  }
+
+  fail_unless_equals_int (info[1].type, GST_RTCP_TYPE_SDES);
+  fail_unless_equals_int (info[1].count, 1);
+  fail_unless_equals_int (info[1].ssrc, 0x44444444);
+  fail_unless_equals_int (info[1].data_size, sizeof (sdes));
+  fail_unless (memcmp (data + info[1].data_offset, sdes, sizeof (sdes)) == 0);
+
+  fail_unless_equals_int (info[2].type, GST_RTCP_TYPE_RTPFB);
+  fail_unless_equals_int (info[2].count, GST_RTCP_RTPFB_TYPE_NACK);
+  fail_unless_equals_int (info[2].ssrc, 0x44444444);
+  fail_unless_equals_int (info[2].media_ssrc, 0x55555555);
+  fail_unless_equals_int (info[2].data_size, sizeof (nack));
+  fail_unless (memcmp (data + info[2].data_offset, nack, sizeof (nack)) == 0);
+
+  fail_unless_equals_int (info[3].type, GST_RTCP_TYPE_PSFB);
+  fail_unless_equals_int (info[3].count, GST_RTCP_PSFB_TYPE_PLI);
+  fail_unless_equals_int (info[3].offset + info[3].size, writer.offset);
+  fail_unless_equals_int (info[3].data_size, 0);
+
+  /* not enough descriptors */
+  n_packets = 3;
+  fail_if (gst_rtcp_buffer_decode_data (data, writer.offset, FALSE, info,
+          &n_packets));
+  fail_unless_equals_int (n_packets, 0);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_rtcp_writer_sr)
+{
+  guint8 data[28 + 24];
+  GstRTCPWriter writer;
+  GstRTCPPacketInfo info[1];
+  guint n_packets = G_N_ELEMENTS (info);
+
+  gst_rtcp_writer_init (&writer, data, sizeof (data));
+  fail_unless (gst_rtcp_writer_add_sr (&writer, 0x44444444,
+          G_GUINT64_CONSTANT (0x1111111122222222), 0x33333333, 10, 1000));
+  fail_unless (gst_rtcp_writer_add_rb (&writer, 0x55555555, 0, 0, 0, 0, 0, 0));
+  /* full, the writer is left untouched */
+  fail_if (gst_rtcp_writer_add_rb (&writer, 0x55555555, 0, 0, 0, 0, 0, 0));
+  fail_if (gst_rtcp_writer_add_rr (&writer, 0x44444444));
+  fail_unless_equals_int (writer.offset, sizeof (data));
+
+  fail_unless (gst_rtcp_buffer_decode_data (data, writer.offset, FALSE, info,
+          &n_packets));
+  fail_unless_equals_int (n_packets, 1);
+  fail_unless_equals_int (info[0].type, GST_RTCP_TYPE_SR);
+  fail_unless_equals_int (info[0].ssrc, 0x44444444);
+  fail_unless_equals_uint64 (info[0].ntptime,
+      G_GUINT64_CONSTANT (0x1111111122222222));
+  fail_unless_equals_int (info[0].rtptime, 0x33333333);
+  fail_unless_equals_int (info[0].packet_count, 10);
+  fail_unless_equals_int (info[0].octet_count, 1000);
+  fail_unless_equals_int (info[0].rb_offset, 28);
+  fail_unless_equals_int (info[0].rb_count, 1);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_rtcp_decode_invalid)
+{
+  GstRTCPPacketInfo info[4];
+  guint n_packets;
+  /* RR with 1 report block but length for 0 */
+  guint8 short_rr[] = { 0x81, 0xc9, 0x00, 0x01, 0x12, 0x34, 0x56, 0x78 };
+  /* RR followed by a padded PLI */
+  guint8 padded[] = {
+    0x80, 0xc9, 0x00, 0x01, 0x12, 0x34, 0x56, 0x78,
+    0xa1, 0xce, 0x00, 0x03, 0x12, 0x34, 0x56, 0x78,
+    0x9a, 0xbc, 0xde, 0xf0, 0x00, 0x00, 0x00, 0x04
+  };
+  /* starts with a PLI */
+  guint8 pli[] = {
+    0x81, 0xce, 0x00, 0x02, 0x12, 0x34, 0x56, 0x78,
+    0x9a, 0xbc, 0xde, 0xf0
+  };
+
+  n_packets = G_N_ELEMENTS (info);
+  fail_if (gst_rtcp_buffer_decode_data (short_rr, sizeof (short_rr), FALSE,
+          info, &n_packets));
+  fail_unless_equals_int (n_packets, 0);
+
+  n_packets = G_N_ELEMENTS (info);
+  fail_unless (gst_rtcp_buffer_decode_data (padded, sizeof (padded), FALSE,
+          info, &n_packets));
+  fail_unless_equals_int (n_packets, 2);
+  fail_unless (info[1].padding);
+  fail_unless_equals_int (info[1].size, 16);
+  fail_unless_equals_int (info[1].data_size, 0);
+
+  /* truncated */
+  n_packets = G_N_ELEMENTS (info);
+  fail_if (gst_rtcp_buffer_decode_data (padded, sizeof (padded) - 4, FALSE,
+          info, &n_packets));
+
+  /* wrong padding */
+  padded[sizeof (padded) - 1] = 0x03;
+  n_packets = G_N_ELEMENTS (info);
+  fail_if (gst_rtcp_buffer_decode_data (padded, sizeof (padded), FALSE,
+          info, &n_packets));
+
+  /* feedback packets are only allowed first in reduced size RTCP */
+  n_packets = G_N_ELEMENTS (info);
+  fail_if (gst_rtcp_buffer_decode_data (pli, sizeof (pli), FALSE, info,
+          &n_packets));
+  n_packets = G_N_ELEMENTS (info);
+  fail_unless (gst_rtcp_buffer_decode_data (pli, sizeof (pli), TRUE, info,
+          &n_packets));
+  fail_unless_equals_int (n_packets, 1);
+  fail_unless_equals_int (info[0].media_ssrc, 0x9abcdef0);
+}
+
+GST_END_TEST;
+
 GST_START_TEST (test_rtp_ntp64_extension)
 {
   GstBuffer *buf;
@@ -1463,6 +1653,9 @@ rtp_suite (void)
   tcase_add_test (tc_chain, test_rtcp_validate_reduced_with_padding);
   tcase_add_test (tc_chain, test_rtcp_buffer_profile_specific_extension);
   tcase_add_test (tc_chain, test_rtcp_buffer_app);
+  tcase_add_test (tc_chain, test_rtcp_writer_decode);
+  tcase_add_test (tc_chain, test_rtcp_writer_sr);
+  tcase_add_test (tc_chain, test_rtcp_decode_invalid);
 
   tcase_add_test (tc_chain, test_rtp_ntp64_extension);
   tcase_add_test (tc_chain, test_rtp_ntp56_extension);
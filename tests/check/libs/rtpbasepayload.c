@@ -48,6 +48,9 @@ typedef struct _GstRtpDummyPayClass GstRtpDummyPayClass;
 struct _GstRtpDummyPay
 {
   GstRTPBasePayload payload;
+
+  /* allocate the packets from the pool of the base class */
+  gboolean use_pool;
 };
 
 struct _GstRtpDummyPayClass
@@ -121,7 +124,10 @@ gst_rtp_dummy_pay_handle_buffer (GstRTPBasePayload * pay, GstBuffer * buffer)
     }
   }
 
-  paybuffer = gst_rtp_buffer_new_allocate (0, 0, 0);
+  if (GST_RTP_DUMMY_PAY (pay)->use_pool)
+    paybuffer = gst_rtp_base_payload_allocate_output_buffer (pay, 0, 0, 0);
+  else
+    paybuffer = gst_rtp_buffer_new_allocate (0, 0, 0);
 
   GST_BUFFER_PTS (paybuffer) = GST_BUFFER_PTS (buffer);
   GST_BUFFER_OFFSET (paybuffer) = GST_BUFFER_OFFSET (buffer);
@@ -1775,6 +1781,193 @@ GST_START_TEST (rtp_base_payload_property_stats_test)
 
 GST_END_TEST;
 
+static void
+validate_pool_stats (State * state, guint64 hits, guint64 misses)
+{
+  GstStructure *stats;
+
+  g_object_get (state->element, "stats", &stats, NULL);
+
+  fail_unless_equals_uint64 (g_value_get_uint64 (gst_structure_get_value (stats,
+              "pool-hits")), hits);
+  fail_unless_equals_uint64 (g_value_get_uint64 (gst_structure_get_value (stats,
+              "pool-misses")), misses);
+
+  gst_structure_free (stats);
+}
+
+/* make the dummy payloader allocate its packets from the pool of the base
+ * class. it appends the input buffer to the RTP header. the first packet needs new
+ * memory, after it has been released downstream the next packets should reuse
+ * it without the payload of the previous packet. a packet that does not fit
+ * in the MTU is allocated outside of the pool.
+ */
+GST_START_TEST (rtp_base_payload_pool_test)
+{
+  State *state;
+  GstBuffer *buffer;
+  GstRTPBuffer rtp = GST_RTP_BUFFER_INIT;
+  guint i;
+
+  state = create_payloader ("application/x-rtp", &sinktmpl, NULL);
+  GST_RTP_DUMMY_PAY (state->element)->use_pool = TRUE;
+
+  set_state (state, GST_STATE_PLAYING);
+
+  for (i = 0; i < 3; i++) {
+    push_buffer (state, "pts", i * GST_SECOND, NULL);
+    validate_pool_stats (state, i, 1);
+
+    validate_buffers_received (1);
+    buffer = GST_BUFFER (buffers->data);
+    fail_unless_equals_int (gst_buffer_n_memory (buffer), 2);
+    fail_unless_equals_int (gst_buffer_get_size (buffer), 24);
+    validate_buffer (0, "pts", i * GST_SECOND, NULL);
+    gst_check_drop_buffers ();
+  }
+
+  buffer = gst_rtp_base_payload_allocate_output_buffer (GST_RTP_BASE_PAYLOAD
+      (state->element), 2000, 0, 0);
+  fail_unless_equals_int (gst_buffer_get_size (buffer), 2012);
+  validate_pool_stats (state, 2, 2);
+  gst_buffer_unref (buffer);
+
+  buffer = gst_rtp_base_payload_allocate_output_buffer (GST_RTP_BASE_PAYLOAD
+      (state->element), 100, 4, 2);
+  fail_unless_equals_int (gst_buffer_get_size (buffer), 124);
+  fail_unless (gst_rtp_buffer_map (buffer, GST_MAP_READ, &rtp));
+  fail_unless_equals_int (gst_rtp_buffer_get_csrc_count (&rtp), 2);
+  fail_unless (gst_rtp_buffer_get_padding (&rtp));
+  fail_unless_equals_int (gst_rtp_buffer_get_payload_len (&rtp), 100);
+  gst_rtp_buffer_unmap (&rtp);
+  validate_pool_stats (state, 3, 2);
+  gst_buffer_unref (buffer);
+
+  set_state (state, GST_STATE_NULL);
+
+  destroy_payloader (state);
+}
+
+GST_END_TEST;
+
+static guint lists_received;
+
+static GstFlowReturn
+chain_list_func (GstPad * pad, GstObject * parent, GstBufferList * list)
+{
+  GstFlowReturn ret = GST_FLOW_OK;
+  guint i, len;
+
+  lists_received++;
+
+  len = gst_buffer_list_length (list);
+  for (i = 0; i < len && ret == GST_FLOW_OK; i++)
+    ret = gst_check_chain_func (pad, parent,
+        gst_buffer_ref (gst_buffer_list_get (list, i)));
+  gst_buffer_list_unref (list);
+
+  return ret;
+}
+
+/* with a flush-latency the payloader collects the packets of several input
+ * buffers in one buffer list. the list is pushed when it reaches
+ * max-list-size, a serialized event pushes the remaining packet before the
+ * event as a single buffer. the packets in the lists must have sequential
+ * sequence numbers.
+ */
+GST_START_TEST (rtp_base_payload_max_list_size_test)
+{
+  State *state;
+  guint32 rtptime;
+  guint16 seq;
+  guint i;
+
+  state = create_payloader ("application/x-rtp", &sinktmpl,
+      "perfect-rtptime", FALSE, "max-list-size", 3,
+      "flush-latency", 10 * GST_SECOND, NULL);
+  gst_pad_set_chain_list_function (state->sinkpad, chain_list_func);
+  lists_received = 0;
+
+  set_state (state, GST_STATE_PLAYING);
+
+  push_buffer (state, "pts", 0 * GST_SECOND, NULL);
+  push_buffer (state, "pts", 1 * GST_SECOND, NULL);
+  validate_buffers_received (0);
+
+  push_buffer (state, "pts", 2 * GST_SECOND, NULL);
+  validate_buffers_received (3);
+  fail_unless_equals_int (lists_received, 1);
+
+  push_buffer (state, "pts", 3 * GST_SECOND, NULL);
+  validate_buffers_received (3);
+
+  fail_unless (gst_pad_push_event (state->srcpad, gst_event_new_eos ()));
+  validate_buffers_received (4);
+  fail_unless_equals_int (lists_received, 1);
+
+  set_state (state, GST_STATE_NULL);
+
+  get_buffer_field (0, "rtptime", &rtptime, "seq", &seq, NULL);
+  for (i = 0; i < 4; i++) {
+    validate_buffer (i,
+        "pts", i * GST_SECOND,
+        "rtptime", rtptime + i * DEFAULT_CLOCK_RATE, "seq", seq + i, NULL);
+  }
+
+  validate_events_received (4);
+
+  validate_normal_start_events (0);
+
+  validate_event (3, "eos", NULL);
+
+  destroy_payloader (state);
+}
+
+GST_END_TEST;
+
+static gboolean
+upstream_latency_query_func (GstPad * pad, GstObject * parent,
+    GstQuery * query)
+{
+  if (GST_QUERY_TYPE (query) == GST_QUERY_LATENCY) {
+    gst_query_set_latency (query, TRUE, 10 * GST_MSECOND, 20 * GST_MSECOND);
+    return TRUE;
+  }
+
+  return gst_pad_query_default (pad, parent, query);
+}
+
+/* the packets can be held back for the flush-latency, the payloader should add
+ * it to the latency reported by upstream.
+ */
+GST_START_TEST (rtp_base_payload_flush_latency_query_test)
+{
+  State *state;
+  GstQuery *query;
+  gboolean live;
+  GstClockTime min_latency, max_latency;
+
+  state = create_payloader ("application/x-rtp", &sinktmpl,
+      "flush-latency", 40 * GST_MSECOND, NULL);
+  gst_pad_set_query_function (state->srcpad, upstream_latency_query_func);
+
+  set_state (state, GST_STATE_PLAYING);
+
+  query = gst_query_new_latency ();
+  fail_unless (gst_pad_peer_query (state->sinkpad, query));
+  gst_query_parse_latency (query, &live, &min_latency, &max_latency);
+  fail_unless (live);
+  fail_unless_equals_uint64 (min_latency, 50 * GST_MSECOND);
+  fail_unless_equals_uint64 (max_latency, 60 * GST_MSECOND);
+  gst_query_unref (query);
+
+  set_state (state, GST_STATE_NULL);
+
+  destroy_payloader (state);
+}
+
+GST_END_TEST;
+
 /* push a single buffer to the payloader which should successfully payload it
  * into an RTP packet. besides the payloaded RTP packet there should be the
  * three events initial events: stream-start, caps and segment. because of that
@@ -1878,6 +2071,9 @@ rtp_basepayloading_suite (void)
   tcase_add_test (tc_chain, rtp_base_payload_property_perfect_rtptime_test);
   tcase_add_test (tc_chain, rtp_base_payload_property_ptime_multiple_test);
   tcase_add_test (tc_chain, rtp_base_payload_property_stats_test);
+  tcase_add_test (tc_chain, rtp_base_payload_pool_test);
+  tcase_add_test (tc_chain, rtp_base_payload_max_list_size_test);
+  tcase_add_test (tc_chain, rtp_base_payload_flush_latency_query_test);
 
   tcase_add_test (tc_chain, rtp_base_payload_framerate_attribute);
   tcase_add_test (tc_chain, rtp_base_payload_max_framerate_attribute);
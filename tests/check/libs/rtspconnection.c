@@ -601,6 +601,107 @@ GST_START_TEST (test_rtspconnection_send_receive)
 
 GST_END_TEST;
 
+GST_START_TEST (test_rtspconnection_zero_copy)
+{
+  GSocketConnection *input_conn = NULL;
+  GSocketConnection *output_conn = NULL;
+  GSocket *input_sock;
+  GOutputStream *ostream;
+  GstRTSPConnection *rtsp_input_conn;
+  GstRTSPMessage *msg;
+  GstBuffer *buffer;
+  GstMemory *parent = NULL;
+  GstMapInfo map;
+  GString *data;
+  gchar *value;
+  gsize size;
+  guint8 *recv_body;
+  guint recv_body_len;
+  gsize j;
+  gint i;
+
+  create_connection (&input_conn, &output_conn);
+  input_sock = g_socket_connection_get_socket (input_conn);
+  fail_unless (input_sock != NULL);
+
+  fail_unless (gst_rtsp_connection_create_from_socket (input_sock, "127.0.0.1",
+          4444, NULL, &rtsp_input_conn) == GST_RTSP_OK);
+  fail_unless (rtsp_input_conn != NULL);
+  fail_if (gst_rtsp_connection_get_zero_copy (rtsp_input_conn));
+  gst_rtsp_connection_set_zero_copy (rtsp_input_conn, TRUE);
+  fail_unless (gst_rtsp_connection_get_zero_copy (rtsp_input_conn));
+
+  /* a request with a folded header and a body followed by interleaved data
+   * messages, all in one write */
+  data = g_string_new ("OPTIONS rtsp://example.org RTSP/1.0\r\n"
+      "CSeq: 1\r\n" "Session: 1234\r\n  ;timeout=60\r\n"
+      "Content-Length: 4\r\n\r\n" "body");
+  for (i = 0; i < 10; i++) {
+    guint8 header[4] = { '$', i, 0, 100 };
+    guint8 payload[100];
+
+    memset (payload, i, sizeof (payload));
+    g_string_append_len (data, (gchar *) header, sizeof (header));
+    g_string_append_len (data, (gchar *) payload, sizeof (payload));
+  }
+
+  ostream = g_io_stream_get_output_stream (G_IO_STREAM (output_conn));
+  fail_unless (g_output_stream_write_all (ostream, data->str, data->len,
+          &size, NULL, NULL));
+  fail_unless_equals_int (size, data->len);
+  g_string_free (data, TRUE);
+
+  fail_unless (gst_rtsp_message_new (&msg) == GST_RTSP_OK);
+  fail_unless (gst_rtsp_connection_receive (rtsp_input_conn, msg, NULL) ==
+      GST_RTSP_OK);
+  fail_unless (gst_rtsp_message_get_type (msg) == GST_RTSP_MESSAGE_REQUEST);
+  fail_unless (gst_rtsp_message_get_header (msg, GST_RTSP_HDR_SESSION,
+          &value, 0) == GST_RTSP_OK);
+  fail_unless_equals_string (value, "1234 ;timeout=60");
+  fail_unless (gst_rtsp_message_has_body_buffer (msg));
+  fail_unless (gst_rtsp_message_get_body (msg, &recv_body,
+          &recv_body_len) == GST_RTSP_OK);
+  fail_unless_equals_int (recv_body_len, 4);
+  fail_unless (memcmp (recv_body, "body", 4) == 0);
+  fail_unless (gst_rtsp_message_free (msg) == GST_RTSP_OK);
+
+  for (i = 0; i < 10; i++) {
+    GstMemory *mem;
+
+    fail_unless (gst_rtsp_message_new (&msg) == GST_RTSP_OK);
+    fail_unless (gst_rtsp_connection_receive (rtsp_input_conn, msg, NULL) ==
+        GST_RTSP_OK);
+    fail_unless (gst_rtsp_message_get_type (msg) == GST_RTSP_MESSAGE_DATA);
+    fail_unless_equals_int (msg->type_data.data.channel, i);
+    fail_unless (gst_rtsp_message_steal_body_buffer (msg,
+            &buffer) == GST_RTSP_OK);
+    fail_if (gst_rtsp_message_has_body_buffer (msg));
+    fail_unless (gst_rtsp_message_free (msg) == GST_RTSP_OK);
+
+    fail_unless (gst_buffer_map (buffer, &map, GST_MAP_READ));
+    fail_unless_equals_int (map.size, 100);
+    for (j = 0; j < map.size; j++)
+      fail_unless_equals_int (map.data[j], i);
+    gst_buffer_unmap (buffer, &map);
+
+    /* all bodies share the memory they were read into */
+    mem = gst_buffer_peek_memory (buffer, 0);
+    fail_unless (mem->parent != NULL);
+    if (parent == NULL)
+      parent = mem->parent;
+    fail_unless (mem->parent == parent);
+    gst_buffer_unref (buffer);
+  }
+
+  fail_unless (gst_rtsp_connection_close (rtsp_input_conn) == GST_RTSP_OK);
+  fail_unless (gst_rtsp_connection_free (rtsp_input_conn) == GST_RTSP_OK);
+
+  g_object_unref (input_conn);
+  g_object_unref (output_conn);
+}
+
+GST_END_TEST;
+
 GST_START_TEST (test_rtspconnection_send_receive_check_headers)
 {
   GSocketConnection *input_conn = NULL;
@@ -840,6 +941,162 @@ GST_START_TEST (test_rtspconnection_backlog)
 
 GST_END_TEST;
 
+GST_START_TEST (test_rtspconnection_send_buffer_list)
+{
+  GSocketConnection *conn1 = NULL;
+  GSocketConnection *conn2 = NULL;
+  GSocket *sock;
+  GstRTSPConnection *rtsp_conn = NULL;
+  GstRTSPConnection *rtsp_peer = NULL;
+  GstRTSPWatch *watch;
+  GstRTSPMessage *msg;
+  GstBufferList *list;
+  guint8 *body;
+  guint body_len;
+  guint id, j;
+  gint i;
+
+  create_connection (&conn1, &conn2);
+  sock = g_socket_connection_get_socket (conn1);
+  fail_unless (sock != NULL);
+  fail_unless (gst_rtsp_connection_create_from_socket (sock, "127.0.0.1",
+          4444, NULL, &rtsp_conn) == GST_RTSP_OK);
+  sock = g_socket_connection_get_socket (conn2);
+  fail_unless (sock != NULL);
+  fail_unless (gst_rtsp_connection_create_from_socket (sock, "127.0.0.1",
+          4444, NULL, &rtsp_peer) == GST_RTSP_OK);
+
+  watch = gst_rtsp_watch_new (rtsp_conn, &watch_funcs, NULL, NULL);
+  fail_unless (watch != NULL);
+  fail_unless (gst_rtsp_watch_attach (watch, NULL) > 0);
+  g_source_unref ((GSource *) watch);
+
+  /* buffers made of a header and a payload memory */
+  list = gst_buffer_list_new ();
+  for (i = 0; i < 5; i++) {
+    GstBuffer *buffer = gst_buffer_new_allocate (NULL, 12, NULL);
+    GstBuffer *payload = gst_buffer_new_allocate (NULL, 100 + i, NULL);
+
+    gst_buffer_memset (buffer, 0, i, 12);
+    gst_buffer_memset (payload, 0, 0x80 + i, 100 + i);
+    buffer = gst_buffer_append (buffer, payload);
+    fail_unless_equals_int (gst_buffer_n_memory (buffer), 2);
+    gst_buffer_list_add (list, buffer);
+  }
+
+  id = 1;
+  fail_unless (gst_rtsp_watch_send_buffer_list (watch, 2, list,
+          &id) == GST_RTSP_OK);
+  /* everything fits in the socket buffer */
+  fail_unless_equals_int (id, 0);
+  gst_buffer_list_unref (list);
+
+  for (i = 0; i < 5; i++) {
+    fail_unless (gst_rtsp_message_new (&msg) == GST_RTSP_OK);
+    fail_unless (gst_rtsp_connection_receive (rtsp_peer, msg, NULL) ==
+        GST_RTSP_OK);
+    fail_unless (gst_rtsp_message_get_type (msg) == GST_RTSP_MESSAGE_DATA);
+    fail_unless_equals_int (msg->type_data.data.channel, 2);
+    fail_unless (gst_rtsp_message_get_body (msg, &body,
+            &body_len) == GST_RTSP_OK);
+    fail_unless_equals_int (body_len, 112 + i);
+    for (j = 0; j < 12; j++)
+      fail_unless_equals_int (body[j], i);
+    for (j = 12; j < body_len; j++)
+      fail_unless_equals_int (body[j], 0x80 + i);
+    fail_unless (gst_rtsp_message_free (msg) == GST_RTSP_OK);
+  }
+
+  /* too big for a data message */
+  list = gst_buffer_list_new ();
+  gst_buffer_list_add (list, gst_buffer_new_allocate (NULL, 65536, NULL));
+  fail_unless (gst_rtsp_watch_send_buffer_list (watch, 0, list,
+          NULL) == GST_RTSP_EINVAL);
+  gst_buffer_list_unref (list);
+
+  g_source_destroy ((GSource *) watch);
+  fail_unless (gst_rtsp_connection_close (rtsp_conn) == GST_RTSP_OK);
+  fail_unless (gst_rtsp_connection_free (rtsp_conn) == GST_RTSP_OK);
+  fail_unless (gst_rtsp_connection_close (rtsp_peer) == GST_RTSP_OK);
+  fail_unless (gst_rtsp_connection_free (rtsp_peer) == GST_RTSP_OK);
+  g_object_unref (conn1);
+  g_object_unref (conn2);
+}
+
+GST_END_TEST;
+
+/* on the server side of a tunnel, the GET channel carries the plain
+ * interleaved data */
+GST_START_TEST (test_rtspconnection_send_buffer_list_tunneled)
+{
+  GSocketConnection *client = NULL;
+  GSocketConnection *server = NULL;
+  GSocket *sock;
+  GInputStream *istream;
+  GstRTSPConnection *rtsp_conn = NULL;
+  GstRTSPWatch *watch;
+  GstRTSPMessage *msg;
+  GstBufferList *list;
+  GstBuffer *buffer;
+  guint8 data[4 + 100];
+  gsize size;
+  guint id, j;
+  gint i;
+
+  create_connection (&client, &server);
+  sock = g_socket_connection_get_socket (server);
+  fail_unless (sock != NULL);
+  fail_unless (gst_rtsp_connection_create_from_socket (sock, "127.0.0.1",
+          4444, NULL, &rtsp_conn) == GST_RTSP_OK);
+  gst_rtsp_connection_set_tunneled (rtsp_conn, TRUE);
+
+  watch = gst_rtsp_watch_new (rtsp_conn, &watch_funcs, NULL, NULL);
+  fail_unless (watch != NULL);
+  fail_unless (gst_rtsp_watch_attach (watch, NULL) > 0);
+  g_source_unref ((GSource *) watch);
+
+  list = gst_buffer_list_new ();
+  for (i = 0; i < 3; i++) {
+    buffer = gst_buffer_new_allocate (NULL, 100, NULL);
+    gst_buffer_memset (buffer, 0, 0x80 + i, 100);
+    gst_buffer_list_add (list, buffer);
+  }
+  id = 1;
+  fail_unless (gst_rtsp_watch_send_buffer_list (watch, 3, list,
+          &id) == GST_RTSP_OK);
+  fail_unless_equals_int (id, 0);
+  gst_buffer_list_unref (list);
+
+  /* data messages with a body buffer take the same path */
+  fail_unless (gst_rtsp_message_new_data (&msg, 3) == GST_RTSP_OK);
+  buffer = gst_buffer_new_allocate (NULL, 100, NULL);
+  gst_buffer_memset (buffer, 0, 0x83, 100);
+  fail_unless (gst_rtsp_message_take_body_buffer (msg, buffer) == GST_RTSP_OK);
+  fail_unless (gst_rtsp_watch_send_message (watch, msg, NULL) == GST_RTSP_OK);
+  fail_unless (gst_rtsp_message_free (msg) == GST_RTSP_OK);
+
+  istream = g_io_stream_get_input_stream (G_IO_STREAM (client));
+  for (i = 0; i < 4; i++) {
+    fail_unless (g_input_stream_read_all (istream, data, sizeof (data), &size,
+            NULL, NULL));
+    fail_unless_equals_int (size, sizeof (data));
+    fail_unless_equals_int (data[0], '$');
+    fail_unless_equals_int (data[1], 3);
+    fail_unless_equals_int (data[2], 0);
+    fail_unless_equals_int (data[3], 100);
+    for (j = 4; j < sizeof (data); j++)
+      fail_unless_equals_int (data[j], 0x80 + i);
+  }
+
+  g_source_destroy ((GSource *) watch);
+  fail_unless (gst_rtsp_connection_close (rtsp_conn) == GST_RTSP_OK);
+  fail_unless (gst_rtsp_connection_free (rtsp_conn) == GST_RTSP_OK);
+  g_object_unref (client);
+  g_object_unref (server);
+}
+
+GST_END_TEST;
+
 GST_START_TEST (test_rtspconnection_ip)
 {
   GstRTSPConnection *conn = NULL;
@@ -871,9 +1128,12 @@ rtspconnection_suite (void)
   tcase_add_test (tc_chain, test_rtspconnection_tunnel_setup_post_first);
   tcase_add_test (tc_chain, test_rtspconnection_send_receive);
   tcase_add_test (tc_chain, test_rtspconnection_send_receive_check_headers);
+  tcase_add_test (tc_chain, test_rtspconnection_zero_copy);
   tcase_add_test (tc_chain, test_rtspconnection_connect);
   tcase_add_test (tc_chain, test_rtspconnection_poll);
   tcase_add_test (tc_chain, test_rtspconnection_backlog);
+  tcase_add_test (tc_chain, test_rtspconnection_send_buffer_list);
+  tcase_add_test (tc_chain, test_rtspconnection_send_buffer_list_tunneled);
   tcase_add_test (tc_chain, test_rtspconnection_ip);
 
   return s;
@@ -2275,6 +2275,283 @@ GST_START_TEST (test_video_scaler)
 
 GST_END_TEST;
 
+GST_START_TEST (test_video_scaler_2d_multi)
+{
+  GstVideoFormat formats[] = { GST_VIDEO_FORMAT_GRAY8, GST_VIDEO_FORMAT_RGBA,
+    GST_VIDEO_FORMAT_NV12
+  };
+  guint in_width = 192, in_height = 108;
+  guint widths[] = { 192, 128, 64, 37 };
+  guint heights[] = { 54, 108, 36, 21 };
+  guint f, i, n_outputs = G_N_ELEMENTS (widths);
+
+  for (f = 0; f < G_N_ELEMENTS (formats); f++) {
+    GstVideoScaler *hscale[4], *vscale[4];
+    gpointer dest[4];
+    gint dest_stride[4];
+    guint8 *src, *ref;
+    gint bpp, src_stride;
+
+    bpp = formats[f] == GST_VIDEO_FORMAT_GRAY8 ? 1 :
+        formats[f] == GST_VIDEO_FORMAT_NV12 ? 2 : 4;
+    src_stride = in_width * bpp;
+    src = g_malloc (src_stride * in_height);
+    for (i = 0; i < src_stride * in_height; i++)
+      src[i] = (i * 7) ^ (i >> 5);
+
+    for (i = 0; i < n_outputs; i++) {
+      hscale[i] = widths[i] == in_width ? NULL :
+          gst_video_scaler_new (GST_VIDEO_RESAMPLER_METHOD_CUBIC,
+          GST_VIDEO_SCALER_FLAG_NONE, 0, in_width, widths[i], NULL);
+      vscale[i] = heights[i] == in_height ? NULL :
+          gst_video_scaler_new (GST_VIDEO_RESAMPLER_METHOD_CUBIC,
+          GST_VIDEO_SCALER_FLAG_NONE, 0, in_height, heights[i], NULL);
+      dest_stride[i] = widths[i] * bpp;
+      dest[i] = g_malloc0 (dest_stride[i] * heights[i]);
+    }
+
+    gst_video_scaler_2d_multi (hscale, vscale, n_outputs, formats[f], src,
+        src_stride, dest, dest_stride, widths, heights);
+
+    /* must match scaling each output separately */
+    for (i = 0; i < n_outputs; i++) {
+      ref = g_malloc0 (dest_stride[i] * heights[i]);
+      gst_video_scaler_2d (hscale[i], vscale[i], formats[f], src, src_stride,
+          ref, dest_stride[i], 0, 0, widths[i], heights[i]);
+      fail_unless (memcmp (ref, dest[i], dest_stride[i] * heights[i]) == 0);
+      g_free (ref);
+
+      if (hscale[i])
+        gst_video_scaler_free (hscale[i]);
+      if (vscale[i])
+        gst_video_scaler_free (vscale[i]);
+      g_free (dest[i]);
+    }
+    g_free (src);
+  }
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_video_scaler_cache)
+{
+  GstVideoScaler *scale1, *scale2, *scale3;
+  guint64 hits, misses, hits2, misses2;
+  const gdouble *coeff1, *coeff2;
+  guint offset1, offset2, taps1, taps2;
+
+  gst_video_scaler_get_cache_stats (&hits, &misses);
+
+  scale1 = gst_video_scaler_new (GST_VIDEO_RESAMPLER_METHOD_LANCZOS,
+      GST_VIDEO_SCALER_FLAG_NONE, 0, 1237, 411, NULL);
+  scale2 = gst_video_scaler_new (GST_VIDEO_RESAMPLER_METHOD_LANCZOS,
+      GST_VIDEO_SCALER_FLAG_NONE, 0, 1237, 411, NULL);
+  scale3 = gst_video_scaler_new (GST_VIDEO_RESAMPLER_METHOD_LANCZOS,
+      GST_VIDEO_SCALER_FLAG_INTERLACED, 0, 1237, 411, NULL);
+
+  gst_video_scaler_get_cache_stats (&hits2, &misses2);
+  fail_unless_equals_uint64 (hits2, hits + 1);
+  fail_unless_equals_uint64 (misses2, misses + 2);
+
+  coeff1 = gst_video_scaler_get_coeff (scale1, 200, &offset1, &taps1);
+  coeff2 = gst_video_scaler_get_coeff (scale2, 200, &offset2, &taps2);
+  fail_unless (coeff1 == coeff2);
+  fail_unless_equals_int (offset1, offset2);
+  fail_unless_equals_int (taps1, taps2);
+
+  /* released coefficients are kept for the next scaler */
+  gst_video_scaler_free (scale1);
+  gst_video_scaler_free (scale2);
+  gst_video_scaler_free (scale3);
+
+  scale1 = gst_video_scaler_new (GST_VIDEO_RESAMPLER_METHOD_LANCZOS,
+      GST_VIDEO_SCALER_FLAG_NONE, 0, 1237, 411, NULL);
+  gst_video_scaler_get_cache_stats (&hits, &misses);
+  fail_unless_equals_uint64 (hits, hits2 + 1);
+  fail_unless_equals_uint64 (misses, misses2);
+  gst_video_scaler_free (scale1);
+}
+
+GST_END_TEST;
+
+static guint
+box_average (const guint16 * s, guint stride, guint k)
+{
+  guint i, sum = 0;
+
+  for (i = 0; i < k; i++)
+    sum += s[i * stride];
+
+  return (sum + k / 2) / k;
+}
+
+static void
+check_box_horizontal (GstVideoFormat format, guint n_elems, guint k)
+{
+  const GstVideoFormatInfo *finfo = gst_video_format_get_info (format);
+  gboolean is16 = GST_VIDEO_FORMAT_INFO_BITS (finfo) == 16;
+  guint in_w = 64, out_w = in_w / k, i, x, e;
+  guint16 ref[64 * 4];
+  guint8 src[64 * 4 * 2], dest[64 * 4 * 2];
+  GstVideoScaler *scale;
+
+  for (i = 0; i < in_w * n_elems; i++) {
+    ref[i] = is16 ? (i * 7919) & 0xffff : (i * 37 + 11) & 0xff;
+    if (is16)
+      ((guint16 *) src)[i] = ref[i];
+    else
+      src[i] = ref[i];
+  }
+
+  scale = gst_video_scaler_new (GST_VIDEO_RESAMPLER_METHOD_BOX,
+      GST_VIDEO_SCALER_FLAG_NONE, 0, in_w, out_w, NULL);
+  gst_video_scaler_horizontal (scale, format, src, dest, 0, out_w);
+
+  for (x = 0; x < out_w; x++) {
+    for (e = 0; e < n_elems; e++) {
+      guint idx = x * n_elems + e;
+      guint val = is16 ? ((guint16 *) dest)[idx] : dest[idx];
+
+      fail_unless_equals_int (val,
+          box_average (ref + x * k * n_elems + e, n_elems, k));
+    }
+  }
+  gst_video_scaler_free (scale);
+}
+
+static void
+check_box_vertical (GstVideoFormat format, guint k)
+{
+  const GstVideoFormatInfo *finfo = gst_video_format_get_info (format);
+  gboolean is16 = GST_VIDEO_FORMAT_INFO_BITS (finfo) == 16;
+  guint width = 24, in_h = 16, out_h = in_h / k, i, x, y;
+  guint16 ref[24 * 16];
+  guint8 src[24 * 16 * 2], dest[24 * 2];
+  guint stride = width * (is16 ? 2 : 1);
+  gpointer lines[4];
+  GstVideoScaler *scale;
+
+  for (i = 0; i < width * in_h; i++) {
+    ref[i] = is16 ? (i * 7919) & 0xffff : (i * 37 + 11) & 0xff;
+    if (is16)
+      ((guint16 *) src)[i] = ref[i];
+    else
+      src[i] = ref[i];
+  }
+
+  scale = gst_video_scaler_new (GST_VIDEO_RESAMPLER_METHOD_BOX,
+      GST_VIDEO_SCALER_FLAG_NONE, 0, in_h, out_h, NULL);
+
+  for (y = 0; y < out_h; y++) {
+    for (i = 0; i < k; i++)
+      lines[i] = src + (y * k + i) * stride;
+    gst_video_scaler_vertical (scale, format, lines, dest, y, width);
+
+    for (x = 0; x < width; x++) {
+      guint val = is16 ? ((guint16 *) dest)[x] : dest[x];
+
+      fail_unless_equals_int (val,
+          box_average (ref + y * k * width + x, width, k));
+    }
+  }
+  gst_video_scaler_free (scale);
+}
+
+GST_START_TEST (test_video_scaler_box)
+{
+  guint8 src[16 * 8], dest[8 * 4], tmp[16 * 4];
+  guint i, k, x, y, sx, sy;
+
+  for (k = 2; k <= 4; k += 2) {
+    check_box_horizontal (GST_VIDEO_FORMAT_GRAY8, 1, k);
+    check_box_horizontal (GST_VIDEO_FORMAT_RGBA, 4, k);
+    check_box_horizontal (GST_VIDEO_FORMAT_GRAY16_LE, 1, k);
+    check_box_vertical (GST_VIDEO_FORMAT_GRAY8, k);
+    check_box_vertical (GST_VIDEO_FORMAT_GRAY16_LE, k);
+  }
+
+  /* packed YUY2 goes through the merged scaler */
+  {
+    GstVideoScaler *y_scale, *uv_scale, *scale;
+    guint8 line[32 * 2], out[16 * 2];
+
+    for (i = 0; i < G_N_ELEMENTS (line); i++)
+      line[i] = (i * 53 + 7) & 0xff;
+
+    y_scale = gst_video_scaler_new (GST_VIDEO_RESAMPLER_METHOD_BOX,
+        GST_VIDEO_SCALER_FLAG_NONE, 0, 32, 16, NULL);
+    uv_scale = gst_video_scaler_new (GST_VIDEO_RESAMPLER_METHOD_BOX,
+        GST_VIDEO_SCALER_FLAG_NONE, 0, 16, 8, NULL);
+    scale = gst_video_scaler_combine_packed_YUV (y_scale, uv_scale,
+        GST_VIDEO_FORMAT_YUY2, GST_VIDEO_FORMAT_YUY2);
+    gst_video_scaler_horizontal (scale, GST_VIDEO_FORMAT_YUY2, line, out, 0,
+        16);
+
+    for (x = 0; x < 16; x++) {
+      /* Y of output pixel x averages input pixels 2x and 2x + 1 */
+      fail_unless_equals_int (out[2 * x],
+          (line[4 * x] + line[4 * x + 2] + 1) / 2);
+    }
+    for (x = 0; x < 8; x++) {
+      /* U and V of output pair x average input pairs 2x and 2x + 1 */
+      fail_unless_equals_int (out[4 * x + 1],
+          (line[8 * x + 1] + line[8 * x + 5] + 1) / 2);
+      fail_unless_equals_int (out[4 * x + 3],
+          (line[8 * x + 3] + line[8 * x + 7] + 1) / 2);
+    }
+    gst_video_scaler_free (scale);
+    gst_video_scaler_free (y_scale);
+    gst_video_scaler_free (uv_scale);
+  }
+
+  for (i = 0; i < G_N_ELEMENTS (src); i++)
+    src[i] = (i * 37) & 0xff;
+
+  for (k = 2; k <= 4; k += 2) {
+    GstVideoScaler *hscale, *vscale;
+    const gdouble *taps;
+    guint offset, n_taps, out_w = 16 / k, out_h = 8 / k;
+
+    hscale = gst_video_scaler_new (GST_VIDEO_RESAMPLER_METHOD_BOX,
+        GST_VIDEO_SCALER_FLAG_NONE, 0, 16, out_w, NULL);
+    vscale = gst_video_scaler_new (GST_VIDEO_RESAMPLER_METHOD_BOX,
+        GST_VIDEO_SCALER_FLAG_NONE, 0, 8, out_h, NULL);
+
+    taps = gst_video_scaler_get_coeff (hscale, 1, &offset, &n_taps);
+    fail_unless_equals_int (offset, k);
+    fail_unless_equals_int (n_taps, k);
+    for (i = 0; i < n_taps; i++)
+      fail_unless (ABS (taps[i] - 1.0 / k) < 1e-9);
+
+    gst_video_scaler_2d (hscale, vscale, GST_VIDEO_FORMAT_GRAY8,
+        src, 16, dest, out_w, 0, 0, out_w, out_h);
+
+    /* with these sizes the vertical pass runs first, each pass rounds */
+    for (y = 0; y < out_h; y++) {
+      for (sx = 0; sx < 16; sx++) {
+        guint sum = 0;
+
+        for (sy = 0; sy < k; sy++)
+          sum += src[(y * k + sy) * 16 + sx];
+        tmp[y * 16 + sx] = (sum + k / 2) / k;
+      }
+    }
+    for (y = 0; y < out_h; y++) {
+      for (x = 0; x < out_w; x++) {
+        guint sum = 0;
+
+        for (sx = 0; sx < k; sx++)
+          sum += tmp[y * 16 + x * k + sx];
+        fail_unless_equals_int (dest[y * out_w + x], (sum + k / 2) / k);
+      }
+    }
+    gst_video_scaler_free (hscale);
+    gst_video_scaler_free (vscale);
+  }
+}
+
+GST_END_TEST;
+
 #define WIDTH 320
 #define HEIGHT 240
 #define TIME 0.01
@@ -2464,6 +2741,91 @@ GST_END_TEST;
 #undef WIDTH
 #undef HEIGHT
 
+#define HEIGHT 1080
+#define DISPATCH_FRAMES 20
+
+/* Converts a narrow frame with every thread count so that all bands are
+ * handed out to the shared pool, and checks the result and the pool
+ * statistics. The dispatch overhead itself is measured by
+ * tests/icles/benchmark-videoconvert */
+GST_START_TEST (test_video_convert_dispatch)
+{
+  GstVideoInfo ininfo, outinfo;
+  GstVideoFrame inframe, outframe;
+  GstBuffer *inbuffer, *outbuffer;
+  guint n_threads, max_threads;
+  gint x, y;
+
+  gst_video_info_set_format (&ininfo, GST_VIDEO_FORMAT_GRAY8, 16, HEIGHT);
+  inbuffer = gst_buffer_new_and_alloc (ininfo.size);
+  gst_video_frame_map (&inframe, &ininfo, inbuffer, GST_MAP_READWRITE);
+  for (y = 0; y < HEIGHT; y++) {
+    guint8 *line = (guint8 *) GST_VIDEO_FRAME_PLANE_DATA (&inframe, 0) +
+        y * GST_VIDEO_FRAME_PLANE_STRIDE (&inframe, 0);
+
+    for (x = 0; x < 16; x++)
+      line[x] = (x + y) & 0xff;
+  }
+
+  gst_video_info_set_format (&outinfo, GST_VIDEO_FORMAT_GRAY16_LE, 16, HEIGHT);
+  outbuffer = gst_buffer_new_and_alloc (outinfo.size);
+  gst_video_frame_map (&outframe, &outinfo, outbuffer, GST_MAP_READWRITE);
+
+  max_threads = MIN (g_get_num_processors (), HEIGHT / 200);
+
+  for (n_threads = 1; n_threads <= max_threads; n_threads++) {
+    GstVideoConverter *convert;
+    gint i;
+
+    convert = gst_video_converter_new (&ininfo, &outinfo,
+        gst_structure_new ("options",
+            GST_VIDEO_CONVERTER_OPT_THREADS, G_TYPE_UINT, n_threads, NULL));
+    fail_unless (convert != NULL);
+
+    for (i = 0; i < DISPATCH_FRAMES; i++) {
+      gst_buffer_memset (outbuffer, 0, 0, -1);
+      gst_video_converter_frame (convert, &inframe, &outframe);
+
+      /* every band must have been converted exactly once */
+      for (y = 0; y < HEIGHT; y++) {
+        guint16 *line = (guint16 *) ((guint8 *)
+            GST_VIDEO_FRAME_PLANE_DATA (&outframe, 0) +
+            y * GST_VIDEO_FRAME_PLANE_STRIDE (&outframe, 0));
+
+        for (x = 0; x < 16; x++)
+          fail_unless_equals_int (GUINT16_FROM_LE (line[x]),
+              ((x + y) & 0xff) * 257);
+      }
+    }
+
+    if (n_threads > 1) {
+      guint pool_threads;
+      guint64 n_jobs;
+      GstClockTime avg_latency, max_latency;
+
+      gst_video_converter_get_pool_stats (&pool_threads, &n_jobs,
+          &avg_latency, &max_latency);
+      fail_unless_equals_int (pool_threads, g_get_num_processors () - 1);
+      fail_unless (avg_latency <= max_latency);
+    }
+
+    gst_video_converter_free (convert);
+  }
+
+  /* the pool goes away with the last converter */
+  gst_video_converter_get_pool_stats (&n_threads, NULL, NULL, NULL);
+  fail_unless_equals_int (n_threads, 0);
+
+  gst_video_frame_unmap (&outframe);
+  gst_buffer_unref (outbuffer);
+  gst_video_frame_unmap (&inframe);
+  gst_buffer_unref (inbuffer);
+}
+
+GST_END_TEST;
+#undef HEIGHT
+#undef DISPATCH_FRAMES
+
 GST_START_TEST (test_video_convert)
 {
   GstVideoInfo ininfo, outinfo;
@@ -2525,6 +2887,115 @@ GST_START_TEST (test_video_convert)
 
 GST_END_TEST;
 
+#define SRC_WIDTH 3840
+#define SRC_HEIGHT 2160
+#define DST_WIDTH 1920
+#define DST_HEIGHT 1080
+#define SCALE_TIME 0.1
+
+static gdouble
+convert_frames_per_sec (GstVideoConverter * convert, GstVideoFrame * inframe,
+    GstVideoFrame * outframe)
+{
+  GTimer *timer;
+  gdouble elapsed;
+  gint count;
+
+  timer = g_timer_new ();
+
+  /* warmup */
+  gst_video_converter_frame (convert, inframe, outframe);
+
+  count = 0;
+  g_timer_start (timer);
+  while (TRUE) {
+    gst_video_converter_frame (convert, inframe, outframe);
+
+    count++;
+    elapsed = g_timer_elapsed (timer, NULL);
+    if (elapsed >= SCALE_TIME)
+      break;
+  }
+  g_timer_destroy (timer);
+
+  return count / elapsed;
+}
+
+/* Downscaling to packed RGB converts and packs straight into the
+ * destination when possible, check that this gives the same result as
+ * converting to a format that is packed separately */
+GST_START_TEST (test_video_convert_scale_pack)
+{
+  GstVideoInfo ininfo, rgbxinfo, rgbinfo;
+  GstVideoFrame inframe, rgbxframe, rgbframe;
+  GstBuffer *inbuffer, *rgbxbuffer, *rgbbuffer;
+  GstVideoConverter *convert;
+  GstMapInfo map;
+  gdouble rgbx_sec, rgb_sec;
+  gsize k;
+  gint i, j;
+
+  gst_video_info_set_format (&ininfo, GST_VIDEO_FORMAT_I420, SRC_WIDTH,
+      SRC_HEIGHT);
+  inbuffer = gst_buffer_new_and_alloc (ininfo.size);
+  gst_buffer_map (inbuffer, &map, GST_MAP_WRITE);
+  for (k = 0; k < map.size; k++)
+    map.data[k] = (k * 7) & 0xff;
+  gst_buffer_unmap (inbuffer, &map);
+  gst_video_frame_map (&inframe, &ininfo, inbuffer, GST_MAP_READ);
+
+  gst_video_info_set_format (&rgbxinfo, GST_VIDEO_FORMAT_BGRx, DST_WIDTH,
+      DST_HEIGHT);
+  rgbxbuffer = gst_buffer_new_and_alloc (rgbxinfo.size);
+  gst_video_frame_map (&rgbxframe, &rgbxinfo, rgbxbuffer, GST_MAP_WRITE);
+
+  gst_video_info_set_format (&rgbinfo, GST_VIDEO_FORMAT_BGR, DST_WIDTH,
+      DST_HEIGHT);
+  rgbbuffer = gst_buffer_new_and_alloc (rgbinfo.size);
+  gst_video_frame_map (&rgbframe, &rgbinfo, rgbbuffer, GST_MAP_WRITE);
+
+  convert = gst_video_converter_new (&ininfo, &rgbxinfo, NULL);
+  fail_unless (convert != NULL);
+  rgbx_sec = convert_frames_per_sec (convert, &inframe, &rgbxframe);
+  gst_video_converter_free (convert);
+
+  convert = gst_video_converter_new (&ininfo, &rgbinfo, NULL);
+  fail_unless (convert != NULL);
+  rgb_sec = convert_frames_per_sec (convert, &inframe, &rgbframe);
+  gst_video_converter_free (convert);
+
+  GST_DEBUG ("I420 %dx%d -> %dx%d: %f frames/sec BGRx, %f frames/sec BGR",
+      SRC_WIDTH, SRC_HEIGHT, DST_WIDTH, DST_HEIGHT, rgbx_sec, rgb_sec);
+
+  for (i = 0; i < DST_HEIGHT; i++) {
+    guint8 *rgbx = GST_VIDEO_FRAME_PLANE_DATA (&rgbxframe, 0);
+    guint8 *rgb = GST_VIDEO_FRAME_PLANE_DATA (&rgbframe, 0);
+
+    rgbx += i * GST_VIDEO_FRAME_PLANE_STRIDE (&rgbxframe, 0);
+    rgb += i * GST_VIDEO_FRAME_PLANE_STRIDE (&rgbframe, 0);
+
+    for (j = 0; j < DST_WIDTH; j++) {
+      fail_unless_equals_int (rgbx[j * 4 + 0], rgb[j * 3 + 0]);
+      fail_unless_equals_int (rgbx[j * 4 + 1], rgb[j * 3 + 1]);
+      fail_unless_equals_int (rgbx[j * 4 + 2], rgb[j * 3 + 2]);
+    }
+  }
+
+  gst_video_frame_unmap (&rgbframe);
+  gst_buffer_unref (rgbbuffer);
+  gst_video_frame_unmap (&rgbxframe);
+  gst_buffer_unref (rgbxbuffer);
+  gst_video_frame_unmap (&inframe);
+  gst_buffer_unref (inbuffer);
+}
+
+GST_END_TEST;
+#undef SRC_WIDTH
+#undef SRC_HEIGHT
+#undef DST_WIDTH
+#undef DST_HEIGHT
+#undef SCALE_TIME
+
 GST_START_TEST (test_video_transfer)
 {
   gint i, j;
@@ -2857,9 +3328,14 @@ video_suite (void)
   tcase_add_test (tc_chain, test_video_pack_unpack2);
   tcase_add_test (tc_chain, test_video_chroma);
   tcase_add_test (tc_chain, test_video_scaler);
+  tcase_add_test (tc_chain, test_video_scaler_cache);
+  tcase_add_test (tc_chain, test_video_scaler_box);
+  tcase_add_test (tc_chain, test_video_scaler_2d_multi);
   tcase_add_test (tc_chain, test_video_color_convert);
   tcase_add_test (tc_chain, test_video_size_convert);
+  tcase_add_test (tc_chain, test_video_convert_dispatch);
   tcase_add_test (tc_chain, test_video_convert);
+  tcase_add_test (tc_chain, test_video_convert_scale_pack);
   tcase_add_test (tc_chain, test_video_transfer);
   tcase_add_test (tc_chain, test_overlay_blend);
   tcase_add_test (tc_chain, test_video_center_rect);
@@ -82,6 +82,8 @@ struct _GstVideoDecoderTester
   guint64 last_buf_num;
   guint64 last_kf_num;
   gboolean set_output_state;
+  gboolean dispatch;
+  gboolean renumber;
 };
 
 struct _GstVideoDecoderTesterClass
@@ -150,6 +152,30 @@ gst_video_decoder_tester_handle_frame (GstVideoDecoder * dec,
 
   input_num = *((guint64 *) map.data);
 
+  if (dectester->renumber) {
+    GstVideoCodecFrame *tmp;
+
+    /* the frame must still be found after the subclass renumbered it */
+    frame->system_frame_number += 1000;
+    tmp = gst_video_decoder_get_frame (dec, frame->system_frame_number);
+    fail_unless (tmp == frame);
+    gst_video_codec_frame_unref (tmp);
+  }
+
+  if (dectester->dispatch) {
+    /* decoded by gst_video_decoder_tester_decode_frame() */
+    gst_buffer_unmap (frame->input_buffer, &map);
+
+    frame->output_buffer =
+        gst_buffer_new_allocate (NULL, TEST_VIDEO_WIDTH * TEST_VIDEO_HEIGHT,
+        NULL);
+    frame->pts = GST_BUFFER_PTS (frame->input_buffer);
+    frame->duration = GST_BUFFER_DURATION (frame->input_buffer);
+    dectester->last_buf_num = input_num;
+
+    return gst_video_decoder_dispatch_frame (dec, frame);
+  }
+
   if ((input_num == dectester->last_buf_num + 1
           && dectester->last_buf_num != -1)
       || !GST_BUFFER_FLAG_IS_SET (frame->input_buffer,
@@ -178,6 +204,24 @@ gst_video_decoder_tester_handle_frame (GstVideoDecoder * dec,
   return GST_FLOW_OK;
 }
 
+static GstFlowReturn
+gst_video_decoder_tester_decode_frame (GstVideoDecoder * dec,
+    GstVideoCodecFrame * frame)
+{
+  GstMapInfo map;
+
+  gst_buffer_map (frame->input_buffer, &map, GST_MAP_READ);
+  gst_buffer_memset (frame->output_buffer, 0, 0, -1);
+  gst_buffer_fill (frame->output_buffer, 0, map.data, sizeof (guint64));
+  gst_buffer_unmap (frame->input_buffer, &map);
+
+  /* finish out of order */
+  if (frame->system_frame_number % 3 == 0)
+    g_usleep (1000);
+
+  return GST_FLOW_OK;
+}
+
 static void
 gst_video_decoder_tester_class_init (GstVideoDecoderTesterClass * klass)
 {
@@ -202,6 +246,7 @@ gst_video_decoder_tester_class_init (GstVideoDecoderTesterClass * klass)
   videodecoder_class->stop = gst_video_decoder_tester_stop;
   videodecoder_class->flush = gst_video_decoder_tester_flush;
   videodecoder_class->handle_frame = gst_video_decoder_tester_handle_frame;
+  videodecoder_class->decode_frame = gst_video_decoder_tester_decode_frame;
   videodecoder_class->set_format = gst_video_decoder_tester_set_format;
 }
 
@@ -345,6 +390,122 @@ GST_START_TEST (videodecoder_playback)
 GST_END_TEST;
 
 
+GST_START_TEST (videodecoder_playback_renumbered_frames)
+{
+  GstSegment segment;
+  GstBuffer *buffer;
+  guint64 i;
+
+  setup_videodecodertester (NULL, NULL);
+
+  ((GstVideoDecoderTester *) dec)->renumber = TRUE;
+
+  gst_pad_set_active (mysrcpad, TRUE);
+  gst_element_set_state (dec, GST_STATE_PLAYING);
+  gst_pad_set_active (mysinkpad, TRUE);
+
+  send_startup_events ();
+
+  gst_segment_init (&segment, GST_FORMAT_TIME);
+  fail_unless (gst_pad_push_event (mysrcpad, gst_event_new_segment (&segment)));
+
+  for (i = 0; i < 10; i++) {
+    buffer = create_test_buffer (i);
+
+    fail_unless (gst_pad_push (mysrcpad, buffer) == GST_FLOW_OK);
+  }
+
+  fail_unless (gst_pad_push_event (mysrcpad, gst_event_new_eos ()));
+  fail_unless_equals_int (g_list_length (buffers), 10);
+
+  g_list_free_full (buffers, (GDestroyNotify) gst_buffer_unref);
+  buffers = NULL;
+
+  cleanup_videodecodertest ();
+}
+
+GST_END_TEST;
+
+#define DECODE_THREADS 4
+
+static void
+run_playback_dispatch (gboolean reordered)
+{
+  GstSegment segment;
+  GstBuffer *buffer;
+  guint64 i;
+  GList *iter;
+
+  setup_videodecodertester (NULL, NULL);
+
+  ((GstVideoDecoderTester *) dec)->dispatch = TRUE;
+  gst_video_decoder_set_decode_threads (GST_VIDEO_DECODER (dec),
+      DECODE_THREADS);
+  fail_unless_equals_int (gst_video_decoder_get_decode_threads
+      (GST_VIDEO_DECODER (dec)), DECODE_THREADS);
+
+  gst_pad_set_active (mysrcpad, TRUE);
+  gst_element_set_state (dec, GST_STATE_PLAYING);
+  gst_pad_set_active (mysinkpad, TRUE);
+
+  send_startup_events ();
+
+  /* push a new segment */
+  gst_segment_init (&segment, GST_FORMAT_TIME);
+  fail_unless (gst_pad_push_event (mysrcpad, gst_event_new_segment (&segment)));
+
+  /* when reordered, every pair of frames arrives in swapped order */
+  for (i = 0; i < NUM_BUFFERS; i++) {
+    buffer = create_test_buffer (reordered ? i ^ 1 : i);
+
+    fail_unless (gst_pad_push (mysrcpad, buffer) == GST_FLOW_OK);
+  }
+
+  /* the decoded frames don't wait for EOS, only the last ones that could
+   * still be reordered and those in flight are held back */
+  fail_unless (g_list_length (buffers) >= NUM_BUFFERS - 2 * DECODE_THREADS);
+
+  fail_unless (gst_pad_push_event (mysrcpad, gst_event_new_eos ()));
+
+  /* all frames are output in presentation order even though the threads
+   * finish them out of order */
+  fail_unless_equals_int (g_list_length (buffers), NUM_BUFFERS);
+  i = 0;
+  for (iter = buffers; iter; iter = g_list_next (iter)) {
+    GstMapInfo map;
+    guint64 num;
+
+    buffer = iter->data;
+
+    gst_buffer_map (buffer, &map, GST_MAP_READ);
+    num = *(guint64 *) map.data;
+    fail_unless_equals_uint64 (num, i);
+    fail_unless (GST_BUFFER_PTS (buffer) == gst_util_uint64_scale_round (i,
+            GST_SECOND * TEST_VIDEO_FPS_D, TEST_VIDEO_FPS_N));
+    gst_buffer_unmap (buffer, &map);
+    i++;
+  }
+
+  g_list_free_full (buffers, (GDestroyNotify) gst_buffer_unref);
+  buffers = NULL;
+
+  cleanup_videodecodertest ();
+}
+
+GST_START_TEST (videodecoder_playback_dispatch)
+{
+  run_playback_dispatch (FALSE);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (videodecoder_playback_dispatch_reordered)
+{
+  run_playback_dispatch (TRUE);
+}
+
+GST_END_TEST;
+
 GST_START_TEST (videodecoder_playback_with_events)
 {
   GstSegment segment;
@@ -1267,6 +1428,9 @@ gst_videodecoder_suite (void)
   tcase_add_test (tc, videodecoder_query_caps_with_custom_getcaps);
 
   tcase_add_test (tc, videodecoder_playback);
+  tcase_add_test (tc, videodecoder_playback_dispatch);
+  tcase_add_test (tc, videodecoder_playback_dispatch_reordered);
+  tcase_add_test (tc, videodecoder_playback_renumbered_frames);
   tcase_add_test (tc, videodecoder_playback_with_events);
   tcase_add_test (tc, videodecoder_playback_first_frames_not_decoded);
   tcase_add_test (tc, videodecoder_buffer_after_segment);
@@ -0,0 +1,157 @@
+/* GStreamer audio resampler benchmark
+ * Copyright (C) 2018 The GStreamer developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <gst/gst.h>
+#include <gst/audio/audio.h>
+
+/* Runs the resampler inner loops for every sample format and filter mode
+ * and prints the throughput. Use --simd=c,sse2,avx2 to compare the
+ * functions of several instruction sets in one run, levels the CPU does not
+ * support fall back to the next lower one. Run with
+ * GST_DEBUG=audio-resampler:5 to see which SIMD optimisations were picked. */
+
+#define IN_RATE 44100
+#define OUT_RATE 48000
+#define CHANNELS 2
+#define BLOCK_FRAMES 4096
+#define RUN_TIME 1.0
+
+static const GstAudioFormat formats[] = {
+  GST_AUDIO_FORMAT_S16,
+  GST_AUDIO_FORMAT_S32,
+  GST_AUDIO_FORMAT_F32,
+  GST_AUDIO_FORMAT_F64,
+};
+
+static const struct
+{
+  const gchar *name;
+  GstAudioResamplerFilterMode mode;
+  GstAudioResamplerFilterInterpolation interpolation;
+} filters[] = {
+  {"full", GST_AUDIO_RESAMPLER_FILTER_MODE_FULL,
+      GST_AUDIO_RESAMPLER_FILTER_INTERPOLATION_NONE},
+  {"linear", GST_AUDIO_RESAMPLER_FILTER_MODE_INTERPOLATED,
+      GST_AUDIO_RESAMPLER_FILTER_INTERPOLATION_LINEAR},
+  {"cubic", GST_AUDIO_RESAMPLER_FILTER_MODE_INTERPOLATED,
+      GST_AUDIO_RESAMPLER_FILTER_INTERPOLATION_CUBIC},
+};
+
+static void
+run_one (GstAudioFormat format, gint filter, gint quality, const gchar * simd)
+{
+  const GstAudioFormatInfo *finfo = gst_audio_format_get_info (format);
+  GstAudioResampler *resampler;
+  GstStructure *options;
+  gpointer in, out;
+  gsize in_size, out_frames, total = 0;
+  GTimer *timer;
+  gdouble elapsed;
+
+  options = gst_structure_new_empty ("resampler");
+  gst_audio_resampler_options_set_quality (GST_AUDIO_RESAMPLER_METHOD_KAISER,
+      quality, IN_RATE, OUT_RATE, options);
+  gst_structure_set (options,
+      GST_AUDIO_RESAMPLER_OPT_FILTER_MODE, GST_TYPE_AUDIO_RESAMPLER_FILTER_MODE,
+      filters[filter].mode,
+      GST_AUDIO_RESAMPLER_OPT_FILTER_INTERPOLATION,
+      GST_TYPE_AUDIO_RESAMPLER_FILTER_INTERPOLATION,
+      filters[filter].interpolation, NULL);
+  if (simd)
+    gst_structure_set (options, GST_AUDIO_RESAMPLER_OPT_SIMD, G_TYPE_STRING,
+        simd, NULL);
+
+  resampler = gst_audio_resampler_new (GST_AUDIO_RESAMPLER_METHOD_KAISER,
+      GST_AUDIO_RESAMPLER_FLAG_NONE, format, CHANNELS, IN_RATE, OUT_RATE,
+      options);
+  gst_structure_free (options);
+
+  in_size = BLOCK_FRAMES * CHANNELS * GST_AUDIO_FORMAT_INFO_WIDTH (finfo) / 8;
+  in = g_malloc0 (in_size);
+  out = g_malloc0 (in_size * 2);
+
+  timer = g_timer_new ();
+  do {
+    out_frames = gst_audio_resampler_get_out_frames (resampler, BLOCK_FRAMES);
+    gst_audio_resampler_resample (resampler, &in, BLOCK_FRAMES, &out,
+        out_frames);
+    total += out_frames;
+    elapsed = g_timer_elapsed (timer, NULL);
+  } while (elapsed < RUN_TIME);
+  g_timer_destroy (timer);
+
+  g_print ("%-6s %-4s %-6s quality %2d: %8.3f Mframes/s\n",
+      simd ? simd : "best", GST_AUDIO_FORMAT_INFO_NAME (finfo),
+      filters[filter].name, quality, total / elapsed / 1000000.0);
+
+  g_free (in);
+  g_free (out);
+  gst_audio_resampler_free (resampler);
+}
+
+int
+main (int argc, char **argv)
+{
+  gchar *opt_simd = NULL;
+  GOptionEntry options[] = {
+    {"simd", 's', 0, G_OPTION_ARG_STRING, &opt_simd,
+        "SIMD levels to run (comma-separated list of c, sse, sse2, sse41, "
+          "avx2, avx512, neon)", NULL},
+    {NULL}
+  };
+  GOptionContext *ctx;
+  GError *err = NULL;
+  gchar **simd;
+  gint i, j, k, quality;
+
+  ctx = g_option_context_new ("");
+  g_option_context_add_main_entries (ctx, options, NULL);
+  g_option_context_add_group (ctx, gst_init_get_option_group ());
+  if (!g_option_context_parse (ctx, &argc, &argv, &err)) {
+    g_print ("Error initializing: %s\n", err->message);
+    g_option_context_free (ctx);
+    g_clear_error (&err);
+    return 1;
+  }
+  g_option_context_free (ctx);
+
+  simd = opt_simd ? g_strsplit (opt_simd, ",", -1) : NULL;
+
+  for (i = 0; i < G_N_ELEMENTS (formats); i++) {
+    for (j = 0; j < G_N_ELEMENTS (filters); j++) {
+      for (quality = 4; quality <= GST_AUDIO_RESAMPLER_QUALITY_MAX;
+          quality += 3) {
+        /* without --simd run the best supported functions */
+        if (simd == NULL)
+          run_one (formats[i], j, quality, NULL);
+        else
+          for (k = 0; simd[k]; k++)
+            run_one (formats[i], j, quality, simd[k]);
+      }
+    }
+  }
+
+  g_strfreev (simd);
+  g_free (opt_simd);
+
+  return 0;
+}
@@ -0,0 +1,307 @@
+/* GStreamer RTCP parsing and building benchmark
+ * Copyright (C) 2018 The GStreamer developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <string.h>
+
+#include <gst/gst.h>
+#include <gst/rtp/rtp.h>
+
+/* Parses and builds a few typical compound RTCP packets, once with the
+ * GstRTCPBuffer API and once with gst_rtcp_buffer_decode_data() and
+ * GstRTCPWriter, and prints the throughput of each. */
+
+#define RUN_TIME 1.0
+#define MAX_PACKETS 16
+
+/* SSRC, CNAME "user@host", end of chunk */
+static const guint8 sdes[] = {
+  0x11, 0x11, 0x11, 0x11, 0x01, 0x09, 'u', 's', 'e', 'r', '@', 'h', 'o', 's',
+  't', 0x00
+};
+
+/* two NACK FCI entries */
+static const guint8 nack[] = {
+  0x00, 0x10, 0x00, 0x05, 0x00, 0x20, 0x80, 0x01
+};
+
+/* REMB: "REMB", 1 SSRC, exponent and mantissa, SSRC */
+static const guint8 remb[] = {
+  'R', 'E', 'M', 'B', 0x01, 0x0b, 0x4c, 0x4b, 0x22, 0x22, 0x22, 0x22
+};
+
+typedef struct
+{
+  const gchar *name;
+  gboolean sr;
+  guint n_rb;
+  gboolean nack;
+  gboolean pli_remb;
+} Compound;
+
+static const Compound compounds[] = {
+  {"SR+RB+SDES", TRUE, 1, FALSE, FALSE},
+  {"RR+4RB+SDES+NACK", FALSE, 4, TRUE, FALSE},
+  {"RR+SDES+PLI+REMB", FALSE, 0, FALSE, TRUE},
+};
+
+static guint
+build_writer (const Compound * c, guint8 * data, guint size)
+{
+  GstRTCPWriter writer;
+  guint i;
+
+  gst_rtcp_writer_init (&writer, data, size);
+  if (c->sr)
+    gst_rtcp_writer_add_sr (&writer, 0x11111111,
+        G_GUINT64_CONSTANT (0xdeadbeef00000000), 0x12345678, 100, 120000);
+  else
+    gst_rtcp_writer_add_rr (&writer, 0x11111111);
+  for (i = 0; i < c->n_rb; i++)
+    gst_rtcp_writer_add_rb (&writer, 0x22222222 + i, 3, 10, 0x10000 + i,
+        40, 0x12340000, 0x8000);
+  gst_rtcp_writer_add_packet (&writer, GST_RTCP_TYPE_SDES, 1, sdes,
+      sizeof (sdes));
+  if (c->nack)
+    gst_rtcp_writer_add_fb (&writer, GST_RTCP_TYPE_RTPFB,
+        GST_RTCP_RTPFB_TYPE_NACK, 0x11111111, 0x22222222, nack,
+        sizeof (nack));
+  if (c->pli_remb) {
+    gst_rtcp_writer_add_fb (&writer, GST_RTCP_TYPE_PSFB,
+        GST_RTCP_PSFB_TYPE_PLI, 0x11111111, 0x22222222, NULL, 0);
+    gst_rtcp_writer_add_fb (&writer, GST_RTCP_TYPE_PSFB,
+        GST_RTCP_PSFB_TYPE_AFB, 0x11111111, 0, remb, sizeof (remb));
+  }
+
+  return writer.offset;
+}
+
+static void
+build_buffer (const Compound * c, GstBuffer * buf)
+{
+  GstRTCPBuffer rtcp = GST_RTCP_BUFFER_INIT;
+  GstRTCPPacket packet;
+  guint i;
+
+  gst_rtcp_buffer_map (buf, GST_MAP_READWRITE, &rtcp);
+  if (c->sr) {
+    gst_rtcp_buffer_add_packet (&rtcp, GST_RTCP_TYPE_SR, &packet);
+    gst_rtcp_packet_sr_set_sender_info (&packet, 0x11111111,
+        G_GUINT64_CONSTANT (0xdeadbeef00000000), 0x12345678, 100, 120000);
+  } else {
+    gst_rtcp_buffer_add_packet (&rtcp, GST_RTCP_TYPE_RR, &packet);
+    gst_rtcp_packet_rr_set_ssrc (&packet, 0x11111111);
+  }
+  for (i = 0; i < c->n_rb; i++)
+    gst_rtcp_packet_add_rb (&packet, 0x22222222 + i, 3, 10, 0x10000 + i,
+        40, 0x12340000, 0x8000);
+  gst_rtcp_buffer_add_packet (&rtcp, GST_RTCP_TYPE_SDES, &packet);
+  gst_rtcp_packet_sdes_add_item (&packet, 0x11111111);
+  gst_rtcp_packet_sdes_add_entry (&packet, GST_RTCP_SDES_CNAME, 9,
+      (const guint8 *) "user@host");
+  if (c->nack) {
+    gst_rtcp_buffer_add_packet (&rtcp, GST_RTCP_TYPE_RTPFB, &packet);
+    gst_rtcp_packet_fb_set_type (&packet, GST_RTCP_RTPFB_TYPE_NACK);
+    gst_rtcp_packet_fb_set_sender_ssrc (&packet, 0x11111111);
+    gst_rtcp_packet_fb_set_media_ssrc (&packet, 0x22222222);
+    gst_rtcp_packet_fb_set_fci_length (&packet, sizeof (nack) / 4);
+    memcpy (gst_rtcp_packet_fb_get_fci (&packet), nack, sizeof (nack));
+  }
+  if (c->pli_remb) {
+    gst_rtcp_buffer_add_packet (&rtcp, GST_RTCP_TYPE_PSFB, &packet);
+    gst_rtcp_packet_fb_set_type (&packet, GST_RTCP_PSFB_TYPE_PLI);
+    gst_rtcp_packet_fb_set_sender_ssrc (&packet, 0x11111111);
+    gst_rtcp_packet_fb_set_media_ssrc (&packet, 0x22222222);
+    gst_rtcp_buffer_add_packet (&rtcp, GST_RTCP_TYPE_PSFB, &packet);
+    gst_rtcp_packet_fb_set_type (&packet, GST_RTCP_PSFB_TYPE_AFB);
+    gst_rtcp_packet_fb_set_sender_ssrc (&packet, 0x11111111);
+    gst_rtcp_packet_fb_set_media_ssrc (&packet, 0);
+    gst_rtcp_packet_fb_set_fci_length (&packet, sizeof (remb) / 4);
+    memcpy (gst_rtcp_packet_fb_get_fci (&packet), remb, sizeof (remb));
+  }
+  gst_rtcp_buffer_unmap (&rtcp);
+}
+
+/* read the fields that a session manager typically looks at */
+static guint32
+parse_buffer (GstBuffer * buf)
+{
+  GstRTCPBuffer rtcp = GST_RTCP_BUFFER_INIT;
+  GstRTCPPacket packet;
+  guint32 ssrc, acc = 0;
+  guint64 ntptime;
+  guint i;
+  gboolean more;
+
+  if (!gst_rtcp_buffer_validate (buf))
+    return 0;
+
+  gst_rtcp_buffer_map (buf, GST_MAP_READ, &rtcp);
+  more = gst_rtcp_buffer_get_first_packet (&rtcp, &packet);
+  while (more) {
+    switch (gst_rtcp_packet_get_type (&packet)) {
+      case GST_RTCP_TYPE_SR:
+        gst_rtcp_packet_sr_get_sender_info (&packet, &ssrc, &ntptime, NULL,
+            NULL, NULL);
+        acc += ssrc + (guint32) ntptime;
+        /* fallthrough */
+      case GST_RTCP_TYPE_RR:
+        for (i = 0; i < gst_rtcp_packet_get_rb_count (&packet); i++) {
+          gst_rtcp_packet_get_rb (&packet, i, &ssrc, NULL, NULL, NULL, NULL,
+              NULL, NULL);
+          acc += ssrc;
+        }
+        break;
+      case GST_RTCP_TYPE_RTPFB:
+      case GST_RTCP_TYPE_PSFB:
+        acc += gst_rtcp_packet_fb_get_media_ssrc (&packet);
+        acc += gst_rtcp_packet_fb_get_fci_length (&packet);
+        break;
+      default:
+        acc += gst_rtcp_packet_get_length (&packet);
+        break;
+    }
+    more = gst_rtcp_packet_move_to_next (&packet);
+  }
+  gst_rtcp_buffer_unmap (&rtcp);
+
+  return acc;
+}
+
+static guint32
+parse_decode (const guint8 * data, guint size)
+{
+  GstRTCPPacketInfo info[MAX_PACKETS];
+  guint n_packets = MAX_PACKETS;
+  guint32 ssrc, acc = 0;
+  guint i, j;
+
+  if (!gst_rtcp_buffer_decode_data (data, size, FALSE, info, &n_packets))
+    return 0;
+
+  for (i = 0; i < n_packets; i++) {
+    switch (info[i].type) {
+      case GST_RTCP_TYPE_SR:
+        acc += info[i].ssrc + (guint32) info[i].ntptime;
+        /* fallthrough */
+      case GST_RTCP_TYPE_RR:
+        for (j = 0; j < info[i].rb_count; j++) {
+          gst_rtcp_packet_info_get_rb (&info[i], data, j, &ssrc, NULL, NULL,
+              NULL, NULL, NULL, NULL);
+          acc += ssrc;
+        }
+        break;
+      case GST_RTCP_TYPE_RTPFB:
+      case GST_RTCP_TYPE_PSFB:
+        acc += info[i].media_ssrc;
+        acc += info[i].data_size / 4;
+        break;
+      default:
+        acc += info[i].size / 4 - 1;
+        break;
+    }
+  }
+
+  return acc;
+}
+
+static void
+run_one (const Compound * c)
+{
+  guint8 data[1500];
+  GstBuffer *buf;
+  GTimer *timer;
+  gdouble elapsed;
+  guint64 n;
+  guint32 acc = 0;
+  guint size;
+
+  size = build_writer (c, data, sizeof (data));
+  buf = gst_buffer_new_wrapped_full (GST_MEMORY_FLAG_READONLY, data,
+      sizeof (data), 0, size, NULL, NULL);
+  g_assert (parse_buffer (buf) == parse_decode (data, size));
+
+  timer = g_timer_new ();
+
+  n = 0;
+  g_timer_start (timer);
+  do {
+    acc += parse_buffer (buf);
+    n++;
+  } while ((elapsed = g_timer_elapsed (timer, NULL)) < RUN_TIME);
+  g_print ("%-18s %3u bytes parse  GstRTCPBuffer: %8.3f Mpackets/s\n",
+      c->name, size, n / elapsed / 1000000.0);
+
+  n = 0;
+  g_timer_start (timer);
+  do {
+    acc += parse_decode (data, size);
+    n++;
+  } while ((elapsed = g_timer_elapsed (timer, NULL)) < RUN_TIME);
+  g_print ("%-18s %3u bytes parse  decode_data:   %8.3f Mpackets/s\n",
+      c->name, size, n / elapsed / 1000000.0);
+  gst_buffer_unref (buf);
+
+  n = 0;
+  g_timer_start (timer);
+  do {
+    buf = gst_rtcp_buffer_new (sizeof (data));
+    build_buffer (c, buf);
+    acc += gst_buffer_get_size (buf);
+    gst_buffer_unref (buf);
+    n++;
+  } while ((elapsed = g_timer_elapsed (timer, NULL)) < RUN_TIME);
+  g_print ("%-18s %3u bytes build  GstRTCPBuffer: %8.3f Mpackets/s\n",
+      c->name, size, n / elapsed / 1000000.0);
+
+  n = 0;
+  g_timer_start (timer);
+  do {
+    guint8 *out = g_malloc (sizeof (data));
+
+    size = build_writer (c, out, sizeof (data));
+    buf = gst_buffer_new_wrapped (out, size);
+    acc += gst_buffer_get_size (buf);
+    gst_buffer_unref (buf);
+    n++;
+  } while ((elapsed = g_timer_elapsed (timer, NULL)) < RUN_TIME);
+  g_print ("%-18s %3u bytes build  GstRTCPWriter: %8.3f Mpackets/s\n",
+      c->name, size, n / elapsed / 1000000.0);
+
+  g_timer_destroy (timer);
+
+  /* keep the compiler from optimizing the loops away */
+  if (acc == 0)
+    g_print ("\n");
+}
+
+int
+main (int argc, char **argv)
+{
+  gint i;
+
+  gst_init (&argc, &argv);
+
+  for (i = 0; i < G_N_ELEMENTS (compounds); i++)
+    run_one (&compounds[i]);
+
+  return 0;
+}
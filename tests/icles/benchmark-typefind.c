@@ -0,0 +1,114 @@
+/* GStreamer typefind benchmark
+ * Copyright (C) 2018 The GStreamer developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <gst/gst.h>
+#include <gst/base/base.h>
+
+/* Runs all registered typefinders over the head of every file in the given
+ * directory (tests/files by default) and prints the detected caps and the
+ * average typefind latency per file. Compare the output of two builds to
+ * see the effect of changes to the typefind functions. */
+
+#define HEAD_SIZE (64 * 1024)
+#define ITERATIONS 200
+
+static gdouble
+run_one (const gchar * path)
+{
+  GstTypeFindProbability prob = GST_TYPE_FIND_NONE;
+  GstCaps *caps = NULL;
+  GstBuffer *buf;
+  gchar *contents;
+  gsize size;
+  GTimer *timer;
+  gdouble elapsed;
+  gint i;
+
+  if (!g_file_get_contents (path, &contents, &size, NULL))
+    return 0.0;
+
+  size = MIN (size, HEAD_SIZE);
+  buf = gst_buffer_new_wrapped (contents, size);
+
+  timer = g_timer_new ();
+  for (i = 0; i < ITERATIONS; i++) {
+    if (caps)
+      gst_caps_unref (caps);
+    caps = gst_type_find_helper_for_buffer (NULL, buf, &prob);
+  }
+  elapsed = g_timer_elapsed (timer, NULL) / ITERATIONS;
+  g_timer_destroy (timer);
+
+  if (caps) {
+    gchar *str = gst_caps_to_string (caps);
+
+    g_print ("%-40s %8.1f us  %3u%%  %s\n", path, elapsed * 1000000.0, prob,
+        str);
+    g_free (str);
+    gst_caps_unref (caps);
+  } else {
+    g_print ("%-40s %8.1f us        (none)\n", path, elapsed * 1000000.0);
+  }
+
+  gst_buffer_unref (buf);
+
+  return elapsed;
+}
+
+int
+main (int argc, char **argv)
+{
+  const gchar *dirname = "tests/files";
+  const gchar *name;
+  gdouble total = 0.0;
+  guint n_files = 0;
+  GDir *dir;
+
+  gst_init (&argc, &argv);
+
+  if (argc > 1)
+    dirname = argv[1];
+
+  dir = g_dir_open (dirname, 0, NULL);
+  if (dir == NULL) {
+    g_printerr ("Usage: %s [DIRECTORY]\n", argv[0]);
+    return 1;
+  }
+
+  while ((name = g_dir_read_name (dir)) != NULL) {
+    gchar *path = g_build_filename (dirname, name, NULL);
+
+    if (g_file_test (path, G_FILE_TEST_IS_REGULAR)) {
+      total += run_one (path);
+      n_files++;
+    }
+    g_free (path);
+  }
+  g_dir_close (dir);
+
+  if (n_files > 0) {
+    g_print ("%u files, average %.1f us per file\n", n_files,
+        total / n_files * 1000000.0);
+  }
+
+  return 0;
+}